@@ -0,0 +1,21 @@
+# ============================================
+# Toolchain configuration for the host (virtual ESC)
+# ============================================
+# Builds Services and Control natively (x86-64 Linux) against the
+# stand-in drivers of Firmware/Simulation. No HAL, no Board, no Drivers.
+
+# Native compilers
+set(CMAKE_C_COMPILER   gcc)
+set(CMAKE_CXX_COMPILER g++)
+
+# Same warning level as the target build; keep optimisation close to the
+# firmware so hot-path timings measured on the host stay meaningful.
+set(CMAKE_C_FLAGS   "-Wall -Wextra -g -O2" CACHE STRING "C compiler flags" FORCE)
+set(CMAKE_CXX_FLAGS "-Wall -Wextra -fno-exceptions -fno-rtti -g -O2" CACHE STRING "C++ compiler flags" FORCE)
+
+# Set C++ standard
+set(CMAKE_CXX_STANDARD 20)
+set(CMAKE_CXX_STANDARD_REQUIRED ON)
+
+# libm is implicit with newlib on target, explicit on the host
+set(CMAKE_C_STANDARD_LIBRARIES "-lm" CACHE STRING "Host C libraries" FORCE)
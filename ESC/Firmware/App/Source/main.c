@@ -1,6 +1,7 @@
 #include <stdint.h>
 #include "control.h"
 #include "control_six_step.h"
+#include "control_foc.h"
 
 /* -------------------------------------------------------------------------- */
 /* Main loop ---------------------------------------------------------------- */
@@ -14,6 +15,9 @@ int main(void)
 
     // Initialize motor control specific components
     Control_Motor_Init();
+
+    // FOC drive, selectable at runtime (debug command "drive")
+    Control_Foc_Init();
     
     // Infinite main loop
     while (1)
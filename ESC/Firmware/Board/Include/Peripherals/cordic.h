@@ -0,0 +1,35 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    cordic.h
+  * @brief   This file contains all the function prototypes for
+  *          the cordic.c file
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CORDIC_H__
+#define __CORDIC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "bsp_utils.h"
+
+/* USER CODE BEGIN Includes */
+
+/* USER CODE END Includes */
+
+void MX_CORDIC_Init(void);
+
+/* USER CODE BEGIN Prototypes */
+
+/* USER CODE END Prototypes */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CORDIC_H__ */
@@ -0,0 +1,35 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    fmac.h
+  * @brief   This file contains all the function prototypes for
+  *          the fmac.c file
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __FMAC_H__
+#define __FMAC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "bsp_utils.h"
+
+/* USER CODE BEGIN Includes */
+
+/* USER CODE END Includes */
+
+void MX_FMAC_Init(void);
+
+/* USER CODE BEGIN Prototypes */
+
+/* USER CODE END Prototypes */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FMAC_H__ */
@@ -0,0 +1,40 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    cordic.c
+  * @brief   This file provides code for the configuration
+  *          of the CORDIC instance.
+  ******************************************************************************
+  * The HAL CORDIC module is not used: the coprocessor is driven through its
+  * registers by driver_math_cordic.c, which writes the function setup with
+  * every operation. Only the clock is enabled here.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+/* Includes ------------------------------------------------------------------*/
+#include "cordic.h"
+
+/* USER CODE BEGIN 0 */
+
+/* USER CODE END 0 */
+
+/* CORDIC init function */
+void MX_CORDIC_Init(void)
+{
+
+  /* USER CODE BEGIN CORDIC_Init 0 */
+
+  /* USER CODE END CORDIC_Init 0 */
+
+  /* CORDIC clock enable */
+  __HAL_RCC_CORDIC_CLK_ENABLE();
+
+  /* USER CODE BEGIN CORDIC_Init 1 */
+
+  /* USER CODE END CORDIC_Init 1 */
+
+}
+
+/* USER CODE BEGIN 1 */
+
+/* USER CODE END 1 */
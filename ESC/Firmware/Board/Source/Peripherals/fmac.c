@@ -0,0 +1,40 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    fmac.c
+  * @brief   This file provides code for the configuration
+  *          of the FMAC instance.
+  ******************************************************************************
+  * The HAL FMAC module is not used: the accelerator is driven through its
+  * registers by driver_filter_fmac.c, which preloads the coefficient memory
+  * and the filter history itself. Only the clock is enabled here.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+/* Includes ------------------------------------------------------------------*/
+#include "fmac.h"
+
+/* USER CODE BEGIN 0 */
+
+/* USER CODE END 0 */
+
+/* FMAC init function */
+void MX_FMAC_Init(void)
+{
+
+  /* USER CODE BEGIN FMAC_Init 0 */
+
+  /* USER CODE END FMAC_Init 0 */
+
+  /* FMAC clock enable */
+  __HAL_RCC_FMAC_CLK_ENABLE();
+
+  /* USER CODE BEGIN FMAC_Init 1 */
+
+  /* USER CODE END FMAC_Init 1 */
+
+}
+
+/* USER CODE BEGIN 1 */
+
+/* USER CODE END 1 */
@@ -0,0 +1,91 @@
+/**
+ * @file control_drive.h
+ * @brief Runtime selection between the six-step and FOC drives.
+ *
+ * Both scenarios are initialized at startup; only the selected one owns
+ * the fast and slow loops and the bridge. The speed / stop / status calls
+ * below go to the selected drive (debug protocol commands use them).
+ *
+ * Typical usage:
+ *  @code
+ *  Control_Motor_Init();
+ *  Control_Foc_Init();
+ *  ...
+ *  Control_Drive_Select(CONTROL_DRIVE_FOC);    // Motor at rest
+ *  Control_Drive_SetSpeed_RPM(3000.0f);
+ *  @endcode
+ */
+
+#ifndef CONTROL_DRIVE_H
+#define CONTROL_DRIVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Available drives.
+ */
+typedef enum
+{
+    CONTROL_DRIVE_SIX_STEP = 0,     ///< Trapezoidal, BEMF zero-cross (control_six_step.h), default
+    CONTROL_DRIVE_FOC               ///< Sinusoidal, flux observer (control_foc.h)
+} control_drive_t;
+
+/**
+ * @brief Switch to another drive.
+ *
+ * Refused while the active drive is running: stop it and let the rotor
+ * come to rest first. The new drive starts stopped.
+ *
+ * @param drive Drive to use
+ * @return false if the motor is running (selection unchanged)
+ */
+bool Control_Drive_Select(control_drive_t drive);
+
+/**
+ * @brief Drive currently selected.
+ */
+control_drive_t Control_Drive_Get(void);
+
+/**
+ * @brief Command a speed (mechanical RPM, signed) to the selected drive.
+ */
+void Control_Drive_SetSpeed_RPM(float rpm);
+
+/**
+ * @brief Command a torque (current, signed) to the selected drive.
+ *
+ * Six-step only (Control_Motor_SetTorqueCurrent_A()); FOC has no torque mode.
+ *
+ * @param amps Current reference [A], 0 = bridge off
+ * @return false if the selected drive has no torque mode
+ */
+bool Control_Drive_SetTorqueCurrent_A(float amps);
+
+/**
+ * @brief Stop the selected drive.
+ */
+void Control_Drive_Stop(void);
+
+/**
+ * @brief Measured speed of the selected drive (mechanical RPM).
+ *
+ * Same convention for both drives: signed by the direction (CCW negative),
+ * 0 when stopped, no low-speed floor.
+ */
+float Control_Drive_GetSpeed_RPM(void);
+
+/**
+ * @brief Print the status of the selected drive via the logging interface.
+ */
+void Control_Drive_PrintStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONTROL_DRIVE_H */
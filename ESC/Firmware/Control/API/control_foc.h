@@ -0,0 +1,137 @@
+/**
+ * @file control_foc.h
+ * @brief Public API for sensorless field-oriented control (FOC) of the BLDC.
+ *
+ * Sinusoidal alternative to the six-step scenario (control_six_step.h):
+ *  - d/q current regulators at the PWM rate (24 kHz), space-vector PWM
+ *  - rotor angle and speed from a flux observer + PLL, no sensor
+ *  - speed regulation (PI on the q current) at 1 kHz
+ *
+ * Start-up from standstill: the rotor is aligned on a d current, then
+ * dragged by a current vector turning at an increasing open-loop speed
+ * (I/f start) until the observer agrees with it, and the angle source
+ * switches to the observer.
+ *
+ * Reversal: the speed loop brakes down to the sensorless minimum, the
+ * windings are shorted (low sides on) until the rotor is at rest, then the
+ * start sequence runs in the new direction.
+ *
+ * Only one drive runs at a time: see control_drive.h to switch between
+ * six-step and FOC.
+ *
+ * Typical usage:
+ *  @code
+ *  Control_Foc_Init();                  // At startup
+ *  Control_Foc_AttachLoops();           // Or Control_Drive_Select(CONTROL_DRIVE_FOC)
+ *  Control_Foc_SetSpeed_RPM(+3000.0f);  // CW
+ *  ...
+ *  Control_Foc_Stop();
+ *  @endcode
+ */
+
+#ifndef CONTROL_FOC_H
+#define CONTROL_FOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ============================================================================
+ *  PUBLIC ENUMERATIONS / TYPES
+ * ========================================================================== */
+
+/**
+ * @brief FOC operation modes (read-only).
+ */
+typedef enum
+{
+    CONTROL_FOC_MODE_STOPPED = 0,   ///< Bridge off
+    CONTROL_FOC_MODE_ALIGNING,      ///< d current at a fixed angle: rotor pulled to it
+    CONTROL_FOC_MODE_STARTING,      ///< I/f start: open-loop angle, observer converging
+    CONTROL_FOC_MODE_RUNNING,       ///< Sensorless: observer angle, speed loop active
+    CONTROL_FOC_MODE_BRAKING        ///< Windings shorted before a restart in the other direction
+} control_foc_mode_t;
+
+/**
+ * @brief Snapshot of the FOC loops (telemetry, tests).
+ */
+typedef struct
+{
+    control_foc_mode_t mode;
+    float speed_rpm;        ///< Observer speed, mechanical (signed)
+    float theta_deg;        ///< Observer rotor angle [0, 360), zero-cross PLL frame
+    float i_d_a;            ///< Measured d current [A]
+    float i_q_a;            ///< Measured q current [A]
+    float i_q_ref_a;        ///< q current reference [A]
+    float v_d;              ///< d voltage command [V]
+    float v_q;              ///< q voltage command [V]
+} control_foc_state_t;
+
+/* ============================================================================
+ *  PUBLIC FUNCTIONS (USER API)
+ * ========================================================================== */
+
+/**
+ * @brief Initialize the FOC regulators and observer.
+ *
+ * Call once during system startup, after Control_Motor_Init() (which
+ * starts the fast and slow loops). The loops stay with the six-step drive
+ * until Control_Foc_AttachLoops().
+ */
+void Control_Foc_Init(void);
+
+/**
+ * @brief Take the fast and slow loops over from the other drive.
+ *
+ * The bridge is left off; the other drive must be stopped first.
+ */
+void Control_Foc_AttachLoops(void);
+
+/**
+ * @brief Command a new motor speed in RPM.
+ *
+ * - Positive value → CW rotation, negative → CCW
+ * - 0 → decelerate, then bridge off
+ *
+ * From standstill: alignment and I/f start. A change of direction while
+ * running decelerates to the lowest sensorless speed, stops and restarts.
+ *
+ * @param rpm  Target speed in mechanical RPM (signed).
+ */
+void Control_Foc_SetSpeed_RPM(float rpm);
+
+/**
+ * @brief Bridge off at once, all loops reset (the rotor coasts).
+ */
+void Control_Foc_Stop(void);
+
+/**
+ * @brief Get the current operating mode.
+ */
+control_foc_mode_t Control_Foc_GetMode(void);
+
+/**
+ * @brief Observer speed in mechanical RPM (signed, 0 when stopped).
+ */
+float Control_Foc_GetSpeed_RPM(void);
+
+/**
+ * @brief Read a snapshot of the FOC loops.
+ *
+ * @param out Receives the snapshot.
+ */
+void Control_Foc_GetState(control_foc_state_t *out);
+
+/**
+ * @brief Print FOC status (mode, speed, currents) via the logging interface.
+ */
+void Control_Foc_PrintStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONTROL_FOC_H */
@@ -5,7 +5,10 @@
  * This module implements a robust sensorless BLDC controller with:
  *  - Smooth Open→Closed Loop transition (no torque gap)
  *  - µs-accurate commutation scheduling
- *  - Closed-loop speed regulation (PID)
+ *  - Cascaded regulation: speed PI (1 kHz) setting the reference of a
+ *    current PI at the PWM rate (driven pair current, i.e. the DC-link
+ *    current during the on-time), which sets the duty
+ *  - Torque mode: current reference commanded directly, speed loop bypassed
  *  - Direction control (CW / CCW)
  *  - Speed ramping (linear acceleration / deceleration)
  *
@@ -16,6 +19,8 @@
  *  ...
  *  Control_Motor_SetSpeed(-1200.0f);   // Reverse direction (CCW)
  *  ...
+ *  Control_Motor_SetTorqueCurrent_A(+4.0f);   // Torque mode: 4 A, CW
+ *  ...
  *  Control_Motor_Stop();               // Stop motor safely
  *  @endcode
  *
@@ -52,6 +57,11 @@ extern "C" {
  */
 #define CONTROL_MOTOR_POLE_PAIRS  6
 
+/**
+ * @brief Largest current reference [A]: speed loop output and torque command.
+ */
+#define CONTROL_MOTOR_CURRENT_MAX_A  8.0f
+
 /* ============================================================================
  *  PUBLIC ENUMERATIONS
  * ========================================================================== */
@@ -63,9 +73,53 @@ typedef enum
 {
     CONTROL_MOTOR_MODE_STOPPED = 0,   ///< PWM disabled, no rotation
     CONTROL_MOTOR_MODE_OPEN_LOOP,     ///< Open-loop ramp during startup
-    CONTROL_MOTOR_MODE_CLOSED_LOOP    ///< Closed-loop BEMF control active
+    CONTROL_MOTOR_MODE_CLOSED_LOOP,   ///< Closed-loop BEMF control active
+    CONTROL_MOTOR_MODE_CATCHING,      ///< Flying start: listening to a spinning rotor
+    CONTROL_MOTOR_MODE_LOCATING       ///< Standstill start: inductive rotor position detection
 } control_motor_mode_t;
 
+/* ============================================================================
+ *  DESYNC DETECTION AND RECOVERY
+ * ========================================================================== */
+
+/**
+ * @brief Number of desync causes counted separately (ZC timeout, ZC window,
+ *        period jump, current spike).
+ */
+#define CONTROL_MOTOR_DESYNC_CAUSES  4
+
+/**
+ * @brief Loss-of-synchronization retry policy.
+ *
+ * On a desync in closed loop, the controller first re-syncs from BEMF (the
+ * open-loop sequence restarts from the estimated rotor position and speed,
+ * without stopping the rotor), then re-aligns and ramps, then gives up and
+ * stops. The attempt counters are cleared once closed loop has been held
+ * for @c stable_ms.
+ */
+typedef struct
+{
+    bool     enabled;        ///< Detection and automatic recovery
+    uint8_t  max_resyncs;    ///< Re-syncs from BEMF before re-aligning
+    uint8_t  max_restarts;   ///< Re-align + ramp attempts before giving up
+    uint16_t stable_ms;      ///< Closed loop held this long: attempts forgiven
+} control_motor_desync_policy_t;
+
+/**
+ * @brief Desync counters (since power-up).
+ */
+typedef struct
+{
+    uint32_t events;                                ///< Desyncs detected
+    uint32_t by_cause[CONTROL_MOTOR_DESYNC_CAUSES]; ///< ZC timeout, ZC window, period jump, current spike
+    uint32_t resyncs;                               ///< Re-sync attempts
+    uint32_t restarts;                              ///< Re-align + ramp attempts
+    uint32_t recovered;                             ///< Returns to closed loop
+    uint32_t give_ups;                              ///< Recoveries abandoned (motor stopped)
+    uint32_t last_recovery_us;                      ///< Detection → closed loop, last recovery
+    uint32_t max_recovery_us;                       ///< Longest recovery
+} control_motor_desync_stats_t;
+
 /* ============================================================================
  *  PUBLIC FUNCTIONS (USER API)
  * ========================================================================== */
@@ -77,6 +131,13 @@ typedef enum
  */
 void Control_Motor_Init(void);
 
+/**
+ * @brief Take the fast and slow loops back from another drive.
+ *
+ * The bridge is left off; advance map and desync policy are kept.
+ */
+void Control_Motor_AttachLoops(void);
+
 /**
  * @brief Command a new motor speed in RPM.
  *
@@ -84,13 +145,33 @@ void Control_Motor_Init(void);
  * - Negative value → CCW rotation
  * - 0 → decelerate to stop
  *
- * If the motor is stopped, it will automatically perform alignment,
- * then open-loop startup, and finally switch to closed-loop mode.
+ * If the motor is stopped, it first listens to the BEMF with the bridge
+ * off: a rotor already spinning in the commanded direction (windmilling
+ * prop) is caught and driven in closed loop directly. Otherwise it
+ * locates the rotor by inductive sensing (alignment if that fails or the
+ * rotor was seen turning), then performs the open-loop startup from that
+ * position, and finally switches to closed-loop mode.
  *
  * @param rpm  Target speed in mechanical RPM (signed).
  */
 void Control_Motor_SetSpeed_RPM(float rpm);
 
+/**
+ * @brief Command a torque as the current of the driven pair [A], signed.
+ *
+ * Torque mode: the current loop follows this reference directly, the
+ * speed loop is bypassed (it takes over again, without a step, at the next
+ * Control_Motor_SetSpeed_RPM()). Starts the motor like a speed command if
+ * stopped; a change of sign coasts the rotor down (no current), then
+ * restarts in the other direction.
+ *
+ * - Positive value → CW torque, negative → CCW
+ * - 0 → bridge off at once (the rotor coasts)
+ *
+ * @param amps  Current reference, clamped to CONTROL_MOTOR_CURRENT_MAX_A.
+ */
+void Control_Motor_SetTorqueCurrent_A(float amps);
+
 /**
  * @brief Stop the motor smoothly (soft stop).
  *
@@ -100,11 +181,23 @@ void Control_Motor_SetSpeed_RPM(float rpm);
 void Control_Motor_Stop(void);
 
 /**
- * @brief Get the current commanded target speed (RPM).
- * @return Current speed command in RPM (positive value).
+ * @brief Get the speed target of the ramp (RPM).
+ * @return Ramped speed target in RPM (positive value, 0 outside closed loop).
  */
 float Control_Motor_GetTargetSpeed_RPM(void);
 
+/**
+ * @brief Get the measured speed (RPM).
+ * @return Speed from the BEMF in mechanical RPM (signed: CCW negative, 0 when stopped).
+ */
+float Control_Motor_GetMeasuredSpeed_RPM(void);
+
+/**
+ * @brief Get the current operating mode (stopped / open loop / closed loop).
+ * @return Current control mode.
+ */
+control_motor_mode_t Control_Motor_GetMode(void);
+
 /**
  * @brief Set the maximum slope of the internal speed ramp (RPM per ms).
  *
@@ -115,6 +208,33 @@ float Control_Motor_GetTargetSpeed_RPM(void);
  */
 void Control_Motor_SetRampSlope(float rpm_per_ms);
 
+/**
+ * @brief Calibrate the commutation advance at the current operating point.
+ *
+ * Sweeps the advance while the speed loop holds the speed, then stores the
+ * advance of lowest phase current in the nearest cell of the advance map
+ * (about 2 s; aborted if the motor leaves closed loop or the speed drifts).
+ *
+ * @return false if not running in closed loop or already calibrating.
+ */
+bool Control_Motor_CalibrateAdvance(void);
+
+/**
+ * @brief Set the desync detection / recovery policy.
+ *
+ * Default: enabled, 2 re-syncs, 3 restarts, 500 ms to forgive attempts.
+ *
+ * @param policy  New policy (copied).
+ */
+void Control_Motor_SetDesyncPolicy(const control_motor_desync_policy_t *policy);
+
+/**
+ * @brief Read the desync detection / recovery counters.
+ *
+ * @param stats  Receives a copy of the counters.
+ */
+void Control_Motor_GetDesyncStats(control_motor_desync_stats_t *stats);
+
 /**
  * @brief Print motor control debug statistics via logging interface.
  *
@@ -21,7 +21,9 @@
 #include "service_bemf_monitor.h"
 #include "service_bldc_motor.h"
 #include "service_dc_motor.h"
+#include "service_comm_advance.h"
 #include "control_six_step.h"
+#include "control_drive.h"
 
 /// Maximum frame buffer size
 #define FRAME_MAX_SIZE 64
@@ -208,6 +210,14 @@ static void dispatch_system_command(const protocol_msg_t* msg)
             break;
         }
 
+        case CMD_PERF:
+        {
+            // Dump worst-case execution times, then start a new window
+            Service_Perf_Print();
+            Service_Perf_Reset();
+            break;
+        }
+
         case CMD_SETSPEED:
         {
             // Check that the command has at least one argument
@@ -227,17 +237,41 @@ static void dispatch_system_command(const protocol_msg_t* msg)
             }
 
             // Command the motor with the specified speed (RPM)
-            Control_Motor_SetSpeed_RPM(RPM);
+            Control_Drive_SetSpeed_RPM(RPM);
 
             // Confirm to the user that the speed was set
             LOG_INFO("Motor commanded with speed of: %d RPM", RPM);
             break;
         }
 
+        case CMD_SETTORQUE:
+        {
+            // Current reference in amps, float or int, signed like the speed
+            if (msg->arg_count < 1 || (msg->args[0].type != PROTOCOL_ARG_FLOAT && msg->args[0].type != PROTOCOL_ARG_INT)) {
+                LOG_WARN("Usage: settorque <amps>");
+                break;
+            }
+
+            float amps = (msg->args[0].type == PROTOCOL_ARG_FLOAT) ? msg->args[0].value.f : (float)msg->args[0].value.i;
+            if (amps < -CONTROL_MOTOR_CURRENT_MAX_A || amps > CONTROL_MOTOR_CURRENT_MAX_A) {
+                LOG_WARN("Invalid current: must be between -%d and %d A",
+                         (int)CONTROL_MOTOR_CURRENT_MAX_A, (int)CONTROL_MOTOR_CURRENT_MAX_A);
+                break;
+            }
+
+            if (!Control_Drive_SetTorqueCurrent_A(amps)) {
+                LOG_WARN("Torque mode needs the six-step drive");
+                break;
+            }
+
+            LOG_INFO("Motor commanded with current of: %d mA", (int)(amps * 1000.0f));
+            break;
+        }
+
         case CMD_STOP:
         {
             // Stop the motor by setting duty cycle to zero
-            Control_Motor_Stop();
+            Control_Drive_Stop();
             LOG_INFO("Motor stopped safely.");
             break;
         }
@@ -292,13 +326,68 @@ static void dispatch_system_command(const protocol_msg_t* msg)
 
         case CMD_STATUS:
         {
-            Control_Motor_PrintStats();
+            Control_Drive_PrintStats();
             break;
         }
 
         case CMD_GETSPEED:
         {
-            LOG_INFO("Speed = %d RPM", (uint32_t) Control_Motor_GetTargetSpeed_RPM());
+            LOG_INFO("Speed = %d RPM", (int)Control_Drive_GetSpeed_RPM());
+            break;
+        }
+
+        case CMD_ADVGET:
+        {
+            Service_CommAdvance_Print();
+            break;
+        }
+
+        case CMD_ADVSET:
+        {
+            // Two indices, then the advance as float or int
+            if (msg->arg_count < 3 || msg->args[0].type != PROTOCOL_ARG_INT || msg->args[1].type != PROTOCOL_ARG_INT ||
+                (msg->args[2].type != PROTOCOL_ARG_FLOAT && msg->args[2].type != PROTOCOL_ARG_INT)) {
+                LOG_WARN("Usage: advset <speed_idx> <current_idx> <deg>");
+                break;
+            }
+
+            float deg = (msg->args[2].type == PROTOCOL_ARG_FLOAT) ? msg->args[2].value.f : (float)msg->args[2].value.i;
+            if (msg->args[0].value.i < 0 || msg->args[1].value.i < 0 ||
+                !Service_CommAdvance_SetCell((uint8_t)msg->args[0].value.i, (uint8_t)msg->args[1].value.i, deg)) {
+                LOG_WARN("Invalid cell or advance (0 - 30 deg)");
+                break;
+            }
+
+            LOG_INFO("Advance cell [%d][%d] set", (int)msg->args[0].value.i, (int)msg->args[1].value.i);
+            break;
+        }
+
+        case CMD_ADVCAL:
+        {
+            if (!Control_Motor_CalibrateAdvance())
+                LOG_WARN("Advance calibration needs the motor in closed loop");
+            break;
+        }
+
+        case CMD_DRIVE:
+        {
+            if (msg->arg_count < 1 || msg->args[0].type != PROTOCOL_ARG_STRING) {
+                LOG_WARN("Usage: drive <sixstep|foc>");
+                break;
+            }
+
+            const char* arg = msg->args[0].value.str;
+            control_drive_t drive;
+
+            if      (strcmp(arg, "sixstep") == 0) drive = CONTROL_DRIVE_SIX_STEP;
+            else if (strcmp(arg, "foc")     == 0) drive = CONTROL_DRIVE_FOC;
+            else {
+                LOG_WARN("Invalid drive: %s (sixstep or foc)", arg);
+                break;
+            }
+
+            // Refused (and logged) while the motor is running
+            (void)Control_Drive_Select(drive);
             break;
         }
 
@@ -0,0 +1,120 @@
+/**
+ * @file control_drive.c
+ * @brief Runtime selection between the six-step and FOC drives.
+ */
+
+#include "control_drive.h"
+#include "control_foc.h"
+#include "control_six_step.h"
+#include "service_generic.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* --- Module state --- */
+static control_drive_t s_drive = CONTROL_DRIVE_SIX_STEP;
+
+/**
+ * @brief True while the selected drive has the bridge on.
+ */
+static bool Drive_IsRunning(void)
+{
+    if (s_drive == CONTROL_DRIVE_FOC)
+        return Control_Foc_GetMode() != CONTROL_FOC_MODE_STOPPED;
+
+    return Control_Motor_GetMode() != CONTROL_MOTOR_MODE_STOPPED;
+}
+
+/**
+ * @brief Switch to another drive (motor stopped only).
+ */
+bool Control_Drive_Select(control_drive_t drive)
+{
+    if (drive == s_drive)
+        return true;
+
+    if (Drive_IsRunning())
+    {
+        LOG_WARN("Drive change refused: motor running");
+        return false;
+    }
+
+    if (drive == CONTROL_DRIVE_FOC)
+    {
+        Control_Motor_Stop();
+        Control_Foc_AttachLoops();
+    }
+    else
+    {
+        Control_Foc_Stop();
+        Control_Motor_AttachLoops();
+    }
+
+    s_drive = drive;
+    LOG_INFO("Drive: %s", (drive == CONTROL_DRIVE_FOC) ? "FOC" : "six-step");
+    return true;
+}
+
+/**
+ * @brief Drive currently selected.
+ */
+control_drive_t Control_Drive_Get(void)
+{
+    return s_drive;
+}
+
+/**
+ * @brief Speed command to the selected drive.
+ */
+void Control_Drive_SetSpeed_RPM(float rpm)
+{
+    if (s_drive == CONTROL_DRIVE_FOC)
+        Control_Foc_SetSpeed_RPM(rpm);
+    else
+        Control_Motor_SetSpeed_RPM(rpm);
+}
+
+/**
+ * @brief Torque command to the selected drive (six-step only).
+ */
+bool Control_Drive_SetTorqueCurrent_A(float amps)
+{
+    if (s_drive == CONTROL_DRIVE_FOC)
+        return false;
+
+    Control_Motor_SetTorqueCurrent_A(amps);
+    return true;
+}
+
+/**
+ * @brief Stop the selected drive.
+ */
+void Control_Drive_Stop(void)
+{
+    if (s_drive == CONTROL_DRIVE_FOC)
+        Control_Foc_Stop();
+    else
+        Control_Motor_Stop();
+}
+
+/**
+ * @brief Measured speed of the selected drive.
+ */
+float Control_Drive_GetSpeed_RPM(void)
+{
+    if (s_drive == CONTROL_DRIVE_FOC)
+        return Control_Foc_GetSpeed_RPM();
+
+    return Control_Motor_GetMeasuredSpeed_RPM();
+}
+
+/**
+ * @brief Status of the selected drive.
+ */
+void Control_Drive_PrintStats(void)
+{
+    if (s_drive == CONTROL_DRIVE_FOC)
+        Control_Foc_PrintStats();
+    else
+        Control_Motor_PrintStats();
+}
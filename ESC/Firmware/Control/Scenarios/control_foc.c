@@ -0,0 +1,626 @@
+/**
+ * @file control_foc.c
+ * @brief Sensorless field-oriented control of the BLDC (sinusoidal drive).
+ *
+ * Fast loop (24 kHz, one run per current sample):
+ *  - phase currents signed from a one-period prediction, Clarke
+ *  - flux observer + PLL: rotor angle and speed
+ *  - d/q PI current regulators with cross-coupling and BEMF feed-forward
+ *  - space-vector duties (overmodulation up to six-step), ADC trigger in
+ *    the common off-time
+ *
+ * Slow loop (1 kHz): bus voltage, speed ramp, speed PI → q current.
+ *
+ * Start-up (I/f): d current at angle 0 aligns the rotor, then the current
+ * vector turns at an open-loop speed ramped up to FOC_START_RPM, dragging
+ * the rotor behind it while the observer converges. Once the PLL speed
+ * agrees with the open-loop one, the regulators switch to the observer
+ * frame (states rotated, torque kept) and the speed loop takes over.
+ *
+ * Timing: on the virtual ESC the sample and the fast loop come just before
+ * the PWM update event, so the duties written here apply over the next
+ * sampling interval. The output angle is advanced by half an interval
+ * (mean angle over the period the duties are applied).
+ */
+
+#include "control_foc.h"
+#include "service_generic.h"
+#include "service_bldc_motor.h"
+#include "service_foc.h"
+#include "service_math.h"
+#include "service_modulator.h"
+#include "service_loop.h"
+#include "service_pid.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ *  CONFIGURATION CONSTANTS
+ * ========================================================================== */
+
+#define FOC_POLE_PAIRS               6           ///< Motor pole-pair count (mechanical↔electrical conversion)
+#define FOC_PHASE_R_OHM              0.10f       ///< Phase resistance [Ω]
+#define FOC_PHASE_L_H                30e-6f      ///< Phase inductance [H]
+#define FOC_FLUX_WB                  1.05e-3f    ///< Magnet flux linkage, fundamental [Wb] (ke · 1.216 / pole pairs)
+#define FOC_CURRENT_BW_HZ            1500.0f     ///< Current loop bandwidth (PI zero on the R/L pole)
+#define FOC_DUTY_MAX                 0.85f       ///< Largest phase duty (off-time left for the current sample)
+#define FOC_SIGN_BAND_A              0.5f        ///< Phase current this close to zero: sign re-checked both ways
+#define FOC_IQ_MAX_A                 8.0f        ///< Speed loop output limit [A]
+#define FOC_I_MIN_A                  2.0f        ///< Smallest current vector (d current fills in at light load) [A]
+#define FOC_ALIGN_A                  3.0f        ///< Alignment d current [A]
+#define FOC_ALIGN_MS                 100U        ///< Alignment time
+#define FOC_START_A                  3.0f        ///< I/f start current [A]
+#define FOC_START_RPM                600.0f      ///< Open-loop speed reached by the I/f ramp
+#define FOC_START_MS                 250U        ///< I/f ramp time
+#define FOC_HANDOVER_TOL             0.25f       ///< Observer / open-loop speed agreement (fraction)
+#define FOC_HANDOVER_MS              10U         ///< Agreement held this long before switching to the observer
+#define FOC_HANDOVER_TIMEOUT_MS      100U        ///< No agreement this long after the ramp: start failed
+#define FOC_PLL_BW_HZ                100.0f      ///< Angle PLL bandwidth
+#define FOC_SPEED_KP                 0.02f       ///< Speed PI [A/RPM]
+#define FOC_SPEED_KI                 0.6f        ///< Speed PI [A/(RPM·s)]
+#define FOC_MIN_RPM                  300.0f      ///< Lowest sensorless speed (below: stop)
+#define FOC_BRAKE_MS                 100U        ///< Windings shorted this long before a reversed start
+#define DEFAULT_RAMP_SLOPE_RPM_MS    10.0f       ///< Speed target ramp slope (RPM/ms)
+#define FOC_VBUS_DEFAULT_V           12.0f       ///< Bus voltage until the first reading
+
+#define FOC_TWO_PI                   6.28318531f
+#define FOC_RPM_TO_RAD_S             (FOC_TWO_PI * (float)FOC_POLE_PAIRS / 60.0f)   ///< Mechanical RPM → electrical rad/s
+
+/* ============================================================================
+ *  LOCAL TYPES AND CONTEXT
+ * ========================================================================== */
+
+/* --- Module state --- */
+static volatile control_foc_mode_t s_mode = CONTROL_FOC_MODE_STOPPED;
+static bool     s_direction_cw = true;
+static float    s_ts = 1.0f / 24000.0f;         ///< Fast loop period [s]
+static uint32_t s_ticks_per_ms = 24U;
+
+/* --- Bus voltage (slow loop) --- */
+static float s_vbus = FOC_VBUS_DEFAULT_V;
+static float s_v_max;                           ///< Largest voltage vector (six-step fundamental) [V]
+
+/* --- Angle and speed --- */
+static foc_observer_t s_obs;
+static foc_pll_t      s_pll;
+
+/* --- Current regulation --- */
+static pid_t    s_pid_d;
+static pid_t    s_pid_q;
+static foc_dq_t s_i_ref;                        ///< Current references [A]
+static foc_dq_t s_i_dq;                         ///< Last measured currents [A]
+static foc_dq_t s_v_dq;                         ///< Last voltage command [V]
+static foc_ab_t s_v_applied;                    ///< Mean vector since the last sample [V]
+static foc_ab_t s_v_written;                    ///< Vector of the duties written last [V]
+static float    s_output_lead = 0.5f;           ///< Next sample to the centre of the pulse it commands [sampling periods]
+
+/* --- I/f start --- */
+static float    s_theta_ol;                     ///< Open-loop angle [rad]
+static float    s_omega_ol;                     ///< Open-loop speed, electrical [rad/s]
+static uint32_t s_ticks;                        ///< Fast loop ticks in the current start phase
+static uint32_t s_agree_ticks;                  ///< Ticks of observer / open-loop agreement
+static bool     s_handover_done;                ///< Observer frame reached (slow loop: speed PI)
+static bool     s_start_failed;                 ///< No observer agreement (slow loop: stop)
+
+/* --- Speed control --- */
+static pid_t s_pid_speed;
+static float s_speed_rpm          = 0.0f;       ///< Observer speed (signed)
+static float s_target_speed_rpm   = 0.0f;       ///< Ramped target (signed)
+static float s_commanded_speed_rpm = 0.0f;      ///< User command (signed)
+static float s_buffer_speed_rpm   = 0.0f;       ///< Command buffered during a reversal
+static bool  s_reverse_pending    = false;
+static uint32_t s_brake_ms        = 0U;         ///< Time spent braking before a reversed start
+
+/* ============================================================================
+ *  STATIC (INTERNAL) FUNCTIONS
+ * ========================================================================== */
+
+/**
+ * @brief Current regulator limits from the bus voltage.
+ */
+static void Foc_SetVoltageLimits(float vbus)
+{
+    s_vbus  = vbus;
+    s_v_max = Service_Modulator_MaxVoltage(vbus, FOC_DUTY_MAX);
+
+    s_pid_d.out_min = s_pid_q.out_min = -s_v_max;
+    s_pid_d.out_max = s_pid_q.out_max =  s_v_max;
+    s_pid_d.integrator_limit = s_pid_q.integrator_limit = s_v_max;
+}
+
+/**
+ * @brief Current references for a torque current.
+ *
+ * Below FOC_I_MIN_A the vector is completed with negative d current (no
+ * torque, slight field weakening): phase currents near zero all the time
+ * would leave their signs to noise.
+ */
+static void Foc_SetTorqueCurrent(float i_q)
+{
+    float i_d2 = FOC_I_MIN_A * FOC_I_MIN_A - i_q * i_q;
+
+    s_i_ref.d = (i_d2 > 0.0f) ? -sqrtf(i_d2) : 0.0f;
+    s_i_ref.q = i_q;
+}
+
+/**
+ * @brief Switch the regulators from the open-loop frame to the observer
+ *        frame.
+ *
+ * The integrators are vectors of the stationary frame expressed in the old
+ * axes: re-expressed in the new ones, the voltage is unchanged. The q
+ * current reference takes the torque the start current gives the rotor
+ * now.
+ */
+static void Foc_Handover(void)
+{
+    float delta = Service_Foc_WrapPi(s_pll.theta_rad - s_theta_ol);
+    float sin_d, cos_d;
+    Service_Math_SinCos(delta, &sin_d, &cos_d);
+
+    foc_ab_t integ = { s_pid_d.integrator, s_pid_q.integrator };
+    foc_dq_t integ_new = Service_Foc_Park(&integ, sin_d, cos_d);
+    s_pid_d.integrator = integ_new.d;
+    s_pid_q.integrator = integ_new.q;
+
+    Foc_SetTorqueCurrent(-FOC_START_A * sin_d);
+
+    s_handover_done = true;
+    s_mode = CONTROL_FOC_MODE_RUNNING;
+}
+
+/**
+ * @brief Alignment and I/f start sequencing (fast loop).
+ */
+static void Foc_Start_Process(const foc_ab_t *i_ab)
+{
+    s_ticks++;
+
+    if (s_mode == CONTROL_FOC_MODE_ALIGNING)
+    {
+        if (s_ticks < FOC_ALIGN_MS * s_ticks_per_ms)
+            return;
+
+        /* Rotor flux on the current vector: the observer starts there */
+        Service_Foc_Observer_Reset(&s_obs, s_theta_ol, i_ab);
+        Service_Foc_Pll_Reset(&s_pll, s_theta_ol, 0.0f);
+        s_i_ref.d     = FOC_START_A;
+        s_ticks       = 0U;
+        s_agree_ticks = 0U;
+        s_mode        = CONTROL_FOC_MODE_STARTING;
+        return;
+    }
+
+    /* --- Open-loop speed ramp --- */
+    float omega_end = FOC_START_RPM * FOC_RPM_TO_RAD_S;
+    float accel     = omega_end / ((float)FOC_START_MS * 1e-3f);
+
+    if (fabsf(s_omega_ol) < omega_end)
+    {
+        s_omega_ol += (s_direction_cw ? accel : -accel) * s_ts;
+        return;
+    }
+    s_omega_ol = s_direction_cw ? omega_end : -omega_end;
+
+    /* --- Observer agreement → handover --- */
+    if (fabsf(s_pll.omega_rad_s - s_omega_ol) < FOC_HANDOVER_TOL * omega_end)
+        s_agree_ticks++;
+    else
+        s_agree_ticks = 0U;
+
+    if (s_agree_ticks >= FOC_HANDOVER_MS * s_ticks_per_ms)
+        Foc_Handover();
+    else if (s_ticks >= (FOC_START_MS + FOC_HANDOVER_TIMEOUT_MS) * s_ticks_per_ms)
+        s_start_failed = true;
+}
+
+/**
+ * @brief FOC fast loop (executed at 24 kHz, after each current sample).
+ */
+static void Foc_FastLoop(void)
+{
+    if (s_mode == CONTROL_FOC_MODE_STOPPED || s_mode == CONTROL_FOC_MODE_BRAKING || s_start_failed)
+        return;
+
+    if (!Service_ADC_Motor_UpdateMeasurements())
+        return;
+
+    /* ----------------------------------------------------------------------
+     * 1. OPEN-LOOP ANGLE (start-up)
+     * ---------------------------------------------------------------------- */
+    bool running = (s_mode == CONTROL_FOC_MODE_RUNNING);
+
+    if (!running)
+        s_theta_ol = Service_Foc_WrapPi(s_theta_ol + s_omega_ol * s_ts);
+
+    /* ----------------------------------------------------------------------
+     * 2. SIGNED PHASE CURRENTS
+     * ----------------------------------------------------------------------
+     * The amplifiers give magnitudes: signs from the current predicted over
+     * the period just ended. During the start the observer has not converged
+     * and its prediction can latch a wrong sign: signs from the current
+     * reference instead, which the regulators track.
+     */
+    foc_ab_t i_exp;
+    if (running)
+    {
+        i_exp = Service_Foc_Observer_PredictCurrent(&s_obs, &s_v_applied, s_pll.omega_rad_s, s_ts);
+    }
+    else
+    {
+        float sin_ol, cos_ol;
+        Service_Math_SinCos(s_theta_ol, &sin_ol, &cos_ol);
+        i_exp = Service_Foc_InvPark(&s_i_ref, sin_ol, cos_ol);
+    }
+
+    float i_a, i_b;
+    Service_Foc_SignCurrents(Service_Get_PhaseA_Current_Inst(), Service_Get_PhaseB_Current_Inst(),
+                             &i_exp, &s_obs.i_prev, FOC_SIGN_BAND_A, &i_a, &i_b);
+    foc_ab_t i_ab = Service_Foc_Clarke(i_a, i_b);
+
+    /* ----------------------------------------------------------------------
+     * 3. OBSERVER + PLL (voltage applied since the previous sample)
+     * ---------------------------------------------------------------------- */
+    Service_Foc_Observer_Update(&s_obs, &s_v_applied, &i_ab, s_ts);
+    Service_Foc_Pll_Update(&s_pll, s_obs.theta_rad, s_ts);
+
+    if (!running)
+    {
+        Foc_Start_Process(&i_ab);
+        running = (s_mode == CONTROL_FOC_MODE_RUNNING);
+    }
+
+    float theta = running ? s_pll.theta_rad   : s_theta_ol;
+    float omega = running ? s_pll.omega_rad_s : s_omega_ol;
+
+    /* ----------------------------------------------------------------------
+     * 4. CURRENT REGULATORS
+     * ----------------------------------------------------------------------
+     * PI on each axis, plus the rotation terms: -ωL·iq on d, ω(L·id + ψ)
+     * on q. The vector is limited to the six-step fundamental: beyond the
+     * inscribed circle the modulator overmodulates.
+     *
+     * Sine and cosine of the sampling and output angles in one batch. The
+     * duties written now transfer at the update at the period top (written
+     * before it, RCR = 1) and their pulses are centred on the next
+     * underflow: the output angle leads the sample by one period less the
+     * trigger position after the centre of the on-time.
+     */
+    float angle[2] = { theta, theta + omega * (s_output_lead * s_ts) };
+    float sin_a[2], cos_a[2];
+    Service_Math_SinCosN(angle, sin_a, cos_a, 2U);
+
+    s_i_dq = Service_Foc_Park(&i_ab, sin_a[0], cos_a[0]);
+
+    foc_dq_t v = {
+        .d = Service_PID_Update(&s_pid_d, s_i_ref.d, s_i_dq.d) - omega * FOC_PHASE_L_H * s_i_dq.q,
+        .q = Service_PID_Update(&s_pid_q, s_i_ref.q, s_i_dq.q) + omega * (FOC_PHASE_L_H * s_i_dq.d + FOC_FLUX_WB),
+    };
+
+    float v_mag = Service_Math_Magnitude(v.d, v.q);
+    if (v_mag > s_v_max)
+    {
+        float scale = s_v_max / v_mag;
+        v.d *= scale;
+        v.q *= scale;
+    }
+    s_v_dq = v;
+
+    /* ----------------------------------------------------------------------
+     * 5. MODULATION
+     * ---------------------------------------------------------------------- */
+    foc_ab_t v_ab = Service_Foc_InvPark(&v, sin_a[1], cos_a[1]);
+
+    float duty[3];
+    (void)Service_Modulator_AlphaBeta(v_ab.alpha, v_ab.beta, s_vbus, FOC_DUTY_MAX, duty);
+    Service_Motor_SetPhaseDuties(duty);
+    s_output_lead = 1.0f - Service_Motor_PlaceAdcTriggerOffTime(fmaxf(fmaxf(duty[0], duty[1]), duty[2]));
+
+    /* Next interval: second half of the period running now, first half of the next */
+    foc_ab_t v_new = Service_Foc_VoltageOfDuties(duty, s_vbus);
+    s_v_applied.alpha = 0.5f * (s_v_written.alpha + v_new.alpha);
+    s_v_applied.beta  = 0.5f * (s_v_written.beta  + v_new.beta);
+    s_v_written = v_new;
+}
+
+/**
+ * @brief Start from standstill: bridge on, alignment first.
+ */
+static void Foc_Start(float rpm)
+{
+    s_mode = CONTROL_FOC_MODE_STOPPED;          // Fast loop idle while resetting
+
+    s_direction_cw        = (rpm >= 0.0f);
+    s_commanded_speed_rpm = rpm;
+    s_target_speed_rpm    = 0.0f;
+    s_speed_rpm           = 0.0f;
+    s_reverse_pending     = false;
+
+    Service_PID_Reset(&s_pid_d);
+    Service_PID_Reset(&s_pid_q);
+    Service_PID_Reset(&s_pid_speed);
+    Service_Foc_Observer_Reset(&s_obs, 0.0f, NULL);
+    Service_Foc_Pll_Reset(&s_pll, 0.0f, 0.0f);
+
+    s_theta_ol = s_omega_ol = 0.0f;
+    s_i_ref.d  = FOC_ALIGN_A;
+    s_i_ref.q  = 0.0f;
+    memset(&s_i_dq, 0, sizeof(s_i_dq));
+    memset(&s_v_dq, 0, sizeof(s_v_dq));
+    memset(&s_v_applied, 0, sizeof(s_v_applied));
+    memset(&s_v_written, 0, sizeof(s_v_written));
+    s_ticks = s_agree_ticks = 0U;
+    s_handover_done = s_start_failed = false;
+
+    Service_Motor_Sinusoidal_Start();
+    s_output_lead = 1.0f - Service_Motor_PlaceAdcTriggerOffTime(0.5f);
+
+    LOG_INFO("FOC start: (%s)", s_direction_cw ? "CW" : "CCW");
+    s_mode = CONTROL_FOC_MODE_ALIGNING;
+}
+
+/**
+ * @brief Short the windings (all low sides on) to stop the rotor before a
+ *        reversed start: an I/f start needs it at rest.
+ */
+static void Foc_Brake(void)
+{
+    static const float duty_low[3] = { 0.0f, 0.0f, 0.0f };
+
+    s_mode = CONTROL_FOC_MODE_BRAKING;          // Fast loop idle
+    s_reverse_pending = false;
+    s_brake_ms = 0U;
+    Service_Motor_SetPhaseDuties(duty_low);
+}
+
+/**
+ * @brief 1 kHz slow loop: bus voltage, speed ramp + PI, stop / reversal.
+ */
+static void Foc_LowLoop(void)
+{
+    float vbus = Service_GetBus_Voltage();
+    Foc_SetVoltageLimits((vbus > 1.0f) ? vbus : FOC_VBUS_DEFAULT_V);
+
+    if (s_mode == CONTROL_FOC_MODE_STOPPED)
+        return;
+
+    /* --- Reversal: windings shorted, then start the other way --- */
+    if (s_mode == CONTROL_FOC_MODE_BRAKING)
+    {
+        if (++s_brake_ms >= FOC_BRAKE_MS)
+        {
+            LOG_INFO("Restarting in opposite direction (%s)", (s_buffer_speed_rpm >= 0.0f) ? "CW" : "CCW");
+            Foc_Start(s_buffer_speed_rpm);
+        }
+        return;
+    }
+
+    s_speed_rpm = s_pll.omega_rad_s / FOC_RPM_TO_RAD_S;
+
+    /* --- Start outcome --- */
+    if (s_start_failed)
+    {
+        LOG_WARN("FOC start failed: observer not locked at %lu RPM", (unsigned long)FOC_START_RPM);
+        Control_Foc_Stop();
+        return;
+    }
+
+    if (s_handover_done)
+    {
+        s_handover_done = false;
+
+        /* Speed loop continues from the torque the rotor has now */
+        Service_PID_Reset(&s_pid_speed);
+        s_pid_speed.integrator = s_i_ref.q;
+        s_target_speed_rpm = s_speed_rpm;
+        LOG_INFO("FOC: sensorless at %ld RPM", (long)s_speed_rpm);
+    }
+
+    if (s_mode != CONTROL_FOC_MODE_RUNNING)
+        return;
+
+    /* --- Target ramp (signed), not below the sensorless minimum --- */
+    float delta = s_commanded_speed_rpm - s_target_speed_rpm;
+    delta = fminf(fmaxf(delta, -DEFAULT_RAMP_SLOPE_RPM_MS), DEFAULT_RAMP_SLOPE_RPM_MS);
+    s_target_speed_rpm += delta;
+
+    if (s_commanded_speed_rpm != 0.0f && fabsf(s_target_speed_rpm) < FOC_MIN_RPM)
+        s_target_speed_rpm = s_direction_cw ? FOC_MIN_RPM : -FOC_MIN_RPM;
+
+    /* --- Speed PI → q current --- */
+    Foc_SetTorqueCurrent(Service_PID_Update(&s_pid_speed, s_target_speed_rpm, s_speed_rpm));
+
+    /* --- Stop (or reverse) once slowed down --- */
+    if (s_commanded_speed_rpm == 0.0f && fabsf(s_speed_rpm) < FOC_MIN_RPM)
+    {
+        if (s_reverse_pending)
+            Foc_Brake();
+        else
+        {
+            Control_Foc_Stop();
+        }
+    }
+}
+
+
+/* ============================================================================
+ *  PUBLIC USER-LEVEL API
+ * ========================================================================== */
+
+/**
+ * @brief Configure the FOC regulators and observer (loops not taken).
+ */
+void Control_Foc_Init(void)
+{
+    Control_Foc_Stop();
+
+    /* Current PI: zero on the R/L pole, crossover at the loop bandwidth */
+    float wc = FOC_TWO_PI * FOC_CURRENT_BW_HZ;
+    Service_PID_Init(&s_pid_d, FOC_PHASE_L_H * wc, FOC_PHASE_R_OHM * wc, 0.0f, s_ts);
+    Service_PID_Init(&s_pid_q, FOC_PHASE_L_H * wc, FOC_PHASE_R_OHM * wc, 0.0f, s_ts);
+    Foc_SetVoltageLimits(FOC_VBUS_DEFAULT_V);
+
+    /* Speed PI (1 kHz) */
+    Service_PID_Init(&s_pid_speed, FOC_SPEED_KP, FOC_SPEED_KI, 0.0f, 0.001f);
+    s_pid_speed.out_min = -FOC_IQ_MAX_A;
+    s_pid_speed.out_max =  FOC_IQ_MAX_A;
+    s_pid_speed.integrator_limit = FOC_IQ_MAX_A;
+
+    /* Sensorless angle */
+    Service_Foc_Observer_Init(&s_obs, FOC_PHASE_R_OHM, FOC_PHASE_L_H, FOC_FLUX_WB);
+    Service_Foc_Pll_Init(&s_pll, FOC_PLL_BW_HZ);
+
+    LOG_INFO("FOC control initialized.");
+}
+
+/**
+ * @brief Register the FOC fast and slow loops (bridge off).
+ */
+void Control_Foc_AttachLoops(void)
+{
+    Control_Foc_Stop();
+
+    /* Fast loop period: regulators and observer integrate over it */
+    uint32_t f_fast = SFastLoop->get_frequency_hz();
+    if (f_fast >= 1000U)
+    {
+        s_ts = 1.0f / (float)f_fast;
+        s_ticks_per_ms = f_fast / 1000U;
+        s_pid_d.dt = s_pid_q.dt = s_ts;
+    }
+
+    SFastLoop->register_callback(Foc_FastLoop);
+    SLowLoop->register_callback(Foc_LowLoop);
+}
+
+/**
+ * @brief Set motor speed command (in RPM, signed).
+ */
+void Control_Foc_SetSpeed_RPM(float rpm)
+{
+    bool new_dir_cw = (rpm >= 0.0f);
+
+    if (s_mode == CONTROL_FOC_MODE_STOPPED)
+    {
+        if (rpm != 0.0f)
+            Foc_Start(rpm);
+        return;
+    }
+
+    if (s_mode == CONTROL_FOC_MODE_BRAKING)
+    {
+        /* Reversal under way: stop, or the speed it restarts at */
+        if (rpm == 0.0f)
+            Control_Foc_Stop();
+        else
+            s_buffer_speed_rpm = rpm;
+        return;
+    }
+
+    if (s_mode != CONTROL_FOC_MODE_RUNNING)
+    {
+        /* Aligning / starting: stop, restart the other way, or new target */
+        if (rpm == 0.0f)
+            Control_Foc_Stop();
+        else if (new_dir_cw != s_direction_cw)
+            Foc_Start(rpm);
+        else
+            s_commanded_speed_rpm = rpm;
+        return;
+    }
+
+    if (rpm != 0.0f && new_dir_cw != s_direction_cw)
+    {
+        LOG_WARN("Direction change detected: %s → %s. Initiating safe stop...",
+                 s_direction_cw ? "CW" : "CCW", new_dir_cw ? "CW" : "CCW");
+        s_commanded_speed_rpm = 0.0f;
+        s_buffer_speed_rpm    = rpm;
+        s_reverse_pending     = true;
+        return;
+    }
+
+    s_reverse_pending     = false;
+    s_commanded_speed_rpm = rpm;
+    LOG_DEBUG("Speed update: %.0f RPM", rpm);
+}
+
+/**
+ * @brief Bridge off, loops reset.
+ */
+void Control_Foc_Stop(void)
+{
+    s_mode = CONTROL_FOC_MODE_STOPPED;
+    Service_Motor_Stop();
+
+    s_commanded_speed_rpm = s_target_speed_rpm = s_speed_rpm = 0.0f;
+    s_reverse_pending = false;
+    s_handover_done = s_start_failed = false;
+    memset(&s_i_ref, 0, sizeof(s_i_ref));
+    memset(&s_i_dq, 0, sizeof(s_i_dq));
+    memset(&s_v_dq, 0, sizeof(s_v_dq));
+}
+
+/**
+ * @brief Return the current control mode.
+ */
+control_foc_mode_t Control_Foc_GetMode(void)
+{
+    return s_mode;
+}
+
+/**
+ * @brief Observer speed (RPM, signed).
+ */
+float Control_Foc_GetSpeed_RPM(void)
+{
+    return (s_mode == CONTROL_FOC_MODE_STOPPED) ? 0.0f : s_speed_rpm;
+}
+
+/**
+ * @brief Snapshot of the loops.
+ */
+void Control_Foc_GetState(control_foc_state_t *out)
+{
+    if (out == NULL)
+        return;
+
+    /* Flux angle → zero-cross frame (flux of phase A at -cos θ) */
+    float theta_deg = (s_pll.theta_rad - FOC_TWO_PI * 0.5f) * (360.0f / FOC_TWO_PI);
+    if (theta_deg < 0.0f)
+        theta_deg += 360.0f;
+
+    out->mode      = s_mode;
+    out->speed_rpm = s_pll.omega_rad_s / FOC_RPM_TO_RAD_S;
+    out->theta_deg = theta_deg;
+    out->i_d_a     = s_i_dq.d;
+    out->i_q_a     = s_i_dq.q;
+    out->i_q_ref_a = s_i_ref.q;
+    out->v_d       = s_v_dq.d;
+    out->v_q       = s_v_dq.q;
+}
+
+/**
+ * @brief Print FOC status (human-readable telemetry).
+ */
+void Control_Foc_PrintStats(void)
+{
+    const char *mode_str =
+        (s_mode == CONTROL_FOC_MODE_ALIGNING) ? "ALIGNING" :
+        (s_mode == CONTROL_FOC_MODE_STARTING) ? "STARTING" :
+        (s_mode == CONTROL_FOC_MODE_RUNNING)  ? "RUNNING" :
+        (s_mode == CONTROL_FOC_MODE_BRAKING)  ? "BRAKING" :
+                                                "STOPPED";
+
+    if (s_mode == CONTROL_FOC_MODE_STOPPED)
+    {
+        LOG_INFO("[FOC] Status: \033[31mSTOPPED\033[0m");
+        return;
+    }
+
+    LOG_INFO("[FOC] %s | Dir=%s | Speed=%ld RPM | Id=%ld mA Iq=%ld mA (ref %ld mA)",
+             mode_str, s_direction_cw ? "CW" : "CCW", (long)s_speed_rpm,
+             (long)(s_i_dq.d * 1000.0f), (long)(s_i_dq.q * 1000.0f), (long)(s_i_ref.q * 1000.0f));
+}
@@ -16,6 +16,10 @@
 #include "service_bldc_motor.h"
 #include "service_loop.h"
 #include "service_pid.h"
+#include "service_zc_pll.h"
+#include "service_comm_advance.h"
+#include "service_desync.h"
+#include "service_rotor_ipd.h"
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -29,11 +33,40 @@
 #define MOTOR_POLE_PAIRS             6           ///< Motor pole-pair count (mechanical↔electrical conversion)
 #define COMM_DELAY_MIN_US            80.0f       ///< Minimum commutation scheduling delay
 #define COMM_DELAY_MAX_US            30000.0f    ///< Maximum commutation delay
-#define COMM_LEAD_FACTOR             0.45f       ///< Lead advance factor (≈27° electrical)
+#define COMM_PLL_TIMED               true        ///< Commutation at the PLL-predicted angle (period-based until locked)
 #define CL_MIN_VALID_ZC              4           ///< Number of valid zero-crossings before handover
 #define CL_MIN_DUTY_TRANSITION       0.20f       ///< Minimum duty cycle at closed-loop entry
-#define CL_ENTER_SPEED_HZ            200.0f      ///< Minimum electrical speed to enable closed-loop
+#define CL_ENTER_SPEED_HZ            150.0f      ///< Minimum electrical speed to enable closed-loop (early in the ramp, before it can lose the rotor)
 #define DEFAULT_RAMP_SLOPE_RPM_MS    10.0f        ///< Default ramp slope (RPM/ms)
+#define RAMP_START_DUTY              0.5f        ///< Open-loop start-up ramp: duty at the first step
+#define RAMP_END_DUTY                0.6f        ///< Duty at the end of the ramp
+#define RAMP_START_HZ                10.0f       ///< Electrical frequency at the first step (a rotor at rest catches it)
+#define RAMP_END_HZ                  400.0f      ///< Electrical frequency at the end of the ramp (well past the handover)
+#define RAMP_MS                      1000        ///< Ramp duration
+#define COMM_HW_TIMED                true        ///< Closed-loop steps switched by TIM1 COM at the deadline
+#define BEMF_HW_COMPARATOR           false       ///< ZC captured by comparator + timer instead of ADC sign changes (board revision: driver_bemf_comp.c)
+#define FLYING_START                 true        ///< Listen for a spinning rotor before aligning
+#define CATCH_LISTEN_MS              40          ///< Flying start: listening time before falling back to a standstill start
+#define CATCH_MIN_EVENTS             4           ///< Crossings in sequence (after the first) to trust the direction
+#define CATCH_DUTY_PER_BEMF          1.5f        ///< Duty / (peak coasting BEMF / Vbus): line-line BEMF of a six-step pair
+#define ROTOR_IPD                    true        ///< Standstill start: locate the rotor by inductive sensing instead of aligning it
+#define LOCATE_RAMP_LAG_DEG          45.0f       ///< First ramp step chosen for the located angle minus this (field behind the rotor)
+#define ALIGN_DUTY                   0.10f       ///< Alignment vector duty (IPD fallback, restarts on a moving rotor)
+#define ALIGN_MS                     500         ///< Alignment time
+#define DESYNC_RESYNC_HOLD_MS        150         ///< Re-sync ramp: time allowed to catch the BEMF again
+#define DESYNC_DEFAULT_RESYNCS       2           ///< Re-syncs from BEMF before re-aligning
+#define DESYNC_DEFAULT_RESTARTS      3           ///< Re-align + ramp attempts before giving up
+#define DESYNC_DEFAULT_STABLE_MS     500         ///< Closed loop held this long: attempts forgiven
+#define PAIR_R_OHM                   0.20f       ///< Resistance of the driven pair (two phases in series) [Ω]
+#define PAIR_L_H                     60e-6f      ///< Inductance of the driven pair [H]
+#define PAIR_KE_V_PER_HZ             0.0109f     ///< Line-to-line BEMF of the driven pair per electrical Hz [V/Hz]
+#define CURRENT_BW_HZ                1000.0f     ///< Current loop bandwidth (PI zero on the R/L pole)
+#define CURRENT_MIN_A                0.6f        ///< Smallest current reference: the duty stays near the BEMF (crossings sampled reliably)
+#define DUTY_MIN                     0.05f       ///< Closed-loop duty range (current loop output)
+#define DUTY_MAX                     0.95f
+#define SPEED_KP                     0.02f       ///< Speed PI [A/RPM]
+#define SPEED_KI                     1.0f        ///< Speed PI [A/(RPM·s)]
+#define VBUS_DEFAULT_V               12.0f       ///< Bus voltage until the first reading
 
 /* ============================================================================
  *  LOCAL TYPES AND CONTEXT
@@ -45,7 +78,9 @@
 typedef enum {
     MOTOR_MODE_STOPPED = 0,
     MOTOR_MODE_OPEN_LOOP,
-    MOTOR_MODE_CLOSED_LOOP
+    MOTOR_MODE_CLOSED_LOOP,
+    MOTOR_MODE_CATCH,
+    MOTOR_MODE_LOCATE
 } motor_mode_t;
 
 /**
@@ -58,6 +93,8 @@ typedef struct {
     bool comm_armed;
     bool transition_scheduled;
     bool handover_armed;
+    bool hw_comm;               ///< Next step preloaded, applied by hardware at the deadline
+    s_motor_phase_t next_floating;  ///< Floating phase of the preloaded step (hw_comm)
 } motor_ctx_t;
 
 /* --- Module state --- */
@@ -73,8 +110,65 @@ static float s_commanded_speed_rpm = 0.0f;       ///< External user command (tar
 static float s_buffer_speed_rpm = 0.0f;          ///< Internal buffer user command (speed)
 static float s_ramp_slope_rpm_ms   = DEFAULT_RAMP_SLOPE_RPM_MS;
 
-/* --- PID controller --- */
+/* --- Cascaded regulation: speed PI (1 kHz) → current PI (fast loop) → duty --- */
 static pid_t speed_pid;
+static pid_t current_pid;
+static float s_current_ref_a = 0.0f;            ///< Current loop reference (speed loop output or torque command)
+static float s_vbus = VBUS_DEFAULT_V;           ///< Bus voltage: current loop output range
+static float s_ts = 1.0f / 24000.0f;            ///< Fast loop period [s]
+
+/* --- Torque mode: current commanded directly, speed loop idle --- */
+static bool  s_torque_mode = false;
+static float s_commanded_current_a = 0.0f;      ///< External user command (current magnitude)
+static float s_buffer_current_a = 0.0f;         ///< Internal buffer user command (current)
+
+/* --- Zero-cross PLL (angle / speed / acceleration) --- */
+static zc_pll_t          s_pll;
+static zc_pll_estimate_t s_pll_est;            ///< Refreshed every fast-loop tick
+
+/* --- Commutation timing --- */
+static float s_comm_lag_deg = 30.0f;           ///< Zero-cross → commutation [° el.], 30° - advance map
+
+/* --- Flying start --- */
+static struct {
+    uint32_t t_start_us;        ///< Listening started
+    bool     seen;              ///< A crossing was seen
+    uint8_t  last_step[2];      ///< Step of the last crossing, per direction (0 = CW, 1 = CCW)
+    uint8_t  streak[2];         ///< Crossings in sequence, per direction
+    bool     caught;            ///< Outcome to report (slow loop)
+    bool     fell_back;
+    bool     reverse;           ///< Fallback: the rotor turns the other way
+} s_catch;
+
+/* --- Standstill start: inductive position detection --- */
+static struct {
+    bool     located;           ///< Outcome to report (slow loop)
+    bool     fell_back;
+    float    angle_deg;         ///< Detected rotor angle
+    float    contrast;
+    uint8_t  step;              ///< First step of the ramp
+} s_locate;
+
+/* --- Desync detection and recovery --- */
+static desync_detector_t s_desync;
+static control_motor_desync_policy_t s_desync_policy = {
+    .enabled      = true,
+    .max_resyncs  = DESYNC_DEFAULT_RESYNCS,
+    .max_restarts = DESYNC_DEFAULT_RESTARTS,
+    .stable_ms    = DESYNC_DEFAULT_STABLE_MS,
+};
+static control_motor_desync_stats_t s_desync_stats;
+
+static struct {
+    bool     active;            ///< Recovering: closed loop not reached again yet
+    uint8_t  resyncs;           ///< Re-syncs since the last stable closed loop
+    uint8_t  restarts;          ///< Re-aligns since the last stable closed loop
+    uint16_t stable_ms;         ///< Time in closed loop since the last attempt
+    uint32_t t_detect_us;       ///< First detection of the ongoing recovery
+    uint32_t logged_events;     ///< Stats already reported by the slow loop
+    uint32_t logged_recovered;
+    uint32_t logged_give_ups;
+} s_recovery;
 
 /* --- Debug counters --- */
 static uint32_t s_zc_count = 0;
@@ -89,31 +183,100 @@ static bool s_reverse_pending = false;
  * ========================================================================== */
 
 /**
- * @brief Return the floating phase for a given step and direction.
+ * @brief Electrical speed [Hz] for the advance map: PLL once locked, else
+ *        from the filtered BEMF period (0 while unknown).
  */
-static s_motor_phase_t Motor_GetFloatingPhase(uint8_t step, bool direction_cw)
+static float Motor_ElectricalSpeedHz(void)
 {
-    /* Phase flottante par step (doit correspondre aux STATE_HIZ des tables) */
+    if (s_pll_est.locked)
+        return s_pll_est.omega_dps / 360.0f;
+    if (s_bemf_status.valid && s_bemf_status.period_us > 0.0f)
+        return 1e6f / (6.0f * s_bemf_status.period_us);
+    return 0.0f;
+}
+
+/**
+ * @brief A speed or torque command is pending (a restart is wanted).
+ */
+static bool Motor_Commanded(void)
+{
+    return s_torque_mode ? (s_commanded_current_a > 0.0f) : (s_commanded_speed_rpm > 0.0f);
+}
+
+/**
+ * @brief Output range of the current loop for a bus voltage.
+ */
+static void Motor_SetVoltageLimits(float vbus)
+{
+    s_vbus = vbus;
+    current_pid.out_min = -DUTY_MAX * vbus;
+    current_pid.out_max = DUTY_MAX * vbus;
+    current_pid.integrator_limit = DUTY_MAX * vbus;
+}
+
+/**
+ * @brief BEMF of the driven pair at the present speed (current loop feed-forward) [V].
+ */
+static float Motor_PairBemf_V(void)
+{
+    return PAIR_KE_V_PER_HZ * Motor_ElectricalSpeedHz();
+}
+
+/**
+ * @brief Closed-loop entry without a duty or torque step.
+ *
+ * The current loop starts from the duty applied now (less the BEMF fed
+ * forward), the speed loop from the current flowing (torque mode: the
+ * commanded one).
+ */
+static void Motor_Regulators_Preset(float duty)
+{
+    Service_PID_Reset(&current_pid);
+    current_pid.integrator = duty * s_vbus - Motor_PairBemf_V();
 
-    static const s_motor_phase_t float_phase_cw[6] = {
-        S_MOTOR_PHASE_C, // Step 0 → C est flottante
-        S_MOTOR_PHASE_B, // Step 1 → B est flottante
-        S_MOTOR_PHASE_A, // Step 2 → A est flottante
-        S_MOTOR_PHASE_C, // Step 3 → C est flottante
-        S_MOTOR_PHASE_B, // Step 4 → B est flottante
-        S_MOTOR_PHASE_A  // Step 5 → A est flottante
-    };
+    s_current_ref_a = s_torque_mode ? s_commanded_current_a
+                                    : fminf(fmaxf(s_bemf_status.current_a, CURRENT_MIN_A), CONTROL_MOTOR_CURRENT_MAX_A);
+    Service_PID_Reset(&speed_pid);
+    speed_pid.integrator = s_current_ref_a;
+}
+
+/**
+ * @brief Period-based delay from a zero-cross to its commutation.
+ */
+static float Motor_PeriodCommDelayUs(void)
+{
+    return s_bemf_status.period_us * (s_comm_lag_deg / 60.0f);
+}
 
-    static const s_motor_phase_t float_phase_ccw[6] = {
-        S_MOTOR_PHASE_A, // Step 0 → A est flottante
-        S_MOTOR_PHASE_B, // Step 1 → B est flottante
-        S_MOTOR_PHASE_C, // Step 2 → C est flottante
-        S_MOTOR_PHASE_A, // Step 3 → A est flottante
-        S_MOTOR_PHASE_B, // Step 4 → B est flottante
-        S_MOTOR_PHASE_C  // Step 5 → C est flottante
-    };
+/**
+ * @brief Delay from @p now_us to the commutation angle of the current step,
+ *        predicted by the zero-cross PLL.
+ *
+ * The commutation angle is the same lag after the crossing as the period
+ * based timing (s_comm_lag_deg), but reached at the predicted speed and
+ * acceleration instead of the filtered last period.
+ *
+ * @return Delay [µs], negative if the PLL is not usable (not locked)
+ */
+static float Motor_PllCommDelayUs(uint8_t step, uint32_t now_us)
+{
+    if (!COMM_PLL_TIMED)
+        return -1.0f;
 
-    return direction_cw ? float_phase_cw[step % 6] : float_phase_ccw[step % 6];
+    float target_deg = 60.0f + 60.0f * (float)step + s_comm_lag_deg;
+    return Service_ZcPll_TimeToAngle(&s_pll, now_us, target_deg);
+}
+
+/**
+ * @brief Six-step position the rotor is in, from the PLL angle.
+ *
+ * Step k spans 30° before to 30° after its crossing (60° + 60°·k), so the
+ * pattern applied from this step has its zero-cross still ahead.
+ */
+static uint8_t Motor_PllStep(void)
+{
+    /* θ in [0, 360): shifted by a turn, truncation is the floor (no floorf per tick) */
+    return (uint8_t)((uint32_t)((s_pll_est.theta_deg + 330.0f) / 60.0f) % 6U);
 }
 
 /**
@@ -126,8 +289,17 @@ static void Motor_ClosedLoop_Commutate(void *user_ctx)
     s_ctx.comm_armed = false;
     s_ctx.step = (s_ctx.step + 1) % 6;
 
-    Inverter_SixStepCommutate(s_ctx.step, s_ctx.duty, s_ctx.direction_cw);
-    s_floating_phase = Motor_GetFloatingPhase(s_ctx.step, s_ctx.direction_cw);
+    if (s_ctx.hw_comm)
+    {
+        /* Outputs already switched by the COM event: preload the next step */
+        s_floating_phase = s_ctx.next_floating;
+        s_ctx.next_floating = (s_motor_phase_t)Inverter_SixStepPreload((s_ctx.step + 1) % 6, s_ctx.duty, s_ctx.direction_cw);
+    }
+    else
+    {
+        s_floating_phase = (s_motor_phase_t)Inverter_SixStepCommutate(s_ctx.step, s_ctx.duty, s_ctx.direction_cw);
+    }
+    SBemfMonitor->commutated(s_floating_phase, (s_ctx.step & 1U) != 0U);
     s_comm_count++;
 }
 
@@ -144,13 +316,18 @@ static void Motor_Transition_Commutate(void *user_ctx)
 
     /* Perform commutation */
     s_ctx.step = (s_ctx.step + 1) % 6;
-    Inverter_SixStepCommutate(s_ctx.step, s_ctx.duty, s_ctx.direction_cw);
-    s_floating_phase = Motor_GetFloatingPhase(s_ctx.step, s_ctx.direction_cw);
+    s_floating_phase = (s_motor_phase_t)Inverter_SixStepCommutate(s_ctx.step, s_ctx.duty, s_ctx.direction_cw);
+    SBemfMonitor->commutated(s_floating_phase, (s_ctx.step & 1U) != 0U);
 
     /* Switch to closed-loop mode */
     s_motor_mode = MOTOR_MODE_CLOSED_LOOP;
     s_ctx.comm_armed = false;
 
+    /* From now on each step is preloaded one commutation ahead */
+    s_ctx.hw_comm = COMM_HW_TIMED && Service_Motor_SetHwCommutation(true);
+    if (s_ctx.hw_comm)
+        s_ctx.next_floating = (s_motor_phase_t)Inverter_SixStepPreload((s_ctx.step + 1) % 6, s_ctx.duty, s_ctx.direction_cw);
+
     /* Stop open-loop ramp gracefully */
     Service_Motor_OpenLoopRamp_StopSoft();
 
@@ -158,17 +335,218 @@ static void Motor_Transition_Commutate(void *user_ctx)
     float electrical_freq_hz = 1e6f / (6.0f * s_bemf_status.period_us);
     s_measured_speed_rpm = (electrical_freq_hz * 60.0f) / MOTOR_POLE_PAIRS;
     s_target_speed_rpm = s_measured_speed_rpm;
+    Motor_Regulators_Preset(s_ctx.duty);
+
+    /* Watch the synchronization from the last crossing on */
+    Service_Desync_Arm(&s_desync, SBemfMonitor->get_last_zc_time_us(), s_bemf_status.period_us, s_bemf_status.current_a);
+
+    if (s_recovery.active)
+    {
+        uint32_t recover_us = Service_GetTimeUs() - s_recovery.t_detect_us;
+        s_desync_stats.recovered++;
+        s_desync_stats.last_recovery_us = recover_us;
+        if (recover_us > s_desync_stats.max_recovery_us)
+            s_desync_stats.max_recovery_us = recover_us;
+        s_recovery.active = false;
+        s_recovery.stable_ms = 0;
+    }
 
     /* Arm first commutation immediately for continuous motion */
     if (s_bemf_status.valid && !s_ctx.comm_armed)
     {
-        float delay_us = s_bemf_status.period_us * COMM_LEAD_FACTOR;
+        float delay_us = Motor_PeriodCommDelayUs();
         delay_us = fminf(fmaxf(delay_us, COMM_DELAY_MIN_US), COMM_DELAY_MAX_US);
-        Service_ScheduleCommutation((uint32_t)delay_us, Motor_ClosedLoop_Commutate, NULL);
+        Service_ScheduleCommutation(delay_us, Motor_ClosedLoop_Commutate, NULL);
         s_ctx.comm_armed = true;
     }
 }
 
+/* Forward declarations: recovery entry (fast loop, ramp ends), fallback start */
+static void Motor_Desync_Recover(desync_cause_t cause, bool allow_resync);
+static void Motor_StartOpenLoopRamp(void);
+static void Motor_StartOpenLoopRampFrom(uint8_t step);
+
+/**
+ * @brief Standstill start: locate the rotor, then ramp from its position.
+ *
+ * The inductive detection takes about 1.5 ms instead of the 500 ms
+ * alignment; the alignment stays as the fallback. Only for a rotor at
+ * rest: restarts on a rotor that may still turn align it (and brake it).
+ */
+static void Motor_Locate_Rotor(void)
+{
+    if (!ROTOR_IPD)
+    {
+        Service_Motor_Align_Rotor(ALIGN_DUTY, ALIGN_MS, Motor_StartOpenLoopRamp);
+        return;
+    }
+
+    Service_Motor_Stop();                           // Immediate mode, events cancelled
+    Service_RotorIpd_Start();
+    s_motor_mode = MOTOR_MODE_LOCATE;
+}
+
+/**
+ * @brief Standstill start: run the detection pulses (fast loop).
+ *
+ * The ramp starts from the step whose window holds the detected angle
+ * moved back by LOCATE_RAMP_LAG_DEG: its first pattern already drives the
+ * rotor the right way, and the rotor is late in (or just past) that window,
+ * so the field does not get ahead of it when the ramp, still slow, moves to
+ * the next step. Without enough contrast (non-salient motor, open phase)
+ * the rotor is aligned instead.
+ */
+static void Motor_Locate_Process(void)
+{
+    rotor_ipd_result_t result;
+
+    if (Service_RotorIpd_Process() == ROTOR_IPD_RUNNING)
+        return;
+
+    (void)Service_RotorIpd_GetResult(&result);
+    s_locate.angle_deg = result.angle_deg;
+    s_locate.contrast  = result.contrast;
+
+    if (!result.valid)
+    {
+        s_locate.fell_back = true;
+        s_motor_mode = MOTOR_MODE_STOPPED;
+        Service_Motor_Align_Rotor(ALIGN_DUTY, ALIGN_MS, Motor_StartOpenLoopRamp);
+        return;
+    }
+
+    s_locate.located = true;
+    float lag_deg = s_ctx.direction_cw ? LOCATE_RAMP_LAG_DEG : -LOCATE_RAMP_LAG_DEG;
+    s_locate.step = Service_Motor_SixStepOfAngle(result.angle_deg - lag_deg, s_ctx.direction_cw);
+    Motor_StartOpenLoopRampFrom(s_locate.step);
+}
+
+/**
+ * @brief Flying start: enter closed loop on the caught rotor.
+ *
+ * The last crossing was the zero-cross of @p step: its pattern is applied
+ * at once (the rotor is in its window) with the duty matching the BEMF, so
+ * the current starts near zero, and the commutation to the next step is
+ * scheduled from the PLL like any closed-loop step.
+ */
+static void Motor_Catch_Enter(uint8_t step, uint32_t now_us)
+{
+    float speed_hz = Motor_ElectricalSpeedHz();
+    float duty = fminf(fmaxf(CATCH_DUTY_PER_BEMF * s_bemf_status.bemf_ratio, DUTY_MIN), DUTY_MAX);
+
+    s_ctx.step = step;
+    s_ctx.duty = duty;
+    s_ctx.comm_armed = s_ctx.transition_scheduled = s_ctx.handover_armed = false;
+    s_motor_mode = MOTOR_MODE_CLOSED_LOOP;
+
+    s_floating_phase = (s_motor_phase_t)Inverter_SixStepCommutate(step, duty, s_ctx.direction_cw);
+    SBemfMonitor->commutated(s_floating_phase, (step & 1U) != 0U);
+
+    s_ctx.hw_comm = COMM_HW_TIMED && Service_Motor_SetHwCommutation(true);
+    if (s_ctx.hw_comm)
+        s_ctx.next_floating = (s_motor_phase_t)Inverter_SixStepPreload((step + 1) % 6, duty, s_ctx.direction_cw);
+
+    /* Loops pick up from here, without a duty step (no current flowing yet) */
+    s_measured_speed_rpm = (speed_hz * 60.0f) / MOTOR_POLE_PAIRS;
+    s_target_speed_rpm = s_measured_speed_rpm;
+    Motor_Regulators_Preset(duty);
+
+    Service_Desync_Arm(&s_desync, SBemfMonitor->get_last_zc_time_us(), s_bemf_status.period_us, s_bemf_status.current_a);
+
+    /* Commutation to the next step, as after a closed-loop crossing */
+    s_comm_lag_deg = 30.0f - Service_CommAdvance_Get(speed_hz, 0.0f);
+    float delay_us = Motor_PllCommDelayUs(step, now_us);
+    if (delay_us < 0.0f)
+        delay_us = Motor_PeriodCommDelayUs() - (float)(now_us - SBemfMonitor->get_last_zc_time_us());
+    delay_us = fminf(fmaxf(delay_us, COMM_DELAY_MIN_US), COMM_DELAY_MAX_US);
+
+    Service_ScheduleCommutation(delay_us, Motor_ClosedLoop_Commutate, NULL);
+    s_ctx.comm_armed = true;
+    s_catch.caught = true;
+}
+
+/**
+ * @brief Flying start: listen to the coasting rotor (fast loop, bridge off).
+ *
+ * Each crossing is mapped to its six-step position under both direction
+ * hypotheses; the true direction is the one in which consecutive crossings
+ * advance by one step. Crossings in the commanded direction feed the PLL.
+ * Once enough are in sequence, fast enough for the BEMF to be reliable, the
+ * motor enters closed loop directly. Otherwise (rotor still, too slow, or
+ * turning the other way) the standstill start takes over after the
+ * listening time: position detection if no crossing was seen, else
+ * alignment.
+ */
+static void Motor_Catch_Process(void)
+{
+    uint32_t now_us = Service_GetTimeUs();
+    uint8_t dir = s_ctx.direction_cw ? 0U : 1U;
+
+    SBemfMonitor->process_coasting();
+    SBemfMonitor->get_status(&s_bemf_status);
+
+    if (s_bemf_status.zero_cross_detected)
+    {
+        SBemfMonitor->clear_flag();
+
+        for (uint8_t d = 0; d < 2U; d++)
+        {
+            uint8_t k = Service_Motor_SixStepOfZeroCross((uint8_t)s_bemf_status.floating_phase, s_bemf_status.zc_rising, d == 0U);
+            bool in_sequence = s_catch.seen && k == (s_catch.last_step[d] + 1U) % 6U;
+            s_catch.streak[d] = in_sequence ? (uint8_t)(s_catch.streak[d] + 1U) : 0U;
+            s_catch.last_step[d] = k;
+        }
+        s_catch.seen = true;
+
+        /* PLL on the commanded direction only; restarted when out of sequence */
+        if (s_catch.streak[dir] == 0U)
+            Service_ZcPll_Reset(&s_pll);
+        (void)Service_ZcPll_OnZeroCross(&s_pll, SBemfMonitor->get_last_zc_time_us(), s_catch.last_step[dir]);
+        Service_ZcPll_Estimate(&s_pll, now_us, &s_pll_est);
+
+        if (s_catch.streak[dir] >= CATCH_MIN_EVENTS && s_bemf_status.valid && s_pll_est.locked &&
+            Motor_ElectricalSpeedHz() >= CL_ENTER_SPEED_HZ)
+        {
+            Motor_Catch_Enter(s_catch.last_step[dir], now_us);
+            return;
+        }
+    }
+
+    if (now_us - s_catch.t_start_us < CATCH_LISTEN_MS * 1000U)
+        return;
+
+    /* Nothing to catch: normal start, the rotor located if it looks still */
+    s_catch.fell_back = true;
+    s_catch.reverse = s_catch.streak[dir ^ 1U] >= CATCH_MIN_EVENTS;
+    Service_ZcPll_Reset(&s_pll);
+    s_motor_mode = MOTOR_MODE_STOPPED;
+
+    if (s_catch.seen)
+        Service_Motor_Align_Rotor(ALIGN_DUTY, ALIGN_MS, Motor_StartOpenLoopRamp);
+    else
+        Motor_Locate_Rotor();
+}
+
+/**
+ * @brief Start the motor: flying start if enabled, else locate and ramp.
+ */
+static void Motor_Start(void)
+{
+    if (!FLYING_START)
+    {
+        Motor_Locate_Rotor();
+        return;
+    }
+
+    Service_Motor_Stop();                           // All phases Hi-Z
+    SBemfMonitor->reset();
+    Service_ZcPll_Reset(&s_pll);
+    Service_Desync_Disarm(&s_desync);
+    memset(&s_catch, 0, sizeof(s_catch));
+    s_catch.t_start_us = Service_GetTimeUs();
+    s_motor_mode = MOTOR_MODE_CATCH;
+}
+
 /**
  * @brief Motor fast loop (executed at 24 kHz).
  *
@@ -182,6 +560,20 @@ static void Motor_Transition_Commutate(void *user_ctx)
  */
 static void Motor_FastLoop(void)
 {
+    /* Flying start: bridge off, listening to the rotor */
+    if (s_motor_mode == MOTOR_MODE_CATCH)
+    {
+        Motor_Catch_Process();
+        return;
+    }
+
+    /* Standstill start: inductive position detection pulses */
+    if (s_motor_mode == MOTOR_MODE_LOCATE)
+    {
+        Motor_Locate_Process();
+        return;
+    }
+
     /* ----------------------------------------------------------------------
      * 1. UPDATE FLOATING PHASE IN OPEN-LOOP MODE
      * ----------------------------------------------------------------------
@@ -190,16 +582,19 @@ static void Motor_FastLoop(void)
      * is the one not driven at each step — needed for BEMF measurement.
      * Here we update it in real-time to keep BEMF monitoring aligned.
      */
+    float duty = s_ctx.duty;
+    uint8_t step = s_ctx.step;
+
     if (s_motor_mode == MOTOR_MODE_OPEN_LOOP)
     {
-        uint8_t step;
-        bool dir;
-
-        /* Query current step & direction from the open-loop ramp service */
-        Service_Motor_OpenLoopRamp_GetState(&step, NULL, &dir);
-
-        /* Determine which motor phase is floating at this step */
-        s_floating_phase = Motor_GetFloatingPhase(step, dir);
+        /* Floating phase of the step last applied by the open-loop ramp */
+        s_motor_phase_t floating = (s_motor_phase_t)Service_Motor_OpenLoopRamp_GetFloatingPhase();
+        bool cw;
+
+        Service_Motor_OpenLoopRamp_GetState(&step, &duty, &cw);
+        if (floating != s_floating_phase)
+            SBemfMonitor->commutated(floating, (step & 1U) != 0U);
+        s_floating_phase = floating;
     }
 
     /* ----------------------------------------------------------------------
@@ -212,12 +607,78 @@ static void Motor_FastLoop(void)
     SBemfMonitor->process(s_floating_phase);
     SBemfMonitor->get_status(&s_bemf_status);
 
+    /* ----------------------------------------------------------------------
+     * 2a. CURRENT LOOP
+     * ----------------------------------------------------------------------
+     * In closed loop the duty holds the current of the driven pair (the
+     * DC-link current while the high side conducts) on the reference of
+     * the speed loop or on the torque command. The pair BEMF is fed
+     * forward: the PI only supplies the R·i + L·di/dt drop, and the duty
+     * cannot slide below the BEMF (no conduction, no torque) while the
+     * sampled current over-reads at low duties (discontinuous conduction).
+     * Written for the next PWM period; the next commutations reuse it.
+     */
+    if (s_motor_mode == MOTOR_MODE_CLOSED_LOOP)
+    {
+        float v = Motor_PairBemf_V()
+                + Service_PID_Update(&current_pid, s_current_ref_a, s_bemf_status.current_inst_a);
+        duty = s_ctx.duty = fminf(fmaxf(v / s_vbus, DUTY_MIN), DUTY_MAX);
+        (void)Service_Motor_SetSixStepDuty(duty);
+    }
+
+    /* ----------------------------------------------------------------------
+     * 2b. PLACE THE NEXT BEMF SAMPLE
+     * ----------------------------------------------------------------------
+     * On-time while the pulse is wide enough for the sampling window,
+     * mid off-time below; applied from the next PWM period.
+     */
+    if (s_motor_mode != MOTOR_MODE_STOPPED)
+        (void)Service_Motor_PlaceAdcTrigger(duty);
+
+    /* ----------------------------------------------------------------------
+     * 2c. TRACK ROTOR ANGLE
+     * ----------------------------------------------------------------------
+     * Each zero-cross (at its interpolated / captured instant) corrects the
+     * PLL; angle, speed and acceleration are extrapolated to every tick.
+     */
+    uint32_t now_us = Service_GetTimeUs();          // Capture current timestamp (µs precision)
+
+    if (s_bemf_status.zero_cross_detected && s_motor_mode != MOTOR_MODE_STOPPED)
+        (void)Service_ZcPll_OnZeroCross(&s_pll, SBemfMonitor->get_last_zc_time_us(), step);
+    Service_ZcPll_Estimate(&s_pll, now_us, &s_pll_est);
+
+    /* Commutation lag from the advance map at this operating point */
+    s_comm_lag_deg = 30.0f - Service_CommAdvance_Get(Motor_ElectricalSpeedHz(), s_bemf_status.current_a);
+
+    /* ----------------------------------------------------------------------
+     * 2d. DESYNC DETECTION
+     * ----------------------------------------------------------------------
+     * In closed loop, each crossing must arrive in its expected window and
+     * keep coming, without a current spike; otherwise the commutations no
+     * longer follow the rotor and the recovery takes over at once.
+     */
+    if (s_motor_mode == MOTOR_MODE_CLOSED_LOOP && s_desync_policy.enabled)
+    {
+        desync_cause_t cause = DESYNC_NONE;
+
+        if (s_bemf_status.zero_cross_detected && s_bemf_status.floating_phase == s_floating_phase)
+            cause = Service_Desync_OnZeroCross(&s_desync, SBemfMonitor->get_last_zc_time_us());
+        if (cause == DESYNC_NONE)
+            cause = Service_Desync_Tick(&s_desync, now_us, s_bemf_status.current_a);
+
+        if (cause != DESYNC_NONE)
+        {
+            Motor_Desync_Recover(cause, true);
+            SBemfMonitor->clear_flag();
+            return;
+        }
+    }
+
     /* If no zero-crossing was detected this cycle, exit early */
     if (!s_bemf_status.zero_cross_detected)
         return;
 
     s_zc_count++;                                   // Increment ZC counter for debugging
-    uint32_t now_us = Service_GetTimeUs();          // Capture current timestamp (µs precision)
 
     /* ----------------------------------------------------------------------
      * 3. CLOSED-LOOP COMMUTATION (Normal running mode)
@@ -225,8 +686,10 @@ static void Motor_FastLoop(void)
      * Once the motor runs sensorlessly, we schedule each commutation
      * after a precise delay from the detected zero-crossing.
      *
-     * The delay = (BEMF period × lead factor), which corresponds
-     * to advancing the next phase by ≈27° electrical.
+     * The delay = BEMF period × (30° - advance) / 60°, the advance being
+     * interpolated in the speed × current map. Once the PLL is locked,
+     * the same angle is reached at the predicted speed and acceleration
+     * instead (no lag under throttle changes).
      */
     if (s_motor_mode == MOTOR_MODE_CLOSED_LOOP && s_bemf_status.valid)
     {
@@ -236,7 +699,9 @@ static void Motor_FastLoop(void)
         if (s_bemf_status.floating_phase == s_floating_phase && !s_ctx.comm_armed)
         {
             /* Compute commutation delay (lead angle compensation) */
-            float delay_us = s_bemf_status.period_us * COMM_LEAD_FACTOR;
+            float delay_us = Motor_PllCommDelayUs(s_ctx.step, now_us);
+            if (delay_us < 0.0f)
+                delay_us = Motor_PeriodCommDelayUs();
 
             /* Clamp the delay to safe bounds to avoid missed commutation */
             delay_us = fminf(fmaxf(delay_us, COMM_DELAY_MIN_US), COMM_DELAY_MAX_US);
@@ -278,11 +743,14 @@ static void Motor_FastLoop(void)
                 /* Enforce a minimum duty before switching to CL */
                 s_ctx.duty = fmaxf(s_ctx.duty, CL_MIN_DUTY_TRANSITION);
 
-                /* Compute the elapsed time since the last zero-cross */
-                float age_us = (float)(now_us - SBemfMonitor->get_last_zc_time_us());
-
-                /* Compute exact commutation time (synchronous handover) */
-                float t_comm_us = (s_bemf_status.period_us * COMM_LEAD_FACTOR) - age_us;
+                /* Compute exact commutation time (synchronous handover):
+                 * PLL prediction, else lead after the last zero-cross */
+                float t_comm_us = Motor_PllCommDelayUs(s_ctx.step, now_us);
+                if (t_comm_us < 0.0f)
+                {
+                    float age_us = (float)(now_us - SBemfMonitor->get_last_zc_time_us());
+                    t_comm_us = Motor_PeriodCommDelayUs() - age_us;
+                }
 
                 /* If we're already past the ideal point → commutate immediately,
                    else schedule precise transition commutation. */
@@ -292,7 +760,9 @@ static void Motor_FastLoop(void)
                 }
                 else
                 {
-                    Service_ScheduleCommutation((uint32_t)t_comm_us, Motor_Transition_Commutate, NULL);
+                    /* Freeze the ramp on its step until the handover commutation */
+                    Service_Motor_OpenLoopRamp_Hold();
+                    Service_ScheduleCommutation(t_comm_us, Motor_Transition_Commutate, NULL);
                     s_ctx.transition_scheduled = true;
                     s_ctx.handover_armed = true;
                 }
@@ -314,45 +784,157 @@ static void Motor_FastLoop(void)
 
 
 /**
- * @brief Start open-loop ramp (alignment already done).
+ * @brief Reset the rotor tracking and enter open loop (ramp about to start).
  */
-static void Motor_StartOpenLoopRamp(void)
+static void Motor_EnterOpenLoop(void)
 {
     SBemfMonitor->reset();
+    Service_ZcPll_Reset(&s_pll);
+
+    /* Fast-loop snapshots read by the slow loop: none from before the stop */
+    SBemfMonitor->get_status(&s_bemf_status);
+    Service_ZcPll_Estimate(&s_pll, Service_GetTimeUs(), &s_pll_est);
+    s_measured_speed_rpm = 0.0f;
+
+    Service_Desync_Disarm(&s_desync);
     s_motor_mode = MOTOR_MODE_OPEN_LOOP;
 
     s_zc_count = s_comm_count = s_valid_zc_count = 0;
     s_ctx.transition_scheduled = s_ctx.handover_armed = s_ctx.comm_armed = false;
+    s_ctx.hw_comm = false;
+}
+
+/**
+ * @brief Ramp (start-up or recovery) ran out without a handover: the
+ *        bridge is off, escalate to a restart or a stop.
+ */
+static void Motor_Desync_OnRampEnd(void *user_ctx)
+{
+    (void)user_ctx;
+    Motor_Desync_Recover(DESYNC_NONE, false);
+}
+
+/**
+ * @brief Start open-loop ramp (alignment already done).
+ */
+static void Motor_StartOpenLoopRamp(void)
+{
+    Motor_StartOpenLoopRampFrom(0U);
+}
+
+/**
+ * @brief Start open-loop ramp from a given step (located rotor).
+ */
+static void Motor_StartOpenLoopRampFrom(uint8_t step)
+{
+    Motor_EnterOpenLoop();
 
     LOG_INFO("Starting open-loop ramp...");
-    Service_Motor_OpenLoopRamp_Start(
-        0.5f,    // Start duty
-        0.6f,     // End duty
-        25.0f,    // Start freq
-        500.0f,   // End freq
-        1000,     // Duration (ms)
-        s_ctx.direction_cw, // CCW/CCW
+    Service_Motor_OpenLoopRamp_StartFrom(
+        step,                   // First step
+        RAMP_START_DUTY,
+        RAMP_END_DUTY,
+        RAMP_START_HZ,
+        RAMP_END_HZ,
+        RAMP_MS,
+        s_ctx.direction_cw,     // CW/CCW
         RAMP_PROFILE_EXPONENTIAL,
-        NULL,
+        Motor_Desync_OnRampEnd, // No handover during the ramp: retry or stop
         NULL
     );
 }
 
+/**
+ * @brief Desync recovery (fast loop, or end of a failed recovery ramp).
+ *
+ * Policy, cheapest first:
+ *  1. Re-sync from BEMF: the rotor still spins, so the open-loop sequence
+ *     restarts from the step and speed the PLL last estimated, without
+ *     stopping it; the normal handover returns to closed loop.
+ *  2. Re-align and ramp, as a fresh start.
+ *  3. Give up: stop the motor.
+ * Attempts are counted until closed loop is held for stable_ms.
+ *
+ * @param cause        Detected cause, DESYNC_NONE for a failed attempt
+ * @param allow_resync false when a re-sync just failed
+ */
+static void Motor_Desync_Recover(desync_cause_t cause, bool allow_resync)
+{
+    /* Rotor as last tracked, before the estimates are reset */
+    float speed_hz = Motor_ElectricalSpeedHz();
+    uint8_t step = s_pll_est.locked ? Motor_PllStep() : s_ctx.step;
+
+    if (cause != DESYNC_NONE)
+    {
+        s_desync_stats.events++;
+        s_desync_stats.by_cause[cause - 1]++;
+        if (!s_recovery.active)
+            s_recovery.t_detect_us = Service_GetTimeUs();
+    }
+    s_recovery.active = true;
+    s_recovery.stable_ms = 0;
+
+    /* Stale commutations out: pending events cancelled, immediate mode */
+    Service_Motor_Stop();
+    Service_Desync_Disarm(&s_desync);
+
+    if (allow_resync && s_recovery.resyncs < s_desync_policy.max_resyncs && speed_hz >= CL_ENTER_SPEED_HZ)
+    {
+        s_recovery.resyncs++;
+        s_desync_stats.resyncs++;
+
+        Motor_EnterOpenLoop();
+        Service_Motor_OpenLoopRamp_Resync(step, fmaxf(s_ctx.duty, CL_MIN_DUTY_TRANSITION), speed_hz,
+                                          DESYNC_RESYNC_HOLD_MS, s_ctx.direction_cw, Motor_Desync_OnRampEnd, NULL);
+    }
+    else if (s_recovery.restarts < s_desync_policy.max_restarts && Motor_Commanded())
+    {
+        s_recovery.restarts++;
+        s_desync_stats.restarts++;
+
+        Service_ZcPll_Reset(&s_pll);
+        s_motor_mode = MOTOR_MODE_STOPPED;
+        Service_Motor_Align_Rotor(ALIGN_DUTY, ALIGN_MS, Motor_StartOpenLoopRamp);
+    }
+    else
+    {
+        s_desync_stats.give_ups++;
+        Control_Motor_Stop();
+    }
+}
+
 
 /**
- * @brief 1 kHz slow loop: speed ramp + PID control.
+ * @brief 1 kHz slow loop: speed ramp + speed PI (current reference).
  */
 static void Motor_LowLoop(void)
 {
-    /* --- Speed measurement (mechanical RPM) --- */
-    if (s_bemf_status.valid && s_bemf_status.period_us > 0)
+    /* --- Bus voltage: current loop output range --- */
+    float vbus = Service_GetBus_Voltage();
+    Motor_SetVoltageLimits((vbus > 1.0f) ? vbus : VBUS_DEFAULT_V);
+
+    /* --- Speed measurement (mechanical RPM): PLL once locked --- */
+    if (s_pll_est.locked && s_motor_mode != MOTOR_MODE_STOPPED)
+    {
+        float f_elec = s_pll_est.omega_dps / 360.0f;
+        s_measured_speed_rpm = (f_elec * 60.0f) / MOTOR_POLE_PAIRS;
+    }
+    else if (s_bemf_status.valid && s_bemf_status.period_us > 0)
     {
         float f_elec = 1e6f / (6.0f * s_bemf_status.period_us);
         s_measured_speed_rpm = (f_elec * 60.0f) / MOTOR_POLE_PAIRS;
     }
+    else
+    {
+        s_measured_speed_rpm = 0.0f;                // Nothing tracks the rotor: no stale speed
+    }
 
-    /* --- Target ramp (active only in closed-loop) --- */
-    if (s_motor_mode == MOTOR_MODE_CLOSED_LOOP)
+    /* --- Target ramp (active only in closed-loop; torque mode: follows the speed) --- */
+    if (s_motor_mode == MOTOR_MODE_CLOSED_LOOP && s_torque_mode)
+    {
+        s_target_speed_rpm = s_measured_speed_rpm;
+    }
+    else if (s_motor_mode == MOTOR_MODE_CLOSED_LOOP)
     {
         float delta = s_commanded_speed_rpm - s_target_speed_rpm;
         delta = fminf(fmaxf(delta, -s_ramp_slope_rpm_ms), s_ramp_slope_rpm_ms);
@@ -360,10 +942,76 @@ static void Motor_LowLoop(void)
     }
     else s_target_speed_rpm = 0.0f;
 
-    /* --- PID update --- */
+    /* --- Current reference: speed PI, or the torque command --- */
     if (s_motor_mode == MOTOR_MODE_CLOSED_LOOP && s_bemf_status.valid)
     {
-        s_ctx.duty = Service_PID_Update(&speed_pid, s_target_speed_rpm, s_measured_speed_rpm);
+        if (s_torque_mode)
+        {
+            s_current_ref_a = s_commanded_current_a;
+            speed_pid.integrator = s_current_ref_a;     // Speed mode resumes from this torque
+        }
+        else
+        {
+            s_current_ref_a = Service_PID_Update(&speed_pid, s_target_speed_rpm, s_measured_speed_rpm);
+        }
+    }
+
+    /* --- Advance calibration: closed loop only, speed held by the PID --- */
+    if (Service_CommAdvance_CalActive())
+    {
+        if (s_motor_mode == MOTOR_MODE_CLOSED_LOOP)
+            Service_CommAdvance_CalTick(Motor_ElectricalSpeedHz(), s_bemf_status.current_a);
+        else
+            Service_CommAdvance_CalAbort();
+    }
+
+    /* --- Desync recovery: forgive attempts once stable, report --- */
+    if (s_motor_mode == MOTOR_MODE_CLOSED_LOOP && (s_recovery.resyncs > 0 || s_recovery.restarts > 0))
+    {
+        if (++s_recovery.stable_ms >= s_desync_policy.stable_ms)
+            s_recovery.resyncs = s_recovery.restarts = 0;
+    }
+
+    if (s_recovery.logged_events != s_desync_stats.events)
+    {
+        s_recovery.logged_events = s_desync_stats.events;
+        LOG_WARN("Desync detected (%lu so far): recovering", (unsigned long)s_desync_stats.events);
+    }
+    if (s_recovery.logged_recovered != s_desync_stats.recovered)
+    {
+        s_recovery.logged_recovered = s_desync_stats.recovered;
+        LOG_INFO("Desync recovered in %lu us", (unsigned long)s_desync_stats.last_recovery_us);
+    }
+    if (s_recovery.logged_give_ups != s_desync_stats.give_ups)
+    {
+        s_recovery.logged_give_ups = s_desync_stats.give_ups;
+        LOG_WARN("Desync recovery failed: motor stopped");
+    }
+
+    /* --- Flying start outcome --- */
+    if (s_catch.caught)
+    {
+        s_catch.caught = false;
+        LOG_INFO("Flying start: rotor caught at %lu RPM", (unsigned long)s_measured_speed_rpm);
+    }
+    if (s_catch.fell_back)
+    {
+        s_catch.fell_back = false;
+        LOG_INFO("Flying start: %s", s_catch.reverse ? "rotor turning backwards, aligning" : "no rotation caught");
+    }
+
+    /* --- Standstill start outcome --- */
+    if (s_locate.located)
+    {
+        s_locate.located = false;
+        LOG_INFO("Rotor located at %lu deg (contrast %lu %%): ramp from step %u",
+                 (unsigned long)s_locate.angle_deg, (unsigned long)(s_locate.contrast * 100.0f), s_locate.step);
+    }
+    if (s_locate.fell_back)
+    {
+        s_locate.fell_back = false;
+        LOG_INFO("Rotor position not detected (contrast %lu %%), aligning",
+                 (unsigned long)(s_locate.contrast * 100.0f));
     }
 
     /* --- Handle pending reversal --- */
@@ -378,10 +1026,13 @@ static void Motor_LowLoop(void)
         Service_Motor_Stop();
         s_motor_mode = MOTOR_MODE_STOPPED;
 
-        /* Apply buffered speed command after reversal */
-        s_commanded_speed_rpm = s_buffer_speed_rpm;
+        /* Apply buffered speed (or torque) command after reversal */
+        if (s_torque_mode)
+            s_commanded_current_a = s_buffer_current_a;
+        else
+            s_commanded_speed_rpm = s_buffer_speed_rpm;
 
-        Service_Motor_Align_Rotor(0.10f, 500, Motor_StartOpenLoopRamp);
+        Service_Motor_Align_Rotor(ALIGN_DUTY, ALIGN_MS, Motor_StartOpenLoopRamp);
     }
 
 }
@@ -396,18 +1047,40 @@ static void Motor_LowLoop(void)
  */
 void Control_Motor_Init(void)
 {
-    SBemfMonitor->init();
+    /* Comparator capture only if the board routes the dividers to the comparators */
+    if (BEMF_HW_COMPARATOR && SBemfMonitorComp->init())
+        SBemfMonitor = SBemfMonitorComp;
+    else
+        SBemfMonitor->init();
 
     /* Fast loop (24 kHz) */
     SFastLoop->init();
     SFastLoop->register_callback(Motor_FastLoop);
     SFastLoop->start();
 
-    /* PID configuration (1 kHz) */
-    Service_PID_Init(&speed_pid, 0.0005f, 0.001f, 0.0f, 0.001f);
-    speed_pid.out_min = 0.05f;
-    speed_pid.out_max = 0.95f;
-    speed_pid.integrator_limit = 0.5f;
+    /* Current PI (fast loop): zero on the R/L pole of the pair, crossover at the bandwidth */
+    uint32_t f_fast = SFastLoop->get_frequency_hz();
+    if (f_fast >= 1000U)
+        s_ts = 1.0f / (float)f_fast;
+
+    float wc = 2.0f * 3.14159265f * CURRENT_BW_HZ;
+    Service_PID_Init(&current_pid, PAIR_L_H * wc, PAIR_R_OHM * wc, 0.0f, s_ts);
+    Motor_SetVoltageLimits(VBUS_DEFAULT_V);
+
+    /* Speed PI (1 kHz) → current reference, motoring only */
+    Service_PID_Init(&speed_pid, SPEED_KP, SPEED_KI, 0.0f, 0.001f);
+    speed_pid.out_min = CURRENT_MIN_A;
+    speed_pid.out_max = CONTROL_MOTOR_CURRENT_MAX_A;
+    speed_pid.integrator_limit = CONTROL_MOTOR_CURRENT_MAX_A;
+
+    /* Zero-cross PLL (fed from the fast loop) */
+    Service_ZcPll_Init(&s_pll);
+
+    /* Commutation advance map (default table) */
+    Service_CommAdvance_Init();
+
+    /* Desync detector (armed at each closed-loop entry) */
+    Service_Desync_Init(&s_desync);
 
     /* Slow loop (1 kHz) */
     SLowLoop->init();
@@ -418,39 +1091,65 @@ void Control_Motor_Init(void)
 }
 
 /**
- * @brief Set motor speed command (in RPM, signed).
+ * @brief Register the six-step loops again, keeping the calibration.
+ */
+void Control_Motor_AttachLoops(void)
+{
+    Control_Motor_Stop();
+
+    SFastLoop->register_callback(Motor_FastLoop);
+    SLowLoop->register_callback(Motor_LowLoop);
+}
+
+/**
+ * @brief Apply a speed or torque command: start, update or reversal.
  *
- * This function manages both speed updates and direction changes.
- * If the requested direction is opposite to the current one,
- * the motor will first decelerate to a stop, then restart safely
- * in the new direction.
+ * If the requested direction is opposite to the current one, the motor
+ * first slows down (speed 0, or no current in torque mode), then restarts
+ * in the new direction with the buffered command.
  *
- * @param rpm  Target mechanical speed in RPM (signed).
+ * @param torque     true: @p value is a current [A], false: a speed [RPM]
+ * @param new_dir_cw Requested direction
+ * @param value      Command magnitude
  */
-void Control_Motor_SetSpeed_RPM(float rpm)
+static void Motor_Command(bool torque, bool new_dir_cw, float value)
 {
-    /* ----------------------------------------------------------------------
-     * 1. Determine requested direction and magnitude
-     * ---------------------------------------------------------------------- */
-    bool new_dir_cw = (rpm >= 0.0f);
-    float target_rpm = fabsf(rpm);
+    float *commanded = torque ? &s_commanded_current_a : &s_commanded_speed_rpm;
+    float *buffered  = torque ? &s_buffer_current_a : &s_buffer_speed_rpm;
+
+    s_torque_mode = torque;
 
     /* ----------------------------------------------------------------------
-     * 2. Case: Motor currently stopped → start directly
+     * 1. Case: Motor currently stopped → start directly
      * ---------------------------------------------------------------------- */
+    if (s_motor_mode == MOTOR_MODE_STOPPED && s_recovery.active)
+    {
+        /* Re-aligning after a desync: the restart picks up the command */
+        *commanded = value;
+        return;
+    }
+
     if (s_motor_mode == MOTOR_MODE_STOPPED)
     {
-        LOG_INFO("Motor start: (%s)", new_dir_cw ? "CW" : "CCW");
+        LOG_INFO("Motor start: (%s%s)", new_dir_cw ? "CW" : "CCW", torque ? ", torque mode" : "");
         s_ctx.direction_cw = new_dir_cw;
-        s_commanded_speed_rpm = target_rpm;
-        Service_Motor_Align_Rotor(0.10f, 500, Motor_StartOpenLoopRamp);
+        *commanded = value;
+        Motor_Start();
+        return;
+    }
+
+    if (s_motor_mode == MOTOR_MODE_CATCH || s_motor_mode == MOTOR_MODE_LOCATE)
+    {
+        /* Still listening / locating: the start follows the new command */
+        s_ctx.direction_cw = new_dir_cw;
+        *commanded = value;
         return;
     }
 
     /* ----------------------------------------------------------------------
-     * 3. Case: Motor running in opposite direction → safe reversal sequence
+     * 2. Case: Motor running in opposite direction → safe reversal sequence
      * ----------------------------------------------------------------------
-     * - Step 1: Command 0 RPM (smooth stop via ramp)
+     * - Step 1: Command 0 (smooth stop via ramp, or coasting without current)
      * - Step 2: Wait until measured speed < threshold
      * - Step 3: Restart with opposite direction
      */
@@ -461,10 +1160,10 @@ void Control_Motor_SetSpeed_RPM(float rpm)
                  new_dir_cw ? "CW" : "CCW");
 
         /* --- Start deceleration --- */
-        s_commanded_speed_rpm = 0.0f;
+        *commanded = 0.0f;
 
-        /* --- Buffer new speed after reversal --- */
-        s_buffer_speed_rpm = target_rpm;
+        /* --- Buffer new command after reversal --- */
+        *buffered = value;
 
         /* wait flag to prevent new start before complete stop */
         s_reverse_pending = true;
@@ -472,15 +1171,43 @@ void Control_Motor_SetSpeed_RPM(float rpm)
     }
 
     /* ----------------------------------------------------------------------
-     * 4. Case: Motor already running in same direction → update target
+     * 3. Case: Motor already running in same direction → update target
      * ---------------------------------------------------------------------- */
     if (s_motor_mode == MOTOR_MODE_OPEN_LOOP || s_motor_mode == MOTOR_MODE_CLOSED_LOOP)
     {
-        s_commanded_speed_rpm = target_rpm;
-        LOG_DEBUG("Speed update: %.0f RPM (%s)", target_rpm, new_dir_cw ? "CW" : "CCW");
+        *commanded = value;
+        LOG_DEBUG("%s update: %.2f (%s)", torque ? "Torque" : "Speed", value, new_dir_cw ? "CW" : "CCW");
     }
 }
 
+/**
+ * @brief Set motor speed command (in RPM, signed).
+ *
+ * Leaves torque mode: the speed loop takes over from the current flowing.
+ *
+ * @param rpm  Target mechanical speed in RPM (signed).
+ */
+void Control_Motor_SetSpeed_RPM(float rpm)
+{
+    Motor_Command(false, rpm >= 0.0f, fabsf(rpm));
+}
+
+/**
+ * @brief Set a torque (current) command, speed loop bypassed.
+ *
+ * @param amps  Current reference of the driven pair [A] (signed, 0 = stop).
+ */
+void Control_Motor_SetTorqueCurrent_A(float amps)
+{
+    if (amps == 0.0f)
+    {
+        Control_Motor_Stop();
+        return;
+    }
+
+    Motor_Command(true, amps > 0.0f, fminf(fmaxf(fabsf(amps), CURRENT_MIN_A), CONTROL_MOTOR_CURRENT_MAX_A));
+}
+
 
 /**
  * @brief Smoothly stop the motor (soft stop).
@@ -492,16 +1219,78 @@ void Control_Motor_Stop(void)
     Service_Motor_Stop();
 
     memset(&s_ctx, 0, sizeof(s_ctx));
+    Service_ZcPll_Reset(&s_pll);
+    Service_CommAdvance_CalAbort();
+    Service_Desync_Disarm(&s_desync);
+    s_recovery.active = false;
+    s_recovery.resyncs = s_recovery.restarts = 0;
     s_motor_mode = MOTOR_MODE_STOPPED;
     s_target_speed_rpm = s_measured_speed_rpm = 0.0f;
+
+    s_torque_mode = false;
+    s_commanded_current_a = s_current_ref_a = 0.0f;
+    Service_PID_Reset(&current_pid);
+    Service_PID_Reset(&speed_pid);
+}
+
+/**
+ * @brief Calibrate the commutation advance at the current operating point.
+ */
+bool Control_Motor_CalibrateAdvance(void)
+{
+    if (s_motor_mode != MOTOR_MODE_CLOSED_LOOP || !s_bemf_status.valid)
+        return false;
+
+    return Service_CommAdvance_CalStart(Motor_ElectricalSpeedHz(), s_bemf_status.current_a);
+}
+
+/**
+ * @brief Set the desync detection / recovery policy.
+ */
+void Control_Motor_SetDesyncPolicy(const control_motor_desync_policy_t *policy)
+{
+    if (policy == NULL)
+        return;
+
+    s_desync_policy = *policy;
+    if (!s_desync_policy.enabled)
+        Service_Desync_Disarm(&s_desync);
 }
 
 /**
- * @brief Return current commanded speed (RPM).
+ * @brief Read the desync counters.
+ */
+void Control_Motor_GetDesyncStats(control_motor_desync_stats_t *stats)
+{
+    if (stats != NULL)
+        *stats = s_desync_stats;
+}
+
+/**
+ * @brief Return the speed target of the ramp (RPM).
  */
 float Control_Motor_GetTargetSpeed_RPM(void)
 {
-    return s_measured_speed_rpm < 300.0? 0.0 : s_measured_speed_rpm;
+    return s_target_speed_rpm;
+}
+
+/**
+ * @brief Return the measured speed (RPM, signed by the direction).
+ */
+float Control_Motor_GetMeasuredSpeed_RPM(void)
+{
+    if (s_motor_mode == MOTOR_MODE_STOPPED)
+        return 0.0f;
+
+    return s_ctx.direction_cw ? s_measured_speed_rpm : -s_measured_speed_rpm;
+}
+
+/**
+ * @brief Return the current control mode.
+ */
+control_motor_mode_t Control_Motor_GetMode(void)
+{
+    return (control_motor_mode_t)s_motor_mode;
 }
 
 /**
@@ -520,6 +1309,7 @@ void Control_Motor_SetRampSlope(float rpm_per_ms)
  *  - Current mode (STOPPED / OL / CL)
  *  - Direction of rotation (CW / CCW)
  *  - Measured mechanical speed (RPM)
+ *  - Pair current and its reference (speed loop output or torque command)
  */
 void Control_Motor_PrintStats(void)
 {
@@ -531,6 +1321,8 @@ void Control_Motor_PrintStats(void)
         (s_motor_mode == MOTOR_MODE_STOPPED)    ? "STOPPED" :
         (s_motor_mode == MOTOR_MODE_OPEN_LOOP)  ? "OPEN_LOOP" :
         (s_motor_mode == MOTOR_MODE_CLOSED_LOOP)? "CLOSED_LOOP" :
+        (s_motor_mode == MOTOR_MODE_CATCH)      ? "CATCHING" :
+        (s_motor_mode == MOTOR_MODE_LOCATE)     ? "LOCATING" :
                                                   "UNKNOWN";
 
     /* Determine rotation direction (if relevant) */
@@ -546,7 +1338,21 @@ void Control_Motor_PrintStats(void)
     }
     else
     {
-        LOG_INFO("[Motor] RUNNING | Mode=%s | Dir=%s | Speed=%lu RPM",
-                 mode_str, dir_str, (uint32_t)rpm);
+        LOG_INFO("[Motor] RUNNING | Mode=%s | Dir=%s | Speed=%lu RPM | I=%lu mA (ref %lu mA%s)",
+                 mode_str, dir_str, (uint32_t)rpm, (uint32_t)(s_bemf_status.current_a * 1000.0f),
+                 (uint32_t)(s_current_ref_a * 1000.0f), s_torque_mode ? ", torque mode" : "");
+    }
+
+    if (s_desync_stats.events > 0)
+    {
+        LOG_INFO("[Motor] Desyncs=%lu (timeout %lu, window %lu, jump %lu, spike %lu) | Resyncs=%lu Restarts=%lu Failed=%lu | Recovery last=%lu us max=%lu us",
+                 (unsigned long)s_desync_stats.events,
+                 (unsigned long)s_desync_stats.by_cause[DESYNC_ZC_TIMEOUT - 1],
+                 (unsigned long)s_desync_stats.by_cause[DESYNC_ZC_WINDOW - 1],
+                 (unsigned long)s_desync_stats.by_cause[DESYNC_PERIOD_JUMP - 1],
+                 (unsigned long)s_desync_stats.by_cause[DESYNC_CURRENT_SPIKE - 1],
+                 (unsigned long)s_desync_stats.resyncs, (unsigned long)s_desync_stats.restarts,
+                 (unsigned long)s_desync_stats.give_ups,
+                 (unsigned long)s_desync_stats.last_recovery_us, (unsigned long)s_desync_stats.max_recovery_us);
     }
 }
\ No newline at end of file
@@ -6,6 +6,32 @@
  * PWM frequency, deadtime, polarity, and break input are configured in BSP.
  * This driver only handles arming, enabling/disabling PWM, duty updates,
  * emergency stop, and fault management.
+ *
+ * Output states are written directly to the CCxE/CCxNE bits of TIM1->CCER
+ * (no HAL start/stop sequence per channel). six_step() takes its CCER
+ * mask and floating phase from a precomputed table: one compare value for
+ * the three channels and a single CCER write per commutation (CCMR is not
+ * touched, every state is PWM mode 1 gated by CCxE/CCxNE).
+ *
+ * Duties: CCR1..3 are preloaded (OCxPE) and the BSP sets RCR = 1, so the
+ * compares transfer once per PWM period. MX_TIM1_Init() pins that update to
+ * the counter overflow (middle of the off-time for a center-aligned PWM
+ * mode 1) and SensorsCallbacks_Init() checks it on the first update after
+ * the start (CR1.DIR down), rather than leaving it to when RCR happened to
+ * be loaded. Both halves of a pulse always use the same value. The three
+ * CCRs are written with CR1.UDIS set so that they transfer at the same
+ * update event. The cached compares (ticks) are the duty reference;
+ * set_duty_ticks() is the float-free path.
+ *
+ * Hardware-timed commutation (INVERTER_COMM_PRELOAD): TIM1 CR2.CCPC makes
+ * the CCxE/CCxNE bits preloaded, and CR2.CCUS transfers them on a rising
+ * edge of TRGI. TRGI is TIM5 TRGO, pulsed by the compare channel holding
+ * TIMER_EVENT_COMMUTATION (driver_timer_sched_tim5.c): the next pattern is
+ * preloaded from the ISR and applied by the timer exactly at the deadline.
+ *
+ * ADC trigger: TIM1 CH4 in PWM mode 2 drives TRGO (OC4REF), rising when the
+ * up-counting half reaches CCR4. CCR4 is preloaded like CCR1..3, so a new
+ * sampling point applies from the period after the next update event.
  */
 
 #include "i_inverter.h"
@@ -26,9 +52,58 @@ static const uint32_t inverter_channels[PHASE_COUNT] = {
     TIM_CHANNEL_3   // Phase C
 };
 
+/**
+ * @brief TIM1 internal trigger connected to TIM5 TRGO (RM0440, TIM1 ITR4),
+ *        source of the COM event in INVERTER_COMM_PRELOAD mode.
+ */
+#define INVERTER_COM_TRIGGER       TIM_TS_ITR4
+
+/* CCER enable bits of a phase: CCxE at bit 4·x, CCxNE at bit 4·x + 2 */
+#define INVERTER_CCER_HIGH(ph)     (TIM_CCER_CC1E  << (4U * (uint32_t)(ph)))
+#define INVERTER_CCER_LOW(ph)      (TIM_CCER_CC1NE << (4U * (uint32_t)(ph)))
+#define INVERTER_CCER_PHASE(ph)    (INVERTER_CCER_HIGH(ph) | INVERTER_CCER_LOW(ph))
+#define INVERTER_CCER_ALL          (INVERTER_CCER_PHASE(PHASE_A) | \
+                                    INVERTER_CCER_PHASE(PHASE_B) | \
+                                    INVERTER_CCER_PHASE(PHASE_C))
+
+/* === Six-step table ==================================================== */
+/**
+ * @brief Register image of one six-step pattern.
+ */
+typedef struct {
+    uint32_t         ccer;      // CCxE of the PWM_HIGH phase | CCxNE of the PWM_LOW phase
+    inverter_phase_t floating;  // Hi-Z phase (BEMF sensing)
+} inverter_six_step_entry_t;
+
+#define INVERTER_SIX_STEP(hi, lo, fl) \
+    { INVERTER_CCER_HIGH(hi) | INVERTER_CCER_LOW(lo), (fl) }
+
+// [direction: 0 = CW, 1 = CCW][step], patterns documented in i_inverter.h
+static const inverter_six_step_entry_t inverter_six_step_lut[2][6] = {
+    {
+        INVERTER_SIX_STEP(PHASE_A, PHASE_B, PHASE_C),
+        INVERTER_SIX_STEP(PHASE_A, PHASE_C, PHASE_B),
+        INVERTER_SIX_STEP(PHASE_B, PHASE_C, PHASE_A),
+        INVERTER_SIX_STEP(PHASE_B, PHASE_A, PHASE_C),
+        INVERTER_SIX_STEP(PHASE_C, PHASE_A, PHASE_B),
+        INVERTER_SIX_STEP(PHASE_C, PHASE_B, PHASE_A)
+    },
+    {
+        INVERTER_SIX_STEP(PHASE_C, PHASE_B, PHASE_A),
+        INVERTER_SIX_STEP(PHASE_C, PHASE_A, PHASE_B),
+        INVERTER_SIX_STEP(PHASE_B, PHASE_A, PHASE_C),
+        INVERTER_SIX_STEP(PHASE_B, PHASE_C, PHASE_A),
+        INVERTER_SIX_STEP(PHASE_A, PHASE_C, PHASE_B),
+        INVERTER_SIX_STEP(PHASE_A, PHASE_B, PHASE_C)
+    }
+};
+
 /* === Internal state =================================================== */
 static inverter_status_t inverter_status = {0};  // Tracks armed/enabled/running/faults
-static inverter_duty_t inverter_duties = {0};   // Cached duty cycles (0.0..1.0)
+static uint16_t inverter_compare[PHASE_COUNT];   // Cached compare values (ticks)
+static uint16_t inverter_period_ticks = 0;       // ARR + 1, read once at init
+static inverter_comm_mode_t inverter_comm_mode = INVERTER_COMM_IMMEDIATE;
+static uint32_t inverter_ccer = 0;               // Phase enable bits last written (applied or preloaded)
 
 /* === Forward declarations ============================================ */
 static bool Driver_Init(void);
@@ -38,11 +113,17 @@ static bool Driver_Disable(void);
 static void Driver_EmergencyStop(bool latch_fault);
 static bool Driver_SetPhaseDuty(inverter_phase_t phase, float duty);
 static bool Driver_SetAllDuties(const inverter_duty_t* duties);
+static uint16_t Driver_GetPeriodTicks(void);
+static bool Driver_SetDutyTicks(const inverter_ticks_t* ticks);
 static bool Driver_GetDuties(inverter_duty_t* out);
 static void Driver_GetStatus(inverter_status_t* out);
 static bool Driver_ClearFaults(void);
 static void Driver_NotifyFault(inverter_fault_t fault);
 static bool Driver_SetOutputState(inverter_phase_t phase, phase_output_state_t state);
+static bool Driver_SetCommMode(inverter_comm_mode_t mode);
+static bool Driver_PreloadOutputStates(const phase_output_state_t states[PHASE_COUNT]);
+static inverter_phase_t Driver_SixStep(uint8_t step, float duty, bool cw);
+static bool Driver_SetAdcTrigger(uint16_t ticks);
 
 /* === Global interface instance ======================================= */
 i_inverter_t stm32g4_inverter_driver = {
@@ -53,15 +134,95 @@ i_inverter_t stm32g4_inverter_driver = {
     .emergency_stop   = Driver_EmergencyStop,
     .set_phase_duty   = Driver_SetPhaseDuty,
     .set_all_duties   = Driver_SetAllDuties,
+    .get_period_ticks = Driver_GetPeriodTicks,
+    .set_duty_ticks   = Driver_SetDutyTicks,
     .get_duties       = Driver_GetDuties,
     .get_status       = Driver_GetStatus,
     .clear_faults     = Driver_ClearFaults,
     .notify_fault     = Driver_NotifyFault,
-    .set_output_state = Driver_SetOutputState
+    .set_output_state = Driver_SetOutputState,
+    .set_comm_mode    = Driver_SetCommMode,
+    .preload_output_states = Driver_PreloadOutputStates,
+    .six_step         = Driver_SixStep,
+    .set_adc_trigger  = Driver_SetAdcTrigger
 };
 
 i_inverter_t* IInverter = &stm32g4_inverter_driver;
 
+/* ========================================================= */
+/* === Register helpers ==================================== */
+/* ========================================================= */
+
+/**
+ * @brief CCER enable bits producing @p state on @p phase.
+ */
+static uint32_t Driver_StateToCcer(inverter_phase_t phase, phase_output_state_t state)
+{
+    switch (state)
+    {
+        case STATE_PWM_ACTIVE:  return INVERTER_CCER_PHASE(phase);
+        case STATE_PWM_HIGH:
+        case STATE_FORCE_HIGH:  return INVERTER_CCER_HIGH(phase);
+        case STATE_PWM_LOW:
+        case STATE_FORCE_LOW:   return INVERTER_CCER_LOW(phase);
+        case STATE_HIZ:
+        default:                return 0U;
+    }
+}
+
+/**
+ * @brief Write the phase enable bits of CCER, other channels untouched.
+ *
+ * MOE follows the HAL start/stop rules (set when a phase is enabled,
+ * cleared once no channel output is enabled). In INVERTER_COMM_PRELOAD
+ * mode the bits are preloaded, so a software COM event applies them now.
+ */
+static void Driver_ApplyCcer(uint32_t ccer)
+{
+    TIM_TypeDef *tim = inverter_tim->Instance;
+
+    inverter_ccer = ccer;
+    MODIFY_REG(tim->CCER, INVERTER_CCER_ALL, ccer);
+
+    if (inverter_comm_mode == INVERTER_COMM_PRELOAD)
+        tim->EGR = TIM_EGR_COMG;
+
+    if (ccer != 0U)
+        __HAL_TIM_MOE_ENABLE(inverter_tim);
+    else
+        __HAL_TIM_MOE_DISABLE(inverter_tim);
+}
+
+/**
+ * @brief Write the three compare values, transferred at one update event.
+ *
+ * UDIS holds the preload → active transfer while the CCRs are written. An
+ * update falling inside this window is skipped, the values then apply one
+ * period later, still all three together.
+ */
+static void Driver_WriteCompare(uint16_t a, uint16_t b, uint16_t c)
+{
+    TIM_TypeDef *tim = inverter_tim->Instance;
+
+    inverter_compare[PHASE_A] = a;
+    inverter_compare[PHASE_B] = b;
+    inverter_compare[PHASE_C] = c;
+
+    SET_BIT(tim->CR1, TIM_CR1_UDIS);
+    tim->CCR1 = a;
+    tim->CCR2 = b;
+    tim->CCR3 = c;
+    CLEAR_BIT(tim->CR1, TIM_CR1_UDIS);
+}
+
+/**
+ * @brief Normalized duty (0.0..1.0) to compare ticks.
+ */
+static inline uint16_t Driver_DutyToTicks(float duty)
+{
+    return (uint16_t)(duty * (float)inverter_period_ticks);
+}
+
 /* ========================================================= */
 /* === Implementation ====================================== */
 /* ========================================================= */
@@ -78,10 +239,11 @@ static bool Driver_Init(void)
     inverter_status.running = false;
     inverter_status.fault   = INVERTER_FAULT_NONE;
 
-    for (int i = 0; i < PHASE_COUNT; i++)
-        inverter_duties.phase_duty[i] = 0.0f;
+    inverter_period_ticks = (uint16_t)(__HAL_TIM_GET_AUTORELOAD(inverter_tim) + 1U);
+    Driver_WriteCompare(0U, 0U, 0U);
 
-    return true;
+    inverter_ccer = 0;
+    return Driver_SetCommMode(INVERTER_COMM_IMMEDIATE);
 }
 
 /**
@@ -107,13 +269,8 @@ static bool Driver_Enable(void)
     if (!inverter_status.armed || inverter_status.fault != INVERTER_FAULT_NONE)
         return false;
 
-    for (int i = 0; i < PHASE_COUNT; i++)
-    {
-        // Start normal PWM channel
-        HAL_TIM_PWM_Start(inverter_tim, inverter_channels[i]);
-        // Start complementary channel
-        HAL_TIMEx_PWMN_Start(inverter_tim, inverter_channels[i]);
-    }
+    // Complementary PWM (CHx + CHxN) on every phase
+    Driver_ApplyCcer(INVERTER_CCER_ALL);
 
     inverter_status.enabled = true;
     inverter_status.running = true;
@@ -127,11 +284,7 @@ static bool Driver_Enable(void)
  */
 static bool Driver_Disable(void)
 {
-    for (int i = 0; i < PHASE_COUNT; i++)
-    {
-        HAL_TIM_PWM_Stop(inverter_tim, inverter_channels[i]);
-        HAL_TIMEx_PWMN_Stop(inverter_tim, inverter_channels[i]);
-    }
+    Driver_ApplyCcer(0U);
 
     inverter_status.enabled = false;
     inverter_status.running = false;
@@ -162,11 +315,9 @@ static bool Driver_SetPhaseDuty(inverter_phase_t phase, float duty)
     if (phase >= PHASE_COUNT || duty < 0.0f || duty > 1.0f)
         return false;
 
-    inverter_duties.phase_duty[phase] = duty;
-
-    // Convert normalized duty to timer CCR value
-    uint32_t pulse = (uint32_t)(duty * (__HAL_TIM_GET_AUTORELOAD(inverter_tim) + 1));
-    __HAL_TIM_SET_COMPARE(inverter_tim, inverter_channels[phase], pulse);
+    // Convert normalized duty to timer CCR value (single CCR: no UDIS needed)
+    inverter_compare[phase] = Driver_DutyToTicks(duty);
+    __HAL_TIM_SET_COMPARE(inverter_tim, inverter_channels[phase], inverter_compare[phase]);
 
     return true;
 }
@@ -184,14 +335,35 @@ static bool Driver_SetAllDuties(const inverter_duty_t* duties)
             return false;  // Reject invalid value
     }
 
-    inverter_duties = *duties;
+    Driver_WriteCompare(Driver_DutyToTicks(duties->phase_duty[PHASE_A]),
+                        Driver_DutyToTicks(duties->phase_duty[PHASE_B]),
+                        Driver_DutyToTicks(duties->phase_duty[PHASE_C]));
 
-    for (int i = 0; i < PHASE_COUNT; i++)
-    {
-        uint32_t pulse = (uint32_t)(duties->phase_duty[i] * (__HAL_TIM_GET_AUTORELOAD(inverter_tim) + 1));
-        __HAL_TIM_SET_COMPARE(inverter_tim, inverter_channels[i], pulse);
-    }
+    return true;
+}
+
+/**
+ * @brief PWM period in compare ticks (ARR + 1).
+ */
+static uint16_t Driver_GetPeriodTicks(void)
+{
+    return inverter_period_ticks;
+}
 
+/**
+ * @brief Set the three compare values (float-free), committed together
+ *        at the next update event.
+ */
+static bool Driver_SetDutyTicks(const inverter_ticks_t* ticks)
+{
+    if (!ticks) return false;
+
+    if (ticks->compare[PHASE_A] > inverter_period_ticks ||
+        ticks->compare[PHASE_B] > inverter_period_ticks ||
+        ticks->compare[PHASE_C] > inverter_period_ticks)
+        return false;  // Reject invalid value
+
+    Driver_WriteCompare(ticks->compare[PHASE_A], ticks->compare[PHASE_B], ticks->compare[PHASE_C]);
     return true;
 }
 
@@ -202,7 +374,9 @@ static bool Driver_GetDuties(inverter_duty_t* out)
 {
     if (!out) return false;
 
-    *out = inverter_duties;
+    for (int i = 0; i < PHASE_COUNT; i++)
+        out->phase_duty[i] = (float)inverter_compare[i] / (float)inverter_period_ticks;
+
     return true;
 }
 
@@ -243,54 +417,124 @@ static void Driver_NotifyFault(inverter_fault_t fault)
  * - PWM: Normal complementary operation
  * - PWM_HIGH: High-side PWM, low-side always OFF
  * - PWM_LOW: High-side always OFF, low-side PWM
+ * - FORCE_HIGH / FORCE_LOW: PWM_HIGH / PWM_LOW at 100 % / 0 % duty
  */
 static bool Driver_SetOutputState(inverter_phase_t phase, phase_output_state_t state)
 {
     if (phase >= PHASE_COUNT) return false;
-    
+
     uint32_t channel = inverter_channels[phase];
-    
-    switch (state)
+
+    if (state == STATE_FORCE_HIGH)
     {
-        case STATE_HIZ:
-            /* Both outputs Hi-Z (stop both channels) */
-            HAL_TIM_PWM_Stop(inverter_tim, channel);
-            HAL_TIMEx_PWMN_Stop(inverter_tim, channel);
-            break;
-            
-        case STATE_PWM_ACTIVE:
-            /* Normal complementary PWM (both channels active) */
-            HAL_TIM_PWM_Start(inverter_tim, channel);
-            HAL_TIMEx_PWMN_Start(inverter_tim, channel);
-            break;
-            
-        case STATE_PWM_HIGH:
-            /* High-side PWM, Low-side forced OFF */
-            HAL_TIM_PWM_Start(inverter_tim, channel);
-            HAL_TIMEx_PWMN_Stop(inverter_tim, channel);
-            break;
-            
-        case STATE_PWM_LOW:
-            /* High-side forced OFF, Low-side PWM */
-            HAL_TIM_PWM_Stop(inverter_tim, channel);
-            HAL_TIMEx_PWMN_Start(inverter_tim, channel);
-            break;
-            
-        case STATE_FORCE_HIGH:
-            /* Force 100% duty (high-side ON) */
-            __HAL_TIM_SET_COMPARE(inverter_tim, channel, 
-                                 __HAL_TIM_GET_AUTORELOAD(inverter_tim) + 1);
-            HAL_TIM_PWM_Start(inverter_tim, channel);
-            HAL_TIMEx_PWMN_Stop(inverter_tim, channel);
+        inverter_compare[phase] = inverter_period_ticks;
+        __HAL_TIM_SET_COMPARE(inverter_tim, channel, inverter_period_ticks);
+    }
+    else if (state == STATE_FORCE_LOW)
+    {
+        inverter_compare[phase] = 0U;
+        __HAL_TIM_SET_COMPARE(inverter_tim, channel, 0);
+    }
+
+    Driver_ApplyCcer((inverter_ccer & ~INVERTER_CCER_PHASE(phase)) | Driver_StateToCcer(phase, state));
+
+    return true;
+}
+
+/**
+ * @brief Select immediate or COM-event commutation.
+ *
+ * PRELOAD: CCPC = 1 (CCxE/CCxNE preloaded), CCUS = 1 (COM on TRGI rising
+ * edge as well as EGR.COMG), TRGI = TIM5 TRGO. The current outputs are
+ * copied to the preload register first, so nothing changes until the next
+ * preload_output_states(). Back to IMMEDIATE, the last pattern written
+ * (even if still pending) drives the outputs at once.
+ */
+static bool Driver_SetCommMode(inverter_comm_mode_t mode)
+{
+    TIM_TypeDef *tim = inverter_tim->Instance;
+
+    switch (mode)
+    {
+        case INVERTER_COMM_IMMEDIATE:
+            CLEAR_BIT(tim->CR2, TIM_CR2_CCPC | TIM_CR2_CCUS);
+            MODIFY_REG(tim->CCER, INVERTER_CCER_ALL, inverter_ccer);
             break;
-            
-        case STATE_FORCE_LOW:
-            /* Force 0% duty (low-side ON) */
-            __HAL_TIM_SET_COMPARE(inverter_tim, channel, 0);
-            HAL_TIM_PWM_Stop(inverter_tim, channel);
-            HAL_TIMEx_PWMN_Start(inverter_tim, channel);
+
+        case INVERTER_COMM_PRELOAD:
+            MODIFY_REG(tim->CCER, INVERTER_CCER_ALL, inverter_ccer);
+            MODIFY_REG(tim->SMCR, TIM_SMCR_TS, INVERTER_COM_TRIGGER);
+            SET_BIT(tim->CR2, TIM_CR2_CCPC | TIM_CR2_CCUS);
             break;
+
+        default:
+            return false;
     }
 
+    inverter_comm_mode = mode;
+    return true;
+}
+
+/**
+ * @brief Preload the pattern of the next COM event (INVERTER_COMM_PRELOAD only).
+ *
+ * The CCER preload register is written in one store; the active outputs
+ * change when TIM5 TRGO (commutation deadline) raises the COM event.
+ */
+static bool Driver_PreloadOutputStates(const phase_output_state_t states[PHASE_COUNT])
+{
+    if (!states || inverter_comm_mode != INVERTER_COMM_PRELOAD)
+        return false;
+
+    uint32_t ccer = 0U;
+
+    for (int i = 0; i < PHASE_COUNT; i++)
+        ccer |= Driver_StateToCcer((inverter_phase_t)i, states[i]);
+
+    inverter_ccer = ccer;
+    MODIFY_REG(inverter_tim->Instance->CCER, INVERTER_CCER_ALL, ccer);
+
+    if (ccer != 0U)
+        __HAL_TIM_MOE_ENABLE(inverter_tim);
+
+    return true;
+}
+
+/**
+ * @brief Six-step fast path: one compare value, one CCER write.
+ *
+ * The three CCRs get the same value: in PRELOAD mode the CCRs still load
+ * at the next update event, before the COM event, so the phase about to
+ * be driven must already hold the duty (the Hi-Z one ignores it).
+ */
+static inverter_phase_t Driver_SixStep(uint8_t step, float duty, bool cw)
+{
+    if (step >= 6U || duty < 0.0f || duty > 1.0f)
+        return PHASE_COUNT;
+
+    const inverter_six_step_entry_t *entry = &inverter_six_step_lut[cw ? 0U : 1U][step];
+    TIM_TypeDef *tim = inverter_tim->Instance;
+    uint16_t pulse = Driver_DutyToTicks(duty);
+
+    Driver_WriteCompare(pulse, pulse, pulse);
+
+    // Applied now (IMMEDIATE) or preloaded for the COM event (PRELOAD)
+    inverter_ccer = entry->ccer;
+    MODIFY_REG(tim->CCER, INVERTER_CCER_ALL, entry->ccer);
+    __HAL_TIM_MOE_ENABLE(inverter_tim);
+
+    return entry->floating;
+}
+
+/**
+ * @brief Set the ADC trigger compare (CCR4, preloaded): the injected
+ *        conversions start @p ticks after the centre of the on-time.
+ */
+static bool Driver_SetAdcTrigger(uint16_t ticks)
+{
+    if (ticks == 0U || ticks >= inverter_period_ticks)
+        return false;
+
+    inverter_tim->Instance->CCR4 = ticks;
     return true;
-}
\ No newline at end of file
+}
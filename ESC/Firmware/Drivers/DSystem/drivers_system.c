@@ -7,6 +7,9 @@
 #include "adc.h"
 #include "tim.h"
 #include "dma.h"
+#include "cordic.h"
+#include "fmac.h"
+#include "i_filter.h"
 
 /**
  * @brief Initialize system core (HAL, clock)
@@ -69,6 +72,16 @@ i_status_t Driver_Init(void)
     MX_TIM5_Init();
     MX_TIM6_Init();
 
+    // Enable the CORDIC coprocessor (trigonometry of the control path, driver_math_cordic.c).
+    MX_CORDIC_Init();
+
+    // Enable the FMAC (filters of the injected ADC channels, driver_filter_fmac.c).
+    MX_FMAC_Init();
+
+    // Design and load the default ADC channel filters before the injected conversions start.
+    if (!IFilter->init())
+        return I_ERROR;
+
     // TODO: Add other essential peripheral initializations here if needed
     // For example: SPI, I2C, additional timers, DAC, etc.
 
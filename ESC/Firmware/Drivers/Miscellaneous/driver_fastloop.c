@@ -1,13 +1,19 @@
 /**
  * @file driver_fastloop.c
- * @brief Hardware-level implementation of the Fast Loop interface (i_periodic_loop_t) using TIM3.
+ * @brief Hardware-level implementation of the Fast Loop interface (i_periodic_loop_t).
  *
- * This module implements the high-frequency control loop trigger (e.g., 24 kHz)
- * using a hardware timer configured to generate periodic interrupts.
- * It directly implements the generic i_periodic_loop_t interface.
+ * This module implements the high-frequency control loop trigger (e.g., 24 kHz).
+ * Two trigger sources are available, selected by FASTLOOP_SYNC_TO_ADC:
+ *
+ *   - 1 (default): the callback runs at the end of the ADC1/ADC2 injected
+ *     end-of-conversion ISR, right after the motor measurements are stored.
+ *     The conversions are triggered by TIM1 TRGO, so the loop is phase-locked
+ *     to the PWM, always sees the sample of the current period and its rate
+ *     follows the TIM1 frequency. TIM3 is left unused.
+ *   - 0: the callback runs from the free-running TIM3 update interrupt.
  *
  * Responsibilities:
- *   - Configure and manage the timer resource (TIM3 by default)
+ *   - Configure and manage the trigger resource (ADC JEOC or TIM3)
  *   - Call the registered control-layer callback every control period
  *   - Expose a portable, hardware-agnostic interface to upper layers
  *
@@ -21,6 +27,7 @@
 
 #include "i_periodic_loop.h"
 #include "timers_callbacks.h"
+#include "../Sensors/sensors_callbacks.h"
 #include "bsp_utils.h"
 #include "tim.h"   // Auto-generated by STM32CubeMX
 
@@ -38,6 +45,27 @@
 #define FASTLOOP_TIMER_HANDLE     (&htim3)
 #define FASTLOOP_TIMER_INSTANCE   TIM3
 
+/**
+ * @brief Run the Fast Loop from the ADC injected end-of-conversion (1)
+ *        or from the FASTLOOP_TIMER_HANDLE update interrupt (0).
+ */
+#ifndef FASTLOOP_SYNC_TO_ADC
+#define FASTLOOP_SYNC_TO_ADC      1
+#endif
+
+/**
+ * @brief PWM timer triggering the injected conversions (TRGO = OC4REF).
+ */
+#define FASTLOOP_PWM_HANDLE       (&htim1)
+
+/**
+ * @brief NVIC priority of ADC1_2 when it carries the Fast Loop.
+ *
+ * Takes over the TIM3 slot: above the TIM4 Low Loop (3) so the control
+ * callback is never delayed by it, below the TIM5 timer scheduler (1).
+ */
+#define FASTLOOP_ADC_IRQ_PRIORITY 2U
+
 /* ========================================================================== */
 /* === Private Static Variables ============================================ */
 /* ========================================================================== */
@@ -61,6 +89,14 @@ static periodic_callback_t s_registered_cb = NULL;
  */
 static uint32_t s_fastloop_freq_hz = 24000U;
 
+/**
+ * @brief true between start() and stop() (ADC-synchronous mode only).
+ *
+ * The injected conversions keep running for the sensors; this flag gates
+ * the callback instead of the interrupt.
+ */
+static volatile bool s_sync_running = false;
+
 /* ========================================================================== */
 /* === Local Helper Functions ============================================== */
 /* ========================================================================== */
@@ -109,7 +145,28 @@ static bool drv_fastloop_init(void)
 
     /* Clear any previously registered callback */
     s_registered_cb = NULL;
+    s_sync_running  = false;
 
+#if FASTLOOP_SYNC_TO_ADC
+    /*
+     * Loop rate = one injected conversion per TIM1 period.
+     * Center-aligned: the counter runs 0 → ARR → 0, one period is 2·ARR
+     * ticks (not 2·(ARR + 1)): Freq = TIM_CLK / (2 * (PSC + 1) * ARR).
+     * TIM_CLK = PCLK2 (APB2 prescaler = 1).
+     */
+    uint32_t arr = __HAL_TIM_GET_AUTORELOAD(FASTLOOP_PWM_HANDLE);
+    uint32_t psc = FASTLOOP_PWM_HANDLE->Instance->PSC;
+
+    if (arr == 0)
+        return false;
+
+    s_fastloop_freq_hz = HAL_RCC_GetPCLK2Freq() / (2U * (psc + 1U) * arr);
+
+    /* The Fast Loop now executes inside the ADC1_2 ISR */
+    HAL_NVIC_SetPriority(ADC1_2_IRQn, FASTLOOP_ADC_IRQ_PRIORITY, 0);
+
+    return true;
+#else
     /* Ensure timer is stopped and counter reset */
     __HAL_TIM_DISABLE(FASTLOOP_TIMER_HANDLE);
     __HAL_TIM_SET_COUNTER(FASTLOOP_TIMER_HANDLE, 0);
@@ -119,6 +176,7 @@ static bool drv_fastloop_init(void)
         return false;
 
     return true;
+#endif
 }
 
 /**
@@ -137,14 +195,20 @@ static void drv_fastloop_register_callback(periodic_callback_t cb)
  *
  * This enables timer interrupts. Once started, the registered callback
  * will be invoked at each timer overflow (e.g., every 41.67 µs at 24 kHz).
+ * In ADC-synchronous mode the callback is invoked from the next injected
+ * end-of-conversion (started by SensorsCallbacks_Init()).
  */
 static void drv_fastloop_start(void)
 {
+#if FASTLOOP_SYNC_TO_ADC
+    s_sync_running = true;
+#else
     /* Clear any pending update flag before enabling interrupts */
     __HAL_TIM_CLEAR_FLAG(FASTLOOP_TIMER_HANDLE, TIM_FLAG_UPDATE);
 
     /* Start timer in interrupt mode */
     HAL_TIM_Base_Start_IT(FASTLOOP_TIMER_HANDLE);
+#endif
 }
 
 /**
@@ -155,7 +219,11 @@ static void drv_fastloop_start(void)
  */
 static void drv_fastloop_stop(void)
 {
+#if FASTLOOP_SYNC_TO_ADC
+    s_sync_running = false;
+#else
     HAL_TIM_Base_Stop_IT(FASTLOOP_TIMER_HANDLE);
+#endif
 }
 
 /**
@@ -193,10 +261,30 @@ static void drv_fastloop_trigger_once(void)
  */
 void Driver_FastLoop_OnTimerElapsed(TIM_HandleTypeDef *htim)
 {
+#if !FASTLOOP_SYNC_TO_ADC
     if (htim->Instance == FASTLOOP_TIMER_INSTANCE)
     {
         Driver_FastLoop_OnTick();
     }
+#else
+    (void)htim;
+#endif
+}
+
+/**
+ * @brief Called at the end of the ADC1 injected end-of-conversion ISR.
+ *
+ * The motor measurements of the current PWM period are already stored and
+ * flagged as new when this runs.
+ */
+void Driver_FastLoop_OnInjectedConversion(void)
+{
+#if FASTLOOP_SYNC_TO_ADC
+    if (s_sync_running)
+    {
+        Driver_FastLoop_OnTick();
+    }
+#endif
 }
 
 /* ========================================================================== */
@@ -0,0 +1,293 @@
+/**
+ * @file driver_filter.c
+ * @brief Fixed-point front end of the ADC channel filters, implementing i_filter_t.
+ *
+ * Designs one section per channel from its type and cutoff, quantises it
+ * to the FMAC format of driver_filter.h and keeps the section states. The
+ * module has no hardware dependency, so the host simulation links it
+ * unchanged: only the hooks differ (FMAC on target, software model on host).
+ *
+ * Split: a first-order section is two products, cheaper on the CPU than
+ * reconfiguring the FMAC for it (buffers, history preload, start, result,
+ * stop, interrupts masked), so it runs here in the same q1.15 arithmetic.
+ * Only second-order sections go through the hooks; with the defaults (all
+ * first order) the ADC interrupt does not touch the FMAC. The defaults are
+ * designed by init(), before the injected conversions start, never in the
+ * ADC interrupt.
+ *
+ * Quantisation: the feedback coefficients are rounded first, then the
+ * feed-forward ones are chosen so that their sum closes the loop gain
+ * exactly: the DC gain is 1 in integer arithmetic, whatever the cutoff.
+ *
+ * Dead band: the FMAC truncates every output to q1.15, and the feedback
+ * accumulates that error by 1 / (1 - Σa): a low-cutoff section stops up to
+ * 1 / Σb LSBs short of its input. The samples are centred on mid-scale
+ * and shifted by 4 (one more guard bit than unsigned), each section gets
+ * half its dead band as input bias (error centred on zero), and sections
+ * with a dead band above FILTER_DEADBAND_MAX_LSB are rejected: about ±1
+ * count at the output. This bounds the cutoffs from below (about 120 Hz
+ * first order, 720 Hz second order); lower cutoffs need more than 16 bits.
+ *
+ * The defaults reproduce the former shift IIRs of the ADC interrupt
+ * (y += (x - y) / 2^α, α = 5 on currents, 1 on voltages): same poles, same
+ * group delay.
+ */
+
+#include "i_filter.h"
+#include "i_math.h"
+#include "driver_filter.h"
+#include <math.h>
+
+/* ========================================================================== */
+/* === Configuration Macros ================================================ */
+/* ========================================================================== */
+
+#define FILTER_CURRENT_CUTOFF_HZ    121.28f     /**< Pole 31/32: the former α = 5 */
+#define FILTER_VOLTAGE_CUTOFF_HZ    2760.6f     /**< Pole 1/2: the former α = 1 */
+
+#define FILTER_SAMPLE_MID           2048        /**< 12-bit mid-scale, sample 0 */
+#define FILTER_SAMPLE_SHIFT         4U          /**< Centred 12-bit samples to q1.15 */
+#define FILTER_SAMPLE_MAX           4095
+#define FILTER_COEF_ONE             (1L << (15U - FILTER_GAIN_SHIFT))   /**< Coefficient 1.0 */
+#define FILTER_DEADBAND_MAX_LSB     32          /**< 2 counts peak to peak */
+
+#define FILTER_PI                   3.14159265f
+#define FILTER_SQRT2                1.41421356f
+
+/* ========================================================================== */
+/* === Module State ======================================================== */
+/* ========================================================================== */
+
+typedef struct
+{
+    filter_type_t type;
+    float         cutoff_hz;
+} filter_setting_t;
+
+static const filter_setting_t s_defaults[FILTER_CH_COUNT] = {
+    [FILTER_CH_I_A]   = { FILTER_TYPE_LOWPASS1, FILTER_CURRENT_CUTOFF_HZ },
+    [FILTER_CH_I_B]   = { FILTER_TYPE_LOWPASS1, FILTER_CURRENT_CUTOFF_HZ },
+    [FILTER_CH_V_A]   = { FILTER_TYPE_LOWPASS1, FILTER_VOLTAGE_CUTOFF_HZ },
+    [FILTER_CH_V_B]   = { FILTER_TYPE_LOWPASS1, FILTER_VOLTAGE_CUTOFF_HZ },
+    [FILTER_CH_V_C]   = { FILTER_TYPE_LOWPASS1, FILTER_VOLTAGE_CUTOFF_HZ },
+    [FILTER_CH_V_BUS] = { FILTER_TYPE_LOWPASS1, FILTER_VOLTAGE_CUTOFF_HZ },
+};
+
+static volatile filter_type_t s_type[FILTER_CH_COUNT];
+static volatile uint32_t      s_lp1_coef[FILTER_CH_COUNT]; /**< First order: b0 | a1 << 16 (one store) */
+static volatile uint32_t      s_delay_q8[FILTER_CH_COUNT];
+static volatile int16_t       s_bias[FILTER_CH_COUNT];     /**< Half dead band, q1.15 */
+static filter_hw_state_t      s_state[FILTER_CH_COUNT];
+
+static bool s_primed = false;           /**< States initialised on a sample */
+
+/* ========================================================================== */
+/* === Design ============================================================== */
+/* ========================================================================== */
+
+static int32_t filter_round(float v)
+{
+    return (int32_t)((v < 0.0f) ? (v - 0.5f) : (v + 0.5f));
+}
+
+/**
+ * @brief Design and quantise the section of one channel; a second-order
+ *        one is loaded in its FMAC slot.
+ * @return false if the cutoff is out of range or too low for q1.15
+ */
+static bool filter_design(filter_channel_t ch, filter_type_t type, float cutoff_hz)
+{
+    float a1 = 0.0f, a2 = 0.0f;
+
+    if (type != FILTER_TYPE_BYPASS)
+    {
+        if (!(cutoff_hz > 0.0f) || !(cutoff_hz < 0.5f * FILTER_SAMPLE_RATE_HZ))
+            return false;
+
+        float s, c;
+
+        if (type == FILTER_TYPE_LOWPASS1)
+        {
+            /* |H(ω)|² = (1-p)² / (1 - 2p·cos ω + p²) = 1/2 at the cutoff */
+            IMath->sin_cos(2.0f * FILTER_PI * cutoff_hz / FILTER_SAMPLE_RATE_HZ, &s, &c);
+            float u = 2.0f - c;
+            a1 = u - sqrtf(u * u - 1.0f);
+        }
+        else if (type == FILTER_TYPE_LOWPASS2)
+        {
+            /* Bilinear transform, K = tan(π·fc/fs) */
+            IMath->sin_cos(FILTER_PI * cutoff_hz / FILTER_SAMPLE_RATE_HZ, &s, &c);
+            float k    = s / c;
+            float norm = 1.0f / (1.0f + FILTER_SQRT2 * k + k * k);
+            a1 = 2.0f * (1.0f - k * k) * norm;
+            a2 = -(1.0f - FILTER_SQRT2 * k + k * k) * norm;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    int32_t a1q  = filter_round(a1 * (float)FILTER_COEF_ONE);
+    int32_t a2q  = filter_round(a2 * (float)FILTER_COEF_ONE);
+    int32_t bsum = FILTER_COEF_ONE - a1q - a2q;
+    int32_t b0q  = bsum, b1q = 0, b2q = 0;
+
+    /* Dead band: one LSB of truncation times the feedback gain 1 / (1 - Σa) */
+    if (bsum * FILTER_DEADBAND_MAX_LSB < FILTER_COEF_ONE)
+        return false;
+
+    if (type == FILTER_TYPE_LOWPASS2)
+    {
+        b0q = b2q = (bsum + 2) / 4;
+        b1q = bsum - 2 * b0q;
+    }
+
+    int16_t coef[FILTER_COEF_COUNT] = {
+        (int16_t)b0q, (int16_t)b1q, (int16_t)b2q, (int16_t)a1q, (int16_t)a2q
+    };
+
+    /* DC group delay: Σk·b_k / Σb_k + Σk·a_k / (1 - Σa_k) */
+    float delay = (float)(b1q + 2 * b2q) / (float)bsum
+                + (float)(a1q + 2 * a2q) / (float)(FILTER_COEF_ONE - a1q - a2q);
+
+    if (type == FILTER_TYPE_LOWPASS2)
+        Filter_HW_Load((uint32_t)ch, coef);
+    else
+        s_lp1_coef[ch] = (uint32_t)(uint16_t)coef[0] | ((uint32_t)(uint16_t)coef[3] << 16);
+
+    s_delay_q8[ch] = (uint32_t)filter_round(delay * 256.0f);
+    s_bias[ch]     = (type == FILTER_TYPE_BYPASS) ? 0 : (int16_t)(FILTER_COEF_ONE / (2 * bsum));
+    s_type[ch]     = type;
+    return true;
+}
+
+static int16_t filter_to_q15(uint16_t raw)
+{
+    return (int16_t)(((int32_t)raw - FILTER_SAMPLE_MID) * (1 << FILTER_SAMPLE_SHIFT));
+}
+
+static int16_t filter_add_sat(int16_t x, int16_t bias)
+{
+    int32_t v = (int32_t)x + bias;
+    return (v > INT16_MAX) ? INT16_MAX : (int16_t)v;
+}
+
+/**
+ * @brief First-order section, FMAC arithmetic (b1 = b2 = a2 = 0): exact
+ *        products, sum shifted by the gain R, truncated and saturated.
+ */
+static int16_t filter_run_lp1(uint32_t coef, filter_hw_state_t *st, int16_t x)
+{
+    int32_t acc = (int32_t)(int16_t)(coef & 0xFFFFU) * x
+                + (int32_t)(int16_t)(coef >> 16) * st->y1;
+
+    acc >>= (15U - FILTER_GAIN_SHIFT);
+    if (acc > INT16_MAX) acc = INT16_MAX;
+    if (acc < INT16_MIN) acc = INT16_MIN;
+
+    int16_t y = (int16_t)acc;
+
+    st->x2 = st->x1;
+    st->x1 = x;
+    st->y2 = st->y1;
+    st->y1 = y;
+    return y;
+}
+
+static uint16_t filter_to_raw(int16_t y)
+{
+    int32_t v = (((int32_t)y + (1 << (FILTER_SAMPLE_SHIFT - 1U))) >> FILTER_SAMPLE_SHIFT) + FILTER_SAMPLE_MID;
+    if (v < 0)                 v = 0;
+    if (v > FILTER_SAMPLE_MAX) v = FILTER_SAMPLE_MAX;
+    return (uint16_t)v;
+}
+
+/* ========================================================================== */
+/* === Interface Implementation ============================================ */
+/* ========================================================================== */
+
+static bool filter_init(void)
+{
+    bool ok = true;
+
+    for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+        ok &= filter_design((filter_channel_t)ch, s_defaults[ch].type, s_defaults[ch].cutoff_hz);
+
+    s_primed = false;
+    return ok;
+}
+
+static bool filter_configure(filter_channel_t ch, filter_type_t type, float cutoff_hz)
+{
+    if ((uint32_t)ch >= FILTER_CH_COUNT)
+        return false;
+
+    return filter_design(ch, type, cutoff_hz);
+}
+
+static void filter_process(const uint16_t *raw, uint16_t *filtered)
+{
+    if (!s_primed)
+    {
+        /* Steady state on this sample: exact output from the start */
+        for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+        {
+            int16_t x  = filter_to_q15(raw[ch]);
+            int16_t xb = filter_add_sat(x, s_bias[ch]);
+            s_state[ch] = (filter_hw_state_t){ xb, xb, x, x };
+        }
+        s_primed = true;
+    }
+
+    for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+    {
+        int16_t x = filter_to_q15(raw[ch]);
+        filter_hw_state_t *st = &s_state[ch];
+        filter_type_t type = s_type[ch];
+
+        if (type == FILTER_TYPE_BYPASS)
+        {
+            /* Keep the history current: a later section starts from here */
+            st->x2 = st->x1;
+            st->x1 = x;
+            st->y2 = st->y1;
+            st->y1 = x;
+            filtered[ch] = raw[ch];
+            continue;
+        }
+
+        int16_t xb = filter_add_sat(x, s_bias[ch]);
+        int16_t y  = (type == FILTER_TYPE_LOWPASS1) ? filter_run_lp1(s_lp1_coef[ch], st, xb)
+                                                    : Filter_HW_Run(ch, st, xb);
+        filtered[ch] = filter_to_raw(y);
+    }
+}
+
+static void filter_reset(void)
+{
+    s_primed = false;
+}
+
+static uint32_t filter_delay_q8(filter_channel_t ch)
+{
+    if ((uint32_t)ch >= FILTER_CH_COUNT)
+        return 0U;
+
+    return s_delay_q8[ch];
+}
+
+/* ========================================================================== */
+/* === Global Interface Binding =========================================== */
+/* ========================================================================== */
+
+static i_filter_t s_filter_iface = {
+    .init      = filter_init,
+    .configure = filter_configure,
+    .process   = filter_process,
+    .reset     = filter_reset,
+    .delay_q8  = filter_delay_q8,
+};
+
+/** Global pointer to the filter interface */
+i_filter_t* IFilter = &s_filter_iface;
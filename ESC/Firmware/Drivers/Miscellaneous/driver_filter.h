@@ -0,0 +1,71 @@
+/**
+ * @file driver_filter.h
+ * @brief Hardware hooks of the filter front end (driver_filter.c).
+ *
+ * The front end designs and quantises the sections, keeps their state and
+ * binds IFilter (i_filter.h); it has no hardware dependency. It runs the
+ * first-order sections itself; the second-order ones are computed by:
+ *   - driver_filter_fmac.c on target (FMAC, IIR direct form 1),
+ *   - sim_fmac.c in the host simulation (software model, same arithmetic).
+ *
+ * Formats (q1.15, as the FMAC):
+ *  - samples: value / 2^15 (12-bit ADC samples minus mid-scale, shifted
+ *    left by 4);
+ *  - coefficients: value / 2^15 / 2^FILTER_GAIN_SHIFT, in the FMAC form
+ *    y[n] = 2^R · (b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2])
+ *    (feedback coefficients added, i.e. the opposite sign of the usual
+ *    denominator).
+ */
+
+#ifndef DRIVER_FILTER_H
+#define DRIVER_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/** Injected conversion rate (TIM1 TRGO, one per PWM period) */
+#define FILTER_SAMPLE_RATE_HZ   24000.0f
+
+/** Coefficients per section: b0 b1 b2 a1 a2 */
+#define FILTER_COEF_COUNT       5U
+
+/** FMAC gain R: coefficients up to 2 in magnitude, stored halved */
+#define FILTER_GAIN_SHIFT       1U
+
+/**
+ * @brief State of one section: the last two inputs and outputs (q1.15).
+ */
+typedef struct
+{
+    int16_t x1, x2;
+    int16_t y1, y2;
+} filter_hw_state_t;
+
+/* ========================================================================== */
+/* === Hooks implemented by the hardware layer ============================= */
+/* ========================================================================== */
+
+/**
+ * @brief Store the coefficients of section @p slot (FILTER_COEF_COUNT values).
+ *
+ * Called for second-order sections only (configuration time, not the ADC
+ * interrupt).
+ * Atomic against interrupts: may be called while the ADC interrupt runs
+ * the sections.
+ */
+void Filter_HW_Load(uint32_t slot, const int16_t *coef);
+
+/**
+ * @brief Run section @p slot on one sample and advance its state.
+ * @return Output sample (saturated to q1.15)
+ */
+int16_t Filter_HW_Run(uint32_t slot, filter_hw_state_t *state, int16_t x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRIVER_FILTER_H */
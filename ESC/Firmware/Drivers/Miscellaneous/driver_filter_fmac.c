@@ -0,0 +1,114 @@
+/**
+ * @file driver_filter_fmac.c
+ * @brief FMAC layer of the filter front end (driver_filter.h).
+ *
+ * The FMAC computes the second-order sections, one at a time (the front
+ * end runs the first-order ones on the CPU): IIR direct form 1, P = 3
+ * feed-forward and Q = 2 feedback taps, gain R = FILTER_GAIN_SHIFT,
+ * clipping on. Local memory layout (16-bit words):
+ *   - X2: one coefficient slot per channel (5 words each, from address 0),
+ *     written by Filter_HW_Load();
+ *   - X1 / Y: one input and one output buffer shared by all channels,
+ *     configured by Filter_HW_Load() and kept (only X2 moves per run).
+ *
+ * Several channels cannot stay resident in the FMAC (one filter runs at a
+ * time and its buffer pointers are not saved), so each run preloads the
+ * channel history (two inputs, two outputs, known to the front end) before
+ * starting the filter, writes the new sample and reads the result.
+ * No DMA: the ADC interrupt consumes every result immediately.
+ *
+ * Each call runs with interrupts masked (the slow loop may reconfigure a
+ * slot while the ADC interrupt filters).
+ *
+ * **Target hardware:** FMAC (STM32G473CCTx), clock enabled by MX_FMAC_Init()
+ */
+
+#include "driver_filter.h"
+#include "bsp_utils.h"
+
+/* ========================================================================== */
+/* === Configuration Macros ================================================ */
+/* ========================================================================== */
+
+#define FMAC_FUNC_LOAD_X1       1U
+#define FMAC_FUNC_LOAD_X2       2U
+#define FMAC_FUNC_LOAD_Y        3U
+#define FMAC_FUNC_IIR_DF1       9U
+
+#define FMAC_TAPS_B             3U      /**< P */
+#define FMAC_TAPS_A             2U      /**< Q */
+
+#define FMAC_X1_BASE            32U     /**< After the coefficient slots (6 × 5 words) */
+#define FMAC_X1_SIZE            (FMAC_TAPS_B + 1U)
+#define FMAC_Y_BASE             40U
+#define FMAC_Y_SIZE             (FMAC_TAPS_A + 1U)
+
+#define FMAC_PARAM(func, p, q, r)   (((uint32_t)(func) << FMAC_PARAM_FUNC_Pos)      \
+                                     | ((uint32_t)(p) << FMAC_PARAM_P_Pos)          \
+                                     | ((uint32_t)(q) << FMAC_PARAM_Q_Pos)          \
+                                     | ((uint32_t)(r) << FMAC_PARAM_R_Pos)          \
+                                     | FMAC_PARAM_START)
+
+#define FMAC_X2_SLOT(slot)      (((slot) * FILTER_COEF_COUNT) << FMAC_X2BUFCFG_X2_BASE_Pos \
+                                 | (FILTER_COEF_COUNT << FMAC_X2BUFCFG_X2_BUF_SIZE_Pos))
+
+static inline void fmac_write(int16_t v)
+{
+    FMAC->WDATA = (uint32_t)(uint16_t)v;
+}
+
+/* ========================================================================== */
+/* === Hook Implementation ================================================= */
+/* ========================================================================== */
+
+void Filter_HW_Load(uint32_t slot, const int16_t *coef)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    FMAC->PARAM    = 0U;
+    FMAC->CR       = FMAC_CR_CLIPEN;
+    FMAC->X1BUFCFG = (FMAC_X1_BASE << FMAC_X1BUFCFG_X1_BASE_Pos) | (FMAC_X1_SIZE << FMAC_X1BUFCFG_X1_BUF_SIZE_Pos);
+    FMAC->YBUFCFG  = (FMAC_Y_BASE << FMAC_YBUFCFG_Y_BASE_Pos) | (FMAC_Y_SIZE << FMAC_YBUFCFG_Y_BUF_SIZE_Pos);
+    FMAC->X2BUFCFG = FMAC_X2_SLOT(slot);
+    FMAC->PARAM    = FMAC_PARAM(FMAC_FUNC_LOAD_X2, FMAC_TAPS_B, FMAC_TAPS_A, 0U);
+
+    for (uint32_t k = 0; k < FILTER_COEF_COUNT; k++)
+        fmac_write(coef[k]);
+
+    __set_PRIMASK(primask);
+}
+
+int16_t Filter_HW_Run(uint32_t slot, filter_hw_state_t *state, int16_t x)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    FMAC->X2BUFCFG = FMAC_X2_SLOT(slot);
+
+    /* History, oldest first (the preload functions stop by themselves) */
+    FMAC->PARAM = FMAC_PARAM(FMAC_FUNC_LOAD_X1, FMAC_TAPS_B - 1U, 0U, 0U);
+    fmac_write(state->x2);
+    fmac_write(state->x1);
+
+    FMAC->PARAM = FMAC_PARAM(FMAC_FUNC_LOAD_Y, FMAC_TAPS_A, 0U, 0U);
+    fmac_write(state->y2);
+    fmac_write(state->y1);
+
+    FMAC->PARAM = FMAC_PARAM(FMAC_FUNC_IIR_DF1, FMAC_TAPS_B, FMAC_TAPS_A, FILTER_GAIN_SHIFT);
+    fmac_write(x);
+
+    while (FMAC->SR & FMAC_SR_YEMPTY)
+        ;                               // P + Q cycles
+
+    int16_t y = (int16_t)FMAC->RDATA;
+    FMAC->PARAM = 0U;                   // Stop: the next channel reconfigures the buffers
+
+    __set_PRIMASK(primask);
+
+    state->x2 = state->x1;
+    state->x1 = x;
+    state->y2 = state->y1;
+    state->y1 = y;
+    return y;
+}
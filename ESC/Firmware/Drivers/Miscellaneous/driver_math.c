@@ -0,0 +1,164 @@
+/**
+ * @file driver_math.c
+ * @brief Float front end of the CORDIC math functions, implementing i_math_t.
+ *
+ * Converts the float arguments to the q1.31 formats of driver_math.h, calls
+ * the fixed-point hooks and converts the results back. The module has no
+ * hardware dependency, so the host simulation links it unchanged: only the
+ * hooks differ (coprocessor on target, software model on host).
+ *
+ * Angles: multiplying by 2^31/π and truncating to 64 bits, then keeping
+ * the low 32 bits, wraps any angle into one turn without fmodf().
+ *
+ * Vectors: (x, y) is scaled by a power of two (exact) so that the larger
+ * coordinate lies in [0.25, 0.5): full q1.31 resolution whatever the
+ * magnitude, and the modulus stays below 1 as the CORDIC requires.
+ */
+
+#include "i_math.h"
+#include "driver_math.h"
+
+/* ========================================================================== */
+/* === Configuration Macros ================================================ */
+/* ========================================================================== */
+
+#define MATH_Q31_PER_RAD    683565275.6f    /**< 2^31 / π */
+#define MATH_RAD_PER_Q31    1.462918079e-9f /**< π / 2^31 */
+#define MATH_Q31_ONE        2147483648.0f   /**< 2^31 */
+#define MATH_ONE_PER_Q31    4.656612873e-10f /**< 2^-31 */
+
+/* ========================================================================== */
+/* === Helpers ============================================================= */
+/* ========================================================================== */
+
+typedef union
+{
+    float    f;
+    uint32_t u;
+} math_bits_t;
+
+/**
+ * @brief 2^k as a float (k in -126 – 127).
+ */
+static float math_pow2(int32_t k)
+{
+    math_bits_t v = { .u = (uint32_t)(k + 127) << 23 };
+    return v.f;
+}
+
+/**
+ * @brief Unbiased exponent of a positive float (m in [2^e, 2^(e+1))).
+ */
+static int32_t math_exponent(float m)
+{
+    math_bits_t v = { .f = m };
+    return (int32_t)((v.u >> 23) & 0xFFU) - 127;
+}
+
+static int32_t math_angle_to_q31(float angle_rad)
+{
+    return (int32_t)(uint32_t)(int64_t)(angle_rad * MATH_Q31_PER_RAD);
+}
+
+/**
+ * @brief Phase and modulus of (x, y) through the hook, with exact scaling.
+ * @return false for the null vector (outputs not written)
+ */
+static bool math_phase(float x, float y, int32_t *phase, float *modulus)
+{
+    float ax = (x < 0.0f) ? -x : x;
+    float ay = (y < 0.0f) ? -y : y;
+    float m  = (ax > ay) ? ax : ay;
+
+    if (!(m > 0.0f))
+        return false;
+
+    int32_t e = math_exponent(m);
+    if (e < -125) e = -125;             // Denormals: resolution lost, still in range
+    if (e >  124) e =  124;
+
+    float scale = math_pow2(-e - 2);
+    int32_t mod_q31;
+
+    Math_HW_Phase((int32_t)(x * scale * MATH_Q31_ONE), (int32_t)(y * scale * MATH_Q31_ONE), phase, &mod_q31);
+
+    *modulus = (float)mod_q31 * MATH_ONE_PER_Q31 * math_pow2(e + 2);
+    return true;
+}
+
+/* ========================================================================== */
+/* === Interface Implementation ============================================ */
+/* ========================================================================== */
+
+static void math_sin_cos(float angle_rad, float *sin_out, float *cos_out)
+{
+    int32_t a = math_angle_to_q31(angle_rad);
+    int32_t c, s;
+
+    Math_HW_CosSin(&a, &c, &s, 1U);
+
+    *sin_out = (float)s * MATH_ONE_PER_Q31;
+    *cos_out = (float)c * MATH_ONE_PER_Q31;
+}
+
+static void math_sin_cos_n(const float *angle_rad, float *sin_out, float *cos_out, uint32_t n)
+{
+    int32_t a[MATH_BATCH_MAX], c[MATH_BATCH_MAX], s[MATH_BATCH_MAX];
+
+    while (n > 0U)
+    {
+        uint32_t chunk = (n < MATH_BATCH_MAX) ? n : MATH_BATCH_MAX;
+
+        for (uint32_t k = 0; k < chunk; k++)
+            a[k] = math_angle_to_q31(angle_rad[k]);
+
+        Math_HW_CosSin(a, c, s, chunk);
+
+        for (uint32_t k = 0; k < chunk; k++)
+        {
+            sin_out[k] = (float)s[k] * MATH_ONE_PER_Q31;
+            cos_out[k] = (float)c[k] * MATH_ONE_PER_Q31;
+        }
+
+        angle_rad += chunk;
+        sin_out   += chunk;
+        cos_out   += chunk;
+        n         -= chunk;
+    }
+}
+
+static float math_atan2(float y, float x)
+{
+    int32_t phase;
+    float modulus;
+
+    if (!math_phase(x, y, &phase, &modulus))
+        return 0.0f;
+
+    return (float)phase * MATH_RAD_PER_Q31;
+}
+
+static float math_magnitude(float x, float y)
+{
+    int32_t phase;
+    float modulus;
+
+    if (!math_phase(x, y, &phase, &modulus))
+        return 0.0f;
+
+    return modulus;
+}
+
+/* ========================================================================== */
+/* === Global Interface Binding =========================================== */
+/* ========================================================================== */
+
+static i_math_t s_math_iface = {
+    .sin_cos   = math_sin_cos,
+    .sin_cos_n = math_sin_cos_n,
+    .atan2     = math_atan2,
+    .magnitude = math_magnitude,
+};
+
+/** Global pointer to the math interface */
+i_math_t* IMath = &s_math_iface;
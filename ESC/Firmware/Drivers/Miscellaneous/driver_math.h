@@ -0,0 +1,55 @@
+/**
+ * @file driver_math.h
+ * @brief Hardware hooks of the math front end (driver_math.c).
+ *
+ * The front end converts floats to the CORDIC fixed-point formats and back
+ * and binds IMath (i_math.h); it has no hardware dependency. The fixed-point
+ * functions below are implemented by:
+ *   - driver_math_cordic.c on target (CORDIC coprocessor),
+ *   - sim_cordic.c in the host simulation (software model, same iterations).
+ *
+ * Formats (q1.31, as the CORDIC 32-bit mode):
+ *  - angles: value / 2^31 · π rad, i.e. the full int32 range is one turn
+ *    and angle arithmetic wraps naturally;
+ *  - coordinates, sine, cosine, modulus: value / 2^31.
+ */
+
+#ifndef DRIVER_MATH_H
+#define DRIVER_MATH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/** CORDIC precision setting: 4 iterations per step, 24 iterations (q1.31 accuracy ≈ 2^-22) */
+#define MATH_CORDIC_PRECISION   6U
+
+/** Angles converted per hook call by the batch front end */
+#define MATH_BATCH_MAX          8U
+
+/* ========================================================================== */
+/* === Hooks implemented by the hardware layer ============================= */
+/* ========================================================================== */
+
+/**
+ * @brief Cosine and sine of @p n angles (q1.31), pipelined.
+ *
+ * Atomic against interrupts (the coprocessor is shared by all contexts).
+ */
+void Math_HW_CosSin(const int32_t *angle, int32_t *cos_out, int32_t *sin_out, uint32_t n);
+
+/**
+ * @brief Phase and modulus of the vector (x, y) (q1.31).
+ *
+ * The modulus must stay below 1 (|x|, |y| < 0.5 guarantees it); the phase
+ * of the null vector is 0.
+ */
+void Math_HW_Phase(int32_t x, int32_t y, int32_t *phase, int32_t *modulus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRIVER_MATH_H */
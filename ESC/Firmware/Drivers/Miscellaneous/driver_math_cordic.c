@@ -0,0 +1,87 @@
+/**
+ * @file driver_math_cordic.c
+ * @brief CORDIC coprocessor layer of the math front end (driver_math.h).
+ *
+ * The coprocessor runs in zero-overhead mode: arguments are written to
+ * WDATA and results read from RDATA, the read stalling the bus until the
+ * calculation is done (no polling, no interrupt). 32-bit arguments and
+ * results (q1.31), two arguments and two results per calculation:
+ *  - cosine:  ARG1 = angle, ARG2 = modulus 1 → RES1 = cos, RES2 = sin
+ *  - phase:   ARG1 = x,     ARG2 = y         → RES1 = phase, RES2 = modulus
+ *
+ * ARG2 is always written: the coprocessor keeps the last ARG2 otherwise,
+ * and a phase calculation in between would leave y as the cosine modulus.
+ *
+ * Batches are pipelined: the arguments of the next angle are written before
+ * the results of the current one are read, so the next calculation starts
+ * as soon as the registers are free.
+ *
+ * The function setup (CSR) is written with every call and each call runs
+ * with interrupts masked, so the fast loop may preempt a slow-loop user.
+ *
+ * **Target hardware:** CORDIC (STM32G473CCTx), clock enabled by
+ * MX_CORDIC_Init()
+ */
+
+#include "driver_math.h"
+#include "bsp_utils.h"
+
+/* ========================================================================== */
+/* === Configuration Macros ================================================ */
+/* ========================================================================== */
+
+#define CORDIC_FUNC_COSINE      0U
+#define CORDIC_FUNC_PHASE       2U
+
+#define CORDIC_MODULUS_ONE      0x7FFFFFFF      /**< q1.31 maximum */
+
+/** CSR: 24 iterations, no scaling, 2 × 32-bit arguments and results */
+#define CORDIC_CSR(func)        (((func) << CORDIC_CSR_FUNC_Pos)                        \
+                                 | (MATH_CORDIC_PRECISION << CORDIC_CSR_PRECISION_Pos)  \
+                                 | CORDIC_CSR_NARGS | CORDIC_CSR_NRES)
+
+/* ========================================================================== */
+/* === Hook Implementation ================================================= */
+/* ========================================================================== */
+
+void Math_HW_CosSin(const int32_t *angle, int32_t *cos_out, int32_t *sin_out, uint32_t n)
+{
+    if (n == 0U)
+        return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    CORDIC->CSR   = CORDIC_CSR(CORDIC_FUNC_COSINE);
+    CORDIC->WDATA = (uint32_t)angle[0];
+    CORDIC->WDATA = (uint32_t)CORDIC_MODULUS_ONE;
+
+    for (uint32_t k = 0; k < n; k++)
+    {
+        if (k + 1U < n)
+        {
+            CORDIC->WDATA = (uint32_t)angle[k + 1U];
+            CORDIC->WDATA = (uint32_t)CORDIC_MODULUS_ONE;
+        }
+
+        cos_out[k] = (int32_t)CORDIC->RDATA;
+        sin_out[k] = (int32_t)CORDIC->RDATA;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+void Math_HW_Phase(int32_t x, int32_t y, int32_t *phase, int32_t *modulus)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    CORDIC->CSR   = CORDIC_CSR(CORDIC_FUNC_PHASE);
+    CORDIC->WDATA = (uint32_t)x;
+    CORDIC->WDATA = (uint32_t)y;
+
+    *phase   = (int32_t)CORDIC->RDATA;
+    *modulus = (int32_t)CORDIC->RDATA;
+
+    __set_PRIMASK(primask);
+}
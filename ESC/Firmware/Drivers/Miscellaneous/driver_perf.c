@@ -0,0 +1,108 @@
+/**
+ * @file driver_perf.c
+ * @brief Execution-time probe storage implementing i_perf_t.
+ *
+ * Durations are measured by the callers with ITime->get_cycles() (or
+ * DWT->CYCCNT directly inside drivers) and accumulated here. The module
+ * has no hardware dependency, so the host simulation links it unchanged.
+ *
+ * Statistics are updated from ISRs of different priorities; each probe is
+ * only written by its own ISR, readers may see a torn snapshot while the
+ * probe is being updated (acceptable for diagnostics).
+ */
+
+#include "i_perf.h"
+#include <string.h>
+
+/* ========================================================================== */
+/* === Private Data ======================================================== */
+/* ========================================================================== */
+
+static perf_probe_stats_t s_probes[PERF_PROBE_COUNT];
+
+/* ========================================================================== */
+/* === Helpers ============================================================= */
+/* ========================================================================== */
+
+/**
+ * @brief log2 histogram bin of a duration.
+ */
+static uint32_t perf_bin(uint32_t cycles)
+{
+    uint32_t bin = 31U - (uint32_t)__builtin_clz(cycles | 1U);
+    return (bin < PERF_HIST_BINS) ? bin : (PERF_HIST_BINS - 1U);
+}
+
+static void perf_clear(perf_probe_stats_t *p)
+{
+    uint32_t budget = p->budget_cycles;
+
+    memset(p, 0, sizeof(*p));
+    p->min_cycles    = UINT32_MAX;
+    p->budget_cycles = budget;
+}
+
+/* ========================================================================== */
+/* === Interface Implementation ============================================ */
+/* ========================================================================== */
+
+static void perf_record(perf_probe_id_t id, uint32_t cycles)
+{
+    if ((uint32_t)id >= PERF_PROBE_COUNT)
+        return;
+
+    perf_probe_stats_t *p = &s_probes[id];
+
+    if (p->count == 0U)
+        p->min_cycles = UINT32_MAX;         // Zero-initialised before first reset
+
+    p->count++;
+    p->last_cycles = cycles;
+    p->sum_cycles += cycles;
+
+    if (cycles < p->min_cycles) p->min_cycles = cycles;
+    if (cycles > p->max_cycles) p->max_cycles = cycles;
+
+    if (p->budget_cycles != 0U && cycles > p->budget_cycles)
+        p->overruns++;
+
+    p->hist[perf_bin(cycles)]++;
+}
+
+static void perf_set_budget(perf_probe_id_t id, uint32_t cycles)
+{
+    if ((uint32_t)id < PERF_PROBE_COUNT)
+        s_probes[id].budget_cycles = cycles;
+}
+
+static bool perf_get_stats(perf_probe_id_t id, perf_probe_stats_t *out)
+{
+    if ((uint32_t)id >= PERF_PROBE_COUNT || out == NULL)
+        return false;
+
+    *out = s_probes[id];
+    if (out->count == 0U)
+        out->min_cycles = 0U;
+
+    return true;
+}
+
+static void perf_reset(void)
+{
+    for (uint32_t i = 0; i < PERF_PROBE_COUNT; i++)
+        perf_clear(&s_probes[i]);
+}
+
+/* ========================================================================== */
+/* === Global Interface Binding =========================================== */
+/* ========================================================================== */
+
+static i_perf_t s_perf_iface = {
+    .record     = perf_record,
+    .set_budget = perf_set_budget,
+    .get_stats  = perf_get_stats,
+    .reset      = perf_reset,
+};
+
+/** Global pointer to the profiling interface */
+i_perf_t* IPerf = &s_perf_iface;
@@ -95,6 +95,15 @@ static uint32_t time_get_us(void)
     return __HAL_TIM_GET_COUNTER(&htim2);
 }
 
+/**
+ * @brief Get the CPU cycle counter (DWT->CYCCNT).
+ * @return Cycles since DWT_Init(), 32-bit wrap (~28.6 s @ 150 MHz)
+ */
+static uint32_t time_get_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
 /* -------------------------------------------------------------------------- */
 /*                   Global time driver interface instance                    */
 /* -------------------------------------------------------------------------- */
@@ -111,7 +120,8 @@ i_time_t driver_time = {
     .delay_ms           = HAL_Delay_ms,
     .getSystemFrequency = GetSystemFrequency,
     .delay_us           = DWT_delay_us,
-    .get_time_us        = time_get_us
+    .get_time_us        = time_get_us,
+    .get_cycles         = time_get_cycles
 };
 
 /** Global pointer to the time driver instance */
@@ -0,0 +1,325 @@
+/**
+ * @file driver_timer_sched.c
+ * @brief Multi-event timer scheduler implementing i_timer_sched_t.
+ *
+ * Every event source of timer_event_id_t owns at most one pending deadline.
+ * Pending events are split between:
+ *   - the TIMER_SCHED_HW_CHANNELS compare channels of the counter, which
+ *     always hold the earliest deadlines;
+ *   - a software queue sorted by deadline for the remaining ones.
+ *
+ * When a compare channel fires, its event is released and the head of the
+ * queue (next earliest deadline) is loaded into the freed channel: dispatch
+ * is O(1) in the ISR. Arming an event is O(n) with n ≤ TIMER_EVENT_COUNT.
+ * If a new deadline is earlier than every channel deadline, the latest
+ * channel event is moved back to the queue.
+ *
+ * Deadlines are compared as signed differences, so the counter may wrap as
+ * long as every pending deadline lies less than 2^31 ticks from now.
+ *
+ * The channel holding TIMER_SCHED_TRIGGER_EVENT also pulses the counter
+ * trigger output at its deadline (hardware-timed commutation).
+ *
+ * The module has no hardware dependency (see driver_timer_sched.h): the
+ * host simulation links it unchanged on top of a virtual TIM5.
+ */
+
+#include "i_timer_sched.h"
+#include "i_perf.h"
+#include "i_time.h"
+#include "driver_timer_sched.h"
+#include <string.h>
+
+/* ========================================================================== */
+/* === Private Types & Data ================================================ */
+/* ========================================================================== */
+
+#define TIMER_SCHED_NONE   0xFFU   /**< No event / no channel */
+
+/**
+ * @brief Runtime state of one event source.
+ */
+typedef struct
+{
+    timer_event_callback_t callback;    /**< Function executed at the deadline */
+    void                  *context;     /**< User context passed to callback */
+    uint32_t               deadline;    /**< Absolute counter value */
+    bool                   active;      /**< Deadline pending */
+    uint8_t                channel;     /**< Compare channel, or TIMER_SCHED_NONE if queued */
+    uint8_t                next;        /**< Next queued event (sorted by deadline) */
+} timer_event_t;
+
+static timer_event_t s_events[TIMER_EVENT_COUNT];
+static uint8_t       s_channel_owner[TIMER_SCHED_HW_CHANNELS];
+static uint8_t       s_queue_head = TIMER_SCHED_NONE;
+
+/* ========================================================================== */
+/* === Helpers (called with the compare interrupt masked) ================== */
+/* ========================================================================== */
+
+/**
+ * @brief true if deadline @p a comes before @p b (wrap-safe).
+ */
+static inline bool sched_before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+static void sched_queue_insert(uint8_t id)
+{
+    uint8_t *link = &s_queue_head;
+
+    /* Equal deadlines keep their arming order */
+    while (*link != TIMER_SCHED_NONE &&
+           !sched_before(s_events[id].deadline, s_events[*link].deadline))
+    {
+        link = &s_events[*link].next;
+    }
+
+    s_events[id].next = *link;
+    *link = id;
+}
+
+static void sched_queue_remove(uint8_t id)
+{
+    uint8_t *link = &s_queue_head;
+
+    while (*link != TIMER_SCHED_NONE && *link != id)
+        link = &s_events[*link].next;
+
+    if (*link == id)
+        *link = s_events[id].next;
+
+    s_events[id].next = TIMER_SCHED_NONE;
+}
+
+static void sched_bind(uint8_t id, uint8_t ch)
+{
+    s_channel_owner[ch]   = id;
+    s_events[id].channel  = ch;
+    TimerSched_HW_SetCompare(ch, s_events[id].deadline, id == TIMER_SCHED_TRIGGER_EVENT);
+}
+
+/**
+ * @brief Place an active event in a free channel, the latest channel or the queue.
+ */
+static void sched_insert(uint8_t id)
+{
+    uint8_t latest = 0U;
+
+    for (uint8_t ch = 0; ch < TIMER_SCHED_HW_CHANNELS; ch++)
+    {
+        if (s_channel_owner[ch] == TIMER_SCHED_NONE)
+        {
+            sched_bind(id, ch);
+            return;
+        }
+
+        if (sched_before(s_events[s_channel_owner[latest]].deadline,
+                         s_events[s_channel_owner[ch]].deadline))
+        {
+            latest = ch;
+        }
+    }
+
+    uint8_t victim = s_channel_owner[latest];
+
+    if (sched_before(s_events[id].deadline, s_events[victim].deadline))
+    {
+        /* Channels must hold the earliest deadlines: swap with the latest */
+        s_events[victim].channel = TIMER_SCHED_NONE;
+        sched_queue_insert(victim);
+        sched_bind(id, latest);
+    }
+    else
+    {
+        s_events[id].channel = TIMER_SCHED_NONE;
+        sched_queue_insert(id);
+    }
+}
+
+/**
+ * @brief Remove an active event; a freed channel takes the queue head.
+ */
+static void sched_remove(uint8_t id)
+{
+    timer_event_t *ev = &s_events[id];
+    uint8_t ch = ev->channel;
+
+    if (ch != TIMER_SCHED_NONE)
+    {
+        s_channel_owner[ch] = TIMER_SCHED_NONE;
+        ev->channel = TIMER_SCHED_NONE;
+
+        if (s_queue_head != TIMER_SCHED_NONE)
+        {
+            uint8_t head = s_queue_head;
+            s_queue_head = s_events[head].next;
+            s_events[head].next = TIMER_SCHED_NONE;
+            sched_bind(head, ch);
+        }
+        else
+        {
+            TimerSched_HW_DisableCompare(ch);
+        }
+    }
+    else
+    {
+        sched_queue_remove(id);
+    }
+
+    ev->active = false;
+}
+
+/* ========================================================================== */
+/* === Interface Implementation =========================================== */
+/* ========================================================================== */
+
+static bool drv_sched_init(void)
+{
+    memset(s_events, 0, sizeof(s_events));
+
+    for (uint8_t id = 0; id < TIMER_EVENT_COUNT; id++)
+    {
+        s_events[id].channel = TIMER_SCHED_NONE;
+        s_events[id].next    = TIMER_SCHED_NONE;
+    }
+
+    for (uint8_t ch = 0; ch < TIMER_SCHED_HW_CHANNELS; ch++)
+        s_channel_owner[ch] = TIMER_SCHED_NONE;
+
+    s_queue_head = TIMER_SCHED_NONE;
+
+    return TimerSched_HW_Init();
+}
+
+static uint32_t drv_sched_now(void)
+{
+    return TimerSched_HW_Now();
+}
+
+static uint32_t drv_sched_get_tick_hz(void)
+{
+    return TimerSched_HW_TickHz();
+}
+
+static bool drv_sched_start_at(timer_event_id_t id, uint32_t deadline, timer_event_callback_t cb, void *ctx)
+{
+    if ((uint32_t)id >= TIMER_EVENT_COUNT || cb == NULL)
+        return false;
+
+    uint32_t lock = TimerSched_HW_Lock();
+
+    timer_event_t *ev = &s_events[id];
+
+    if (ev->active)
+        sched_remove((uint8_t)id);
+
+    ev->callback = cb;
+    ev->context  = ctx;
+    ev->deadline = deadline;
+    ev->active   = true;
+
+    sched_insert((uint8_t)id);
+
+    TimerSched_HW_Unlock(lock);
+    return true;
+}
+
+static bool drv_sched_start(timer_event_id_t id, uint32_t delay_ticks, timer_event_callback_t cb, void *ctx)
+{
+    return drv_sched_start_at(id, TimerSched_HW_Now() + delay_ticks, cb, ctx);
+}
+
+static void drv_sched_cancel(timer_event_id_t id)
+{
+    if ((uint32_t)id >= TIMER_EVENT_COUNT)
+        return;
+
+    uint32_t lock = TimerSched_HW_Lock();
+
+    if (s_events[id].active)
+        sched_remove((uint8_t)id);
+
+    s_events[id].callback = NULL;
+    s_events[id].context  = NULL;
+
+    TimerSched_HW_Unlock(lock);
+}
+
+static bool drv_sched_is_active(timer_event_id_t id)
+{
+    return ((uint32_t)id < TIMER_EVENT_COUNT) && s_events[id].active;
+}
+
+/* ========================================================================== */
+/* === ISR Entry Point (Called by the hardware layer) ====================== */
+/* ========================================================================== */
+
+/**
+ * @brief Release the event of compare channel @p ch and run its callback.
+ *
+ * The channel is refilled before the callback so that the callback may
+ * re-arm its own event or any other one.
+ *
+ * @note Executes in ISR context at the compare interrupt priority.
+ */
+void TimerSched_OnCompare(uint8_t ch)
+{
+    if (ch >= TIMER_SCHED_HW_CHANNELS)
+        return;
+
+    uint8_t id = s_channel_owner[ch];
+
+    if (id == TIMER_SCHED_NONE)
+    {
+        TimerSched_HW_DisableCompare(ch);
+        return;
+    }
+
+    timer_event_t *ev = &s_events[id];
+
+    /* Stale flag of a previous deadline: the channel is already re-armed */
+    if (sched_before(TimerSched_HW_Now(), ev->deadline))
+        return;
+
+    timer_event_callback_t user_cb = ev->callback;
+    void *user_ctx                 = ev->context;
+
+    sched_remove(id);
+    ev->callback = NULL;
+    ev->context  = NULL;
+
+    /* Execute user callback (ISR context), profiled in CPU cycles */
+    if (user_cb)
+    {
+        uint32_t t0 = ITime->get_cycles();
+        user_cb(user_ctx);
+        IPerf->record(PERF_PROBE_ONESHOT, ITime->get_cycles() - t0);
+    }
+}
+
+/* ========================================================================== */
+/* === Global Interface Binding =========================================== */
+/* ========================================================================== */
+
+static const i_timer_sched_t s_timer_sched_iface = {
+    .init        = drv_sched_init,
+    .now         = drv_sched_now,
+    .get_tick_hz = drv_sched_get_tick_hz,
+    .start_at    = drv_sched_start_at,
+    .start       = drv_sched_start,
+    .cancel      = drv_sched_cancel,
+    .is_active   = drv_sched_is_active,
+};
+
+/**
+ * @brief Global timer scheduler instance.
+ *
+ * Example usage:
+ * @code
+ *     ITimerSched->init();
+ *     ITimerSched->start(TIMER_EVENT_TIMEOUT, ITimerSched->get_tick_hz() / 2U, OnTimeout, NULL);
+ * @endcode
+ */
+i_timer_sched_t *ITimerSched = (i_timer_sched_t *)&s_timer_sched_iface;
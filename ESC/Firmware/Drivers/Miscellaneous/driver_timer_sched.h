@@ -0,0 +1,81 @@
+/**
+ * @file driver_timer_sched.h
+ * @brief Hardware hooks of the timer scheduler (driver_timer_sched.c).
+ *
+ * The scheduler logic (event table, channel allocation, sorted overflow
+ * queue) has no hardware dependency. It drives a free-running 32-bit
+ * counter with TIMER_SCHED_HW_CHANNELS compare channels through the hooks
+ * below, implemented by:
+ *   - driver_timer_sched_tim5.c on target (TIM5 CC2..CC4),
+ *   - sim_timer_sched.c in the host simulation (virtual TIM5).
+ */
+
+#ifndef DRIVER_TIMER_SCHED_H
+#define DRIVER_TIMER_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Number of hardware compare channels (TIM5 CH2..CH4, CH1 captures the BEMF comparator) */
+#define TIMER_SCHED_HW_CHANNELS   3U
+
+/**
+ * Event whose compare match also drives the counter trigger output
+ * (TIM5 TRGO → TIM1 COM: hardware-timed commutation, see i_inverter.h).
+ */
+#define TIMER_SCHED_TRIGGER_EVENT TIMER_EVENT_COMMUTATION
+
+/* ========================================================================== */
+/* === Hooks implemented by the hardware layer ============================= */
+/* ========================================================================== */
+
+/**
+ * @brief Start the free-running counter, all compare channels disabled.
+ */
+bool TimerSched_HW_Init(void);
+
+/** Current counter value. */
+uint32_t TimerSched_HW_Now(void);
+
+/** Counter frequency in Hz. */
+uint32_t TimerSched_HW_TickHz(void);
+
+/**
+ * @brief Arm compare channel @p ch at @p deadline.
+ *
+ * If the deadline is not in the future any more when the channel is armed,
+ * the compare event must be raised immediately (never one wrap later).
+ *
+ * With @p trigger, the match also produces a rising edge on the trigger
+ * output at the deadline (at once if already due). Only one channel at a
+ * time is armed with @p trigger.
+ */
+void TimerSched_HW_SetCompare(uint8_t ch, uint32_t deadline, bool trigger);
+
+/** Disable compare channel @p ch (and its trigger output) and clear its pending flag. */
+void TimerSched_HW_DisableCompare(uint8_t ch);
+
+/** Enter a critical section against the compare interrupt; returns the state for TimerSched_HW_Unlock(). */
+uint32_t TimerSched_HW_Lock(void);
+
+/** Restore the state saved by TimerSched_HW_Lock(). */
+void TimerSched_HW_Unlock(uint32_t state);
+
+/* ========================================================================== */
+/* === Entry point called by the hardware layer ============================ */
+/* ========================================================================== */
+
+/**
+ * @brief Compare match on channel @p ch (ISR context).
+ */
+void TimerSched_OnCompare(uint8_t ch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRIVER_TIMER_SCHED_H */
@@ -0,0 +1,213 @@
+/**
+ * @file driver_timer_sched_tim5.c
+ * @brief TIM5 hardware layer of the timer scheduler (driver_timer_sched.h).
+ *
+ * TIM5 is reconfigured at init as a free-running 32-bit up-counter clocked
+ * at the full timer clock (PSC = 0 → 150 MHz, 6.67 ns/tick, wraps every
+ * 28.6 s). Channels 2..4 are used in output-compare mode without pin: each
+ * CCxIF raises the TIM5 interrupt, dispatched by
+ * HAL_TIM_OC_DelayElapsedCallback() in timers_callbacks.c. Channel 1 is left
+ * to the BEMF comparator capture (driver_bemf_comp.c), which shares the
+ * counter so that zero-cross timestamps are scheduler ticks.
+ *
+ * A deadline that is already due when its channel is armed is raised with
+ * a software compare event (EGR.CCxG) instead of waiting a full wrap.
+ *
+ * Trigger channel: the channel holding the commutation event runs in
+ * "active on match" mode and TRGO (MMS) follows its OCxREF, so TRGO rises
+ * exactly at the deadline and fires the TIM1 COM event (driver_invertor.c).
+ * The other channels keep OCxREF forced inactive.
+ *
+ * **Target hardware:** TIM5 (32-bit timer on STM32G473CCTx)
+ */
+
+#include "driver_timer_sched.h"
+#include "timers_callbacks.h"
+#include "bsp_utils.h"
+#include "tim.h"     // CubeMX-generated HAL handles (htimX)
+
+/* ========================================================================== */
+/* === Configuration Macros ================================================ */
+/* ========================================================================== */
+
+/**
+ * @brief Hardware timer used by the scheduler (must be a 32-bit timer
+ *        with four compare channels: TIM2 or TIM5).
+ */
+#define TIMER_SCHED_TIMER_HANDLE     (&htim5)
+#define TIMER_SCHED_TIMER_INSTANCE   TIM5
+
+/* ========================================================================== */
+/* === Channel Tables ====================================================== */
+/* ========================================================================== */
+
+/* Scheduler channel ch = TIM5 channel ch + 2 */
+static const uint32_t s_cc_channel[TIMER_SCHED_HW_CHANNELS] = {
+    TIM_CHANNEL_2, TIM_CHANNEL_3, TIM_CHANNEL_4
+};
+
+static const uint32_t s_cc_it[TIMER_SCHED_HW_CHANNELS] = {
+    TIM_IT_CC2, TIM_IT_CC3, TIM_IT_CC4
+};
+
+static const uint32_t s_cc_flag[TIMER_SCHED_HW_CHANNELS] = {
+    TIM_FLAG_CC2, TIM_FLAG_CC3, TIM_FLAG_CC4
+};
+
+static const uint32_t s_cc_egr[TIMER_SCHED_HW_CHANNELS] = {
+    TIM_EGR_CC2G, TIM_EGR_CC3G, TIM_EGR_CC4G
+};
+
+static const uint32_t s_cc_trgo[TIMER_SCHED_HW_CHANNELS] = {
+    TIM_TRGO_OC2REF, TIM_TRGO_OC3REF, TIM_TRGO_OC4REF
+};
+
+/**
+ * @brief Set the output compare mode (OCxM) of scheduler channel @p ch.
+ *
+ * @param mode TIM_OCMODE_x value of channel 1/3 layout (shifted for 2/4).
+ */
+static void sched_hw_set_ocmode(uint8_t ch, uint32_t mode)
+{
+    TIM_TypeDef *tim = TIMER_SCHED_TIMER_INSTANCE;
+    uint8_t tim_ch = ch + 1U;                           // 0-based TIM5 channel
+    volatile uint32_t *ccmr = (tim_ch < 2U) ? &tim->CCMR1 : &tim->CCMR2;
+    uint32_t shift = (tim_ch & 1U) ? 8U : 0U;
+
+    MODIFY_REG(*ccmr, TIM_CCMR1_OC1M << shift, mode << shift);
+}
+
+/* ========================================================================== */
+/* === Hardware Hooks ====================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief Switch TIM5 from its CubeMX one-pulse setup to a free-running counter.
+ *
+ * @retval true  Counter running.
+ * @retval false Timer callbacks dispatcher unavailable.
+ */
+bool TimerSched_HW_Init(void)
+{
+    TIM_TypeDef *tim = TIMER_SCHED_TIMER_INSTANCE;
+
+    /* Ensure timer callbacks dispatcher is initialized */
+    if (!Timer_Callbacks_IsInitialized())
+    {
+        if (!Timer_callbacks_Init())
+        {
+            return false;
+        }
+    }
+
+    __HAL_TIM_DISABLE(TIMER_SCHED_TIMER_HANDLE);
+
+    tim->DIER  = 0U;                    // No update / compare interrupts yet
+    tim->CR1  &= ~TIM_CR1_OPM;          // Free-running
+    MODIFY_REG(tim->CCMR1, 0xFF00U,     // OC2REF low (CH1 left to the BEMF capture)
+               TIM_OCMODE_FORCED_INACTIVE << 8U);
+    tim->CCMR2 = (TIM_OCMODE_FORCED_INACTIVE << 0U) |   // OC3REF/OC4REF low
+                 (TIM_OCMODE_FORCED_INACTIVE << 8U);
+    CLEAR_BIT(tim->CCER, TIM_CCER_CC2E | TIM_CCER_CC3E | TIM_CCER_CC4E);  // No output pins
+    MODIFY_REG(tim->CR2, TIM_CR2_MMS, TIM_TRGO_OC2REF); // TRGO low
+    tim->PSC   = 0U;                    // Full timer clock
+    tim->ARR   = 0xFFFFFFFFU;           // Full 32-bit range
+    tim->EGR   = TIM_EGR_UG;            // Load PSC
+    tim->SR    = 0U;
+    tim->CNT   = 0U;
+
+    __HAL_TIM_ENABLE(TIMER_SCHED_TIMER_HANDLE);
+    return true;
+}
+
+uint32_t TimerSched_HW_Now(void)
+{
+    return TIMER_SCHED_TIMER_INSTANCE->CNT;
+}
+
+/**
+ * @brief TIM5 clock = PCLK1 (APB1 prescaler = 1), PSC = 0.
+ */
+uint32_t TimerSched_HW_TickHz(void)
+{
+    return HAL_RCC_GetPCLK1Freq();
+}
+
+void TimerSched_HW_SetCompare(uint8_t ch, uint32_t deadline, bool trigger)
+{
+    TIM_HandleTypeDef *hw = TIMER_SCHED_TIMER_HANDLE;
+
+    __HAL_TIM_DISABLE_IT(hw, s_cc_it[ch]);
+    __HAL_TIM_CLEAR_FLAG(hw, s_cc_flag[ch]);
+
+    /* OCxREF low before TRGO is routed to it: no spurious rising edge */
+    sched_hw_set_ocmode(ch, TIM_OCMODE_FORCED_INACTIVE);
+    if (trigger)
+        MODIFY_REG(hw->Instance->CR2, TIM_CR2_MMS, s_cc_trgo[ch]);
+
+    __HAL_TIM_SET_COMPARE(hw, s_cc_channel[ch], deadline);
+
+    if (trigger)
+        sched_hw_set_ocmode(ch, TIM_OCMODE_ACTIVE);
+
+    __HAL_TIM_ENABLE_IT(hw, s_cc_it[ch]);
+
+    /* Already due (or reached while writing CCRx): raise the event now */
+    if ((int32_t)(deadline - hw->Instance->CNT) <= 0)
+    {
+        hw->Instance->EGR = s_cc_egr[ch];
+        if (trigger)
+            sched_hw_set_ocmode(ch, TIM_OCMODE_FORCED_ACTIVE);
+    }
+}
+
+void TimerSched_HW_DisableCompare(uint8_t ch)
+{
+    TIM_HandleTypeDef *hw = TIMER_SCHED_TIMER_HANDLE;
+
+    __HAL_TIM_DISABLE_IT(hw, s_cc_it[ch]);
+    __HAL_TIM_CLEAR_FLAG(hw, s_cc_flag[ch]);
+    sched_hw_set_ocmode(ch, TIM_OCMODE_FORCED_INACTIVE);
+}
+
+/**
+ * @brief Short critical section (a few list operations) with PRIMASK.
+ */
+uint32_t TimerSched_HW_Lock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+void TimerSched_HW_Unlock(uint32_t state)
+{
+    __set_PRIMASK(state);
+}
+
+/* ========================================================================== */
+/* === ISR Entry Point (Called by Dispatcher) ============================== */
+/* ========================================================================== */
+
+/**
+ * @brief ISR entry point called by the global timer dispatcher on a
+ *        compare match of TIM5.
+ *
+ * HAL_TIM_IRQHandler() clears CCxIF and calls the dispatcher once per
+ * flagged channel, CC2 first (CC1 is the polled BEMF capture, no interrupt).
+ *
+ * @param htim Pointer to the HAL timer handle that generated the interrupt.
+ */
+void Driver_TimerSched_OnCompare(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance != TIMER_SCHED_TIMER_INSTANCE)
+        return;
+
+    switch (htim->Channel)
+    {
+        case HAL_TIM_ACTIVE_CHANNEL_2: TimerSched_OnCompare(0U); break;
+        case HAL_TIM_ACTIVE_CHANNEL_3: TimerSched_OnCompare(1U); break;
+        case HAL_TIM_ACTIVE_CHANNEL_4: TimerSched_OnCompare(2U); break;
+        default: break;
+    }
+}
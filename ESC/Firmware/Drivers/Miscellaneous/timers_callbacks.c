@@ -4,10 +4,11 @@
  *
  * This module centralizes all STM32 HAL timer callbacks used in the firmware.
  * It prevents conflicts caused by multiple `HAL_TIM_PeriodElapsedCallback()`
- * definitions across different driver modules.
+ * or `HAL_TIM_OC_DelayElapsedCallback()` definitions across different
+ * driver modules.
  *
  * Each timer-related driver implements an internal entry function (e.g.,
- * Driver_OneShot_OnTimerExpired, Driver_FastLoop_OnTimerElapsed, etc.),
+ * Driver_TimerSched_OnCompare, Driver_FastLoop_OnTimerElapsed, etc.),
  * which this dispatcher calls when the associated hardware timer triggers.
  *
  * This design provides a clean separation between:
@@ -17,7 +18,6 @@
  * Target MCU: STM32G473CCTx
  */
 
-#include "i_time_oneshot.h"   // For one-shot timer ISR redirection
 #include "timers_callbacks.h"
 #include "bsp_utils.h"
 #include <stdbool.h>
@@ -87,9 +87,6 @@ bool Timer_callbacks_Init(void)
  */
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
-    /* === Dispatch to One-Shot Timer Driver =============================== */
-    Driver_OneShot_OnTimerExpired(htim);
-
     /* === Dispatch to FastLoop Driver (future extension) ================== */
     Driver_FastLoop_OnTimerElapsed(htim);
 
@@ -101,3 +98,19 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     // Driver_PwmSync_OnTimerElapsed(htim);
     // Driver_Commutation_OnTimerElapsed(htim);
 }
+
+/**
+ * @brief Common dispatcher for all HAL output-compare match interrupts.
+ *
+ * Called by the STM32 HAL once per flagged compare channel, with
+ * `htim->Channel` set to the active channel.
+ *
+ * @param htim Pointer to the HAL timer handle that generated the interrupt.
+ *
+ * @note This function runs in **ISR context**.
+ */
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    /* === Dispatch to Timer Scheduler (TIM5 CC1..CC4) ===================== */
+    Driver_TimerSched_OnCompare(htim);
+}
@@ -5,7 +5,7 @@
  * This module groups all STM32 HAL timer callbacks into a single
  * implementation point, preventing callback duplication across drivers.
  *
- * Each timer-related driver (e.g., one-shot, fast-loop, PWM sync)
+ * Each timer-related driver (e.g., scheduler, fast-loop, PWM sync)
  * can expose its own internal handler which is then called from this
  * common dispatcher.
  *
@@ -18,6 +18,7 @@
 #ifndef TIMERS_CALLBACKS_H
 #define TIMERS_CALLBACKS_H
 
+#include <stdbool.h>
 #include "tim.h"  // Provides TIM_HandleTypeDef
 
 #ifdef __cplusplus
@@ -42,14 +43,15 @@ bool Timer_Callbacks_IsInitialized(void);
 bool Timer_callbacks_Init(void);
 
 /**
- * @brief ISR entry point for the one-shot timer driver (TIM5).
+ * @brief ISR entry point for the timer scheduler (TIM5 compare channels).
  *
- * This function is implemented in `driver_time_oneshot.c` and is responsible
- * for handling the expiration of a one-shot delay.
+ * This function is implemented in `driver_timer_sched_tim5.c` and is
+ * responsible for releasing the event whose deadline has been reached.
  *
- * @param htim Pointer to the HAL timer handle that triggered the interrupt.
+ * @param htim Pointer to the HAL timer handle that triggered the interrupt
+ *             (htim->Channel identifies the compare channel).
  */
-void Driver_OneShot_OnTimerExpired(TIM_HandleTypeDef *htim);
+void Driver_TimerSched_OnCompare(TIM_HandleTypeDef *htim);
 
 /**
  * @brief ISR entry point for the Fast Loop driver (e.g., TIM3).
@@ -0,0 +1,162 @@
+/**
+ * @file driver_bemf_comp.c
+ * @brief BEMF zero-cross capture with the on-chip comparators (i_bemf_comparator_t).
+ *
+ * Each phase divider drives the non-inverting input of one comparator, the
+ * inverting inputs share the resistor star point of the three dividers
+ * (virtual neutral). The comparator outputs are internally routed to TIM5
+ * TI1 (TISEL remap); TIM5 CH1 captures the selected edge of the floating
+ * phase, so the zero-cross is time-stamped on the scheduler counter
+ * (150 MHz, driver_timer_sched_tim5.c) with no interrupt and no CPU latency.
+ *
+ * Capture delay = comparator propagation (~50 ns) + input filter
+ * (BEMF_COMP_IC_FILTER: 8 timer clocks): a constant offset well below 0.1 µs.
+ *
+ * Registers are written directly (no HAL COMP module in the BSP). The
+ * COMPx_INP / INM pins are board routing and must be in analog mode.
+ *
+ * **Board revision required:** the pins below are the comparator inputs
+ * (INP0, INM1), not the ones the current board wires:
+ *
+ *   | Phase | Comparator | INP0 (divider) | INM1 (star point) |
+ *   |-------|------------|----------------|-------------------|
+ *   | A     | COMP1      | PA1            | PA4               |
+ *   | B     | COMP2      | PA7            | PA5               |
+ *   | C     | COMP3      | PA0            | PF1               |
+ *
+ * The current board has the dividers on PA2, PA5 and PB12 (ADC inputs,
+ * Phase_1..3_Pin), PA0 is the phase A current sense and PA4 the PCB
+ * temperature, and the star point is not brought out. Until a board routes
+ * the table above (BEMF_COMP_BOARD_ROUTED = 1), init() refuses and the
+ * six-step control keeps the ADC zero-cross detection.
+ *
+ * **Target hardware:** COMP1..COMP3 + TIM5 CH1 (STM32G473CCTx)
+ */
+
+#include "i_bemf_comparator.h"
+#include "bsp_utils.h"
+
+/* ========================================================================== */
+/* === Configuration Macros ================================================ */
+/* ========================================================================== */
+
+/** Board routes the phase dividers and the star point as in the header table */
+#ifndef BEMF_COMP_BOARD_ROUTED
+#define BEMF_COMP_BOARD_ROUTED     0
+#endif
+
+/** Capture timer (shared with the timer scheduler, which owns CH2..CH4) */
+#define BEMF_COMP_TIMER_INSTANCE   TIM5
+
+/** Inverting input: INM IO pin (resistor star point) */
+#define BEMF_COMP_INMSEL           (0x6UL << COMP_CSR_INMSEL_Pos)
+
+/** Comparator hysteresis: 20 mV (rejects switching noise near the crossing) */
+#define BEMF_COMP_HYST             (0x2UL << COMP_CSR_HYST_Pos)
+
+/** TIM5 CH1 input filter: fCK_INT, N = 8 */
+#define BEMF_COMP_IC_FILTER        (0x3UL << TIM_CCMR1_IC1F_Pos)
+
+#define BEMF_COMP_PHASE_COUNT      3U
+
+/* ========================================================================== */
+/* === Phase Table ========================================================= */
+/* ========================================================================== */
+
+/**
+ * @brief Comparator, INP selection and TIM5 TI1 remap of one phase.
+ */
+typedef struct {
+    COMP_TypeDef *comp;
+    uint32_t      inpsel;       /**< COMPx_CSR.INPSEL (0 = INP0 pin) */
+    uint32_t      ti1sel;       /**< TIM5_TISEL.TI1SEL = COMPx_OUT */
+} bemf_comp_phase_t;
+
+static const bemf_comp_phase_t s_phase[BEMF_COMP_PHASE_COUNT] = {
+    { COMP1, 0U, TIM_TISEL_TI1SEL_2 },                           // Phase A: PA1 / PA4
+    { COMP2, 0U, TIM_TISEL_TI1SEL_2 | TIM_TISEL_TI1SEL_0 },      // Phase B: PA7 / PA5
+    { COMP3, 0U, TIM_TISEL_TI1SEL_2 | TIM_TISEL_TI1SEL_1 },      // Phase C: PA0 / PF1
+};
+
+/* ========================================================================== */
+/* === Interface Implementation =========================================== */
+/* ========================================================================== */
+
+static bool bemf_comp_init(void)
+{
+    TIM_TypeDef *tim = BEMF_COMP_TIMER_INSTANCE;
+
+    /* Inputs not wired to the comparators: never enabled (PA0 is a current sense) */
+    if (!BEMF_COMP_BOARD_ROUTED)
+        return false;
+
+    __HAL_RCC_SYSCFG_CLK_ENABLE();      // COMP registers are clocked with SYSCFG
+
+    for (uint8_t ph = 0; ph < BEMF_COMP_PHASE_COUNT; ph++)
+    {
+        s_phase[ph].comp->CSR = BEMF_COMP_INMSEL | BEMF_COMP_HYST |
+                                (s_phase[ph].inpsel << COMP_CSR_INPSEL_Pos) | COMP_CSR_EN;
+    }
+
+    /* CH1: IC1 mapped on TI1, no prescaler; CH2 (scheduler) untouched */
+    CLEAR_BIT(tim->CCER, TIM_CCER_CC1E);
+    MODIFY_REG(tim->CCMR1, 0x00FFU, TIM_CCMR1_CC1S_0 | BEMF_COMP_IC_FILTER);
+    CLEAR_BIT(tim->DIER, TIM_DIER_CC1IE | TIM_DIER_CC1DE);
+    tim->SR = ~(TIM_SR_CC1IF | TIM_SR_CC1OF);
+
+    return true;
+}
+
+static bool bemf_comp_arm(uint8_t phase, bemf_comp_edge_t edge)
+{
+    TIM_TypeDef *tim = BEMF_COMP_TIMER_INSTANCE;
+
+    if (phase >= BEMF_COMP_PHASE_COUNT)
+        return false;
+
+    /* Switch the source with the capture disabled, then drop any stale flag */
+    CLEAR_BIT(tim->CCER, TIM_CCER_CC1E);
+    MODIFY_REG(tim->TISEL, TIM_TISEL_TI1SEL, s_phase[phase].ti1sel);
+    MODIFY_REG(tim->CCER, TIM_CCER_CC1P | TIM_CCER_CC1NP,
+               (edge == BEMF_COMP_EDGE_FALLING) ? TIM_CCER_CC1P : 0U);
+    tim->SR = ~(TIM_SR_CC1IF | TIM_SR_CC1OF);
+    SET_BIT(tim->CCER, TIM_CCER_CC1E);
+
+    return true;
+}
+
+static void bemf_comp_disarm(void)
+{
+    TIM_TypeDef *tim = BEMF_COMP_TIMER_INSTANCE;
+
+    CLEAR_BIT(tim->CCER, TIM_CCER_CC1E);
+    tim->SR = ~(TIM_SR_CC1IF | TIM_SR_CC1OF);
+}
+
+/**
+ * @brief Poll CC1IF; reading CCR1 clears it (CC1OF cleared as well).
+ */
+static bool bemf_comp_get_capture(uint32_t *ticks)
+{
+    TIM_TypeDef *tim = BEMF_COMP_TIMER_INSTANCE;
+
+    if (ticks == NULL || (tim->SR & TIM_SR_CC1IF) == 0U)
+        return false;
+
+    *ticks = tim->CCR1;
+    tim->SR = ~TIM_SR_CC1OF;
+    return true;
+}
+
+/* ========================================================================== */
+/* === Interface Registration ============================================== */
+/* ========================================================================== */
+
+static i_bemf_comparator_t s_bemf_comp_interface = {
+    .init        = bemf_comp_init,
+    .arm         = bemf_comp_arm,
+    .disarm      = bemf_comp_disarm,
+    .get_capture = bemf_comp_get_capture,
+};
+
+i_bemf_comparator_t* IBemfComparator = &s_bemf_comp_interface;
@@ -12,6 +12,9 @@
  */
 
 #include "sensors_callbacks.h"
+#include "i_perf.h"
+#include "i_timer_sched.h"
+#include "i_filter.h"
 #include "adc.h"
 #include "gpio.h"
 #include "tim.h"
@@ -67,6 +70,12 @@ bool SensorsCallbacks_Init(void)
 
     HAL_TIM_OC_Start(&htim1, TIM_CHANNEL_4);
 
+    // Update phase pinned by MX_TIM1_Init(): the first update must be the
+    // overflow, i.e. the counter is counting down when it is flagged
+    __HAL_TIM_CLEAR_FLAG(&htim1, TIM_FLAG_UPDATE);
+    while (!__HAL_TIM_GET_FLAG(&htim1, TIM_FLAG_UPDATE)) {}
+    if ((htim1.Instance->CR1 & TIM_CR1_DIR) == 0U) Error_Handler();
+
     // -------------------------------------------------------------------------
     // 3 Configure TIM6 TRGO to trigger regular ADC conversions via DMA
     // -------------------------------------------------------------------------
@@ -96,6 +105,9 @@ bool SensorsCallbacks_Init(void)
     
     if (HAL_ADCEx_InjectedStart_IT(&hadc2) != HAL_OK) Error_Handler();
 
+    // Bus voltage on the same TRGO (ADC4 injected, polled from the ADC1 JEOC)
+    if (HAL_ADCEx_InjectedStart(&hadc4) != HAL_OK) Error_Handler();
+
     // -------------------------------------------------------------------------
     // 6 Additional timers or slow-loop tasks can be started here
     // -------------------------------------------------------------------------
@@ -159,29 +171,19 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
 }
 
 /**
- * @brief IIR Low-Pass Filter (1st order)
- * @note Macro for zero-overhead inline expansion in ISR
- * @param filt Filter state variable (uint32_t, with alpha bits of fraction)
- * @param raw  New raw sample (uint16_t)
- * @param alpha Filter coefficient (cutoff frequency = fs / (2π × 2^alpha))
- * 
- * Filter equation: y[n] = y[n-1] - y[n-1]/2^alpha + x[n]
- * Equivalent to: y[n] = ((2^alpha - 1) / 2^alpha) * y[n-1] + (1 / 2^alpha) * x[n]
+ * @brief JEOC to phase-voltage sampling instant, in ITimerSched ticks (150 MHz).
+ * ADC clock 60 MHz: rank 1 = 12.5 + 12.5, ranks 2/3 = 92.5 + 12.5 cycles →
+ * JEOC at 235 cycles, voltages sampled around 106 cycles (mean of the
+ * rank 2/3 sampling windows) → 129 ADC cycles ≈ 322 ticks.
  */
-#define IIR_UPDATE(filt, raw, alpha) \
-    do { (filt) = (filt) - ((filt) >> (alpha)) + (raw); } while(0)
+#define ADC_INJ_JEOC_TO_VSAMPLE_TICKS 322U
 
 /**
- * @brief Extract filtered value from IIR state
- * @param filt Filter state variable
- * @param alpha Filter coefficient (same as in IIR_UPDATE)
- * @return Filtered value (uint16_t)
+ * @brief TIM1 CCR4 to end of the phase-voltage sampling windows, in TIM1 counts
+ * (5 ticks each): 117.5 ADC cycles ≈ 294 ticks → 59 counts. The voltages are
+ * on-time samples when the PWM compare is still ahead at that point.
  */
-#define IIR_GET_VALUE(filt, alpha) ((uint16_t)((filt) >> (alpha)))
-
-/* Filter coefficients */
-#define IIR_ALPHA_CURRENT 5  // fc ≈ 238 Hz @ 24 kHz sampling
-#define IIR_ALPHA_VOLTAGE 1  // fc ≈ 3.8 kHz @ 24 kHz sampling
+#define ADC_INJ_VSAMPLE_END_COUNTS 59U
 
 /**
  * @brief Injected Conversion Complete Callback
@@ -190,60 +192,73 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
 void HAL_ADCEx_InjectedConvCpltCallback(ADC_HandleTypeDef* hadc)
 {    
     if (hadc->Instance != ADC1) return;
+
+    uint32_t t0 = DWT->CYCCNT;
+    uint32_t t_sample = ITimerSched->now() - ADC_INJ_JEOC_TO_VSAMPLE_TICKS;
     
-    // =========================================================================
-    // IIR Filter states
-    // =========================================================================
-    static uint32_t i_a_filt = 0;
-    static uint32_t i_b_filt = 0;
-    static uint32_t v_phase_a_filt = 0;
-    static uint32_t v_phase_b_filt = 0;
-    static uint32_t v_phase_c_filt = 0;
+    static uint32_t t_prev_sample = 0;
     static bool first_run = true;
     
     // =========================================================================
     // 1. READ RAW ADC VALUES
     // =========================================================================
-    uint16_t i_a_raw = HAL_ADCEx_InjectedGetValue(&hadc1, ADC_INJECTED_RANK_1);
-    uint16_t i_b_raw = HAL_ADCEx_InjectedGetValue(&hadc2, ADC_INJECTED_RANK_1);
-    uint16_t v_phase_a_raw = HAL_ADCEx_InjectedGetValue(&hadc1, ADC_INJECTED_RANK_2);
-    uint16_t v_phase_b_raw = HAL_ADCEx_InjectedGetValue(&hadc2, ADC_INJECTED_RANK_2);
-    uint16_t v_phase_c_raw = HAL_ADCEx_InjectedGetValue(&hadc1, ADC_INJECTED_RANK_3);
+    uint16_t raw[FILTER_CH_COUNT];
+    raw[FILTER_CH_I_A]   = HAL_ADCEx_InjectedGetValue(&hadc1, ADC_INJECTED_RANK_1);
+    raw[FILTER_CH_I_B]   = HAL_ADCEx_InjectedGetValue(&hadc2, ADC_INJECTED_RANK_1);
+    raw[FILTER_CH_V_A]   = HAL_ADCEx_InjectedGetValue(&hadc1, ADC_INJECTED_RANK_2);
+    raw[FILTER_CH_V_B]   = HAL_ADCEx_InjectedGetValue(&hadc2, ADC_INJECTED_RANK_2);
+    raw[FILTER_CH_V_C]   = HAL_ADCEx_InjectedGetValue(&hadc1, ADC_INJECTED_RANK_3);
+    raw[FILTER_CH_V_BUS] = HAL_ADCEx_InjectedGetValue(&hadc4, ADC_INJECTED_RANK_1);
+
+    // Six-step drives the same compare on every phase: the largest is the driven duty
+    uint32_t ccr_pwm = TIM1->CCR1;
+    if (TIM1->CCR2 > ccr_pwm) ccr_pwm = TIM1->CCR2;
+    if (TIM1->CCR3 > ccr_pwm) ccr_pwm = TIM1->CCR3;
+    bool v_on_time = (TIM1->CCR4 + ADC_INJ_VSAMPLE_END_COUNTS) < ccr_pwm;
     
     // =========================================================================
-    // 2. FILTER INITIALIZATION
+    // 2. FILTER INITIALIZATION (sections start in steady state on this sample)
     // =========================================================================
     if (first_run) {
-        i_a_filt = (uint32_t)i_a_raw << IIR_ALPHA_CURRENT;
-        i_b_filt = (uint32_t)i_b_raw << IIR_ALPHA_CURRENT;
-        v_phase_a_filt = (uint32_t)v_phase_a_raw << IIR_ALPHA_VOLTAGE;
-        v_phase_b_filt = (uint32_t)v_phase_b_raw << IIR_ALPHA_VOLTAGE;
-        v_phase_c_filt = (uint32_t)v_phase_c_raw << IIR_ALPHA_VOLTAGE;
+        IFilter->reset();
+        t_prev_sample = t_sample;
         first_run = false;
     }
     
     // =========================================================================
-    // 3. APPLY IIR FILTERS (zero-overhead macros)
+    // 3. APPLY FILTERS (one biquad section per channel, FMAC)
     // =========================================================================
-    IIR_UPDATE(i_a_filt, i_a_raw, IIR_ALPHA_CURRENT);
-    IIR_UPDATE(i_b_filt, i_b_raw, IIR_ALPHA_CURRENT);
-    IIR_UPDATE(v_phase_a_filt, v_phase_a_raw, IIR_ALPHA_VOLTAGE);
-    IIR_UPDATE(v_phase_b_filt, v_phase_b_raw, IIR_ALPHA_VOLTAGE);
-    IIR_UPDATE(v_phase_c_filt, v_phase_c_raw, IIR_ALPHA_VOLTAGE);
+    uint16_t filt[FILTER_CH_COUNT];
+    IFilter->process(raw, filt);
     
     // =========================================================================
     // 4. STORE FILTERED RESULTS
     // =========================================================================
-    adc_motor_measurement_buffer.i_a_raw = IIR_GET_VALUE(i_a_filt, IIR_ALPHA_CURRENT);
-    adc_motor_measurement_buffer.i_b_raw = IIR_GET_VALUE(i_b_filt, IIR_ALPHA_CURRENT);
-    adc_motor_measurement_buffer.v_phase_a_raw = IIR_GET_VALUE(v_phase_a_filt, IIR_ALPHA_VOLTAGE);
-    adc_motor_measurement_buffer.v_phase_b_raw = IIR_GET_VALUE(v_phase_b_filt, IIR_ALPHA_VOLTAGE);
-    adc_motor_measurement_buffer.v_phase_c_raw = IIR_GET_VALUE(v_phase_c_filt, IIR_ALPHA_VOLTAGE);
+    adc_motor_measurement_buffer.i_a_raw = filt[FILTER_CH_I_A];
+    adc_motor_measurement_buffer.i_b_raw = filt[FILTER_CH_I_B];
+    adc_motor_measurement_buffer.i_peak_raw = (raw[FILTER_CH_I_A] > raw[FILTER_CH_I_B]) ? raw[FILTER_CH_I_A] : raw[FILTER_CH_I_B];
+    adc_motor_measurement_buffer.i_a_inst_raw = raw[FILTER_CH_I_A];
+    adc_motor_measurement_buffer.i_b_inst_raw = raw[FILTER_CH_I_B];
+    adc_motor_measurement_buffer.v_phase_a_raw = filt[FILTER_CH_V_A];
+    adc_motor_measurement_buffer.v_phase_b_raw = filt[FILTER_CH_V_B];
+    adc_motor_measurement_buffer.v_phase_c_raw = filt[FILTER_CH_V_C];
+    adc_motor_measurement_buffer.v_bus_raw = filt[FILTER_CH_V_BUS];
+    adc_motor_measurement_buffer.v_on_time = v_on_time;
+    // Phase voltages come out of their filter late by its group delay
+    adc_motor_measurement_buffer.v_sample_ticks = t_sample - ((IFilter->delay_q8(FILTER_CH_V_A) * (t_sample - t_prev_sample)) >> 8);
+    t_prev_sample = t_sample;
     
     // =========================================================================
     // 5. NOTIFY DATA READY
     // =========================================================================
     adc_notify_new_data_ready();
+
+    IPerf->record(PERF_PROBE_ADC_JEOC, DWT->CYCCNT - t0);
+
+    // =========================================================================
+    // 6. RUN THE FAST LOOP (ADC-synchronous mode, profiled separately)
+    // =========================================================================
+    Driver_FastLoop_OnInjectedConversion();
 }
 
 /**
@@ -135,6 +135,13 @@ void VoltageSensorManager_OnEndOfBlock_ADC4(void);
  */
 void adc_notify_new_data_ready(void);
 
+/**
+ * @brief ISR entry point for the Fast Loop driver in ADC-synchronous mode
+ *
+ * Implemented in `driver_fastloop.c`. Called at the end of the ADC1 injected
+ * conversion complete callback, after `adc_notify_new_data_ready()`.
+ */
+void Driver_FastLoop_OnInjectedConversion(void);
 
 
 #ifdef __cplusplus
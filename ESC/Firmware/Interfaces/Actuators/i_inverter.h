@@ -47,6 +47,21 @@ typedef enum {
     STATE_FORCE_LOW     /**< High-side OFF, Low-side ON (0% duty) */
 } phase_output_state_t;
 
+/* === Commutation mode ================================================= */
+/**
+ * @brief How output state changes reach the power stage.
+ *
+ * In INVERTER_COMM_PRELOAD mode the next six-step pattern is written ahead
+ * of time with preload_output_states() and applied by the hardware on a
+ * commutation event (TIM1 COM, triggered by the TIMER_EVENT_COMMUTATION
+ * compare of the timer scheduler), so the switching instant does not
+ * depend on interrupt latency.
+ */
+typedef enum {
+    INVERTER_COMM_IMMEDIATE = 0,    /**< Output states applied when written (default) */
+    INVERTER_COMM_PRELOAD           /**< Output states applied at the next commutation event */
+} inverter_comm_mode_t;
+
 /* === Fault definitions ================================================= */
 
 /**
@@ -87,6 +102,16 @@ typedef struct {
     float phase_duty[PHASE_COUNT];
 } inverter_duty_t;
 
+/**
+ * @brief Compare values of the 3 phases, in PWM timer ticks.
+ * 0 = 0 % duty, get_period_ticks() = 100 % duty. Callers scale once
+ * (e.g. Q15 duty: ticks = (q15 × period) >> 15) so the hot path stays
+ * integer-only.
+ */
+typedef struct {
+    uint16_t compare[PHASE_COUNT];
+} inverter_ticks_t;
+
 /* === Interface function typedefs ====================================== */
 
 /**
@@ -143,6 +168,22 @@ typedef bool (*inverter_set_phase_duty_t)(inverter_phase_t phase, float duty);
  */
 typedef bool (*inverter_set_all_duties_t)(const inverter_duty_t* duties);
 
+/**
+ * @brief PWM period in compare ticks (compare value of 100 % duty).
+ * Constant after init(); read it once to scale duties.
+ * @return Period ticks
+ */
+typedef uint16_t (*inverter_get_period_ticks_t)(void);
+
+/**
+ * @brief Set the compare values of all 3 phases, float-free.
+ * The three values are committed together at the next PWM update event
+ * (once per period, in the middle of the off-time), never mid-pulse.
+ * @param ticks Pointer to caller-owned compare values (each ≤ period ticks)
+ * @return true if accepted
+ */
+typedef bool (*inverter_set_duty_ticks_t)(const inverter_ticks_t* ticks);
+
 /**
  * @brief Retrieve the current cached duty cycles.
  * Non-blocking; returns last set values.
@@ -180,6 +221,61 @@ typedef void (*inverter_notify_fault_t)(inverter_fault_t fault);
  */
 typedef bool (*inverter_set_output_state)(inverter_phase_t phase, phase_output_state_t state);
 
+/**
+ * @brief Select how output state changes are applied.
+ * In INVERTER_COMM_PRELOAD mode, set_output_state() / enable() / disable()
+ * still take effect at once; like leaving PRELOAD mode, they first apply
+ * a pattern still pending from preload_output_states().
+ * @param mode Commutation mode
+ * @return true if the mode is supported and selected
+ */
+typedef bool (*inverter_set_comm_mode_t)(inverter_comm_mode_t mode);
+
+/**
+ * @brief Preload the output states of all phases for the next commutation event.
+ * Only valid in INVERTER_COMM_PRELOAD mode; the current outputs are kept
+ * until the event. A new call replaces the pending pattern.
+ * @param states Output state per phase (STATE_FORCE_x behave as STATE_PWM_x)
+ * @return true if the pattern was preloaded
+ */
+typedef bool (*inverter_preload_output_states_t)(const phase_output_state_t states[PHASE_COUNT]);
+
+/**
+ * @brief Apply a six-step (trapezoidal) commutation pattern in one call.
+ * Fast path for commutation ISRs: the pattern comes from a precomputed
+ * table, the same duty is written on the three phases and the output
+ * enables are written at once. Applied immediately in
+ * INVERTER_COMM_IMMEDIATE mode, at the next commutation event in
+ * INVERTER_COMM_PRELOAD mode.
+ *
+ * Patterns as (PWM_HIGH, PWM_LOW, floating) phases:
+ * | step | CW        | CCW       |
+ * |------|-----------|-----------|
+ * | 0    | A, B, C   | C, B, A   |
+ * | 1    | A, C, B   | C, A, B   |
+ * | 2    | B, C, A   | B, A, C   |
+ * | 3    | B, A, C   | B, C, A   |
+ * | 4    | C, A, B   | A, C, B   |
+ * | 5    | C, B, A   | A, B, C   |
+ *
+ * @param step Step index (0..5)
+ * @param duty Normalized duty (0.0 .. 1.0)
+ * @param cw   true = clockwise sequence, false = counterclockwise
+ * @return Floating phase of the step (BEMF sensing), PHASE_COUNT if rejected
+ */
+typedef inverter_phase_t (*inverter_six_step_t)(uint8_t step, float duty, bool cw);
+
+/**
+ * @brief Move the injected ADC trigger (TIM1 CH4 → TRGO) within the PWM period.
+ * The trigger fires when the up-counting half of the period reaches
+ * @p ticks, i.e. @p ticks after the centre of the on-time: below the duty
+ * compare the sample is taken with the high side on, above it in the
+ * off-time. Committed at the next update event, like the duties.
+ * @param ticks Compare value (1 .. get_period_ticks() - 1)
+ * @return true if accepted
+ */
+typedef bool (*inverter_set_adc_trigger_t)(uint16_t ticks);
+
 /* === Interface struct ================================================= */
 
 typedef struct {
@@ -190,11 +286,17 @@ typedef struct {
     inverter_emergency_stop_t  emergency_stop;   /**< Emergency stop + latch fault */
     inverter_set_phase_duty_t  set_phase_duty;   /**< Set duty of single phase */
     inverter_set_all_duties_t  set_all_duties;   /**< Set duties for all phases atomically */
+    inverter_get_period_ticks_t get_period_ticks; /**< Compare ticks of one PWM period */
+    inverter_set_duty_ticks_t  set_duty_ticks;   /**< Set compare ticks, committed at update event */
     inverter_get_duties_t      get_duties;       /**< Read cached duties */
     inverter_get_status_t      get_status;       /**< Read inverter status */
     inverter_clear_faults_t    clear_faults;     /**< Clear latched faults */
     inverter_notify_fault_t    notify_fault;     /**< Notify of low-level fault from ISR */
     inverter_set_output_state  set_output_state; /**< Set output state for single phase */
+    inverter_set_comm_mode_t   set_comm_mode;    /**< Immediate or hardware-timed commutation */
+    inverter_preload_output_states_t preload_output_states; /**< Pattern for the next commutation event */
+    inverter_six_step_t        six_step;         /**< Six-step pattern fast path */
+    inverter_set_adc_trigger_t set_adc_trigger;  /**< ADC trigger position, committed at update event */
 } i_inverter_t;
 
 /* === Global instance ================================================== */
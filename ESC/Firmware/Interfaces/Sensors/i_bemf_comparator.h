@@ -0,0 +1,86 @@
+/**
+ * @file i_bemf_comparator.h
+ * @brief Abstract interface for hardware BEMF zero-cross capture.
+ *
+ * One analog comparator per phase compares the phase terminal voltage
+ * against a virtual neutral. The comparator of the floating phase is routed
+ * to a timer input capture, which latches the counter at the selected edge:
+ * the zero-cross time is resolved to one timer tick instead of one ADC
+ * sampling period.
+ *
+ * Capture timestamps are ticks of the ITimerSched counter (same free-running
+ * timebase), so they can be used directly to place commutation deadlines.
+ *
+ * Typical implementation: COMP1..COMP3 (phase A..C on INP, resistor star
+ * point on INM) → TIM5 TI1 remap → TIM5 CH1 input capture, polled.
+ */
+
+#ifndef I_BEMF_COMPARATOR_H
+#define I_BEMF_COMPARATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Comparator output edge to capture.
+ *
+ * The output is high while the phase is above the virtual neutral:
+ * a rising edge is a rising BEMF zero-cross.
+ */
+typedef enum {
+    BEMF_COMP_EDGE_RISING = 0,  /**< Phase voltage crosses the neutral upwards */
+    BEMF_COMP_EDGE_FALLING      /**< Phase voltage crosses the neutral downwards */
+} bemf_comp_edge_t;
+
+/**
+ * @brief BEMF comparator capture interface.
+ */
+typedef struct
+{
+    /**
+     * @brief Enable the comparators and configure the capture channel (disarmed).
+     * @return true if successful, false otherwise
+     */
+    bool (*init)(void);
+
+    /**
+     * @brief Route the comparator of @p phase to the capture and arm it.
+     *
+     * A pending capture is discarded. Only edges occurring after the call
+     * are captured.
+     *
+     * @param phase Phase index (PHASE_A..PHASE_C of i_inverter.h)
+     * @param edge  Comparator edge to capture
+     * @return false if @p phase is invalid
+     */
+    bool (*arm)(uint8_t phase, bemf_comp_edge_t edge);
+
+    /**
+     * @brief Stop capturing and discard a pending capture.
+     */
+    void (*disarm)(void);
+
+    /**
+     * @brief Read the capture latched since arm() or the previous read.
+     *
+     * The capture stays armed: when several edges occurred since the last
+     * read, @p ticks holds the latest one.
+     *
+     * @param ticks Capture time in ITimerSched ticks
+     * @return true if a new edge was captured
+     */
+    bool (*get_capture)(uint32_t *ticks);
+
+} i_bemf_comparator_t;
+
+extern i_bemf_comparator_t* IBemfComparator;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I_BEMF_COMPARATOR_H */
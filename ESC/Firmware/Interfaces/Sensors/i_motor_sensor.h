@@ -24,11 +24,20 @@ typedef struct {
     uint16_t i_a_raw;       /**< Phase A current (raw ADC value) */
     uint16_t i_b_raw;       /**< Phase B current (raw ADC value) */
     uint16_t i_c_raw;       /**< Phase C current (raw ADC value) */
+    uint16_t i_peak_raw;    /**< Largest phase current of this trigger, unfiltered (single-pulse measurements) */
+    uint16_t i_a_inst_raw;  /**< Phase A current of this trigger, unfiltered (current regulation) */
+    uint16_t i_b_inst_raw;  /**< Phase B current of this trigger, unfiltered (current regulation) */
     
     // Phase Voltage Measurements (for BEMF Estimation)
     uint16_t v_phase_a_raw; /**< Phase A voltage (raw ADC value) */
     uint16_t v_phase_b_raw; /**< Phase B voltage (raw ADC value) */
     uint16_t v_phase_c_raw; /**< Phase C voltage (raw ADC value) */
+    uint16_t v_bus_raw;     /**< Bus voltage, same trigger and divider as the phases (raw ADC value) */
+    bool     v_on_time;     /**< Phase voltages sampled inside the PWM on-time (high side conducting) */
+
+    // Timing
+    uint32_t v_sample_ticks; /**< Instant the phase voltages stand for (ITimerSched ticks):
+                                  sampling instant minus the voltage filter group delay */
 
 } motor_measurements_t;
 
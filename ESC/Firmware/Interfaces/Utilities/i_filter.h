@@ -0,0 +1,103 @@
+/**
+ * @file i_filter.h
+ * @brief Abstract interface for the low-pass filters of the injected-ADC channels.
+ *
+ * Every injected conversion (phase currents, phase voltages, bus voltage)
+ * goes through one section per channel before it is published. First-order
+ * sections run in software in the fixed-point front end (driver_filter.c);
+ * second-order ones are computed by the FMAC on target
+ * (driver_filter_fmac.c) and by a software model of the same q1.15
+ * arithmetic in the host simulation (sim_fmac.c).
+ *
+ * The cutoffs can be changed at run time from any context; the new section
+ * applies from the next sample on, without resetting the filter state.
+ */
+
+#ifndef I_FILTER_H
+#define I_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Filtered channels, in the order of the process() arrays.
+ */
+typedef enum
+{
+    FILTER_CH_I_A = 0,      /**< Phase A current */
+    FILTER_CH_I_B,          /**< Phase B current */
+    FILTER_CH_V_A,          /**< Phase A voltage */
+    FILTER_CH_V_B,          /**< Phase B voltage */
+    FILTER_CH_V_C,          /**< Phase C voltage */
+    FILTER_CH_V_BUS,        /**< Bus voltage */
+    FILTER_CH_COUNT
+} filter_channel_t;
+
+/**
+ * @brief Section types (unity gain at DC for all of them).
+ */
+typedef enum
+{
+    FILTER_TYPE_BYPASS = 0, /**< No filtering, no delay */
+    FILTER_TYPE_LOWPASS1,   /**< First order, y += (1 - p)(x - y): the former shift IIR */
+    FILTER_TYPE_LOWPASS2,   /**< Second-order Butterworth (bilinear, prewarped) */
+} filter_type_t;
+
+typedef struct
+{
+    /**
+     * @brief Design and load the default sections, states dropped.
+     *
+     * Called once before the injected conversions start: process() does
+     * no design work.
+     *
+     * @return false if a default section could not be designed
+     */
+    bool (*init)(void);
+
+    /**
+     * @brief Set the section of a channel.
+     * @param cutoff_hz -3 dB frequency, below half the sampling rate
+     *                  (ignored for FILTER_TYPE_BYPASS)
+     * @return false if the channel, type or cutoff is out of range (unchanged)
+     */
+    bool (*configure)(filter_channel_t ch, filter_type_t type, float cutoff_hz);
+
+    /**
+     * @brief Filter one sample of every channel (ADC interrupt).
+     * @param raw      FILTER_CH_COUNT raw 12-bit samples
+     * @param filtered FILTER_CH_COUNT filtered samples, same scale
+     *
+     * The first call after reset() starts every section in steady state on
+     * its sample.
+     */
+    void (*process)(const uint16_t *raw, uint16_t *filtered);
+
+    /**
+     * @brief Restart the sections on the next sample (state dropped).
+     */
+    void (*reset)(void);
+
+    /**
+     * @brief Group delay of a channel on slow signals, in 1/256 samples.
+     *
+     * A ramp comes out of the section exactly this late.
+     */
+    uint32_t (*delay_q8)(filter_channel_t ch);
+
+} i_filter_t;
+
+/**
+ * @brief Global filter interface instance.
+ */
+extern i_filter_t* IFilter;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I_FILTER_H */
@@ -0,0 +1,64 @@
+/**
+ * @file i_math.h
+ * @brief Abstract interface for the trigonometry of the control path.
+ *
+ * Angle-based control (FOC, observer, PLL) needs sin/cos/atan2/modulus at
+ * the fast-loop rate. On target these run on the CORDIC coprocessor
+ * (driver_math_cordic.c); the host simulation runs a software model of the
+ * same fixed-point algorithm (sim_cordic.c). Both sit behind the same
+ * float front end (driver_math.c), so host and target see the same
+ * quantisation and the same results.
+ *
+ * Accuracy: about 2e-7 rad on angles, 1e-6 relative on sin/cos/modulus
+ * (q1.31 arguments, 24 CORDIC iterations).
+ *
+ * The calls may be used from any context: each one is atomic against the
+ * other interrupt levels.
+ */
+
+#ifndef I_MATH_H
+#define I_MATH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct
+{
+    /**
+     * @brief Sine and cosine of one angle.
+     * @param angle_rad Angle [rad], any value below 1e9 in magnitude
+     */
+    void (*sin_cos)(float angle_rad, float *sin_out, float *cos_out);
+
+    /**
+     * @brief Sine and cosine of @p n angles in one pipelined run.
+     * @param n Number of angles
+     */
+    void (*sin_cos_n)(const float *angle_rad, float *sin_out, float *cos_out, uint32_t n);
+
+    /**
+     * @brief Angle of the vector (x, y) [rad, -π – π]; 0 for the null vector.
+     */
+    float (*atan2)(float y, float x);
+
+    /**
+     * @brief Length of the vector (x, y), sqrt(x² + y²).
+     */
+    float (*magnitude)(float x, float y);
+
+} i_math_t;
+
+/**
+ * @brief Global math interface instance.
+ */
+extern i_math_t* IMath;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I_MATH_H */
@@ -0,0 +1,88 @@
+/**
+ * @file i_perf.h
+ * @brief Abstract interface for cycle-accurate execution-time profiling.
+ *
+ * Each probe accumulates handler durations measured in CPU cycles
+ * (ITime->get_cycles(), DWT->CYCCNT on target): count, min, max, mean,
+ * a log2 histogram and the number of executions exceeding the budget.
+ *
+ * Histogram bin k counts durations in [2^k, 2^(k+1)) cycles; bin 0 also
+ * holds 0 and 1, the last bin holds everything above.
+ *
+ * record() is called from ISR context and must stay O(1).
+ */
+
+#ifndef I_PERF_H
+#define I_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PERF_HIST_BINS  16U     /**< Up to 2^15 cycles (≈ 218 µs @ 150 MHz) */
+
+/**
+ * @brief Profiled execution contexts.
+ */
+typedef enum
+{
+    PERF_PROBE_FASTLOOP = 0,    /**< Fast-loop callback (ADC JEOC or TIM3) */
+    PERF_PROBE_LOWLOOP,         /**< TIM4 low-loop callback */
+    PERF_PROBE_ADC_JEOC,        /**< ADC1/2 injected conversion complete callback */
+    PERF_PROBE_ONESHOT,         /**< TIM5 timer scheduler event callback */
+    PERF_PROBE_COUNT
+} perf_probe_id_t;
+
+/**
+ * @brief Statistics of one probe.
+ */
+typedef struct
+{
+    uint32_t count;                     /**< Recorded executions */
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint32_t last_cycles;
+    uint64_t sum_cycles;                /**< mean = sum / count */
+    uint32_t budget_cycles;             /**< Overrun threshold (0 = none) */
+    uint32_t overruns;                  /**< Executions longer than budget */
+    uint32_t hist[PERF_HIST_BINS];      /**< log2 histogram */
+} perf_probe_stats_t;
+
+typedef struct
+{
+    /**
+     * @brief Record one execution of @p id lasting @p cycles.
+     */
+    void (*record)(perf_probe_id_t id, uint32_t cycles);
+
+    /**
+     * @brief Set the overrun threshold of a probe (kept across reset).
+     */
+    void (*set_budget)(perf_probe_id_t id, uint32_t cycles);
+
+    /**
+     * @brief Copy the statistics of a probe.
+     * @return false if @p id is invalid.
+     */
+    bool (*get_stats)(perf_probe_id_t id, perf_probe_stats_t *out);
+
+    /**
+     * @brief Clear the statistics of every probe.
+     */
+    void (*reset)(void);
+
+} i_perf_t;
+
+/**
+ * @brief Global profiling interface instance.
+ */
+extern i_perf_t* IPerf;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I_PERF_H */
@@ -57,6 +57,12 @@ typedef struct
      */
     uint32_t (*get_time_us)(void);        // free-running µs counter
 
+    /**
+     * @brief Get the CPU cycle counter.
+     * @return Free-running cycle count (32-bit wrap), for execution-time profiling
+     */
+    uint32_t (*get_cycles)(void);
+
 } i_time_t;
 
 /**
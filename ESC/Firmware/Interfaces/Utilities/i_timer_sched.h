@@ -0,0 +1,119 @@
+/**
+ * @file i_timer_sched.h
+ * @brief Abstract interface for a multi-event hardware timer scheduler.
+ *
+ * This interface schedules one-time callbacks at precise timer ticks.
+ * Each event source (timer_event_id_t) owns one independent deadline, so
+ * commutation, blanking, ramp steps and timeouts can be pending at the
+ * same time without cancelling each other.
+ *
+ * Deadlines are expressed in ticks of a free-running 32-bit counter
+ * (get_tick_hz(), e.g. 150 MHz → 6.67 ns resolution). A deadline must lie
+ * less than 2^31 ticks ahead of now(); a deadline already in the past
+ * fires immediately.
+ *
+ * Typical implementation: TIM5 (32-bit) free-running, three output-compare
+ * channels, earliest deadlines in hardware and a sorted software queue for
+ * the others.
+ */
+
+#ifndef I_TIMER_SCHED_H
+#define I_TIMER_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* === Event sources ==================================================== */
+
+/**
+ * @brief Independent timed events (at most one pending deadline each).
+ */
+typedef enum
+{
+    TIMER_EVENT_COMMUTATION = 0,    /**< Next six-step commutation (also fires the TIM1 COM event) */
+    TIMER_EVENT_BLANKING,           /**< End of the BEMF blanking window */
+    TIMER_EVENT_RAMP,               /**< Open-loop ramp step */
+    TIMER_EVENT_TIMEOUT,            /**< Alignment / supervision timeout */
+    TIMER_EVENT_AUX0,               /**< General purpose (application, tests) */
+    TIMER_EVENT_AUX1,               /**< General purpose (application, tests) */
+    TIMER_EVENT_COUNT
+} timer_event_id_t;
+
+/* === Callback Type ==================================================== */
+
+/**
+ * @brief Callback type for a timed event.
+ * @param context User-defined context pointer (can be NULL).
+ *
+ * @note Executed in ISR context: must be short and non-blocking.
+ *       It may re-arm its own event or any other one.
+ */
+typedef void (*timer_event_callback_t)(void *context);
+
+/* === Interface ======================================================== */
+
+typedef struct
+{
+    /**
+     * @brief Initialize the scheduler and start its free-running counter.
+     * All events are cancelled.
+     * @return true if initialization succeeded, false otherwise.
+     */
+    bool (*init)(void);
+
+    /**
+     * @brief Current counter value in ticks.
+     */
+    uint32_t (*now)(void);
+
+    /**
+     * @brief Counter frequency in Hz.
+     */
+    uint32_t (*get_tick_hz)(void);
+
+    /**
+     * @brief Schedule @p id at an absolute tick.
+     * A pending deadline of the same event is replaced.
+     * @param id Event source.
+     * @param deadline Absolute counter value (wraps modulo 2^32).
+     * @param cb Callback to invoke when the deadline is reached (ISR context).
+     * @param ctx Pointer passed to the callback (user context).
+     * @return true if scheduled, false if @p id or @p cb is invalid.
+     */
+    bool (*start_at)(timer_event_id_t id, uint32_t deadline, timer_event_callback_t cb, void *ctx);
+
+    /**
+     * @brief Schedule @p id @p delay_ticks after now().
+     * Same contract as start_at().
+     */
+    bool (*start)(timer_event_id_t id, uint32_t delay_ticks, timer_event_callback_t cb, void *ctx);
+
+    /**
+     * @brief Cancel the pending deadline of @p id (if any).
+     */
+    void (*cancel)(timer_event_id_t id);
+
+    /**
+     * @brief Check if @p id has a pending deadline.
+     */
+    bool (*is_active)(timer_event_id_t id);
+
+} i_timer_sched_t;
+
+/* === Global instance ================================================== */
+
+/**
+ * @brief Global instance of the timer scheduler interface.
+ * Defined in configuration (platform-specific binding).
+ */
+extern i_timer_sched_t* ITimerSched;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I_TIMER_SCHED_H */
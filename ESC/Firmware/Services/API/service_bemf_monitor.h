@@ -35,9 +35,13 @@ typedef enum
 typedef struct
 {
     bool zero_cross_detected;        /**< True when a new zero-cross is detected */
-    float period_us;                 /**< Electrical period (µs) between two ZC */
+    float period_us;                 /**< Electrical period (µs) between two ZC, sub-µs resolution */
     s_motor_phase_t floating_phase;  /**< Current floating phase */
     bool valid;                      /**< True when period is stable (filtered) */
+    float current_a;                 /**< Phase current magnitude of the last ADC sample [A] */
+    float current_inst_a;            /**< Same, unfiltered (six-step: current of the driven pair) [A] */
+    bool zc_rising;                  /**< Direction of the last zero-cross */
+    float bemf_ratio;                /**< Coasting: peak terminal BEMF / Vbus over the last 60° */
 } bemf_status_t;
 
 /* ---------------------------------------------------------------------------
@@ -63,6 +67,28 @@ typedef void (*bemf_reset_t)(void);
  */
 typedef void (*bemf_process_t)(s_motor_phase_t floating_phase);
 
+/**
+ * @brief Process one ADC sample with the whole bridge off (flying start).
+ *
+ * All three phases are watched: each crossing is reported like a six-step
+ * zero-cross (phase, direction, instant, period), so the rotor position,
+ * speed and direction can be found before driving it. Comparator backends
+ * use the ADC samples as well.
+ */
+typedef void (*bemf_process_coasting_t)(void);
+
+/**
+ * @brief Announce the commutation step just applied (call at every step change).
+ *
+ * With the six-step table of the inverter, the floating phase crosses the
+ * neutral rising on odd steps and falling on even steps, in both directions.
+ * Capture backends arm their hardware here; sampling backends ignore it.
+ *
+ * @param floating_phase Phase left floating by the new step.
+ * @param rising         true if its BEMF is expected to cross upwards.
+ */
+typedef void (*bemf_commutated_t)(s_motor_phase_t floating_phase, bool rising);
+
 /**
  * @brief Get the latest BEMF status (non-blocking).
  * @param out_status Pointer to structure that receives the current status.
@@ -76,6 +102,9 @@ typedef void (*bemf_clear_flag_t)(void);
 
 /**
  * @brief Get timestamp (µs) of the last detected zero-crossing event.
+ *
+ * This is the estimated crossing instant (interpolated between samples, or
+ * captured), not the time at which process() detected it.
  */
 typedef uint32_t (*bemf_get_last_zc_time_us_t)(void);
 
@@ -94,6 +123,8 @@ typedef struct
     bemf_init_t                init;                /**< Initialize the BEMF monitor */
     bemf_reset_t               reset;               /**< Reset internal states (added) ✅ */
     bemf_process_t             process;             /**< Process one fast-loop sample */
+    bemf_process_coasting_t    process_coasting;    /**< Process one sample, bridge off */
+    bemf_commutated_t          commutated;          /**< New commutation step applied */
     bemf_get_status_t          get_status;          /**< Retrieve last computed status */
     bemf_clear_flag_t          clear_flag;          /**< Clear zero-cross flag */
     bemf_get_last_zc_time_us_t get_last_zc_time_us; /**< Get last ZC timestamp */
@@ -113,4 +144,13 @@ typedef struct
  */
 extern s_bemf_monitor_t* SBemfMonitor;
 
+/**
+ * @brief Comparator backend: zero-crosses captured by hardware (timer tick
+ *        resolution) instead of sign changes between ADC samples.
+ *
+ * Same status, period filter and lock logic as the default ADC backend.
+ * Select it by pointing SBemfMonitor to it before init().
+ */
+extern s_bemf_monitor_t* SBemfMonitorComp;
+
 #endif /* SERVICE_BEMF_MONITOR_H */
@@ -98,6 +98,10 @@ typedef void (*commutation_callback_t)(void *user_ctx);
  * and schedules the next steps using an event-driven timer. The ramp
  * progresses automatically until completion or stop request.
  *
+ * The profile is evaluated here on a small table; the step events only
+ * interpolate it and re-arm at absolute deadlines, so the ramp lasts
+ * @p ramp_time_ms to within one step.
+ *
  * @param duty_start     Starting PWM duty (0.0 – 1.0)
  * @param duty_end       Final PWM duty (0.0 – 1.0)
  * @param freq_start_hz  Starting electrical frequency (Hz)
@@ -120,6 +124,61 @@ void Service_Motor_OpenLoopRamp_Start(
     void *user_ctx);
 
 
+/**
+ * @brief Start the open-loop ramp from a known rotor position (non-blocking).
+ *
+ * Same as Service_Motor_OpenLoopRamp_Start(), whose first pattern is step 0
+ * (rotor aligned beforehand), but starting from @p step: the position found
+ * by inductive sensing, no alignment needed.
+ *
+ * @param step           Six-step position to start from (0–5), see
+ *                       Service_Motor_SixStepOfAngle()
+ * @param duty_start     Starting PWM duty (0.0 – 1.0)
+ * @param duty_end       Final PWM duty (0.0 – 1.0)
+ * @param freq_start_hz  Starting electrical frequency (Hz)
+ * @param freq_end_hz    Final electrical frequency (Hz)
+ * @param ramp_time_ms   Total ramp duration in milliseconds
+ * @param cw             true = clockwise, false = counterclockwise
+ * @param profile_type   Ramp progression profile
+ * @param on_complete    Optional callback invoked at ramp completion (can be NULL)
+ * @param user_ctx       Optional user data passed to the callback (can be NULL)
+ */
+void Service_Motor_OpenLoopRamp_StartFrom(
+    uint8_t step,
+    float duty_start,
+    float duty_end,
+    float freq_start_hz,
+    float freq_end_hz,
+    uint32_t ramp_time_ms,
+    bool cw,
+    motor_ramp_profile_t profile_type,
+    motor_ramp_callback_t on_complete,
+    void *user_ctx);
+
+/**
+ * @brief Restart the open-loop sequence on a spinning rotor (non-blocking).
+ *
+ * Constant-frequency ramp starting from @p step instead of the aligned
+ * position, used to catch the BEMF again after a loss of synchronization.
+ * Ends like Service_Motor_OpenLoopRamp_Start() if no handover happens.
+ *
+ * @param step         Six-step position to start from (0–5)
+ * @param duty         PWM duty (0.0 – 1.0)
+ * @param freq_hz      Electrical frequency (Hz)
+ * @param hold_ms      Time allowed to catch the BEMF (milliseconds)
+ * @param cw           true = clockwise, false = counterclockwise
+ * @param on_complete  Optional callback invoked when the ramp runs out (can be NULL)
+ * @param user_ctx     Optional user data passed to the callback (can be NULL)
+ */
+void Service_Motor_OpenLoopRamp_Resync(
+    uint8_t step,
+    float duty,
+    float freq_hz,
+    uint32_t hold_ms,
+    bool cw,
+    motor_ramp_callback_t on_complete,
+    void *user_ctx);
+
 /**
  * @brief Start non-blocking rotor alignment.
  *
@@ -138,6 +197,25 @@ void Service_Motor_OpenLoopRamp_Start(
  */
 void Service_Motor_Align_Rotor(float duty, uint32_t duration_ms, void (*on_alignment_done)(void));
 
+/**
+ * @brief Switch the bridge to sinusoidal operation: complementary PWM on
+ *        all three phases, 50 % duty (zero voltage vector).
+ *
+ * Call once before Service_Motor_SetPhaseDuties(); Service_Motor_Stop()
+ * turns the bridge off again.
+ */
+void Service_Motor_Sinusoidal_Start(void);
+
+/**
+ * @brief Write the three phase duties of a sinusoidal drive at once.
+ *
+ * Committed together at the next PWM update event.
+ *
+ * @param duty Normalized duties of phases A, B, C (0.0 – 1.0)
+ * @return true if accepted
+ */
+bool Service_Motor_SetPhaseDuties(const float duty[3]);
+
 
 /**
  * @brief Stop any ongoing open-loop ramp.
@@ -154,6 +232,15 @@ void Service_Motor_OpenLoopRamp_Stop(void);
  */
 void Service_Motor_OpenLoopRamp_StopSoft(void);
 
+/**
+ * @brief Freeze the open-loop ramp on its current step.
+ *
+ * Cancels the pending ramp step only; the ramp state stays readable with
+ * Service_Motor_OpenLoopRamp_GetState(). Used while the open→closed loop
+ * handover commutation is pending.
+ */
+void Service_Motor_OpenLoopRamp_Hold(void);
+
 /**
  * @brief Apply a commutation pattern for the active control mode.
  *
@@ -164,14 +251,111 @@ void Service_Motor_OpenLoopRamp_StopSoft(void);
  * @param step  Step index (0–5 for six-step mode)
  * @param duty  Normalized PWM duty (0.0 – 1.0)
  * @param cw    true = clockwise, false = counterclockwise
+ * @return Floating phase of the step (0 = A, 1 = B, 2 = C, same order as
+ *         s_motor_phase_t), 3 if the step or duty was rejected
+ */
+uint8_t Inverter_SixStepCommutate(uint8_t step, float duty, bool cw);
+
+/**
+ * @brief Preload a six-step pattern, applied by hardware at the next commutation.
+ *
+ * Hardware-timed commutation only (Service_Motor_SetHwCommutation(true)):
+ * the pattern is applied by the TIM1 COM event at the next
+ * TIMER_EVENT_COMMUTATION deadline (Service_ScheduleCommutation()), so the
+ * switching instant does not depend on ISR latency. The commutation
+ * callback then only needs to preload the following step.
+ *
+ * @param step  Step index (0–5)
+ * @param duty  Normalized PWM duty (0.0 – 1.0)
+ * @param cw    true = clockwise, false = counterclockwise
+ * @return Floating phase of the step once applied (0 = A .. 2 = C), 3 if rejected
+ */
+uint8_t Inverter_SixStepPreload(uint8_t step, float duty, bool cw);
+
+/**
+ * @brief Change the duty of the six-step pattern being applied.
+ *
+ * Current regulation within a step: only the compare values are written,
+ * committed at the next update event; the output states (and a pattern
+ * preloaded for the next commutation) are left as they are. Give the same
+ * duty to the next Inverter_SixStepCommutate() / Inverter_SixStepPreload().
+ *
+ * @param duty Normalized PWM duty (0.0 – 1.0)
+ * @return false if the duty was rejected
  */
-void Inverter_SixStepCommutate(uint8_t step, float duty, bool cw);
+bool Service_Motor_SetSixStepDuty(float duty);
+
+/**
+ * @brief Six-step position of a zero-cross seen on a free-running rotor.
+ *
+ * Inverse of the six-step table for the floating phase: the step during
+ * which @p phase would cross in this direction (rising on odd steps).
+ *
+ * @param phase  Phase that crossed (0 = A, 1 = B, 2 = C)
+ * @param rising Direction of the crossing
+ * @param cw     Rotation direction assumed
+ * @return Step index (0–5)
+ */
+uint8_t Service_Motor_SixStepOfZeroCross(uint8_t phase, bool rising, bool cw);
+
+/**
+ * @brief Six-step position for a rotor at a known electrical angle.
+ *
+ * The step whose 60° window contains the angle, i.e. the pattern giving
+ * the most torque in direction @p cw from there (Motor_PllStep() for CW).
+ *
+ * @param theta_deg Electrical angle [°], zero-cross PLL frame (step k
+ *                  crosses at 60° + 60°·k in CW)
+ * @param cw        Rotation direction
+ * @return Step index (0–5)
+ */
+uint8_t Service_Motor_SixStepOfAngle(float theta_deg, bool cw);
+
+/**
+ * @brief Select hardware-timed or ISR-driven six-step commutation.
+ *
+ * Service_Motor_Stop() always returns to ISR-driven commutation.
+ *
+ * @param enable true = patterns from Inverter_SixStepPreload() are applied
+ *               at the commutation deadline, false = immediate writes
+ * @return true if the mode was selected
+ */
+bool Service_Motor_SetHwCommutation(bool enable);
+
+/**
+ * @brief Place the BEMF sampling point (ADC trigger) for a six-step duty.
+ *
+ * Call once per PWM period with the duty being applied. When the pulse is
+ * long enough for the phase-voltage sampling window plus a margin to the
+ * switching edge, the sample is taken right after the centre of the
+ * on-time; otherwise in the middle of the off-time. The new position
+ * applies from the next period; the measurements flag on-time samples
+ * (v_on_time), from which the BEMF monitor picks its reference.
+ *
+ * @param duty Normalized PWM duty (0.0 – 1.0)
+ * @return true if the sample falls in the on-time
+ */
+bool Service_Motor_PlaceAdcTrigger(float duty);
+
+/**
+ * @brief Place the ADC trigger in the middle of the off-time common to all
+ *        phases (low-side shunt currents of a sinusoidal drive).
+ *
+ * The sampling window is centred between the end of the widest pulse and
+ * the period top; applies from the next period.
+ *
+ * @param duty_max Largest of the three phase duties (0.0 – 1.0)
+ * @return Sampling point after the centre of the on-time [PWM periods]
+ */
+float Service_Motor_PlaceAdcTriggerOffTime(float duty_max);
 
 /**
  * @brief Schedule a six-step commutation event after a specified delay.
  *
- * This helper service uses the one-shot timer to schedule a callback after
- * a given microsecond delay. It abstracts away the hardware timer interface
+ * This helper service uses the timer scheduler (TIMER_EVENT_COMMUTATION) to
+ * schedule a callback after a given microsecond delay, with sub-µs
+ * resolution. A pending commutation is replaced; the ramp and timeout
+ * events keep running. It abstracts away the hardware timer interface
  * from the Control layer.
  *
  * @param delay_us   Delay before triggering commutation (µs)
@@ -192,6 +376,13 @@ void Service_ScheduleCommutation(float delay_us, commutation_callback_t callback
  */
 void Service_Motor_OpenLoopRamp_GetState(uint8_t *step_index, float *duty, bool *direction_cw);
 
+/**
+ * @brief Floating phase of the current open-loop ramp step.
+ *
+ * @return 0 = A, 1 = B, 2 = C (same order as s_motor_phase_t)
+ */
+uint8_t Service_Motor_OpenLoopRamp_GetFloatingPhase(void);
+
 /**
  * @brief Stop the motor by disabling the inverter and cancelling timers.
  */
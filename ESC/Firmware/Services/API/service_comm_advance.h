@@ -0,0 +1,109 @@
+/**
+ * @file service_comm_advance.h
+ * @brief Commutation advance map (speed × current) with auto-calibration.
+ *
+ * Six-step commutation ideally happens 30° electrical after the BEMF zero
+ * cross; the advance is how much earlier it is applied, to compensate the
+ * current rise time in the winding inductance. It grows with the speed and
+ * the load current, so it is taken from a 2D table:
+ *  - Breakpoints: electrical speed [Hz] × phase current magnitude [A]
+ *  - Bilinear interpolation between them, clamped at the table edges
+ *  - Cells tunable live (debug protocol: advget / advset)
+ *
+ * The auto-calibration sweeps the advance at the current operating point
+ * (speed held by the speed loop) and stores the one giving the lowest
+ * phase current in the nearest cell.
+ *
+ * Key features:
+ *  - Cheap lookup for the fast loop
+ *  - Module-level table (one motor per ESC)
+ *  - Calibration ticked from the slow loop, overriding the lookup meanwhile
+ */
+
+#ifndef SERVICE_COMM_ADVANCE_H
+#define SERVICE_COMM_ADVANCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define COMM_ADV_SPEED_POINTS     6U       /**< Speed breakpoints (rows) */
+#define COMM_ADV_CURRENT_POINTS   4U       /**< Current breakpoints (columns) */
+#define COMM_ADV_MAX_DEG          30.0f    /**< Commutation at the zero cross */
+
+/**
+ * @brief Load the default table and stop any calibration.
+ */
+void Service_CommAdvance_Init(void);
+
+/**
+ * @brief Advance for an operating point (bilinear interpolation).
+ *
+ * While a calibration runs, returns the advance under test instead.
+ *
+ * @param speed_hz  Electrical speed [Hz]
+ * @param current_a Phase current magnitude [A]
+ * @return Advance [° electrical], 0 – COMM_ADV_MAX_DEG
+ */
+float Service_CommAdvance_Get(float speed_hz, float current_a);
+
+/**
+ * @brief Set one table cell.
+ *
+ * @param speed_idx   Speed breakpoint index (row)
+ * @param current_idx Current breakpoint index (column)
+ * @param advance_deg Advance [°], 0 – COMM_ADV_MAX_DEG
+ * @return false if an index or the value is out of range
+ */
+bool Service_CommAdvance_SetCell(uint8_t speed_idx, uint8_t current_idx, float advance_deg);
+
+/**
+ * @brief Read one table cell.
+ *
+ * @param speed_idx   Speed breakpoint index (row)
+ * @param current_idx Current breakpoint index (column)
+ * @param advance_deg Out: advance [°]
+ * @return false if an index is out of range
+ */
+bool Service_CommAdvance_GetCell(uint8_t speed_idx, uint8_t current_idx, float *advance_deg);
+
+/**
+ * @brief Print the table (breakpoints and cells) on the debug terminal.
+ */
+void Service_CommAdvance_Print(void);
+
+/**
+ * @brief Start calibrating the cell nearest to an operating point.
+ *
+ * The caller must hold the speed constant (closed loop) and tick the
+ * calibration with Service_CommAdvance_CalTick() until it ends.
+ *
+ * @param speed_hz  Electrical speed [Hz]
+ * @param current_a Phase current magnitude [A]
+ * @return false if a calibration is already running
+ */
+bool Service_CommAdvance_CalStart(float speed_hz, float current_a);
+
+/**
+ * @brief Advance the calibration sweep by one slow-loop tick (1 ms).
+ *
+ * Each advance of the sweep is held for a settling time, then the phase
+ * current is averaged; at the end the minimum (refined by a parabola
+ * through its neighbours) is written to the cell. The sweep is aborted if
+ * the speed leaves the operating point.
+ *
+ * @param speed_hz  Electrical speed [Hz]
+ * @param current_a Phase current magnitude [A]
+ */
+void Service_CommAdvance_CalTick(float speed_hz, float current_a);
+
+/**
+ * @brief Stop a running calibration, table unchanged.
+ */
+void Service_CommAdvance_CalAbort(void);
+
+/**
+ * @brief Tell whether a calibration is running.
+ */
+bool Service_CommAdvance_CalActive(void);
+
+#endif /* SERVICE_COMM_ADVANCE_H */
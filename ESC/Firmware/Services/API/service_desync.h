@@ -0,0 +1,111 @@
+/**
+ * @file service_desync.h
+ * @brief Loss-of-synchronization detector for sensorless six-step commutation.
+ *
+ * Watches the closed-loop drive for the symptoms of a desync (the
+ * commutations no longer follow the rotor):
+ *  - Zero-cross window: each crossing is expected one filtered period after
+ *    the previous one; arrivals outside ± window count as strikes
+ *  - Period jump: an interval beyond [1/jump, jump] × period counts double
+ *  - Zero-cross timeout: no crossing for several periods trips at once
+ *    (the commutations run on a stale period)
+ *  - Current spike: phase current well above its running mean for a few
+ *    consecutive fast-loop ticks (no BEMF left to oppose the supply)
+ *
+ * Strikes are cleared by an in-window crossing, so a single noisy edge
+ * does not trip the detector. Only reports the cause: the recovery policy
+ * belongs to the caller.
+ */
+
+#ifndef SERVICE_DESYNC_H
+#define SERVICE_DESYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Detected desync cause.
+ */
+typedef enum {
+    DESYNC_NONE = 0,            /**< In sync */
+    DESYNC_ZC_TIMEOUT,          /**< No zero-cross for too long */
+    DESYNC_ZC_WINDOW,           /**< Zero-crosses repeatedly off their expected time */
+    DESYNC_PERIOD_JUMP,         /**< Zero-cross interval jumped */
+    DESYNC_CURRENT_SPIKE,       /**< Phase current far above its mean */
+    DESYNC_CAUSE_COUNT
+} desync_cause_t;
+
+/**
+ * @struct desync_detector_t
+ * @brief Desync detector parameters and state.
+ */
+typedef struct {
+    /* === Configuration parameters === */
+    float   window;             /**< Accepted interval error (fraction of the period) */
+    float   jump_ratio;         /**< Interval ratio counted as a period jump */
+    float   timeout_periods;    /**< Periods without zero-cross before tripping */
+    uint8_t max_strikes;        /**< Strikes to trip (window miss = 1, jump = 2) */
+    uint8_t grace_events;       /**< Zero-crosses ignored after arming */
+    float   spike_ratio;        /**< Spike: current above ratio × mean ... */
+    float   spike_min_a;        /**< ... and above this absolute level [A] */
+    uint8_t spike_ticks;        /**< Consecutive spike ticks to trip */
+
+    /* === Internal state === */
+    float    period_us;         /**< Filtered zero-cross interval */
+    uint32_t last_zc_us;        /**< Last zero-cross */
+    float    current_mean_a;    /**< Running mean of the phase current */
+    uint8_t  strikes;           /**< Accumulated window / jump strikes */
+    uint8_t  grace;             /**< Zero-crosses still ignored */
+    uint8_t  spike_count;       /**< Consecutive ticks above the spike level */
+    bool     armed;             /**< Watching (closed loop) */
+} desync_detector_t;
+
+/**
+ * @brief Initialize a detector with the default thresholds (disarmed).
+ *
+ * @param d Pointer to detector structure
+ */
+void Service_Desync_Init(desync_detector_t *d);
+
+/**
+ * @brief Start watching from a known-good zero-cross.
+ *
+ * @param d         Pointer to detector structure
+ * @param zc_us     Last zero-cross instant [µs]
+ * @param period_us Current zero-cross interval [µs]
+ * @param current_a Current phase current [A]
+ */
+void Service_Desync_Arm(desync_detector_t *d, uint32_t zc_us, float period_us, float current_a);
+
+/**
+ * @brief Stop watching (open loop, stopped, recovering).
+ *
+ * @param d Pointer to detector structure
+ */
+void Service_Desync_Disarm(desync_detector_t *d);
+
+/**
+ * @brief Check one zero-cross against its expected window.
+ *
+ * @param d     Pointer to detector structure
+ * @param zc_us Crossing instant (interpolated or captured) [µs]
+ * @return Cause if the detector trips (then disarmed), DESYNC_NONE otherwise
+ */
+desync_cause_t Service_Desync_OnZeroCross(desync_detector_t *d, uint32_t zc_us);
+
+/**
+ * @brief Fast-loop check: zero-cross timeout and current spike.
+ *
+ * @param d         Pointer to detector structure
+ * @param now_us    Current time [µs]
+ * @param current_a Phase current magnitude [A]
+ * @return Cause if the detector trips (then disarmed), DESYNC_NONE otherwise
+ */
+desync_cause_t Service_Desync_Tick(desync_detector_t *d, uint32_t now_us, float current_a);
+
+/**
+ * @brief Short name of a cause, for logs.
+ */
+const char *Service_Desync_CauseName(desync_cause_t cause);
+
+#endif /* SERVICE_DESYNC_H */
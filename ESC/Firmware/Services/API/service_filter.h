@@ -0,0 +1,52 @@
+/**
+ * @file service_filter.h
+ * @brief Run-time configuration of the ADC channel filters (FMAC on target).
+ *
+ * Thin wrapper over IFilter (i_filter.h) for the control layer, which does
+ * not see the interfaces. Every injected channel goes through one section
+ * before it is published; the cutoffs can be changed while the motor runs
+ * (the section changes on the next sample, its state is kept).
+ */
+
+#ifndef SERVICE_FILTER_H
+#define SERVICE_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Filtered channels (same order as filter_channel_t).
+ */
+typedef enum
+{
+    SERVICE_FILTER_CURRENT_A = 0,
+    SERVICE_FILTER_CURRENT_B,
+    SERVICE_FILTER_VOLTAGE_A,
+    SERVICE_FILTER_VOLTAGE_B,
+    SERVICE_FILTER_VOLTAGE_C,
+    SERVICE_FILTER_VOLTAGE_BUS,
+} service_filter_channel_t;
+
+/**
+ * @brief Section types (same order as filter_type_t).
+ */
+typedef enum
+{
+    SERVICE_FILTER_BYPASS = 0,      /**< No filtering */
+    SERVICE_FILTER_LOWPASS1,        /**< First order */
+    SERVICE_FILTER_LOWPASS2,        /**< Second-order Butterworth */
+} service_filter_type_t;
+
+/**
+ * @brief Set the filter of a channel.
+ * @param cutoff_hz -3 dB frequency (below 12 kHz; ignored for a bypass)
+ * @return false if out of range (filter unchanged)
+ */
+bool Service_Filter_Configure(service_filter_channel_t ch, service_filter_type_t type, float cutoff_hz);
+
+/**
+ * @brief Group delay of a channel filter on slow signals [samples].
+ */
+float Service_Filter_GetDelay(service_filter_channel_t ch);
+
+#endif /* SERVICE_FILTER_H */
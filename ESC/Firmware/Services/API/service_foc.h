@@ -0,0 +1,192 @@
+/**
+ * @file service_foc.h
+ * @brief Field-oriented control building blocks: transforms, phase current
+ *        reconstruction, sensorless flux observer and angle PLL (modulation:
+ *        service_modulator.h).
+ *
+ * Frames (amplitude-invariant):
+ *  - abc → αβ: α along phase A, i_a + i_b + i_c = 0
+ *  - αβ → dq: d along the rotor flux at angle θ, q 90° ahead
+ *
+ * Angles are in radians here (they only feed the CORDIC, i_math.h), the control layer
+ * reports degrees.
+ *
+ * The shunt amplifiers are unidirectional: the ADC gives |i_a| and |i_b|
+ * only. The signs are taken from a one-period prediction of the current
+ * (Service_Foc_Observer_PredictCurrent(): machine equation with the
+ * back-EMF of the observed rotor flux) by Service_Foc_SignCurrents(). A
+ * wrong sign can only happen on a phase whose current is within the
+ * prediction error of zero. Since the prediction starts from the previous
+ * (signed) sample, a phase that was near zero is also tried with its
+ * previous sign flipped, so a wrong sign does not latch. The control layer
+ * keeps the current vector above a minimum so that both phases are not
+ * near zero at the same time.
+ *
+ * The observer is the nonlinear flux observer of Ortega et al.: the stator
+ * flux is integrated from v - R·i, and the rotor flux estimate η = ψ - L·i
+ * is pulled back onto the circle of the known magnet flux, which removes
+ * the integrator drift without a high-pass filter (no phase error at low
+ * speed). The angle of η is the rotor flux angle; a PLL on it gives a
+ * smooth angle and the speed.
+ */
+
+#ifndef SERVICE_FOC_H
+#define SERVICE_FOC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Stationary-frame vector (current [A] or voltage [V]).
+ */
+typedef struct {
+    float alpha;
+    float beta;
+} foc_ab_t;
+
+/**
+ * @brief Rotor-frame vector (current [A] or voltage [V]).
+ */
+typedef struct {
+    float d;
+    float q;
+} foc_dq_t;
+
+/**
+ * @struct foc_observer_t
+ * @brief Nonlinear flux observer state and parameters.
+ */
+typedef struct {
+    /* === Configuration parameters === */
+    float r_ohm;        /**< Phase resistance [Ω] */
+    float l_h;          /**< Phase inductance [H] */
+    float flux_wb;      /**< Magnet flux linkage (fundamental, per phase) [Wb] */
+    float gamma;        /**< Observer gain [1/(Wb²·s)] */
+
+    /* === Internal state === */
+    foc_ab_t psi;       /**< Stator flux estimate [Wb] */
+    foc_ab_t eta;       /**< Rotor flux estimate ψ - L·i [Wb] */
+    foc_ab_t i_prev;    /**< Current of the previous update [A] */
+    float    theta_rad; /**< Rotor flux angle [rad, -π – π] */
+} foc_observer_t;
+
+/**
+ * @struct foc_pll_t
+ * @brief Angle tracking loop (type 2) on the observer angle.
+ */
+typedef struct {
+    /* === Configuration parameters === */
+    float kp;           /**< Proportional gain [1/s] */
+    float ki;           /**< Integral gain [1/s²] */
+
+    /* === Internal state === */
+    float theta_rad;    /**< Tracked angle [rad, -π – π] */
+    float omega_rad_s;  /**< Electrical speed [rad/s] */
+} foc_pll_t;
+
+/**
+ * @brief Clarke transform of two phase currents (third one from Σ = 0).
+ */
+foc_ab_t Service_Foc_Clarke(float i_a, float i_b);
+
+/**
+ * @brief Park transform: stationary → rotor frame at the angle of (sin, cos).
+ */
+foc_dq_t Service_Foc_Park(const foc_ab_t *ab, float sin_t, float cos_t);
+
+/**
+ * @brief Inverse Park transform: rotor → stationary frame.
+ */
+foc_ab_t Service_Foc_InvPark(const foc_dq_t *dq, float sin_t, float cos_t);
+
+/**
+ * @brief Phase voltage vector produced by a set of duties (average over a
+ *        PWM period, common mode removed).
+ */
+foc_ab_t Service_Foc_VoltageOfDuties(const float duty[3], float vbus);
+
+/**
+ * @brief Signed phase currents from their magnitudes and the expected vector.
+ *
+ * @param mag_a    |i_a| [A]
+ * @param mag_b    |i_b| [A]
+ * @param expected Current vector expected at the sampling instant [A]
+ * @param previous Signed current vector of the previous sample [A]
+ * @param band     Below this previous phase current [A] its sign is re-checked
+ * @param i_a      Signed phase A current [A]
+ * @param i_b      Signed phase B current [A]
+ */
+void Service_Foc_SignCurrents(float mag_a, float mag_b, const foc_ab_t *expected, const foc_ab_t *previous,
+                              float band, float *i_a, float *i_b);
+
+/**
+ * @brief Initialize an observer with the motor parameters and reset it.
+ *
+ * @param obs     Pointer to observer structure
+ * @param r_ohm   Phase resistance [Ω]
+ * @param l_h     Phase inductance [H]
+ * @param flux_wb Magnet flux linkage [Wb]
+ */
+void Service_Foc_Observer_Init(foc_observer_t *obs, float r_ohm, float l_h, float flux_wb);
+
+/**
+ * @brief Restart the observer with the rotor flux at @p theta_rad.
+ *
+ * @param obs       Pointer to observer structure
+ * @param theta_rad Rotor flux angle [rad]
+ * @param i         Current flowing now [A] (NULL: none)
+ */
+void Service_Foc_Observer_Reset(foc_observer_t *obs, float theta_rad, const foc_ab_t *i);
+
+/**
+ * @brief Integrate one period.
+ *
+ * @param obs Pointer to observer structure
+ * @param v   Voltage applied over the period [V]
+ * @param i   Current at the end of the period [A]
+ * @param dt  Period [s]
+ * @return Rotor flux angle [rad]
+ */
+float Service_Foc_Observer_Update(foc_observer_t *obs, const foc_ab_t *v, const foc_ab_t *i, float dt);
+
+/**
+ * @brief Current expected at the end of the next period.
+ *
+ * One step of L·di/dt = v - R·i - e from the last measured current, with
+ * the back-EMF e = ω × η of the rotor flux estimate.
+ *
+ * @param obs         Pointer to observer structure
+ * @param v           Voltage applied over the period [V]
+ * @param omega_rad_s Electrical speed [rad/s]
+ * @param dt          Period [s]
+ * @return Predicted current [A]
+ */
+foc_ab_t Service_Foc_Observer_PredictCurrent(const foc_observer_t *obs, const foc_ab_t *v, float omega_rad_s, float dt);
+
+/**
+ * @brief Initialize a PLL for a loop bandwidth of @p bandwidth_hz (ζ = 1)
+ *        and reset it.
+ */
+void Service_Foc_Pll_Init(foc_pll_t *pll, float bandwidth_hz);
+
+/**
+ * @brief Restart the PLL at a known angle and speed.
+ */
+void Service_Foc_Pll_Reset(foc_pll_t *pll, float theta_rad, float omega_rad_s);
+
+/**
+ * @brief Track one new angle measurement.
+ *
+ * @param pll        Pointer to PLL structure
+ * @param theta_meas Measured angle [rad]
+ * @param dt         Time since the last update [s]
+ * @return Tracked angle [rad]
+ */
+float Service_Foc_Pll_Update(foc_pll_t *pll, float theta_meas, float dt);
+
+/**
+ * @brief Wrap an angle to [-π, π) (one step per turn: for angles within a few turns).
+ */
+float Service_Foc_WrapPi(float rad);
+
+#endif /* SERVICE_FOC_H */
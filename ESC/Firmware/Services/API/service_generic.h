@@ -133,6 +133,20 @@ void Service_GetRunTimeString(char *buffer, size_t buf_size);
  */
 uint32_t Service_GetSysFrequencyMHz(void);
 
+/**
+ * @brief Print the execution-time profile of the loops and ISRs.
+ *
+ * For each IPerf probe (fast loop, low loop, ADC JEOC, one-shot) prints
+ * count, min/mean/max in cycles and µs, the overrun count against the
+ * probe budget and the non-empty log2 histogram bins.
+ */
+void Service_Perf_Print(void);
+
+/**
+ * @brief Clear the execution-time statistics (budgets are kept).
+ */
+void Service_Perf_Reset(void);
+
 /**
  * @brief Perform a software reset of the MCU.
  *
@@ -236,6 +250,12 @@ float Service_Get_PhaseB_Current(void);
 // Returns Phase C current in Amperes
 float Service_Get_PhaseC_Current(void);
 
+// Returns Phase A current magnitude of the last trigger (unfiltered) in Amperes
+float Service_Get_PhaseA_Current_Inst(void);
+
+// Returns Phase B current magnitude of the last trigger (unfiltered) in Amperes
+float Service_Get_PhaseB_Current_Inst(void);
+
 
 /* -------------------------------------------------------------------------- */
 /*                          User-friendly macros                              */
@@ -268,6 +288,7 @@ typedef enum {
 /// Logging / Debug commands
 typedef enum {
     CMD_LOGLEVEL    = 0x0100,   ///< Set logging level (error, warn, info, debug)
+    CMD_PERF        = 0x0105,   ///< Dump and reset loop / ISR execution profile
     // CMD_LOGON       = 0x0101,   ///< Enable logging output
     // CMD_LOGOFF      = 0x0102,   ///< Disable logging output
     // CMD_TRACEON     = 0x0103,   ///< Enable trace/debug output
@@ -291,6 +312,11 @@ typedef enum {
     CMD_STARTRAMP    = 0x1004,
     CMD_STOPRAMP     = 0x1005,
     CMD_GETSPEED     = 0x1006,
+    CMD_ADVGET       = 0x1007,  ///< Print the commutation advance map
+    CMD_ADVSET       = 0x1008,  ///< Set one cell of the advance map
+    CMD_ADVCAL       = 0x1009,  ///< Calibrate the advance at the operating point
+    CMD_DRIVE        = 0x100A,  ///< Select the drive (six-step / FOC)
+    CMD_SETTORQUE    = 0x100B,  ///< Torque mode: current reference of the six-step drive
     // CMD_MOVE         = 0x100x,
     // CMD_TAKE_CONTROL = 0x100x,
 } project_cmd_t;
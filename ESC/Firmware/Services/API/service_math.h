@@ -0,0 +1,36 @@
+/**
+ * @file service_math.h
+ * @brief Trigonometry for the control path (CORDIC on target).
+ *
+ * Thin wrappers over IMath (i_math.h) for the control layer, which does not
+ * see the interfaces. Use these instead of sinf/cosf/atan2f/sqrtf in
+ * anything that runs in the fast loop: on target they run on the CORDIC
+ * coprocessor, on the host on a software model giving the same results.
+ */
+
+#ifndef SERVICE_MATH_H
+#define SERVICE_MATH_H
+
+#include <stdint.h>
+
+/**
+ * @brief Sine and cosine of an angle [rad] (any angle, no wrapping needed).
+ */
+void Service_Math_SinCos(float angle_rad, float *sin_out, float *cos_out);
+
+/**
+ * @brief Sine and cosine of @p n angles [rad] in one pipelined run.
+ */
+void Service_Math_SinCosN(const float *angle_rad, float *sin_out, float *cos_out, uint32_t n);
+
+/**
+ * @brief Angle of the vector (x, y) [rad, -π – π]; 0 for the null vector.
+ */
+float Service_Math_Atan2(float y, float x);
+
+/**
+ * @brief Length of the vector (x, y).
+ */
+float Service_Math_Magnitude(float x, float y);
+
+#endif /* SERVICE_MATH_H */
@@ -0,0 +1,69 @@
+/**
+ * @file service_modulator.h
+ * @brief Space-vector modulator: voltage vector to centred phase duties.
+ *
+ * Turns a phase voltage vector (α/β or magnitude/angle, in volts) into the
+ * three duties of a centre-aligned PWM, normalised by the bus voltage:
+ *
+ *  - Linear range (|v| ≤ Vbus/√3): min-max zero sequence (the same line-to-
+ *    line voltages as third-harmonic injection, 15 % above sine PWM), the
+ *    zero sequence centred.
+ *  - Overmodulation (Vbus/√3 < |v| < 2·Vbus/π): the reference is amplified
+ *    along its direction and brought back onto the hexagon at its nearest
+ *    point. The amplification comes from a table so that the fundamental
+ *    of the applied voltage equals the request (within 0.2 %), up to
+ *    six-step.
+ *  - Six-step (|v| ≥ 2·Vbus/π): nearest hexagon vertex, fundamental
+ *    2·Vbus/π.
+ *
+ * Every duty stays within [0, duty_max]: the usable bus is duty_max·Vbus,
+ * and when the spread leaves no room for centring, the zero sequence moves
+ * down so that the largest duty stays at duty_max (off-time kept for the
+ * current sample).
+ */
+
+#ifndef SERVICE_MODULATOR_H
+#define SERVICE_MODULATOR_H
+
+#include <stdint.h>
+
+/**
+ * @brief Region the last vector was modulated in.
+ */
+typedef enum
+{
+    MODULATOR_LINEAR = 0,       /**< Applied exactly */
+    MODULATOR_OVERMODULATION,   /**< Fundamental exact, low-order harmonics added */
+    MODULATOR_SIX_STEP,         /**< At or beyond the six-step fundamental (limited) */
+} modulator_region_t;
+
+/**
+ * @brief Duties of a voltage vector given in α/β.
+ * @param v_alpha  α voltage [V]
+ * @param v_beta   β voltage [V]
+ * @param vbus     DC bus voltage [V] (duties all 0 if not positive)
+ * @param duty_max Largest duty allowed (0 – 1)
+ * @param duty     Phase duties A, B, C
+ */
+modulator_region_t Service_Modulator_AlphaBeta(float v_alpha, float v_beta, float vbus,
+                                               float duty_max, float duty[3]);
+
+/**
+ * @brief Duties of a voltage vector given as magnitude and angle.
+ * @param v_mag     Magnitude [V] (fundamental amplitude of the phase voltage)
+ * @param angle_rad Angle from phase A [rad]
+ */
+modulator_region_t Service_Modulator_Polar(float v_mag, float angle_rad, float vbus,
+                                           float duty_max, float duty[3]);
+
+/**
+ * @brief Largest vector applied exactly (circle inscribed in the hexagon).
+ */
+float Service_Modulator_MaxLinear(float vbus, float duty_max);
+
+/**
+ * @brief Largest fundamental (six-step).
+ */
+float Service_Modulator_MaxVoltage(float vbus, float duty_max);
+
+#endif /* SERVICE_MODULATOR_H */
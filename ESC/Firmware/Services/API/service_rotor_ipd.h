@@ -0,0 +1,90 @@
+/**
+ * @file service_rotor_ipd.h
+ * @brief Initial rotor position detection by inductive sensing (IPD).
+ *
+ * Replaces the blind alignment at start-up: each of the six six-step
+ * vectors gets one short voltage pulse, and the phase current reached at
+ * the end of the pulse is read from the injected ADC sample taken inside
+ * it. The stator iron saturates more when the pulse adds to the magnet
+ * flux, so the current rises fastest on the vector closest to the magnet
+ * axis (north pole), slowest on the opposite one.
+ *
+ * The angle is the phase of the first harmonic of the six peak currents
+ * over the vector angles: the saliency term (180° period, same on both
+ * poles) falls on the second harmonic and does not bias it.
+ *
+ * Sequence (one step per fast-loop tick, ADC-synchronous fast loop):
+ *  - arm: pattern of CW step k at IPD duty, ADC trigger moved to the end
+ *    of the pulse (both take effect at the next PWM period)
+ *  - sample: peak current read, bridge off (current decays through the
+ *    body diodes)
+ *  - rest: a few periods, then the next vector
+ * About 1.5 ms in total, with a few amperes for ~20 µs per pulse: the
+ * rotor does not move.
+ *
+ * Only valid with the rotor at rest: a BEMF adds its own asymmetry. The
+ * bridge must be stopped (Service_Motor_Stop()) before the start and the
+ * caller must not read the motor measurements while it runs.
+ */
+
+#ifndef SERVICE_ROTOR_IPD_H
+#define SERVICE_ROTOR_IPD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ROTOR_IPD_VECTORS   6       /**< One pulse per six-step pattern */
+
+/**
+ * @brief Detection progress.
+ */
+typedef enum {
+    ROTOR_IPD_IDLE = 0,         /**< Not started */
+    ROTOR_IPD_RUNNING,          /**< Pulses in progress */
+    ROTOR_IPD_DONE              /**< Result available (check valid) */
+} rotor_ipd_state_t;
+
+/**
+ * @brief Detection result.
+ */
+typedef struct {
+    float angle_deg;                        /**< Rotor electrical angle [0, 360), zero-cross PLL frame */
+    float contrast;                         /**< First-harmonic amplitude / mean of the peak currents */
+    float peak_a[ROTOR_IPD_VECTORS];        /**< Current at the end of the pulse of each vector [A] */
+    bool  valid;                            /**< Enough current and contrast to trust the angle */
+} rotor_ipd_result_t;
+
+/**
+ * @brief Start the pulse sequence (bridge off, all compares cleared).
+ */
+void Service_RotorIpd_Start(void);
+
+/**
+ * @brief Advance the sequence by one step (fast loop, after each ADC sample).
+ *
+ * Consumes the motor measurements.
+ *
+ * @return ROTOR_IPD_RUNNING until the result is available
+ */
+rotor_ipd_state_t Service_RotorIpd_Process(void);
+
+/**
+ * @brief Read the result of the last completed detection.
+ *
+ * @param out Result (unchanged if none)
+ * @return true if a detection has completed since the last start
+ */
+bool Service_RotorIpd_GetResult(rotor_ipd_result_t *out);
+
+/**
+ * @brief Estimate the rotor angle from the six peak currents.
+ *
+ * Vector k (pattern of CW step k) lines up with the magnet at
+ * 150° + 60°·k.
+ *
+ * @param peak_a Current at the end of the pulse of each vector [A]
+ * @param out    Angle, contrast and validity
+ */
+void Service_RotorIpd_Estimate(const float peak_a[ROTOR_IPD_VECTORS], rotor_ipd_result_t *out);
+
+#endif /* SERVICE_ROTOR_IPD_H */
@@ -0,0 +1,107 @@
+/**
+ * @file service_zc_pll.h
+ * @brief Phase-locked speed and position estimator fed by BEMF zero-crosses.
+ *
+ * Tracks the electrical angle of a six-step drive from timestamped
+ * zero-cross events, with a third-order (angle, speed, acceleration) loop:
+ *  - Between events the state is propagated at constant acceleration, so
+ *    angle, speed and acceleration can be read at any fast-loop tick
+ *  - At each event the angle error to the known crossing angle corrects
+ *    the three states (critically damped α-β-γ gains, one set per event,
+ *    i.e. a loop bandwidth proportional to the speed)
+ *  - An event too far from the prediction is rejected instead of pulling
+ *    the estimate; several in a row drop the lock and re-acquire
+ *
+ * The angle is in the commutation frame: it increases by 60° per six-step
+ * step whatever the direction, the crossing of step k being at 60° + 60°·k.
+ */
+
+#ifndef SERVICE_ZC_PLL_H
+#define SERVICE_ZC_PLL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @struct zc_pll_t
+ * @brief Zero-cross PLL internal state and parameters.
+ */
+typedef struct {
+    /* === Configuration parameters === */
+    float k_angle;      /**< α: angle correction per event (fraction of the error) */
+    float k_speed;      /**< β: speed correction per event (× error / dt) */
+    float k_accel;      /**< γ: acceleration correction per event (× 2·error / dt²) */
+    float gate_deg;     /**< Largest accepted angle error of an event [° electrical] */
+
+    /* === Internal state (at t_us) === */
+    float    theta_deg;     /**< Electrical angle [°, 0 – 360) */
+    float    omega_dps;     /**< Electrical speed [°/s] */
+    float    accel_dps2;    /**< Electrical acceleration [°/s²] */
+    uint32_t t_us;          /**< Time of the state (last event) [µs] */
+
+    uint8_t  events;        /**< Events accepted since reset (saturating) */
+    uint8_t  rejects;       /**< Consecutive rejected events */
+    bool     locked;        /**< Estimate usable for commutation timing */
+} zc_pll_t;
+
+/**
+ * @brief Estimate of the PLL at a given time.
+ */
+typedef struct {
+    float theta_deg;        /**< Electrical angle [°, 0 – 360) */
+    float omega_dps;        /**< Electrical speed [°/s] */
+    float accel_dps2;       /**< Electrical acceleration [°/s²] */
+    bool  locked;           /**< Estimate usable (see zc_pll_t::locked) */
+} zc_pll_estimate_t;
+
+/**
+ * @brief Initialize a PLL instance (default gains) and reset it.
+ *
+ * @param pll Pointer to PLL structure
+ */
+void Service_ZcPll_Init(zc_pll_t *pll);
+
+/**
+ * @brief Forget the tracked rotor (restart, stop, desync).
+ *
+ * @param pll Pointer to PLL structure
+ */
+void Service_ZcPll_Reset(zc_pll_t *pll);
+
+/**
+ * @brief Feed one zero-cross event.
+ *
+ * The first event sets the angle, the second the speed (60° over their
+ * interval), the following ones run the tracking loop.
+ *
+ * @param pll       Pointer to PLL structure
+ * @param zc_us     Crossing instant (interpolated or captured) [µs]
+ * @param step      Six-step step during which it occurred (0 – 5)
+ * @return true if the event was accepted
+ */
+bool Service_ZcPll_OnZeroCross(zc_pll_t *pll, uint32_t zc_us, uint8_t step);
+
+/**
+ * @brief Predict angle, speed and acceleration at @p now_us (state unchanged).
+ *
+ * @param pll    Pointer to PLL structure
+ * @param now_us Time of the estimate [µs]
+ * @param out    Estimate
+ */
+void Service_ZcPll_Estimate(const zc_pll_t *pll, uint32_t now_us, zc_pll_estimate_t *out);
+
+/**
+ * @brief Time from @p now_us until the predicted angle reaches @p target_deg.
+ *
+ * The target is taken within half a turn of the current angle: behind it,
+ * it counts as already reached.
+ *
+ * @param pll        Pointer to PLL structure
+ * @param now_us     Reference time [µs]
+ * @param target_deg Electrical angle to reach [°]
+ * @return Delay [µs] (0 if passed), or a negative value if not locked /
+ *         not moving forward
+ */
+float Service_ZcPll_TimeToAngle(const zc_pll_t *pll, uint32_t now_us, float target_deg);
+
+#endif /* SERVICE_ZC_PLL_H */
@@ -0,0 +1,263 @@
+/**
+ * @file service_comm_advance.c
+ * @brief Implementation of the commutation advance map and its calibration.
+ */
+
+#include "service_comm_advance.h"
+#include "service_generic.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/* ========================================================================== */
+/* === Configuration ======================================================== */
+/* ========================================================================== */
+
+#define COMM_ADV_CAL_MIN_DEG      0.0f     /**< First advance of the sweep */
+#define COMM_ADV_CAL_STEP_DEG     2.5f     /**< Sweep increment */
+#define COMM_ADV_CAL_POINTS       11U      /**< 0 – 25° */
+#define COMM_ADV_CAL_SETTLE_MS    100U     /**< Speed loop settling after each change */
+#define COMM_ADV_CAL_MEASURE_MS   100U     /**< Current averaging window */
+#define COMM_ADV_CAL_SPEED_TOL    0.2f     /**< Abort beyond ±20 % of the start speed */
+
+/** Speed breakpoints [Hz electrical] (10 000 rpm, 6 pole pairs = 1 kHz) */
+static const float s_speed_axis_hz[COMM_ADV_SPEED_POINTS] = { 0.0f, 100.0f, 250.0f, 500.0f, 750.0f, 1000.0f };
+
+/** Current breakpoints [A] */
+static const float s_current_axis_a[COMM_ADV_CURRENT_POINTS] = { 0.0f, 5.0f, 10.0f, 20.0f };
+
+/** Default advance [°]: the ω·L·I lag grows with speed and current */
+static const float s_default_deg[COMM_ADV_SPEED_POINTS][COMM_ADV_CURRENT_POINTS] = {
+    {  0.0f,  0.0f,  0.0f,  0.0f },
+    {  2.0f,  2.5f,  3.0f,  4.0f },
+    {  4.0f,  5.0f,  6.0f,  8.0f },
+    {  8.0f, 10.0f, 12.0f, 15.0f },
+    { 12.0f, 14.0f, 16.0f, 20.0f },
+    { 15.0f, 18.0f, 21.0f, 25.0f },
+};
+
+/* ========================================================================== */
+/* === Module State ======================================================== */
+/* ========================================================================== */
+
+static float s_table_deg[COMM_ADV_SPEED_POINTS][COMM_ADV_CURRENT_POINTS];
+
+/** Calibration sweep */
+static struct {
+    bool     active;
+    uint8_t  row, col;              /**< Cell under calibration */
+    float    speed_hz;              /**< Operating point speed at start */
+    uint8_t  point;                 /**< Sweep index */
+    uint16_t ms;                    /**< Time at this point */
+    float    sum_a;                 /**< Current accumulated over the window */
+    float    mean_a[COMM_ADV_CAL_POINTS];
+} s_cal;
+
+/* ========================================================================== */
+/* === Helpers ============================================================= */
+/* ========================================================================== */
+
+/**
+ * @brief Locate @p x on a breakpoint axis.
+ *
+ * @param axis Increasing breakpoints
+ * @param n    Number of breakpoints
+ * @param x    Value
+ * @param frac Out: position between the returned index and the next (0 – 1)
+ * @return Lower breakpoint index (clamped to the axis)
+ */
+static uint8_t CommAdv_Locate(const float *axis, uint8_t n, float x, float *frac)
+{
+    if (x <= axis[0])
+    {
+        *frac = 0.0f;
+        return 0U;
+    }
+
+    for (uint8_t i = 0; i + 1U < n; i++)
+    {
+        if (x < axis[i + 1U])
+        {
+            *frac = (x - axis[i]) / (axis[i + 1U] - axis[i]);
+            return i;
+        }
+    }
+
+    *frac = 1.0f;
+    return (uint8_t)(n - 2U);
+}
+
+/** Index of the breakpoint nearest to @p x */
+static uint8_t CommAdv_Nearest(const float *axis, uint8_t n, float x)
+{
+    float frac;
+    uint8_t i = CommAdv_Locate(axis, n, x, &frac);
+    return (frac < 0.5f) ? i : (uint8_t)(i + 1U);
+}
+
+static float CommAdv_SweepDeg(uint8_t point)
+{
+    return COMM_ADV_CAL_MIN_DEG + COMM_ADV_CAL_STEP_DEG * (float)point;
+}
+
+/**
+ * @brief End of sweep: minimum current, refined with a parabola through
+ *        its two neighbours, stored in the cell.
+ */
+static void CommAdv_CalFinish(void)
+{
+    uint8_t best = 0U;
+    for (uint8_t p = 1U; p < COMM_ADV_CAL_POINTS; p++)
+    {
+        if (s_cal.mean_a[p] < s_cal.mean_a[best])
+            best = p;
+    }
+
+    float adv = CommAdv_SweepDeg(best);
+    if (best > 0U && best + 1U < COMM_ADV_CAL_POINTS)
+    {
+        float y0 = s_cal.mean_a[best - 1U], y1 = s_cal.mean_a[best], y2 = s_cal.mean_a[best + 1U];
+        float den = y0 - 2.0f * y1 + y2;
+        if (den > 0.0f)
+            adv += 0.5f * COMM_ADV_CAL_STEP_DEG * (y0 - y2) / den;
+    }
+
+    s_cal.active = false;
+    (void)Service_CommAdvance_SetCell(s_cal.row, s_cal.col, adv);
+
+    char adv_str[16];
+    Service_FloatToString(s_table_deg[s_cal.row][s_cal.col], adv_str, 1);
+    LOG_INFO("Advance calibration done: cell [%u][%u] = %s deg", (unsigned)s_cal.row, (unsigned)s_cal.col, adv_str);
+}
+
+/* ========================================================================== */
+/* === Public API =========================================================== */
+/* ========================================================================== */
+
+void Service_CommAdvance_Init(void)
+{
+    for (uint8_t r = 0; r < COMM_ADV_SPEED_POINTS; r++)
+        for (uint8_t c = 0; c < COMM_ADV_CURRENT_POINTS; c++)
+            s_table_deg[r][c] = s_default_deg[r][c];
+
+    s_cal.active = false;
+}
+
+float Service_CommAdvance_Get(float speed_hz, float current_a)
+{
+    if (s_cal.active)
+        return CommAdv_SweepDeg(s_cal.point);
+
+    float fs, fc;
+    uint8_t r = CommAdv_Locate(s_speed_axis_hz, COMM_ADV_SPEED_POINTS, speed_hz, &fs);
+    uint8_t c = CommAdv_Locate(s_current_axis_a, COMM_ADV_CURRENT_POINTS, current_a, &fc);
+
+    float lo = s_table_deg[r][c]      + fc * (s_table_deg[r][c + 1U]      - s_table_deg[r][c]);
+    float hi = s_table_deg[r + 1U][c] + fc * (s_table_deg[r + 1U][c + 1U] - s_table_deg[r + 1U][c]);
+    return lo + fs * (hi - lo);
+}
+
+bool Service_CommAdvance_SetCell(uint8_t speed_idx, uint8_t current_idx, float advance_deg)
+{
+    if (speed_idx >= COMM_ADV_SPEED_POINTS || current_idx >= COMM_ADV_CURRENT_POINTS)
+        return false;
+    if (!(advance_deg >= 0.0f && advance_deg <= COMM_ADV_MAX_DEG))
+        return false;
+
+    s_table_deg[speed_idx][current_idx] = advance_deg;
+    return true;
+}
+
+bool Service_CommAdvance_GetCell(uint8_t speed_idx, uint8_t current_idx, float *advance_deg)
+{
+    if (advance_deg == NULL || speed_idx >= COMM_ADV_SPEED_POINTS || current_idx >= COMM_ADV_CURRENT_POINTS)
+        return false;
+
+    *advance_deg = s_table_deg[speed_idx][current_idx];
+    return true;
+}
+
+void Service_CommAdvance_Print(void)
+{
+    char line[96];
+    char num[16];
+    size_t used;
+
+    LOG_NONE("Commutation advance [deg] (rows: speed Hz el., columns: current A)");
+
+    used = (size_t)snprintf(line, sizeof(line), "%8s", "");
+    for (uint8_t c = 0; c < COMM_ADV_CURRENT_POINTS; c++)
+    {
+        Service_FloatToString(s_current_axis_a[c], num, 1);
+        used += (size_t)snprintf(line + used, sizeof(line) - used, " %7s", num);
+    }
+    LOG_NONE("%s", line);
+
+    for (uint8_t r = 0; r < COMM_ADV_SPEED_POINTS; r++)
+    {
+        Service_FloatToString(s_speed_axis_hz[r], num, 0);
+        used = (size_t)snprintf(line, sizeof(line), "%u:%6s", (unsigned)r, num);
+        for (uint8_t c = 0; c < COMM_ADV_CURRENT_POINTS; c++)
+        {
+            Service_FloatToString(s_table_deg[r][c], num, 1);
+            used += (size_t)snprintf(line + used, sizeof(line) - used, " %7s", num);
+        }
+        LOG_NONE("%s", line);
+    }
+}
+
+bool Service_CommAdvance_CalStart(float speed_hz, float current_a)
+{
+    if (s_cal.active)
+        return false;
+
+    s_cal.row      = CommAdv_Nearest(s_speed_axis_hz, COMM_ADV_SPEED_POINTS, speed_hz);
+    s_cal.col      = CommAdv_Nearest(s_current_axis_a, COMM_ADV_CURRENT_POINTS, current_a);
+    s_cal.speed_hz = speed_hz;
+    s_cal.point    = 0U;
+    s_cal.ms       = 0U;
+    s_cal.sum_a    = 0.0f;
+    s_cal.active   = true;
+
+    LOG_INFO("Advance calibration: cell [%u][%u]", (unsigned)s_cal.row, (unsigned)s_cal.col);
+    return true;
+}
+
+void Service_CommAdvance_CalTick(float speed_hz, float current_a)
+{
+    if (!s_cal.active)
+        return;
+
+    if (fabsf(speed_hz - s_cal.speed_hz) > COMM_ADV_CAL_SPEED_TOL * s_cal.speed_hz)
+    {
+        LOG_WARN("Advance calibration aborted: speed left the operating point");
+        s_cal.active = false;
+        return;
+    }
+
+    s_cal.ms++;
+    if (s_cal.ms <= COMM_ADV_CAL_SETTLE_MS)
+        return;
+
+    s_cal.sum_a += current_a;
+    if (s_cal.ms < COMM_ADV_CAL_SETTLE_MS + COMM_ADV_CAL_MEASURE_MS)
+        return;
+
+    /* Window complete: next advance, or done */
+    s_cal.mean_a[s_cal.point] = s_cal.sum_a / (float)COMM_ADV_CAL_MEASURE_MS;
+    s_cal.sum_a = 0.0f;
+    s_cal.ms = 0U;
+
+    if (++s_cal.point >= COMM_ADV_CAL_POINTS)
+        CommAdv_CalFinish();
+}
+
+void Service_CommAdvance_CalAbort(void)
+{
+    s_cal.active = false;
+}
+
+bool Service_CommAdvance_CalActive(void)
+{
+    return s_cal.active;
+}
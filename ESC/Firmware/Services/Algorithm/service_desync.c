@@ -0,0 +1,155 @@
+/**
+ * @file service_desync.c
+ * @brief Implementation of the six-step desync detector.
+ */
+
+#include "service_desync.h"
+
+#include <math.h>
+
+#define DESYNC_WINDOW             0.4f      /**< ± 24° electrical around the expected crossing */
+#define DESYNC_JUMP_RATIO         2.0f      /**< Interval halved / doubled */
+#define DESYNC_TIMEOUT_PERIODS    2.5f      /**< Two crossings missed */
+#define DESYNC_MAX_STRIKES        3U        /**< Three misses, or a jump and a miss */
+#define DESYNC_GRACE_EVENTS       2U        /**< Handover transient */
+#define DESYNC_SPIKE_RATIO        2.5f
+#define DESYNC_SPIKE_MIN_A        8.0f
+#define DESYNC_SPIKE_TICKS        12U       /**< 0.5 ms at 24 kHz */
+#define DESYNC_PERIOD_ALPHA       0.25f     /**< Interval filter (in-window crossings) */
+#define DESYNC_CURRENT_ALPHA      0.01f     /**< Current mean (≈ 4 ms at 24 kHz) */
+
+/**
+ * @brief Initialize a detector with the default thresholds (disarmed).
+ */
+void Service_Desync_Init(desync_detector_t *d)
+{
+    d->window          = DESYNC_WINDOW;
+    d->jump_ratio      = DESYNC_JUMP_RATIO;
+    d->timeout_periods = DESYNC_TIMEOUT_PERIODS;
+    d->max_strikes     = DESYNC_MAX_STRIKES;
+    d->grace_events    = DESYNC_GRACE_EVENTS;
+    d->spike_ratio     = DESYNC_SPIKE_RATIO;
+    d->spike_min_a     = DESYNC_SPIKE_MIN_A;
+    d->spike_ticks     = DESYNC_SPIKE_TICKS;
+
+    Service_Desync_Disarm(d);
+}
+
+/**
+ * @brief Start watching from a known-good zero-cross.
+ */
+void Service_Desync_Arm(desync_detector_t *d, uint32_t zc_us, float period_us, float current_a)
+{
+    d->period_us      = period_us;
+    d->last_zc_us     = zc_us;
+    d->current_mean_a = current_a;
+    d->strikes        = 0U;
+    d->grace          = d->grace_events;
+    d->spike_count    = 0U;
+    d->armed          = (period_us > 0.0f);
+}
+
+/**
+ * @brief Stop watching.
+ */
+void Service_Desync_Disarm(desync_detector_t *d)
+{
+    d->armed       = false;
+    d->strikes     = 0U;
+    d->spike_count = 0U;
+}
+
+/**
+ * @brief Check one zero-cross against its expected window.
+ *
+ * The interval ratio r = interval / period classifies the crossing:
+ *  - |r - 1| <= window      in sync: strikes cleared, period filtered
+ *  - r outside [1/j, j]     period jump: two strikes
+ *  - otherwise              window miss: one strike
+ */
+desync_cause_t Service_Desync_OnZeroCross(desync_detector_t *d, uint32_t zc_us)
+{
+    if (!d->armed)
+        return DESYNC_NONE;
+
+    float interval = (float)(int32_t)(zc_us - d->last_zc_us);
+    if (interval <= 0.0f)
+        return DESYNC_NONE;                         // Same / older event
+    d->last_zc_us = zc_us;
+
+    if (d->grace > 0U)
+    {
+        /* Handover transient: follow the interval, no judgement */
+        d->grace--;
+        d->period_us = interval;
+        return DESYNC_NONE;
+    }
+
+    float r = interval / d->period_us;
+
+    if (fabsf(r - 1.0f) <= d->window)
+    {
+        d->strikes = 0U;
+        d->period_us += DESYNC_PERIOD_ALPHA * (interval - d->period_us);
+        return DESYNC_NONE;
+    }
+
+    bool jump = (r > d->jump_ratio) || (r * d->jump_ratio < 1.0f);
+    d->strikes += jump ? 2U : 1U;
+
+    if (d->strikes < d->max_strikes)
+        return DESYNC_NONE;
+
+    Service_Desync_Disarm(d);
+    return jump ? DESYNC_PERIOD_JUMP : DESYNC_ZC_WINDOW;
+}
+
+/**
+ * @brief Fast-loop check: zero-cross timeout and current spike.
+ */
+desync_cause_t Service_Desync_Tick(desync_detector_t *d, uint32_t now_us, float current_a)
+{
+    if (!d->armed)
+        return DESYNC_NONE;
+
+    /* --- Stale period: crossings stopped coming --- */
+    float age_us = (float)(int32_t)(now_us - d->last_zc_us);
+    if (age_us > d->timeout_periods * d->period_us)
+    {
+        Service_Desync_Disarm(d);
+        return DESYNC_ZC_TIMEOUT;
+    }
+
+    /* --- Current spike against the running mean --- */
+    float level = fmaxf(d->spike_ratio * d->current_mean_a, d->spike_min_a);
+    if (current_a > level)
+    {
+        if (++d->spike_count >= d->spike_ticks)
+        {
+            Service_Desync_Disarm(d);
+            return DESYNC_CURRENT_SPIKE;
+        }
+    }
+    else
+    {
+        d->spike_count = 0U;
+        d->current_mean_a += DESYNC_CURRENT_ALPHA * (current_a - d->current_mean_a);
+    }
+
+    return DESYNC_NONE;
+}
+
+/**
+ * @brief Short name of a cause, for logs.
+ */
+const char *Service_Desync_CauseName(desync_cause_t cause)
+{
+    switch (cause)
+    {
+        case DESYNC_ZC_TIMEOUT:    return "ZC timeout";
+        case DESYNC_ZC_WINDOW:     return "ZC window";
+        case DESYNC_PERIOD_JUMP:   return "period jump";
+        case DESYNC_CURRENT_SPIKE: return "current spike";
+        default:                   return "none";
+    }
+}
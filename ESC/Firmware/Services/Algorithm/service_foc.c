@@ -0,0 +1,224 @@
+/**
+ * @file service_foc.c
+ * @brief Implementation of the FOC building blocks (transforms, current
+ *        signs, flux observer, angle PLL).
+ */
+
+#include "service_foc.h"
+#include "i_math.h"
+
+#include <math.h>
+#include <stddef.h>
+
+#define FOC_SQRT3               1.7320508f
+#define FOC_INV_SQRT3           0.57735027f
+#define FOC_PI                  3.14159265f
+#define FOC_TWO_PI              6.28318531f
+
+#define FOC_OBSERVER_RATE       1000.0f     /**< Flux magnitude correction rate γ·ψ² [1/s] */
+
+/**
+ * @brief Wrap an angle to [-π, π).
+ */
+float Service_Foc_WrapPi(float rad)
+{
+    while (rad >= FOC_PI)
+        rad -= FOC_TWO_PI;
+    while (rad < -FOC_PI)
+        rad += FOC_TWO_PI;
+    return rad;
+}
+
+/**
+ * @brief Clarke transform of two phase currents.
+ */
+foc_ab_t Service_Foc_Clarke(float i_a, float i_b)
+{
+    foc_ab_t ab = {
+        .alpha = i_a,
+        .beta  = (i_a + 2.0f * i_b) * FOC_INV_SQRT3,
+    };
+    return ab;
+}
+
+/**
+ * @brief Park transform.
+ */
+foc_dq_t Service_Foc_Park(const foc_ab_t *ab, float sin_t, float cos_t)
+{
+    foc_dq_t dq = {
+        .d =  ab->alpha * cos_t + ab->beta * sin_t,
+        .q = -ab->alpha * sin_t + ab->beta * cos_t,
+    };
+    return dq;
+}
+
+/**
+ * @brief Inverse Park transform.
+ */
+foc_ab_t Service_Foc_InvPark(const foc_dq_t *dq, float sin_t, float cos_t)
+{
+    foc_ab_t ab = {
+        .alpha = dq->d * cos_t - dq->q * sin_t,
+        .beta  = dq->d * sin_t + dq->q * cos_t,
+    };
+    return ab;
+}
+
+/**
+ * @brief Phase voltage vector of a set of duties.
+ */
+foc_ab_t Service_Foc_VoltageOfDuties(const float duty[3], float vbus)
+{
+    foc_ab_t v = {
+        .alpha = vbus * (2.0f * duty[0] - duty[1] - duty[2]) * (1.0f / 3.0f),
+        .beta  = vbus * (duty[1] - duty[2]) * FOC_INV_SQRT3,
+    };
+    return v;
+}
+
+/**
+ * @brief Sign of one phase current (see Service_Foc_SignCurrents()).
+ */
+static float Foc_SignPhase(float mag, float expected, float previous, float band)
+{
+    float kept = (expected < 0.0f) ? -mag : mag;
+
+    if (fabsf(previous) > band)
+        return kept;
+
+    /* Near zero the previous sign may be wrong: flipped if that fits clearly better */
+    float flipped   = expected - 2.0f * previous;
+    float candidate = (flipped < 0.0f) ? -mag : mag;
+
+    if (fabsf(candidate - flipped) + 0.25f * band < fabsf(kept - expected))
+        return candidate;
+
+    return kept;
+}
+
+/**
+ * @brief Signed phase currents from their magnitudes, the predicted vector
+ *        and the previous one.
+ */
+void Service_Foc_SignCurrents(float mag_a, float mag_b, const foc_ab_t *expected, const foc_ab_t *previous,
+                              float band, float *i_a, float *i_b)
+{
+    float exp_a  = expected->alpha;
+    float exp_b  = -0.5f * expected->alpha + 0.5f * FOC_SQRT3 * expected->beta;
+    float prev_a = previous->alpha;
+    float prev_b = -0.5f * previous->alpha + 0.5f * FOC_SQRT3 * previous->beta;
+
+    *i_a = Foc_SignPhase(mag_a, exp_a, prev_a, band);
+    *i_b = Foc_SignPhase(mag_b, exp_b, prev_b, band);
+}
+
+/**
+ * @brief Initialize an observer with the motor parameters and reset it.
+ */
+void Service_Foc_Observer_Init(foc_observer_t *obs, float r_ohm, float l_h, float flux_wb)
+{
+    obs->r_ohm   = r_ohm;
+    obs->l_h     = l_h;
+    obs->flux_wb = flux_wb;
+    obs->gamma   = FOC_OBSERVER_RATE / (flux_wb * flux_wb);
+
+    Service_Foc_Observer_Reset(obs, 0.0f, NULL);
+}
+
+/**
+ * @brief Restart with the rotor flux at @p theta_rad; the stator flux
+ *        includes the L·i of the current flowing now.
+ */
+void Service_Foc_Observer_Reset(foc_observer_t *obs, float theta_rad, const foc_ab_t *i)
+{
+    foc_ab_t i0 = { 0.0f, 0.0f };
+    if (i != NULL)
+        i0 = *i;
+
+    float s, c;
+    IMath->sin_cos(theta_rad, &s, &c);
+
+    obs->eta.alpha = obs->flux_wb * c;
+    obs->eta.beta  = obs->flux_wb * s;
+    obs->psi.alpha = obs->eta.alpha + obs->l_h * i0.alpha;
+    obs->psi.beta  = obs->eta.beta  + obs->l_h * i0.beta;
+    obs->i_prev    = i0;
+    obs->theta_rad = Service_Foc_WrapPi(theta_rad);
+}
+
+/**
+ * @brief Integrate one period.
+ *
+ *     dψ/dt = v - R·i + γ/2 · η · (ψm² - |η|²),    η = ψ - L·i
+ */
+float Service_Foc_Observer_Update(foc_observer_t *obs, const foc_ab_t *v, const foc_ab_t *i, float dt)
+{
+    /* Resistive drop at the mean current of the period */
+    float i_alpha = 0.5f * (i->alpha + obs->i_prev.alpha);
+    float i_beta  = 0.5f * (i->beta  + obs->i_prev.beta);
+
+    float err = obs->flux_wb * obs->flux_wb - (obs->eta.alpha * obs->eta.alpha + obs->eta.beta * obs->eta.beta);
+    float k   = 0.5f * obs->gamma * err;
+
+    obs->psi.alpha += (v->alpha - obs->r_ohm * i_alpha + k * obs->eta.alpha) * dt;
+    obs->psi.beta  += (v->beta  - obs->r_ohm * i_beta  + k * obs->eta.beta)  * dt;
+
+    obs->eta.alpha = obs->psi.alpha - obs->l_h * i->alpha;
+    obs->eta.beta  = obs->psi.beta  - obs->l_h * i->beta;
+    obs->i_prev    = *i;
+
+    obs->theta_rad = IMath->atan2(obs->eta.beta, obs->eta.alpha);
+    return obs->theta_rad;
+}
+
+/**
+ * @brief One period of L·di/dt = v - R·i - e, e = ω × η held.
+ */
+foc_ab_t Service_Foc_Observer_PredictCurrent(const foc_observer_t *obs, const foc_ab_t *v, float omega_rad_s, float dt)
+{
+    float k = dt / obs->l_h;
+    float e_alpha = -omega_rad_s * obs->eta.beta;
+    float e_beta  =  omega_rad_s * obs->eta.alpha;
+
+    foc_ab_t i = {
+        .alpha = obs->i_prev.alpha + k * (v->alpha - obs->r_ohm * obs->i_prev.alpha - e_alpha),
+        .beta  = obs->i_prev.beta  + k * (v->beta  - obs->r_ohm * obs->i_prev.beta  - e_beta),
+    };
+    return i;
+}
+
+/**
+ * @brief Initialize a critically damped PLL of natural frequency
+ *        2π·bandwidth_hz and reset it.
+ */
+void Service_Foc_Pll_Init(foc_pll_t *pll, float bandwidth_hz)
+{
+    float wn = FOC_TWO_PI * bandwidth_hz;
+
+    pll->kp = 2.0f * wn;
+    pll->ki = wn * wn;
+
+    Service_Foc_Pll_Reset(pll, 0.0f, 0.0f);
+}
+
+/**
+ * @brief Restart at a known angle and speed.
+ */
+void Service_Foc_Pll_Reset(foc_pll_t *pll, float theta_rad, float omega_rad_s)
+{
+    pll->theta_rad   = Service_Foc_WrapPi(theta_rad);
+    pll->omega_rad_s = omega_rad_s;
+}
+
+/**
+ * @brief Track one angle measurement.
+ */
+float Service_Foc_Pll_Update(foc_pll_t *pll, float theta_meas, float dt)
+{
+    float err = Service_Foc_WrapPi(theta_meas - pll->theta_rad);
+
+    pll->omega_rad_s += pll->ki * err * dt;
+    pll->theta_rad    = Service_Foc_WrapPi(pll->theta_rad + (pll->omega_rad_s + pll->kp * err) * dt);
+    return pll->theta_rad;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file service_modulator.c
+ * @brief Space-vector modulator with overmodulation up to six-step.
+ *
+ * Everything is computed on the vector normalised by the usable bus
+ * (duty_max·Vbus): the reachable set is then the hexagon of vertices 2/3
+ * (inscribed radius 1/√3), and the six-step fundamental is 2/π.
+ *
+ * Overmodulation: the reference of radius r is first amplified to R, then
+ * clamped to its nearest point on the hexagon (on the facing side, or the
+ * vertex beyond the side ends). R = 1/√3 is the linear limit; as R grows
+ * the vertex arcs widen until the trajectory is the six vertices. The
+ * fundamental of that trajectory grows monotonically with R, and the table
+ * below inverts it: 1/(√3·R) against the modulation index m = r / (2/π),
+ * from the linear limit (π / (2√3)) to six-step, in 16 equal steps
+ * (computed offline by integrating the clamped trajectory over a sector).
+ */
+
+#include "service_modulator.h"
+#include "i_math.h"
+
+#include <stdbool.h>
+
+/* ========================================================================== */
+/* === Configuration Macros ================================================ */
+/* ========================================================================== */
+
+#define MOD_SQRT3_2             0.86602540f     /**< √3 / 2 */
+#define MOD_R_INSCRIBED         0.57735027f     /**< 1 / √3: linear limit */
+#define MOD_HALF_SIDE           0.33333333f     /**< Half a hexagon side */
+#define MOD_SIX_STEP            0.63661977f     /**< 2 / π: six-step fundamental */
+#define MOD_M_LINEAR            0.90689968f     /**< π / (2√3): index at the linear limit */
+
+#define MOD_TABLE_STEPS         16U
+
+/** 1/(√3·R) at m = MOD_M_LINEAR + k·(1 - MOD_M_LINEAR)/16 */
+static const float s_inv_gain[MOD_TABLE_STEPS + 1U] = {
+    1.000000f, 0.992453f, 0.983609f, 0.973543f, 0.962097f, 0.948945f,
+    0.933485f, 0.914472f, 0.888422f, 0.840167f, 0.780018f, 0.714025f,
+    0.640392f, 0.556099f, 0.455272f, 0.322782f, 0.000000f
+};
+
+/* ========================================================================== */
+/* === Helpers ============================================================= */
+/* ========================================================================== */
+
+/**
+ * @brief Bring a normalised vector outside the hexagon onto its nearest point.
+ * @param vertex Force the nearest vertex (six-step)
+ */
+static void mod_clamp(float *alpha, float *beta, bool vertex)
+{
+    /* Side normals at 30°, 90°, 150°: the facing side has the largest projection */
+    float p[3] = {
+        MOD_SQRT3_2 * *alpha + 0.5f * *beta,
+        *beta,
+        -MOD_SQRT3_2 * *alpha + 0.5f * *beta,
+    };
+    static const float n[3][2] = {
+        { MOD_SQRT3_2, 0.5f }, { 0.0f, 1.0f }, { -MOD_SQRT3_2, 0.5f },
+    };
+
+    uint32_t k = 0;
+    for (uint32_t i = 1; i < 3U; i++)
+        if (((p[i] < 0.0f) ? -p[i] : p[i]) > ((p[k] < 0.0f) ? -p[k] : p[k]))
+            k = i;
+
+    float sign = (p[k] < 0.0f) ? -1.0f : 1.0f;
+
+    /* Already inside (only six-step moves those) */
+    if (!vertex && sign * p[k] <= MOD_R_INSCRIBED)
+        return;
+
+    float nx = sign * n[k][0];
+    float ny = sign * n[k][1];
+
+    /* Position along the side (tangent = normal turned by +90°) */
+    float t = -ny * *alpha + nx * *beta;
+
+    if (vertex)
+        t = (t < 0.0f) ? -MOD_HALF_SIDE : MOD_HALF_SIDE;
+    else if (t > MOD_HALF_SIDE)
+        t = MOD_HALF_SIDE;
+    else if (t < -MOD_HALF_SIDE)
+        t = -MOD_HALF_SIDE;
+
+    *alpha = MOD_R_INSCRIBED * nx - t * ny;
+    *beta  = MOD_R_INSCRIBED * ny + t * nx;
+}
+
+/* ========================================================================== */
+/* === Public API ========================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief Duties of an α/β voltage vector.
+ */
+modulator_region_t Service_Modulator_AlphaBeta(float v_alpha, float v_beta, float vbus,
+                                               float duty_max, float duty[3])
+{
+    float v_eff = vbus * duty_max;
+
+    if (!(v_eff > 0.0f))
+    {
+        duty[0] = duty[1] = duty[2] = 0.0f;
+        return MODULATOR_SIX_STEP;
+    }
+
+    float alpha = v_alpha / v_eff;
+    float beta  = v_beta / v_eff;
+    float r     = IMath->magnitude(alpha, beta);
+    modulator_region_t region = MODULATOR_LINEAR;
+
+    if (r > MOD_R_INSCRIBED)
+    {
+        float m = r * (1.0f / MOD_SIX_STEP);
+
+        if (m >= 1.0f)
+        {
+            region = MODULATOR_SIX_STEP;
+            mod_clamp(&alpha, &beta, true);
+        }
+        else
+        {
+            region = MODULATOR_OVERMODULATION;
+
+            float x = (m - MOD_M_LINEAR) * ((float)MOD_TABLE_STEPS / (1.0f - MOD_M_LINEAR));
+            uint32_t i = (x > 0.0f) ? (uint32_t)x : 0U;
+            if (i > MOD_TABLE_STEPS - 1U)
+                i = MOD_TABLE_STEPS - 1U;
+            float g = s_inv_gain[i] + (s_inv_gain[i + 1U] - s_inv_gain[i]) * (x - (float)i);
+
+            /* Amplified to R = 1/(√3·g), then onto the hexagon (g = 0: vertex) */
+            if (g > 0.0f)
+            {
+                float gain = MOD_R_INSCRIBED / (g * r);
+                alpha *= gain;
+                beta  *= gain;
+                mod_clamp(&alpha, &beta, false);
+            }
+            else
+            {
+                mod_clamp(&alpha, &beta, true);
+            }
+        }
+    }
+
+    float v_abc[3] = {
+        alpha,
+        -0.5f * alpha + MOD_SQRT3_2 * beta,
+        -0.5f * alpha - MOD_SQRT3_2 * beta,
+    };
+
+    float v_max = v_abc[0], v_min = v_abc[0];
+    for (uint32_t x = 1; x < 3U; x++)
+    {
+        if (v_abc[x] > v_max) v_max = v_abc[x];
+        if (v_abc[x] < v_min) v_min = v_abc[x];
+    }
+
+    /* Zero sequence centred, else pushed down to keep the top off-time */
+    float spread = (v_max - v_min) * duty_max;
+    float offset = 0.5f - 0.5f * spread;
+    if (offset > duty_max - spread)
+        offset = duty_max - spread;
+
+    for (uint32_t x = 0; x < 3U; x++)
+    {
+        float d = (v_abc[x] - v_min) * duty_max + offset;
+        duty[x] = (d < 0.0f) ? 0.0f : (d > duty_max) ? duty_max : d;
+    }
+
+    return region;
+}
+
+/**
+ * @brief Duties of a voltage vector given as magnitude and angle.
+ */
+modulator_region_t Service_Modulator_Polar(float v_mag, float angle_rad, float vbus,
+                                           float duty_max, float duty[3])
+{
+    float s, c;
+    IMath->sin_cos(angle_rad, &s, &c);
+    return Service_Modulator_AlphaBeta(v_mag * c, v_mag * s, vbus, duty_max, duty);
+}
+
+/**
+ * @brief Largest vector applied exactly.
+ */
+float Service_Modulator_MaxLinear(float vbus, float duty_max)
+{
+    return MOD_R_INSCRIBED * duty_max * vbus;
+}
+
+/**
+ * @brief Largest fundamental (six-step).
+ */
+float Service_Modulator_MaxVoltage(float vbus, float duty_max)
+{
+    return MOD_SIX_STEP * duty_max * vbus;
+}
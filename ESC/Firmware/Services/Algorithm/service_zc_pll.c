@@ -0,0 +1,180 @@
+/**
+ * @file service_zc_pll.c
+ * @brief Implementation of the zero-cross PLL (angle / speed / acceleration).
+ */
+
+#include "service_zc_pll.h"
+
+#include <math.h>
+
+/* Critically damped α-β-γ gains (fading memory, θ = 0.5) */
+#define ZC_PLL_K_ANGLE        0.875f      /**< 1 - θ³ */
+#define ZC_PLL_K_SPEED        0.5625f     /**< 1.5 (1 - θ)² (1 + θ) */
+#define ZC_PLL_K_ACCEL        0.0625f     /**< 0.5 (1 - θ)³ */
+#define ZC_PLL_GATE_DEG       20.0f       /**< Event farther from the prediction: rejected */
+#define ZC_PLL_LOCK_EVENTS    4U          /**< Accepted events before the estimate is used */
+#define ZC_PLL_MAX_REJECTS    3U          /**< Consecutive rejects: drop the lock, re-acquire */
+
+#define ZC_PLL_WRAP_MAX_TURNS 2.0e9f      /**< Beyond int32 range: the angle is meaningless */
+
+/**
+ * @brief Wrap an angle to [0, 360) without fmodf (runs every fast-loop tick).
+ *
+ * Whole turns removed by truncation (one float→int conversion), then at
+ * most one correction each way.
+ */
+static inline float ZcPll_Wrap360(float deg)
+{
+    float turns = deg * (1.0f / 360.0f);
+
+    if (turns >= ZC_PLL_WRAP_MAX_TURNS || turns <= -ZC_PLL_WRAP_MAX_TURNS)
+        return 0.0f;
+
+    deg -= 360.0f * (float)(int32_t)turns;
+    if (deg < 0.0f)
+        deg += 360.0f;
+    if (deg >= 360.0f)
+        deg -= 360.0f;                              // -ε + 360 rounded up to 360
+    return deg;
+}
+
+/** Wrap an angle difference to [-180, 180) */
+static inline float ZcPll_Wrap180(float deg)
+{
+    return ZcPll_Wrap360(deg + 180.0f) - 180.0f;
+}
+
+/**
+ * @brief Initialize a PLL with the default gains and reset it.
+ */
+void Service_ZcPll_Init(zc_pll_t *pll)
+{
+    pll->k_angle  = ZC_PLL_K_ANGLE;
+    pll->k_speed  = ZC_PLL_K_SPEED;
+    pll->k_accel  = ZC_PLL_K_ACCEL;
+    pll->gate_deg = ZC_PLL_GATE_DEG;
+
+    Service_ZcPll_Reset(pll);
+}
+
+/**
+ * @brief Clear the tracked state (gains kept).
+ */
+void Service_ZcPll_Reset(zc_pll_t *pll)
+{
+    pll->theta_deg  = 0.0f;
+    pll->omega_dps  = 0.0f;
+    pll->accel_dps2 = 0.0f;
+    pll->t_us       = 0;
+    pll->events     = 0;
+    pll->rejects    = 0;
+    pll->locked     = false;
+}
+
+/**
+ * @brief Correct the state with one zero-cross event.
+ *
+ * Propagation to the event at constant acceleration, then:
+ *
+ *     e      = wrap(θ_zc - θ_pred)
+ *     θ     += α · e
+ *     ω     += β · e / dt
+ *     a     += 2γ · e / dt²
+ *
+ * dt is the time since the previous event: the correction is per event,
+ * so the loop bandwidth follows the speed.
+ */
+bool Service_ZcPll_OnZeroCross(zc_pll_t *pll, uint32_t zc_us, uint8_t step)
+{
+    float theta_zc = ZcPll_Wrap360(60.0f + 60.0f * (float)(step % 6U));
+
+    /* --- Acquisition: angle, then speed from the first interval --- */
+    if (pll->events == 0U)
+    {
+        pll->theta_deg = theta_zc;
+        pll->t_us = zc_us;
+        pll->events = 1U;
+        return true;
+    }
+
+    float dt = (float)(int32_t)(zc_us - pll->t_us) * 1e-6f;
+    if (dt <= 0.0f)
+        return false;                               // Not after the previous event
+
+    if (pll->events == 1U)
+    {
+        float d_theta = ZcPll_Wrap180(theta_zc - pll->theta_deg);
+        if (d_theta <= 0.0f)
+            return false;                           // Same / previous step: not a new crossing
+
+        pll->omega_dps = d_theta / dt;
+        pll->theta_deg = theta_zc;
+        pll->t_us = zc_us;
+        pll->events = 2U;
+        return true;
+    }
+
+    /* --- Tracking --- */
+    float theta_pred = pll->theta_deg + pll->omega_dps * dt + 0.5f * pll->accel_dps2 * dt * dt;
+    float err = ZcPll_Wrap180(theta_zc - theta_pred);
+
+    if (pll->locked && fabsf(err) > pll->gate_deg)
+    {
+        /* Bad edge: keep coasting on the prediction */
+        if (++pll->rejects < ZC_PLL_MAX_REJECTS)
+            return false;
+
+        /* Lost: re-acquire, starting from this event */
+        Service_ZcPll_Reset(pll);
+        return Service_ZcPll_OnZeroCross(pll, zc_us, step);
+    }
+
+    pll->omega_dps += pll->accel_dps2 * dt;
+    pll->theta_deg  = ZcPll_Wrap360(theta_pred + pll->k_angle * err);
+    pll->omega_dps += pll->k_speed * err / dt;
+    pll->accel_dps2 += 2.0f * pll->k_accel * err / (dt * dt);
+    pll->t_us = zc_us;
+
+    pll->rejects = 0U;
+    if (pll->events < UINT8_MAX)
+        pll->events++;
+    pll->locked = (pll->events >= ZC_PLL_LOCK_EVENTS);
+    return true;
+}
+
+/**
+ * @brief Extrapolate the state to @p now_us.
+ */
+void Service_ZcPll_Estimate(const zc_pll_t *pll, uint32_t now_us, zc_pll_estimate_t *out)
+{
+    float dt = (float)(int32_t)(now_us - pll->t_us) * 1e-6f;
+
+    out->theta_deg  = ZcPll_Wrap360(pll->theta_deg + pll->omega_dps * dt + 0.5f * pll->accel_dps2 * dt * dt);
+    out->omega_dps  = pll->omega_dps + pll->accel_dps2 * dt;
+    out->accel_dps2 = pll->accel_dps2;
+    out->locked     = pll->locked;
+}
+
+/**
+ * @brief Solve θ(now + t) = target at constant acceleration.
+ *
+ * t = 2·d / (ω + √(ω² + 2·a·d)), the cancellation-free root of
+ * ½·a·t² + ω·t - d = 0; at constant speed when the rotor would stop first.
+ */
+float Service_ZcPll_TimeToAngle(const zc_pll_t *pll, uint32_t now_us, float target_deg)
+{
+    zc_pll_estimate_t est;
+    Service_ZcPll_Estimate(pll, now_us, &est);
+
+    if (!est.locked || est.omega_dps <= 0.0f)
+        return -1.0f;
+
+    float d = ZcPll_Wrap180(target_deg - est.theta_deg);
+    if (d <= 0.0f)
+        return 0.0f;                                // Already passed
+
+    float disc = est.omega_dps * est.omega_dps + 2.0f * est.accel_dps2 * d;
+
+    float t = (disc > 0.0f) ? (2.0f * d / (est.omega_dps + sqrtf(disc))) : (d / est.omega_dps);
+    return t * 1e6f;
+}
@@ -11,21 +11,44 @@
  * ----------------------------
  * Design Summary:
  * ----------------------------
- * - Computes BEMF = Vphase - Vneutral
+ * - Computes BEMF = Vphase - Vref, the reference following the sampling
+ *   point (v_on_time, placed per period by the control layer):
+ *   - on-time: the star point of a six-step drive sits at half the bus
+ *     voltage, sampled on the same ADC trigger as the phases
+ *   - off-time, current freewheeling through the diodes: Vbus/2 as well
+ *   - off-time, bridge idle (low duty): the star point is held at ground by
+ *     the dividers, the floating phase reads ~2/3 e against ground (clipped
+ *     at 0 V when negative)
+ * - Discards the first sample after a change of reference (filter mix)
  * - Detects zero-crossings per phase (sign change)
- * - Measures period between same-phase ZCs
+ * - Interpolates the crossing instant between the two samples bracketing
+ *   the sign change, from their sampling timestamps (not the ISR time)
+ * - Measures period between consecutive ZCs with sub-µs resolution
+ *   (ITimerSched ticks)
+ * - Blanks detection after each commutation: demagnetisation end detected
+ *   from the clamping of the released phase, plus a window sized from the
+ *   learnt demag time per ampere and the phase current
+ * - Accepts one ZC per step, in the expected direction only
  * - Applies amplitude and period validation filters
  * - Provides a smoothed (low-pass filtered) period estimate
  * - Works independently for each phase (3x parallel trackers)
  *
+ * Comparator backend (SBemfMonitorComp):
+ * - The comparator of the floating phase is armed at every commutation
+ *   with the expected edge; the timer capture gives the ZC timestamp
+ * - process() polls the capture and feeds the same validation, filter
+ *   and lock logic as the ADC backend
+ *
  * Layer: Service (S)
- * Dependencies: i_motor_sensor, i_inverter, i_time
+ * Dependencies: i_motor_sensor, i_bemf_comparator, i_inverter, i_time, i_timer_sched
  */
 
 #include "service_bemf_monitor.h"
 #include "i_motor_sensor.h"
+#include "i_bemf_comparator.h"
 #include "i_inverter.h"
 #include "i_time.h"
+#include "i_timer_sched.h"
 #include "service_generic.h"
 
 #include <math.h>
@@ -39,6 +62,9 @@
 /** Minimum amplitude (in volts) required to consider a valid BEMF signal. */
 #define BEMF_MIN_AMPL_V        0.005f     /**< Reject noise below 5 mV. */
 
+/** Rounding of the ADC voltage filter (α = 1/2 shift IIR), on the recovered input. */
+#define BEMF_FILTER_ROUND_V    0.002f     /**< ~2 LSB at 3.3 V / 12 bits. */
+
 /** Valid period bounds (in microseconds) to filter false zero-cross events. */
 #define BEMF_MIN_PERIOD_US     100.0f     /**< Reject extremely fast spikes. */
 #define BEMF_MAX_PERIOD_US     50000.0f   /**< Reject too-slow events (>50ms). */
@@ -50,6 +76,17 @@
 /** Low-pass filter coefficient for period smoothing. */
 #define BEMF_FILTER_ALPHA      0.2f       /**< α = 0.2 → 20% new, 80% old. */
 
+/** Post-commutation blanking of the ADC backend. */
+#define BEMF_BLANK_MIN_US        10.0f    /**< Floor of the blanking window. */
+#define BEMF_BLANK_MAX_RATIO     0.25f    /**< Ceiling: fraction of the 60° period (15° electrical). */
+#define BEMF_DEMAG_MARGIN        1.25f    /**< Window = margin × predicted demag time. */
+#define BEMF_DEMAG_ALPHA         0.25f    /**< Filter of the learnt demag time per ampere. */
+#define BEMF_DEMAG_MIN_CURRENT_A 0.2f     /**< Below: too little current to learn from. */
+
+/** Comparator captures this soon after the commutation are switching / demagnetisation edges. */
+#define BEMF_COMP_BLANK_MIN_US 20.0f      /**< Fixed part of the blanking window. */
+#define BEMF_COMP_BLANK_RATIO  0.25f      /**< Fraction of the 60° period (15° electrical). */
+
 /* ========================================================================== */
 /* === Module State ======================================================== */
 /* ========================================================================== */
@@ -60,9 +97,21 @@ static bemf_status_t s_bemf_status;
 /** Previous BEMF voltage for sign detection, per phase. */
 static float s_prev_bemf[PHASE_COUNT] = {0.0f};
 
-/** Timestamp (µs) of the last detected zero-cross. */
+/** Previous phase voltage readings (filtered by the ADC callback). */
+static float s_prev_v[PHASE_COUNT] = {0.0f};
+
+/** Previous sample of the floating phase: sampling time and phase it belonged to. */
+static uint32_t        s_prev_sample_ticks = 0;
+static s_motor_phase_t s_prev_sample_phase = S_MOTOR_PHASE_A;
+static bool            s_prev_sample_valid = false;
+
+/** Time of the last detected zero-cross: ITimerSched ticks (period) and ITime µs (API). */
+static uint32_t s_last_zc_ticks = 0;
 static uint32_t s_last_zc_time_us = 0;
 
+/** ITimerSched resolution. */
+static float s_ticks_per_us = 0.0f;
+
 /** Filtered (smoothed) period between ZC. */
 static float s_last_period_us = 0.0f;
 
@@ -77,6 +126,32 @@ static bool    s_locked         = false; /**< True = BEMF signal considered vali
 /** Service state flag. */
 static bool s_initialized = false;
 
+/** ADC backend: current step, as announced by commutated(). */
+static bool     s_comm_known     = false;   /**< commutated() called since reset */
+static uint32_t s_comm_ticks     = 0;       /**< Commutation time (ITimerSched ticks) */
+static bool     s_expect_rising  = false;   /**< Expected ZC direction of this step */
+static bool     s_demag_seen     = false;   /**< Released phase seen clamped */
+static bool     s_demag_done     = false;   /**< Clamp released: ZC detection possible */
+static bool     s_zc_done        = false;   /**< ZC of this step already reported */
+static float    s_blank_us       = 0.0f;    /**< Blanking window of this step */
+static float    s_comm_current_a = 0.0f;    /**< Phase current at the commutation */
+static float    s_last_current_a = 0.0f;    /**< Latest phase current magnitude */
+static float    s_demag_us_per_a = 0.0f;    /**< Learnt demag time per ampere (0 = unknown): a motor property, kept across resets */
+static bool     s_pre_valid      = false;   /**< Pre-crossing sample seen this step */
+static float    s_pre_bemf       = 0.0f;    /**< Last pre-crossing BEMF [V] */
+static float    s_coast_max_v    = 0.0f;    /**< Coasting: highest phase voltage since the last ZC */
+static float    s_coast_v[PHASE_COUNT][2];  /**< Coasting: previous two samples per phase [V] (newest first) */
+static uint32_t s_coast_ticks[2];           /**< Their sampling times (ITimerSched ticks) */
+static uint8_t  s_coast_samples  = 0;       /**< Samples stored (0 – 2) */
+static bool     s_idle_ref       = false;   /**< Reference of the last sample: idle bridge */
+static uint32_t s_pre_ticks      = 0;       /**< Its sampling time (ITimerSched ticks) */
+
+/** Comparator backend: capture armed for s_comp_phase since s_comp_armed_ticks. */
+static bool            s_comp_armed = false;
+static s_motor_phase_t s_comp_phase = S_MOTOR_PHASE_A;
+static bool            s_comp_rising = false;
+static uint32_t        s_comp_armed_ticks = 0;
+
 /* ========================================================================== */
 /* === Internal Helper Functions ========================================== */
 /* ========================================================================== */
@@ -90,16 +165,200 @@ static inline float adc_to_voltage(uint16_t raw)
 }
 
 /**
- * @brief Compute virtual neutral point voltage.
- * 
- * @param va Phase A voltage [V]
- * @param vb Phase B voltage [V]
- * @param vc Phase C voltage [V]
- * @return Neutral voltage Vn = (Va + Vb + Vc) / 3
+ * @brief Compute the virtual neutral (zero-cross threshold) of the floating phase.
+ *
+ * With one phase switched to the bus and one to ground, the star point is
+ * at Vbus/2 while the bridge conducts: the floating phase reads
+ * Vbus/2 + e, whatever the duty. The bus is divided like the phases.
+ *
+ * @param vbus Bus voltage at the phase divider scale [V]
+ * @return Neutral voltage Vn = Vbus / 2
+ */
+static inline float compute_neutral(float vbus)
+{
+    return 0.5f * vbus;
+}
+
+/**
+ * @brief Tell whether an off-time sample was taken with the bridge idle.
+ *
+ * While current freewheels the driven phases are clamped to the rails by
+ * their diodes (the star point stays at Vbus/2); once it is extinct they
+ * float at a few volts of BEMF, well below half the bus.
+ *
+ * @param v_driven_max Highest voltage of the two driven phases [V]
+ * @param vbus         Bus voltage at the phase divider scale [V]
+ * @return true if the floating phase is referenced to ground
+ */
+static inline bool bridge_idle(float v_driven_max, float vbus)
+{
+    return v_driven_max < compute_neutral(vbus);
+}
+
+/**
+ * @brief Latest phase current magnitude (the positive phase of the step),
+ *        for the blanking window and the status; unfiltered for the
+ *        current loop (one of the two sensed phases carries the pair
+ *        current in every step).
+ */
+static inline void BEMF_UpdateCurrent(const motor_measurements_t *meas)
+{
+    s_last_current_a = fmaxf(Service_ADC_To_Current(meas->i_a_raw),
+                             fmaxf(Service_ADC_To_Current(meas->i_b_raw), Service_ADC_To_Current(meas->i_c_raw)));
+    s_bemf_status.current_a = s_last_current_a;
+    s_bemf_status.current_inst_a = Service_ADC_To_Current(meas->i_peak_raw);
+}
+
+/* ========================================================================== */
+/* === Zero-Cross Validation (shared by both backends) ===================== */
+/* ========================================================================== */
+
+/**
+ * @brief Validate one zero-cross and update period, lock state and status.
+ *
+ * @param phase    Floating phase on which the ZC occurred
+ * @param rising   Direction of the crossing
+ * @param zc_ticks Time of the zero-cross [ITimerSched ticks, in the past]
+ */
+static void BEMF_OnZeroCross(s_motor_phase_t phase, bool rising, uint32_t zc_ticks)
+{
+    /* 0. Timestamp in the ITime µs base for get_last_zc_time_us() */
+    uint32_t age_us = (uint32_t)((float)(ITimerSched->now() - zc_ticks) / s_ticks_per_us + 0.5f);
+    uint32_t zc_time_us = ITime->get_time_us() - age_us;
+
+    /* 1. Bootstrap logic — first ZC per phase initializes baseline */
+    if (s_bootstrap[phase])
+    {
+        s_last_zc_ticks = zc_ticks;
+        s_last_zc_time_us = zc_time_us;
+        s_bootstrap[phase] = false;
+
+        s_bemf_status.zero_cross_detected = false;
+        s_bemf_status.valid = false;
+        return;
+    }
+
+    /* 2. Compute elapsed time since last ZC (from ANY phase), corresponding to 60° electrical */
+    float period_us = (float)(zc_ticks - s_last_zc_ticks) / s_ticks_per_us;
+    s_last_zc_ticks = zc_ticks;
+    s_last_zc_time_us = zc_time_us;
+
+    /* 3. Validate period range (reject spikes and dropouts) */
+    if (period_us < BEMF_MIN_PERIOD_US || period_us > BEMF_MAX_PERIOD_US)
+    {
+        if (s_invalid_streak < 255) s_invalid_streak++;
+        s_valid_streak = 0;
+
+        /* Too many invalids → unlock BEMF */
+        if (s_locked && s_invalid_streak >= BEMF_UNLOCK_COUNT)
+            s_locked = false;
+
+        s_bemf_status.zero_cross_detected = false;
+        s_bemf_status.valid = s_locked;
+        return;
+    }
+
+    /* 4. Smooth the measured period with exponential filter */
+    if (s_last_period_us == 0.0f)
+        s_last_period_us = period_us;
+    else
+        s_last_period_us = (1.0f - BEMF_FILTER_ALPHA) * s_last_period_us + BEMF_FILTER_ALPHA * period_us;
+
+    /* 5. Lock/unlock logic */
+    if (s_valid_streak < 255) s_valid_streak++;
+    s_invalid_streak = 0;
+
+    if (!s_locked && s_valid_streak >= BEMF_LOCK_COUNT)
+        s_locked = true;
+
+    /* 6. Update shared BEMF status for control layer */
+    s_bemf_status.period_us = s_last_period_us;
+    s_bemf_status.floating_phase = phase;
+    s_bemf_status.zc_rising = rising;
+    s_bemf_status.zero_cross_detected = true;
+    s_bemf_status.valid = s_locked;
+}
+
+/**
+ * @brief Demagnetisation of the released phase is over: learn its duration.
+ *
+ * @param demag_us Time from the commutation to the end of the clamping
+ */
+static void BEMF_DemagEnd(float demag_us)
+{
+    s_demag_done = true;
+
+    if (s_comm_current_a < BEMF_DEMAG_MIN_CURRENT_A)
+        return;
+
+    float per_a = demag_us / s_comm_current_a;
+    if (s_demag_us_per_a == 0.0f)
+        s_demag_us_per_a = per_a;
+    else
+        s_demag_us_per_a += BEMF_DEMAG_ALPHA * (per_a - s_demag_us_per_a);
+}
+
+/**
+ * @brief Zero-cross detection within the current step (see BEMF_Commutated).
+ *
+ * The released phase freewheels through a body diode and is clamped to the
+ * rail on the far side of the coming crossing (Vbus before a rising ZC,
+ * ground before a falling one): its BEMF reads as already crossed. The demag
+ * is over at the first sample back on the pre-crossing side. Past the
+ * blanking window, the first sample on the post-crossing side (beyond the
+ * noise floor) is the crossing, interpolated from the last pre-crossing
+ * sample. Crossings against the expected direction (freewheeling spikes)
+ * and further crossings in the same step are ignored.
+ *
+ * @param phase      Floating phase
+ * @param bemf       Its BEMF against the virtual neutral [V]
+ * @param t_ticks    Sampling time of @p bemf (ITimerSched ticks)
  */
-static inline float compute_neutral(float va, float vb, float vc)
+static void BEMF_StepProcess(s_motor_phase_t phase, float bemf, uint32_t t_ticks)
 {
-    return (va + vb + vc) / 3.0f;
+    float since_us = (float)(int32_t)(t_ticks - s_comm_ticks) / s_ticks_per_us;
+    bool  post_side = s_expect_rising ? (bemf >= 0.0f) : (bemf < 0.0f);
+
+    if (since_us < 0.0f || s_zc_done)
+        return;                                 // Sampled before the step change / done
+
+    /* 1. Demagnetisation: wait for the release of the clamp */
+    if (!s_demag_done)
+    {
+        if (post_side)
+        {
+            s_demag_seen = true;
+            return;
+        }
+        BEMF_DemagEnd(s_demag_seen ? since_us : 0.0f);
+    }
+
+    /* 2. Pre-crossing side: reference sample for the interpolation */
+    if (!post_side)
+    {
+        s_pre_bemf  = bemf;
+        s_pre_ticks = t_ticks;
+        s_pre_valid = true;
+        return;
+    }
+
+    /* 3. Post-crossing side inside the blanking window: chatter, start over */
+    if (since_us < s_blank_us)
+    {
+        s_pre_valid = false;
+        return;
+    }
+
+    /* 4. Crossing beyond the noise floor only (else wait, reference kept) */
+    if (!s_pre_valid || (fabsf(bemf) < BEMF_MIN_AMPL_V && fabsf(s_pre_bemf) < BEMF_MIN_AMPL_V))
+        return;
+
+    /* 5. Crossing instant: linear interpolation between the two samples */
+    float frac = s_pre_bemf / (s_pre_bemf - bemf);
+    uint32_t zc_ticks = s_pre_ticks + (uint32_t)(frac * (float)(t_ticks - s_pre_ticks) + 0.5f);
+
+    s_zc_done = true;
+    BEMF_OnZeroCross(phase, s_expect_rising, zc_ticks);
 }
 
 /* ========================================================================== */
@@ -111,16 +370,25 @@ static inline float compute_neutral(float va, float vb, float vc)
  *
  * Called at the fast-loop frequency (typically 24 kHz).
  * Each call measures the back-EMF of the *floating* phase (the one not driven
- * in the current six-step commutation) and checks for a zero-cross event.
+ * in the current six-step commutation) against Vbus/2 and checks for a
+ * zero-cross event. Only samples taken inside the PWM on-time are used.
  *
  * When a zero-cross is detected:
- *  - The time difference since the last ZC of the *same phase* is measured.
+ *  - The crossing instant is interpolated linearly between the previous and
+ *    the current sample of the floating phase (sampling timestamps of the
+ *    ADC trigger), giving a sub-sample ZC time. Without a previous sample of
+ *    the same floating interval, the current sample time is used.
+ *  - The time difference since the last ZC is measured.
  *  - The period is filtered (low-pass).
  *  - A validation state ("locked") is maintained based on signal consistency.
  *
+ * Once commutations are announced (BEMF_Commutated), detection is done per
+ * step by BEMF_StepProcess: demagnetisation and blanking aware, expected
+ * direction only, one crossing per step.
+ *
  * @param floating_phase Phase currently not driven (PHASE_A/B/C)
  */
-static void BEMF_Process(uint8_t floating_phase)
+static void BEMF_Process(s_motor_phase_t floating_phase)
 {
     /* 1. Ensure service is ready */
     if (!s_initialized || IMotor_ADC_Measure == NULL)
@@ -131,94 +399,263 @@ static void BEMF_Process(uint8_t floating_phase)
     if (!IMotor_ADC_Measure->get_latest_measurements(&meas))
         return;
 
-    /* 3. Convert raw ADC samples to voltages */
+    /* Phase current magnitude, scales the next blanking window */
+    BEMF_UpdateCurrent(&meas);
+
+    /* Convert raw ADC samples to voltages */
     float Va = adc_to_voltage(meas.v_phase_a_raw);
     float Vb = adc_to_voltage(meas.v_phase_b_raw);
     float Vc = adc_to_voltage(meas.v_phase_c_raw);
-    float Vn = compute_neutral(Va, Vb, Vc);
+    float Vbus = adc_to_voltage(meas.v_bus_raw);
 
-    /* 4. Compute back-EMF for the floating phase */
-    float bemf = 0.0f;
+    /* 3. Floating phase and highest driven phase */
+    float v_float, v_driven;
     switch (floating_phase)
     {
-        case PHASE_A: bemf = Va - Vn; break;
-        case PHASE_B: bemf = Vb - Vn; break;
-        case PHASE_C: bemf = Vc - Vn; break;
+        case PHASE_A: v_float = Va; v_driven = fmaxf(Vb, Vc); break;
+        case PHASE_B: v_float = Vb; v_driven = fmaxf(Va, Vc); break;
+        case PHASE_C: v_float = Vc; v_driven = fmaxf(Va, Vb); break;
         default: return;
     }
 
-    /* 5. Detect zero-crossing: sign change in BEMF */
-    bool zc_detected = ((bemf >= 0.0f && s_prev_bemf[floating_phase] < 0.0f) ||
-                        (bemf < 0.0f && s_prev_bemf[floating_phase] >= 0.0f));
+    /* 4. Reference of this sample: Vbus/2 unless taken off-time on an idle
+     *    bridge. The voltage filter mixes consecutive samples: the first one
+     *    after a change of reference is not usable, nor as interpolation base */
+    bool idle = !meas.v_on_time && bridge_idle(v_driven, Vbus);
 
-    if (!zc_detected)
+    float v_prev = s_prev_v[floating_phase];
+    s_prev_v[PHASE_A] = Va;
+    s_prev_v[PHASE_B] = Vb;
+    s_prev_v[PHASE_C] = Vc;
+    if (idle != s_idle_ref)
     {
-        s_prev_bemf[floating_phase] = bemf;
-        return; // No event this cycle
+        s_idle_ref          = idle;
+        s_pre_valid         = false;
+        s_prev_sample_valid = false;
+        return;
     }
 
-    /* 6. Reject very small oscillations (noise floor) */
-    if (fabsf(bemf) < BEMF_MIN_AMPL_V && fabsf(s_prev_bemf[floating_phase]) < BEMF_MIN_AMPL_V)
+    /* Idle bridge: a negative BEMF clips to 0 V, its magnitude is only known
+     * to be past the noise floor (else the crossing would never qualify).
+     * Before a rising crossing, the high clamp of the released phase decays
+     * through the voltage filter of the ADC callback (mean of the sample and
+     * the previous reading) and may not reach 0 V before the BEMF rises: the
+     * input is recovered as 2·v - v_prev, a reading that only decays is
+     * clipped */
+    float bemf;
+    if (!idle)
+        bemf = v_float - compute_neutral(Vbus);
+    else if (s_comm_known && s_expect_rising)
+        bemf = (v_float > 0.0f && 2.0f * v_float - v_prev > BEMF_FILTER_ROUND_V) ? v_float : -BEMF_MIN_AMPL_V;
+    else
+        bemf = (v_float > 0.0f) ? v_float : -BEMF_MIN_AMPL_V;
+
+    /* 5. Step known from commutated(): demag / blanking / direction aware */
+    if (s_comm_known)
     {
-        s_prev_bemf[floating_phase] = bemf;
+        BEMF_StepProcess(floating_phase, bemf, meas.v_sample_ticks);
         return;
     }
 
-    uint32_t now_us = ITime->get_time_us();
+    /* 6. Otherwise: any sign change in BEMF */
+    float prev = s_prev_bemf[floating_phase];
+    bool zc_detected = ((bemf >= 0.0f && prev < 0.0f) ||
+                        (bemf < 0.0f && prev >= 0.0f));
 
-    /* 7. Bootstrap logic — first ZC per phase initializes baseline */
-    if (s_bootstrap[floating_phase])
-    {
-        s_last_zc_time_us = now_us;
-        s_bootstrap[floating_phase] = false;
+    /* Previous sample of this floating interval, for the interpolation */
+    bool     adjacent   = s_prev_sample_valid && s_prev_sample_phase == floating_phase;
+    uint32_t prev_ticks = s_prev_sample_ticks;
 
-        s_prev_bemf[floating_phase] = bemf;
-        s_bemf_status.zero_cross_detected = false;
-        s_bemf_status.valid = false;
+    /* 7. Store last BEMF value and its sampling time for the next sign check */
+    s_prev_bemf[floating_phase] = bemf;
+    s_prev_sample_ticks = meas.v_sample_ticks;
+    s_prev_sample_phase = floating_phase;
+    s_prev_sample_valid = true;
+
+    if (!zc_detected)
+        return; // No event this cycle
+
+    /* 8. Reject very small oscillations (noise floor) */
+    if (fabsf(bemf) < BEMF_MIN_AMPL_V && fabsf(prev) < BEMF_MIN_AMPL_V)
         return;
+
+    /* 9. Crossing instant: linear interpolation between the two samples */
+    uint32_t zc_ticks = meas.v_sample_ticks;
+    if (adjacent)
+    {
+        float frac = prev / (prev - bemf);     // (0, 1]: same sign as each other
+        zc_ticks = prev_ticks + (uint32_t)(frac * (float)(meas.v_sample_ticks - prev_ticks) + 0.5f);
     }
 
-    /* 8. Compute elapsed time since last ZC (from ANY phase), corresponding to 60° electrical */
-    float period_us = (float)(now_us - s_last_zc_time_us);
-    s_last_zc_time_us = now_us;
+    BEMF_OnZeroCross(floating_phase, bemf >= 0.0f, zc_ticks);
+}
 
-    /* 9. Validate period range (reject spikes and dropouts) */
-    if (period_us < BEMF_MIN_PERIOD_US || period_us > BEMF_MAX_PERIOD_US)
+/**
+ * @brief Process one fast-loop iteration with the whole bridge off.
+ *
+ * With no phase driven, the star point is held near ground by the phase
+ * dividers and each terminal reads its own BEMF, clipped to 0 V when
+ * negative. Every phase is watched for a crossing of the noise floor; the
+ * clipped side carries no slope, so the crossing instant is extrapolated
+ * from the two samples on the positive side (one sample later for a rising
+ * crossing), which keeps rising and falling crossings unbiased. They are at
+ * the same angles as the six-step zero-crosses, so period, lock and status
+ * are shared. The highest terminal voltage between two crossings gives the
+ * BEMF amplitude (status bemf_ratio).
+ */
+static void BEMF_ProcessCoasting(void)
+{
+    if (!s_initialized || IMotor_ADC_Measure == NULL)
+        return;
+
+    motor_measurements_t meas;
+    if (!IMotor_ADC_Measure->get_latest_measurements(&meas))
+        return;
+
+    BEMF_UpdateCurrent(&meas);
+
+    float v[PHASE_COUNT] = {
+        adc_to_voltage(meas.v_phase_a_raw),
+        adc_to_voltage(meas.v_phase_b_raw),
+        adc_to_voltage(meas.v_phase_c_raw)
+    };
+    float Vbus = adc_to_voltage(meas.v_bus_raw);
+    uint32_t t = meas.v_sample_ticks;
+
+    s_coast_max_v = fmaxf(s_coast_max_v, fmaxf(v[PHASE_A], fmaxf(v[PHASE_B], v[PHASE_C])));
+
+    for (int x = 0; s_coast_samples >= 2U && x < PHASE_COUNT; x++)
     {
-        if (s_invalid_streak < 255) s_invalid_streak++;
-        s_valid_streak = 0;
+        float    v1 = s_coast_v[x][0], v2 = s_coast_v[x][1];    // Previous sample, the one before
+        uint32_t t1 = s_coast_ticks[0], t2 = s_coast_ticks[1];
+        float    dt1 = (float)(t1 - t2);
+        float    at;                                            // Crossing, ticks after t2
+        bool     rising;
+
+        if (v[x] > BEMF_MIN_AMPL_V && v1 > BEMF_MIN_AMPL_V && v2 <= BEMF_MIN_AMPL_V)
+        {
+            /* Rose before the previous sample: back along (t1, v1) → (t, v) */
+            float slope = (v[x] - v1) / (float)(t - t1);
+            rising = true;
+            at = (slope > 0.0f) ? fmaxf(dt1 - v1 / slope, 0.0f) : dt1;
+        }
+        else if (v[x] <= BEMF_MIN_AMPL_V && v1 > BEMF_MIN_AMPL_V)
+        {
+            /* Fell after the previous sample: on along (t2, v2) → (t1, v1) */
+            float slope = (v1 - v2) / dt1;
+            rising = false;
+            at = dt1 + ((slope < 0.0f) ? fminf(-v1 / slope, (float)(t - t1)) : 0.0f);
+        }
+        else
+        {
+            continue;
+        }
+
+        if (Vbus > 0.0f)
+            s_bemf_status.bemf_ratio = s_coast_max_v / Vbus;
+        s_coast_max_v = 0.0f;
+
+        BEMF_OnZeroCross((s_motor_phase_t)x, rising, t2 + (uint32_t)(at + 0.5f));
+    }
 
-        /* Too many invalids → unlock BEMF */
-        if (s_locked && s_invalid_streak >= BEMF_UNLOCK_COUNT)
-            s_locked = false;
+    for (int x = 0; x < PHASE_COUNT; x++)
+    {
+        s_coast_v[x][1] = s_coast_v[x][0];
+        s_coast_v[x][0] = v[x];
+    }
+    s_coast_ticks[1] = s_coast_ticks[0];
+    s_coast_ticks[0] = t;
+    if (s_coast_samples < 2U)
+        s_coast_samples++;
+}
 
-        s_bemf_status.zero_cross_detected = false;
-        s_bemf_status.valid = s_locked;
-        s_prev_bemf[floating_phase] = bemf;
+/**
+ * @brief Commutation notification: start the demagnetisation / blanking phase.
+ *
+ * The blanking window is the demag time predicted from the learnt time per
+ * ampere and the current at the commutation, with margin, bounded by
+ * [BEMF_BLANK_MIN_US, BEMF_BLANK_MAX_RATIO × period] (floor only until a
+ * period has been measured).
+ */
+static void BEMF_Commutated(s_motor_phase_t floating_phase, bool rising)
+{
+    (void)floating_phase;
+
+    s_comm_ticks     = ITimerSched->now();
+    s_expect_rising  = rising;
+    s_demag_seen     = false;
+    s_demag_done     = false;
+    s_zc_done        = false;
+    s_pre_valid      = false;
+    s_comm_current_a = s_last_current_a;
+    s_comm_known     = true;
+
+    /* No period measured yet: no bound, the demag-end detection alone protects */
+    float blank_us = 0.0f;
+    if (s_last_period_us > 0.0f)
+        blank_us = fminf(BEMF_DEMAG_MARGIN * s_demag_us_per_a * s_comm_current_a,
+                         BEMF_BLANK_MAX_RATIO * s_last_period_us);
+    s_blank_us = fmaxf(blank_us, BEMF_BLANK_MIN_US);
+}
+
+/* ========================================================================== */
+/* === Comparator Backend ================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief Arm the capture of the new floating phase on its expected edge.
+ *
+ * Called right after the step change (commutation ISR or fast loop); the
+ * arm time starts the blanking window.
+ */
+static void BEMF_Comp_Commutated(s_motor_phase_t floating_phase, bool rising)
+{
+    if (!s_initialized || IBemfComparator == NULL)
         return;
-    }
 
-    /* 10. Smooth the measured period with exponential filter */
-    if (s_last_period_us == 0.0f)
-        s_last_period_us = period_us;
-    else
-        s_last_period_us = (1.0f - BEMF_FILTER_ALPHA) * s_last_period_us + BEMF_FILTER_ALPHA * period_us;
+    s_comp_phase       = floating_phase;
+    s_comp_rising      = rising;
+    s_comp_armed_ticks = ITimerSched->now();
+    s_comp_armed       = IBemfComparator->arm((uint8_t)floating_phase,
+                                              rising ? BEMF_COMP_EDGE_RISING : BEMF_COMP_EDGE_FALLING);
+}
 
-    /* 11. Lock/unlock logic */
-    if (s_valid_streak < 255) s_valid_streak++;
-    s_invalid_streak = 0;
+/**
+ * @brief Poll the comparator capture of the floating phase (fast loop).
+ *
+ * A capture inside the blanking window (switching edge of the commutation,
+ * demagnetisation of the phase just released) is dropped and the capture
+ * stays armed. The first capture past the window is the zero-cross: the
+ * capture is disarmed until the next commutation.
+ *
+ * @param floating_phase Phase currently not driven (PHASE_A/B/C)
+ */
+static void BEMF_Comp_Process(s_motor_phase_t floating_phase)
+{
+    uint32_t zc_ticks;
+    motor_measurements_t meas;
 
-    if (!s_locked && s_valid_streak >= BEMF_LOCK_COUNT)
-        s_locked = true;
+    if (!s_initialized)
+        return;
 
-    /* 12. Update shared BEMF status for control layer */
-    s_bemf_status.period_us = s_last_period_us;
-    s_bemf_status.floating_phase = floating_phase;
-    s_bemf_status.zero_cross_detected = true;
-    s_bemf_status.valid = s_locked;
+    /* ADC samples not used for the ZC: current only */
+    if (IMotor_ADC_Measure != NULL && IMotor_ADC_Measure->get_latest_measurements(&meas))
+        BEMF_UpdateCurrent(&meas);
 
-    /* 13. Store last BEMF value for next sign check */
-    s_prev_bemf[floating_phase] = bemf;
+    if (!s_comp_armed || floating_phase != s_comp_phase)
+        return;
+
+    if (!IBemfComparator->get_capture(&zc_ticks))
+        return;
+
+    float blank_us = fmaxf(BEMF_COMP_BLANK_MIN_US, BEMF_COMP_BLANK_RATIO * s_last_period_us);
+    if ((float)(int32_t)(zc_ticks - s_comp_armed_ticks) < blank_us * s_ticks_per_us)
+        return;
+
+    IBemfComparator->disarm();
+    s_comp_armed = false;
+
+    BEMF_OnZeroCross(floating_phase, s_comp_rising, zc_ticks);
 }
 
 /* ========================================================================== */
@@ -233,11 +670,23 @@ static void BEMF_Process(uint8_t floating_phase)
  */
 static bool BEMF_Init(void)
 {
+    if (ITimerSched == NULL || ITimerSched->get_tick_hz() < 1000000U)
+        return false;
+    s_ticks_per_us = (float)ITimerSched->get_tick_hz() / 1e6f;
+
     memset(&s_bemf_status, 0, sizeof(s_bemf_status));
     memset(s_prev_bemf, 0, sizeof(s_prev_bemf));
+    memset(s_prev_v, 0, sizeof(s_prev_v));
     memset(s_bootstrap, true, sizeof(s_bootstrap));
 
+    s_prev_sample_valid = false;
+    s_idle_ref = false;
+    s_comm_known = false;
+    s_coast_max_v = 0.0f;
+    s_coast_samples = 0;
+    s_demag_us_per_a = 0.0f;
     s_last_period_us = 0.0f;
+    s_last_zc_ticks = 0;
     s_last_zc_time_us = 0;
     s_valid_streak = 0;
     s_invalid_streak = 0;
@@ -250,15 +699,24 @@ static bool BEMF_Init(void)
 /**
  * @brief Reset runtime state (used when restarting open-loop).
  *
- * This clears filters and counters but keeps the service initialized.
+ * This clears filters and counters but keeps the service initialized, and
+ * keeps the learnt demag time per ampere: the first steps after a restart
+ * or re-sync are blanked from the start.
  */
 static void BEMF_Reset(void)
 {
     memset(&s_bemf_status, 0, sizeof(s_bemf_status));
     memset(s_prev_bemf, 0, sizeof(s_prev_bemf));
+    memset(s_prev_v, 0, sizeof(s_prev_v));
     memset(s_bootstrap, true, sizeof(s_bootstrap));
 
+    s_prev_sample_valid = false;
+    s_idle_ref = false;
+    s_comm_known = false;
+    s_coast_max_v = 0.0f;
+    s_coast_samples = 0;
     s_last_period_us = 0.0f;
+    s_last_zc_ticks = 0;
     s_last_zc_time_us = 0;
     s_valid_streak = 0;
     s_invalid_streak = 0;
@@ -268,6 +726,31 @@ static void BEMF_Reset(void)
     s_bemf_status.zero_cross_detected = false;
 }
 
+/**
+ * @brief Initialize the comparator backend (shared state + comparators).
+ */
+static bool BEMF_Comp_Init(void)
+{
+    s_comp_armed = false;
+
+    if (IBemfComparator == NULL || !IBemfComparator->init())
+        return false;
+
+    return BEMF_Init();
+}
+
+/**
+ * @brief Reset the comparator backend: capture disarmed until the next commutation.
+ */
+static void BEMF_Comp_Reset(void)
+{
+    if (s_comp_armed)
+        IBemfComparator->disarm();
+    s_comp_armed = false;
+
+    BEMF_Reset();
+}
+
 /**
  * @brief Retrieve the latest computed BEMF status.
  *
@@ -305,6 +788,20 @@ static s_bemf_monitor_t s_bemf_service = {
     .init                   =    BEMF_Init,
     .reset                  =    BEMF_Reset,
     .process                =    BEMF_Process,
+    .process_coasting       =    BEMF_ProcessCoasting,
+    .commutated             =    BEMF_Commutated,
+    .get_status             =    BEMF_GetStatus,
+    .clear_flag             =    BEMF_ClearFlag,
+    .get_last_zc_time_us    =    BEMF_GetLastZCTimeUs,
+};
+
+/** Comparator backend descriptor (status and lock logic shared). */
+static s_bemf_monitor_t s_bemf_comp_service = {
+    .init                   =    BEMF_Comp_Init,
+    .reset                  =    BEMF_Comp_Reset,
+    .process                =    BEMF_Comp_Process,
+    .process_coasting       =    BEMF_ProcessCoasting,
+    .commutated             =    BEMF_Comp_Commutated,
     .get_status             =    BEMF_GetStatus,
     .clear_flag             =    BEMF_ClearFlag,
     .get_last_zc_time_us    =    BEMF_GetLastZCTimeUs,
@@ -312,3 +809,6 @@ static s_bemf_monitor_t s_bemf_service = {
 
 /** Public pointer to BEMF monitoring service. */
 s_bemf_monitor_t* SBemfMonitor = &s_bemf_service;
+
+/** Public pointer to the comparator backend. */
+s_bemf_monitor_t* SBemfMonitorComp = &s_bemf_comp_service;
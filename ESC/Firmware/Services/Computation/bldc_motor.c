@@ -2,37 +2,33 @@
 #include <string.h>
 #include "service_bldc_motor.h"
 #include "i_inverter.h"
-#include "i_time_oneshot.h"
+#include "i_timer_sched.h"
 
 #include "i_time.h"
 
-/* === Step pattern structure ========================================== */
-typedef struct {
-    phase_output_state_t state[PHASE_COUNT];
-} sixstep_pattern_t;
-
-
-/* === Commutation table (CW direction) ================================ */
-static const sixstep_pattern_t sixstep_table_cw[6] = {
-    {{STATE_PWM_HIGH, STATE_PWM_LOW,  STATE_HIZ}},  // Step 0
-    {{STATE_PWM_HIGH, STATE_HIZ,      STATE_PWM_LOW}},
-    {{STATE_HIZ,      STATE_PWM_HIGH, STATE_PWM_LOW}},
-    {{STATE_PWM_LOW,  STATE_PWM_HIGH, STATE_HIZ}},
-    {{STATE_PWM_LOW,  STATE_HIZ,      STATE_PWM_HIGH}},
-    {{STATE_HIZ,      STATE_PWM_LOW,  STATE_PWM_HIGH}}
-};
-
-/* === Commutation table (CCW direction) =============================== */
-static const sixstep_pattern_t sixstep_table_ccw[6] = {
-    {{STATE_HIZ,      STATE_PWM_LOW,  STATE_PWM_HIGH}}, // Step 0
-    {{STATE_PWM_LOW,  STATE_HIZ,      STATE_PWM_HIGH}},
-    {{STATE_PWM_LOW,  STATE_PWM_HIGH, STATE_HIZ}},
-    {{STATE_HIZ,      STATE_PWM_HIGH, STATE_PWM_LOW}},
-    {{STATE_PWM_HIGH, STATE_HIZ,      STATE_PWM_LOW}},
-    {{STATE_PWM_HIGH, STATE_PWM_LOW,  STATE_HIZ}}
-};
+/* ============================================================================
+ * ADC trigger placement
+ * ========================================================================== */
+#define MOTOR_ADC_ON_TIME_TICKS      2U     /**< On-time sampling point: right after the pulse centre */
+#define MOTOR_ADC_WINDOW_TICKS       59U    /**< Trigger to end of the phase-voltage sampling (ADC1/2 ranks 2–3) */
+#define MOTOR_ADC_EDGE_MARGIN_TICKS  16U    /**< Clearance to a switching edge: dead time + ringing (≈ 0.5 µs) */
 
+/* ============================================================================
+ * Timer helpers
+ * ========================================================================== */
+/**
+ * @brief Convert a delay in microseconds to timer scheduler ticks.
+ *
+ * The scheduler counts at the timer clock, so fractional microseconds
+ * (e.g. a commutation delay derived from the BEMF period) are kept.
+ */
+static uint32_t Motor_UsToTicks(float delay_us)
+{
+    if (delay_us <= 0.0f)
+        return 0U;
 
+    return (uint32_t)(delay_us * ((float)ITimerSched->get_tick_hz() * 1e-6f));
+}
 
 /* ============================================================================
  * Internal timeout callback
@@ -98,9 +94,33 @@ void Service_Motor_Align_Rotor(float duty, uint32_t duration_ms, void (*on_align
     IInverter->set_all_duties(&duties);
 
     /* --- 3. Schedule automatic disable --- */
-    uint32_t duration_us = duration_ms * 1000U;
+    uint32_t duration_ticks = duration_ms * (ITimerSched->get_tick_hz() / 1000U);
+
+    ITimerSched->start(TIMER_EVENT_TIMEOUT, duration_ticks, Motor_Alignment_Timeout, on_alignment_done);
+}
 
-    IOneShotTimer->start(duration_us, Motor_Alignment_Timeout, on_alignment_done);
+/**
+ * @brief Complementary PWM on all three phases at 50 % (zero vector).
+ */
+void Service_Motor_Sinusoidal_Start(void)
+{
+    inverter_duty_t duties = { .phase_duty = { 0.5f, 0.5f, 0.5f } };
+
+    IInverter->set_comm_mode(INVERTER_COMM_IMMEDIATE);
+    IInverter->set_all_duties(&duties);
+    IInverter->set_output_state(PHASE_A, STATE_PWM_ACTIVE);
+    IInverter->set_output_state(PHASE_B, STATE_PWM_ACTIVE);
+    IInverter->set_output_state(PHASE_C, STATE_PWM_ACTIVE);
+}
+
+/**
+ * @brief Write the three phase duties, committed at the next update event.
+ */
+bool Service_Motor_SetPhaseDuties(const float duty[3])
+{
+    inverter_duty_t duties = { .phase_duty = { duty[0], duty[1], duty[2] } };
+
+    return IInverter->set_all_duties(&duties);
 }
 
 /* === Main commutation function ======================================= */
@@ -110,25 +130,152 @@ void Service_Motor_Align_Rotor(float duty, uint32_t duration_ms, void (*on_align
  * @param step Step index [0..5]
  * @param duty Normalized PWM duty (0.0 .. 1.0)
  * @param cw   Rotation direction (true = CW, false = CCW)
+ * @return Floating phase index (0 = A, 1 = B, 2 = C), 3 if rejected
  */
-void Inverter_SixStepCommutate(uint8_t step, float duty, bool cw)
+uint8_t Inverter_SixStepCommutate(uint8_t step, float duty, bool cw)
 {
-    if (step >= 6) return;
+    return (uint8_t)IInverter->six_step(step, duty, cw);
+}
 
-    const sixstep_pattern_t *pattern = cw ? &sixstep_table_cw[step] : &sixstep_table_ccw[step];
+/**
+ * @brief Preload a six-step pattern for the next hardware commutation.
+ *
+ * The output states are applied by the TIM1 COM event at the next
+ * TIMER_EVENT_COMMUTATION deadline, not by this call. The duty is written
+ * now on all three phases: it only matters on the driven ones, and the
+ * phase driven on both sides of the commutation keeps the same duty.
+ *
+ * @param step Step index [0..5]
+ * @param duty Normalized PWM duty (0.0 .. 1.0)
+ * @param cw   Rotation direction (true = CW, false = CCW)
+ * @return Floating phase index of @p step once applied, 3 if rejected
+ */
+uint8_t Inverter_SixStepPreload(uint8_t step, float duty, bool cw)
+{
+    /* In PRELOAD mode the driver fast path only loads the shadow registers */
+    return (uint8_t)IInverter->six_step(step, duty, cw);
+}
 
-    inverter_duty_t duties = {0};
+/**
+ * @brief Rewrite the duty of the applied six-step pattern.
+ *
+ * Same duty on the three phases, as written by the six-step fast path:
+ * the output states, immediate or preloaded, are not touched.
+ *
+ * @param duty Normalized PWM duty (0.0 .. 1.0)
+ * @return false if rejected
+ */
+bool Service_Motor_SetSixStepDuty(float duty)
+{
+    inverter_duty_t duties = { .phase_duty = { duty, duty, duty } };
 
-    // Apply duty only on active phases
-    for (uint8_t ph = 0; ph < PHASE_COUNT; ph++)
-        duties.phase_duty[ph] = (pattern->state[ph] != STATE_HIZ) ? duty : 0.0f;
+    return IInverter->set_all_duties(&duties);
+}
 
-    // Apply duty atomically
-    IInverter->set_all_duties(&duties);
+/**
+ * @brief Six-step position of a zero-cross seen on a free-running rotor.
+ *
+ * Floating phase of each step, as in the inverter six-step table: the
+ * floating phase crosses rising on odd steps, falling on even steps.
+ *
+ * @param phase  Phase that crossed (0 = A .. 2 = C)
+ * @param rising Direction of the crossing
+ * @param cw     Rotation direction assumed
+ * @return Step (0–5) whose zero-cross it is
+ */
+uint8_t Service_Motor_SixStepOfZeroCross(uint8_t phase, bool rising, bool cw)
+{
+    static const uint8_t s_floating[2][6] = {
+        { PHASE_C, PHASE_B, PHASE_A, PHASE_C, PHASE_B, PHASE_A },   /* CW  */
+        { PHASE_A, PHASE_B, PHASE_C, PHASE_A, PHASE_B, PHASE_C }    /* CCW */
+    };
 
-    // Configure output states for each phase
-    for (uint8_t ph = 0; ph < PHASE_COUNT; ph++)
-        IInverter->set_output_state((inverter_phase_t)ph, pattern->state[ph]);
+    uint8_t step = rising ? 1U : 0U;
+    for (; step < 6U; step += 2U)
+    {
+        if (s_floating[cw ? 0U : 1U][step] == phase)
+            break;
+    }
+    return step % 6U;
+}
+
+/**
+ * @brief Six-step position driving a rotor at rest at @p theta_deg.
+ *
+ * CW step k motors over [30° + 60°·k, 90° + 60°·k) (its zero-cross at the
+ * middle). The CCW table runs the CW patterns in reverse order, each one
+ * motoring backwards 180° away: CCW step k spans (150° - 60°·k, 210° - 60°·k].
+ *
+ * @param theta_deg Electrical angle (same frame as the zero-cross PLL)
+ * @param cw        Rotation direction
+ * @return Step (0–5) whose window contains @p theta_deg
+ */
+uint8_t Service_Motor_SixStepOfAngle(float theta_deg, bool cw)
+{
+    float x = cw ? (theta_deg - 30.0f) / 60.0f : (210.0f - theta_deg) / 60.0f;
+
+    /* Floor without floorf: truncation, one step down for negatives */
+    int32_t k = (int32_t)x;
+    if ((float)k > x)
+        k--;
+    return (uint8_t)(((k % 6) + 6) % 6);
+}
+
+/**
+ * @brief Select hardware-timed (TIM1 COM) or ISR-driven commutation.
+ *
+ * @param enable true: patterns given to Inverter_SixStepPreload() switch
+ *               at the commutation deadline; false: immediate writes.
+ * @return true if the mode was selected.
+ */
+bool Service_Motor_SetHwCommutation(bool enable)
+{
+    return IInverter->set_comm_mode(enable ? INVERTER_COMM_PRELOAD : INVERTER_COMM_IMMEDIATE);
+}
+
+
+/**
+ * @brief Move the ADC trigger to the on-time if the pulse has room for the
+ *        sampling window, else to the middle of the off-time.
+ *
+ * Trigger compares count from the centre of the on-time (up-counting half):
+ * the pulse ends at the duty compare, the off-time lasts up to the period.
+ *
+ * @param duty Normalized PWM duty (0.0 .. 1.0)
+ * @return true if the sample falls in the on-time
+ */
+bool Service_Motor_PlaceAdcTrigger(float duty)
+{
+    uint16_t period = IInverter->get_period_ticks();
+    uint16_t pulse  = (uint16_t)(fminf(fmaxf(duty, 0.0f), 1.0f) * (float)period);
+
+    if (pulse >= MOTOR_ADC_ON_TIME_TICKS + MOTOR_ADC_WINDOW_TICKS + MOTOR_ADC_EDGE_MARGIN_TICKS)
+    {
+        IInverter->set_adc_trigger(MOTOR_ADC_ON_TIME_TICKS);
+        return true;
+    }
+
+    Service_Motor_PlaceAdcTriggerOffTime(duty);
+    return false;
+}
+
+/**
+ * @brief Centre the sampling window between the end of the widest pulse
+ *        and the period top (all low sides conducting).
+ *
+ * A half period (centre of the on-time to the top) is `period` ticks.
+ *
+ * @param duty_max Largest phase duty (0.0 .. 1.0)
+ * @return Trigger after the centre of the on-time [PWM periods]
+ */
+float Service_Motor_PlaceAdcTriggerOffTime(float duty_max)
+{
+    uint16_t period  = IInverter->get_period_ticks();
+    uint16_t pulse   = (uint16_t)(fminf(fmaxf(duty_max, 0.0f), 1.0f) * (float)period);
+    uint16_t trigger = (uint16_t)((pulse + period - MOTOR_ADC_WINDOW_TICKS) / 2U);
+
+    IInverter->set_adc_trigger(trigger);
+    return (float)trigger / (2.0f * (float)period);
 }
 
 
@@ -136,32 +283,47 @@ void Inverter_SixStepCommutate(uint8_t step, float duty, bool cw)
 /* === Open-Loop Ramp (Event-Driven) ====================================== */
 /* ========================================================================== */
 
+#define RAMP_TABLE_SEGMENTS     32U         /**< Profile knots over the ramp (+1 for the end point) */
+#define RAMP_MIN_STEP_US        100.0f      /**< Shortest commutation step */
+
+/**
+ * @brief One point of the precomputed ramp profile.
+ */
+typedef struct
+{
+    float period_ticks;      /**< Commutation step at this point (scheduler ticks) */
+    float duty;              /**< Duty at this point (0.0–1.0) */
+} motor_ramp_knot_t;
+
 /**
  * @brief Context structure for open-loop six-step ramp (event-driven).
  * 
- * This structure holds both static configuration parameters and
- * dynamic state variables updated at each commutation event.
+ * The profile (frequency law and duty law) is evaluated once at the start,
+ * on RAMP_TABLE_SEGMENTS equal time segments. Each step only interpolates
+ * between two knots and schedules the next commutation at an absolute
+ * deadline, so the ramp lasts the commanded time in scheduler ticks.
  */
 typedef struct
 {
     /* === Configuration parameters (fixed during ramp) === */
-    float duty_start;        /**< Starting duty (0.0–1.0) */
-    float duty_end;          /**< Final duty (0.0–1.0) */
-    float freq_start_hz;     /**< Starting electrical frequency (Hz) */
-    float freq_end_hz;       /**< Final electrical frequency (Hz) */
-    uint32_t ramp_time_us;   /**< Total ramp duration (µs) */
+    motor_ramp_knot_t knot[RAMP_TABLE_SEGMENTS + 1U];  /**< Profile at each segment boundary */
+    uint32_t ramp_ticks;     /**< Total ramp duration (scheduler ticks) */
+    uint32_t seg_ticks;      /**< Duration of one segment (scheduler ticks) */
+    float inv_seg_ticks;     /**< 1 / seg_ticks */
     bool direction_cw;       /**< true = clockwise, false = CCW */
-    motor_ramp_profile_t profile_type;   /**< Ramp progression type */
 
     /* === User callback === */
     motor_ramp_callback_t on_complete;   /**< Callback called at ramp end */
     void *user_context;                  /**< Optional user data passed to callback */
 
     /* === Dynamic state variables (updated each step) === */
+    uint32_t start_ticks;    /**< Scheduler time of the first step */
+    uint32_t deadline;       /**< Scheduler time of the pending step */
+    uint8_t segment;         /**< Segment holding the pending step */
+    uint32_t segment_end;    /**< End of that segment, from start_ticks */
     uint8_t step_index;      /**< Current six-step position (0–5) */
-    uint64_t elapsed_us;     /**< Accumulated elapsed time (µs) */
     float current_duty;      /**< Current applied duty */
-    float current_freq_hz;   /**< Current electrical frequency (Hz) */
+    uint8_t floating_phase;  /**< Hi-Z phase of the current step (0 = A .. 2 = C) */
     bool active;             /**< Ramp currently running flag */
 
 } motor_ramp_context_t;
@@ -176,6 +338,79 @@ static motor_ramp_context_t s_ramp_ctx;  // Only one active ramp at a time
 static void Motor_Ramp_OnStepEvent(void *user_context);
 
 
+/**
+ * @brief Electrical frequency of a ramp profile at progress @p ratio.
+ */
+static float Motor_Ramp_ProfileFreq(motor_ramp_profile_t profile, float f0, float f1, float ratio)
+{
+    switch (profile)
+    {
+        default:
+        case RAMP_PROFILE_LINEAR:
+            return f0 + ratio * (f1 - f0);
+
+        case RAMP_PROFILE_EXPONENTIAL:
+            return f0 * powf((f1 / f0), ratio);
+
+        case RAMP_PROFILE_QUADRATIC:
+            return f0 + powf(ratio, 2.0f) * (f1 - f0);
+
+        case RAMP_PROFILE_LOGARITHMIC:
+            return f1 - (f1 - f0) * expf(-4.0f * ratio);
+    }
+}
+
+/**
+ * @brief Fill knot @p k of the ramp table.
+ */
+static void Motor_Ramp_SetKnot(uint32_t k, float freq_hz, float duty)
+{
+    float min_ticks = RAMP_MIN_STEP_US * ((float)ITimerSched->get_tick_hz() * 1e-6f);
+    float period = (freq_hz > 0.0f) ? (float)ITimerSched->get_tick_hz() / (6.0f * freq_hz) : (float)s_ramp_ctx.ramp_ticks;
+
+    s_ramp_ctx.knot[k].period_ticks = (period < min_ticks) ? min_ticks : period;
+    s_ramp_ctx.knot[k].duty         = duty;
+}
+
+/**
+ * @brief Reset the ramp context for a new ramp of @p ramp_time_ms (the
+ *        knots are filled by the caller afterwards).
+ */
+static void Motor_Ramp_Init(uint32_t ramp_time_ms, bool cw, motor_ramp_callback_t on_complete, void *user_ctx)
+{
+    ITimerSched->cancel(TIMER_EVENT_RAMP);
+
+    memset(&s_ramp_ctx, 0, sizeof(s_ramp_ctx));
+
+    s_ramp_ctx.ramp_ticks    = (uint32_t)(((uint64_t)ramp_time_ms * ITimerSched->get_tick_hz()) / 1000U);
+    s_ramp_ctx.seg_ticks     = s_ramp_ctx.ramp_ticks / RAMP_TABLE_SEGMENTS;
+    if (s_ramp_ctx.seg_ticks == 0U)
+        s_ramp_ctx.seg_ticks = 1U;
+    s_ramp_ctx.inv_seg_ticks = 1.0f / (float)s_ramp_ctx.seg_ticks;
+    s_ramp_ctx.direction_cw  = cw;
+    s_ramp_ctx.on_complete   = on_complete;
+    s_ramp_ctx.user_context  = user_ctx;
+}
+
+/**
+ * @brief Apply the first step and schedule the second one (table ready).
+ */
+static void Motor_Ramp_Begin(uint8_t step)
+{
+    s_ramp_ctx.step_index   = step % 6U;
+    s_ramp_ctx.current_duty = s_ramp_ctx.knot[0].duty;
+    s_ramp_ctx.segment      = 0U;
+    s_ramp_ctx.segment_end  = s_ramp_ctx.seg_ticks;
+    s_ramp_ctx.active       = true;
+
+    s_ramp_ctx.floating_phase = Inverter_SixStepCommutate(s_ramp_ctx.step_index, s_ramp_ctx.current_duty,
+                                                          s_ramp_ctx.direction_cw);
+
+    s_ramp_ctx.start_ticks = ITimerSched->now();
+    s_ramp_ctx.deadline    = s_ramp_ctx.start_ticks + (uint32_t)s_ramp_ctx.knot[0].period_ticks;
+    ITimerSched->start_at(TIMER_EVENT_RAMP, s_ramp_ctx.deadline, Motor_Ramp_OnStepEvent, &s_ramp_ctx);
+}
+
 
 /* ========================================================================== */
 /* === Function: Start Open-Loop Ramp ====================================== */
@@ -184,9 +419,9 @@ static void Motor_Ramp_OnStepEvent(void *user_context);
  * @brief Start an open-loop six-step ramp (event-driven, non-blocking).
  *
  * This function initializes the ramp context, performs the first commutation,
- * and schedules the next commutation step using the one-shot timer. The ramp
- * progresses automatically without blocking the CPU. When the ramp completes,
- * the optional user callback is invoked.
+ * and schedules the next commutation step on the TIMER_EVENT_RAMP event.
+ * The ramp progresses automatically without blocking the CPU. When the ramp
+ * completes, the optional user callback is invoked.
  *
  * @param duty_start     Starting duty (0.0–1.0)
  * @param duty_end       Final duty (0.0–1.0)
@@ -209,38 +444,91 @@ void Service_Motor_OpenLoopRamp_Start(
     motor_ramp_callback_t on_complete,
     void *user_ctx)
 {
-    /* === 1. Cancel any previous ramp ================================= */
-    if (IOneShotTimer->isActive())
-        IOneShotTimer->cancel();
+    Service_Motor_OpenLoopRamp_StartFrom(0U, duty_start, duty_end, freq_start_hz, freq_end_hz,
+                                         ramp_time_ms, cw, profile_type, on_complete, user_ctx);
+}
 
-    /* === 2. Initialize context ======================================= */
-    memset(&s_ramp_ctx, 0, sizeof(s_ramp_ctx));
+/**
+ * @brief Same ramp as Service_Motor_OpenLoopRamp_Start(), from a located
+ *        rotor: the first pattern is @p step instead of the aligned one.
+ *
+ * @param step           Six-step position to start from (0–5)
+ * @param duty_start     Starting duty (0.0–1.0)
+ * @param duty_end       Final duty (0.0–1.0)
+ * @param freq_start_hz  Starting electrical frequency (Hz)
+ * @param freq_end_hz    Final electrical frequency (Hz)
+ * @param ramp_time_ms   Total ramp duration in milliseconds
+ * @param cw             true = clockwise, false = counterclockwise
+ * @param profile_type   Ramp progression profile
+ * @param on_complete    Optional callback called when ramp finishes (can be NULL)
+ * @param user_ctx       User context pointer passed to the callback (can be NULL)
+ */
+void Service_Motor_OpenLoopRamp_StartFrom(
+    uint8_t step,
+    float duty_start,
+    float duty_end,
+    float freq_start_hz,
+    float freq_end_hz,
+    uint32_t ramp_time_ms,
+    bool cw,
+    motor_ramp_profile_t profile_type,
+    motor_ramp_callback_t on_complete,
+    void *user_ctx)
+{
+    /* === 1. Cancel any previous ramp, initialize context ============= */
+    Motor_Ramp_Init(ramp_time_ms, cw, on_complete, user_ctx);
+
+    /* === 2. Evaluate the profile once per segment ==================== */
+    for (uint32_t k = 0; k <= RAMP_TABLE_SEGMENTS; k++)
+    {
+        float ratio = (float)k / (float)RAMP_TABLE_SEGMENTS;
 
-    s_ramp_ctx.duty_start       = duty_start;
-    s_ramp_ctx.duty_end         = duty_end;
-    s_ramp_ctx.freq_start_hz    = freq_start_hz;
-    s_ramp_ctx.freq_end_hz      = freq_end_hz;
-    s_ramp_ctx.ramp_time_us     = ramp_time_ms * 1000U;
-    s_ramp_ctx.direction_cw     = cw;
-    s_ramp_ctx.profile_type     = profile_type;
-    s_ramp_ctx.on_complete      = on_complete;
-    s_ramp_ctx.user_context     = user_ctx;
-
-    s_ramp_ctx.step_index       = 0;
-    s_ramp_ctx.elapsed_us       = 0;
-    s_ramp_ctx.current_duty     = duty_start;
-    s_ramp_ctx.current_freq_hz  = freq_start_hz;
-    s_ramp_ctx.active           = true;
-
-    /* === 3. Apply first commutation step immediately ================= */
-    Inverter_SixStepCommutate(s_ramp_ctx.step_index, s_ramp_ctx.current_duty, cw);
-
-    /* === 4. Compute delay for next commutation ======================= */
-    float step_delay_us_f = 1e6f / (6.0f * s_ramp_ctx.current_freq_hz);
-    uint32_t step_delay_us = (uint32_t)(step_delay_us_f < 100.0f ? 100.0f : step_delay_us_f);
-
-    /* === 5. Schedule next step ======================================= */
-    IOneShotTimer->start(step_delay_us, Motor_Ramp_OnStepEvent, &s_ramp_ctx);
+        Motor_Ramp_SetKnot(k,
+                           Motor_Ramp_ProfileFreq(profile_type, freq_start_hz, freq_end_hz, ratio),
+                           duty_start + powf(ratio, 1.5f) * (duty_end - duty_start));
+    }
+
+    /* === 3. First commutation now, next one at its deadline ========== */
+    Motor_Ramp_Begin(step);
+}
+
+
+/* ========================================================================== */
+/* === Function: Re-sync Ramp ============================================== */
+/* ========================================================================== */
+/**
+ * @brief Restart the open-loop sequence on a spinning rotor.
+ *
+ * Same event-driven ramp as Service_Motor_OpenLoopRamp_Start(), at constant
+ * frequency and duty, but starting from @p step instead of the aligned
+ * position: the first pattern is the one the rotor is estimated to be in,
+ * so the BEMF can be caught without stopping the rotor. If the ramp runs
+ * out without a handover, it ends like a normal ramp (inverter disabled,
+ * @p on_complete invoked).
+ *
+ * @param step         Six-step position to start from (0–5)
+ * @param duty         PWM duty (0.0–1.0)
+ * @param freq_hz      Electrical frequency (Hz)
+ * @param hold_ms      Time allowed to catch the BEMF (milliseconds)
+ * @param cw           true = clockwise, false = counterclockwise
+ * @param on_complete  Optional callback called when the ramp runs out (can be NULL)
+ * @param user_ctx     User context pointer passed to the callback (can be NULL)
+ */
+void Service_Motor_OpenLoopRamp_Resync(
+    uint8_t step,
+    float duty,
+    float freq_hz,
+    uint32_t hold_ms,
+    bool cw,
+    motor_ramp_callback_t on_complete,
+    void *user_ctx)
+{
+    Motor_Ramp_Init(hold_ms, cw, on_complete, user_ctx);
+
+    for (uint32_t k = 0; k <= RAMP_TABLE_SEGMENTS; k++)
+        Motor_Ramp_SetKnot(k, freq_hz, duty);
+
+    Motor_Ramp_Begin(step);
 }
 
 
@@ -248,12 +536,13 @@ void Service_Motor_OpenLoopRamp_Start(
 /* === Function: Ramp Callback (Timer Event) =============================== */
 /* ========================================================================== */
 /**
- * @brief One-shot timer callback for open-loop ramp progression.
+ * @brief Timer callback for open-loop ramp progression.
  *
- * This callback is invoked automatically when the one-shot timer expires.
- * It performs one commutation step, updates the ramp progression,
- * computes new frequency/duty according to the selected profile,
- * and re-arms the timer until the ramp is complete.
+ * This callback is invoked automatically when TIMER_EVENT_RAMP expires.
+ * It performs one commutation step, interpolates the step period and duty
+ * between the two knots around the current time, and re-arms the timer
+ * at an absolute deadline until the ramp is complete. No transcendental
+ * function or division runs here (TIM5 ISR).
  *
  * @param user_context Pointer to current ramp context (motor_ramp_context_t)
  */
@@ -263,17 +552,15 @@ static void Motor_Ramp_OnStepEvent(void *user_context)
     if (ctx == NULL || !ctx->active)
         return;
 
-    /* === 1. Update elapsed time ===================================== */
-    float step_period_us_f = 1e6f / (6.0f * ctx->current_freq_hz);
-    uint32_t step_period_us = (uint32_t)(step_period_us_f < 100.0f ? 100.0f : step_period_us_f);
-    ctx->elapsed_us += step_period_us;
+    /* === 1. Elapsed time: deadlines, not callback latency ============ */
+    uint32_t elapsed = ctx->deadline - ctx->start_ticks;
 
     /* === 2. Check for ramp completion ================================ */
-    if (ctx->elapsed_us >= ctx->ramp_time_us)
+    if (elapsed >= ctx->ramp_ticks)
     {
         ctx->active = false;
         IInverter->disable();   // Stop PWM safely
-        IOneShotTimer->cancel(); // Just in case
+        ITimerSched->cancel(TIMER_EVENT_RAMP); // Just in case
 
         // Notify application if callback is set
         if (ctx->on_complete)
@@ -282,54 +569,31 @@ static void Motor_Ramp_OnStepEvent(void *user_context)
         return;
     }
 
-    /* === 3. Compute progress ratio (0.0 → 1.0) ======================= */
-    float ratio = (float)ctx->elapsed_us / (float)ctx->ramp_time_us;
-    if (ratio > 1.0f)
-        ratio = 1.0f;
-
-    /* === 4. Compute frequency based on profile ======================= */
-    switch (ctx->profile_type)
+    /* === 3. Locate the segment (steps are shorter than segments) ===== */
+    while (elapsed >= ctx->segment_end && ctx->segment < RAMP_TABLE_SEGMENTS - 1U)
     {
-        default:
-        case RAMP_PROFILE_LINEAR:
-            ctx->current_freq_hz =
-                ctx->freq_start_hz +
-                ratio * (ctx->freq_end_hz - ctx->freq_start_hz);
-            break;
-
-        case RAMP_PROFILE_EXPONENTIAL:
-            ctx->current_freq_hz =
-                ctx->freq_start_hz *
-                powf((ctx->freq_end_hz / ctx->freq_start_hz), ratio);
-            break;
+        ctx->segment++;
+        ctx->segment_end += ctx->seg_ticks;
+    }
 
-        case RAMP_PROFILE_QUADRATIC:
-            ctx->current_freq_hz =
-                ctx->freq_start_hz +
-                powf(ratio, 2.0f) * (ctx->freq_end_hz - ctx->freq_start_hz);
-            break;
+    float frac = (float)(elapsed - (ctx->segment_end - ctx->seg_ticks)) * ctx->inv_seg_ticks;
+    if (frac > 1.0f)
+        frac = 1.0f;
 
-        case RAMP_PROFILE_LOGARITHMIC:
-            ctx->current_freq_hz =
-                ctx->freq_end_hz -
-                (ctx->freq_end_hz - ctx->freq_start_hz) * expf(-4.0f * ratio);
-            break;
-    }
+    /* === 4. Interpolate period and duty ============================== */
+    const motor_ramp_knot_t *k0 = &ctx->knot[ctx->segment];
+    const motor_ramp_knot_t *k1 = k0 + 1;
 
-    /* === 5. Compute duty (smooth progression) ======================== */
-    ctx->current_duty =
-        ctx->duty_start +
-        powf(ratio, 1.5f) * (ctx->duty_end - ctx->duty_start);
+    float period_ticks = k0->period_ticks + frac * (k1->period_ticks - k0->period_ticks);
+    ctx->current_duty  = k0->duty + frac * (k1->duty - k0->duty);
 
-    /* === 6. Perform next commutation step ============================ */
+    /* === 5. Perform next commutation step ============================ */
     ctx->step_index = (ctx->step_index + 1) % 6;
-    Inverter_SixStepCommutate(ctx->step_index, ctx->current_duty, ctx->direction_cw);
-
-    /* === 7. Schedule next commutation ================================ */
-    float next_step_us_f = 1e6f / (6.0f * ctx->current_freq_hz);
-    uint32_t next_step_us = (uint32_t)(next_step_us_f < 100.0f ? 100.0f : next_step_us_f);
+    ctx->floating_phase = Inverter_SixStepCommutate(ctx->step_index, ctx->current_duty, ctx->direction_cw);
 
-    IOneShotTimer->start(next_step_us, Motor_Ramp_OnStepEvent, ctx);
+    /* === 6. Schedule next commutation ================================ */
+    ctx->deadline += (uint32_t)period_ticks;
+    ITimerSched->start_at(TIMER_EVENT_RAMP, ctx->deadline, Motor_Ramp_OnStepEvent, ctx);
 }
 
 /* ========================================================================== */
@@ -353,6 +617,17 @@ void Service_Motor_OpenLoopRamp_GetState(uint8_t *step_index, float *duty, bool
     if (direction_cw)  *direction_cw = s_ramp_ctx.direction_cw;
 }
 
+/**
+ * @brief Floating phase of the current ramp step (0 = A, 1 = B, 2 = C).
+ *
+ * Returned by the inverter when the step was applied, so the BEMF monitor
+ * follows the ramp without a lookup of its own.
+ */
+uint8_t Service_Motor_OpenLoopRamp_GetFloatingPhase(void)
+{
+    return s_ramp_ctx.floating_phase;
+}
+
 /* ========================================================================== */
 /* === Function: Stop Open-Loop Ramp ====================================== */
 /* ========================================================================== */
@@ -366,11 +641,8 @@ void Service_Motor_OpenLoopRamp_GetState(uint8_t *step_index, float *duty, bool
  */
 void Service_Motor_OpenLoopRamp_Stop(void)
 {
-    // 1. Cancel pending timer event
-    if (IOneShotTimer->isActive())
-    {
-        IOneShotTimer->cancel();
-    }
+    // 1. Cancel pending ramp step
+    ITimerSched->cancel(TIMER_EVENT_RAMP);
 
     // 2. Disable inverter for safety
     IInverter->disable();
@@ -387,13 +659,24 @@ void Service_Motor_OpenLoopRamp_Stop(void)
  */
 void Service_Motor_OpenLoopRamp_StopSoft(void)
 {
-    if (IOneShotTimer->isActive())
-        IOneShotTimer->cancel();
+    ITimerSched->cancel(TIMER_EVENT_RAMP);
 
     memset(&s_ramp_ctx, 0, sizeof(s_ramp_ctx));
     s_ramp_ctx.active = false;
 }
 
+/**
+ * @brief Freeze the open-loop ramp on its current step.
+ *
+ * The pending ramp step is cancelled but the ramp state stays readable
+ * through Service_Motor_OpenLoopRamp_GetState(). Used while a handover
+ * commutation is pending, so the ramp cannot commutate in between.
+ */
+void Service_Motor_OpenLoopRamp_Hold(void)
+{
+    ITimerSched->cancel(TIMER_EVENT_RAMP);
+}
+
 
 
 /* ========================================================================== */
@@ -403,9 +686,10 @@ void Service_Motor_OpenLoopRamp_StopSoft(void)
 /**
  * @brief Schedule a six-step commutation event after a specified delay.
  *
- * This helper service uses the one-shot timer to schedule a callback after
- * a given microsecond delay. It abstracts away the hardware timer interface
- * from the Control layer.
+ * This helper service uses the timer scheduler commutation event to schedule
+ * a callback after a given microsecond delay (sub-µs resolution). A pending
+ * commutation is replaced; ramp steps and timeouts are not affected. It
+ * abstracts away the hardware timer interface from the Control layer.
  *
  * @param delay_us   Delay before triggering commutation (µs)
  * @param callback   Function to call when the timer expires
@@ -416,10 +700,7 @@ void Service_ScheduleCommutation(float delay_us, commutation_callback_t callback
     if (callback == NULL)
         return;
 
-    if (IOneShotTimer->isActive())
-        IOneShotTimer->cancel();
-
-    IOneShotTimer->start((uint32_t)delay_us, callback, user_ctx);
+    ITimerSched->start(TIMER_EVENT_COMMUTATION, Motor_UsToTicks(delay_us), callback, user_ctx);
 }
 
 
@@ -433,7 +714,12 @@ void Service_ScheduleCommutation(float delay_us, commutation_callback_t callback
 void Service_Motor_Stop(void)
 {
     IInverter->disable();
-    IOneShotTimer->cancel();
+    IInverter->set_comm_mode(INVERTER_COMM_IMMEDIATE);
+
+    ITimerSched->cancel(TIMER_EVENT_COMMUTATION);
+    ITimerSched->cancel(TIMER_EVENT_BLANKING);
+    ITimerSched->cancel(TIMER_EVENT_RAMP);
+    ITimerSched->cancel(TIMER_EVENT_TIMEOUT);
 
     memset(&s_ramp_ctx, 0, sizeof(s_ramp_ctx));
     s_ramp_ctx.active = false;
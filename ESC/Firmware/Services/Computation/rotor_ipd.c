@@ -0,0 +1,167 @@
+/**
+ * @file rotor_ipd.c
+ * @brief Initial rotor position detection by inductive sensing.
+ *
+ * Pulses are the six-step patterns themselves (IInverter->six_step(), CW
+ * table), at a fixed duty: the centred pulse of the next PWM period is the
+ * only one applied, its end current sampled by moving the ADC trigger just
+ * before the falling edge. The current channel read is the unfiltered
+ * i_peak_raw (the IIR of i_a/i_b would average one pulse away).
+ *
+ * Layer: Service (S)
+ * Dependencies: i_inverter, i_motor_sensor, service_generic
+ */
+
+#include "service_rotor_ipd.h"
+#include "service_generic.h"
+#include "i_inverter.h"
+#include "i_motor_sensor.h"
+
+#include <math.h>
+#include <string.h>
+
+#define IPD_PULSE_DUTY          0.5f    /**< ≈ 20 µs centred pulse: 12 V into 2 × 30 µH → ≈ 4 A */
+#define IPD_SAMPLE_LEAD_TICKS   24U     /**< Trigger before the pulse end: current rank + edge margin */
+#define IPD_REST_TICKS          3U      /**< Samples between pulses: current back to zero */
+#define IPD_MIN_CURRENT_A       0.5f    /**< Mean peak current below: no motor / no bus */
+#define IPD_MIN_CONTRAST        0.02f   /**< First harmonic below 2 % of the mean: no position information */
+#define IPD_VECTOR0_DEG         150.0f  /**< Magnet angle lined up with the pattern of CW step 0 (A+ B-) */
+
+#define IPD_DEG_PER_RAD         57.2957795f
+
+/**
+ * @brief Step of the pulse sequence.
+ */
+typedef enum {
+    IPD_STAGE_REST = 0,         /**< Waiting for the current to decay */
+    IPD_STAGE_SAMPLE            /**< Pulse armed: the next sample is inside it */
+} ipd_stage_t;
+
+static struct {
+    rotor_ipd_state_t  state;
+    ipd_stage_t        stage;
+    uint8_t            vector;      /**< Vector being measured */
+    uint8_t            wait;        /**< Rest samples left */
+    float              peak_a[ROTOR_IPD_VECTORS];
+    rotor_ipd_result_t result;
+} s_ipd;
+
+/**
+ * @brief Bridge off, compares cleared: no pulse until the next arm.
+ */
+static void Ipd_BridgeOff(void)
+{
+    static const inverter_duty_t zero = { .phase_duty = { 0.0f, 0.0f, 0.0f } };
+
+    IInverter->disable();
+    IInverter->set_all_duties(&zero);
+}
+
+/**
+ * @brief Preload the pulse of vector @p k and its end-of-pulse sample.
+ */
+static void Ipd_ArmPulse(uint8_t k)
+{
+    uint16_t pulse = (uint16_t)(IPD_PULSE_DUTY * (float)IInverter->get_period_ticks());
+
+    (void)IInverter->six_step(k, IPD_PULSE_DUTY, true);
+    (void)IInverter->set_adc_trigger((uint16_t)(pulse - IPD_SAMPLE_LEAD_TICKS));
+}
+
+/**
+ * @brief Start the pulse sequence (bridge off, all compares cleared).
+ */
+void Service_RotorIpd_Start(void)
+{
+    memset(&s_ipd, 0, sizeof(s_ipd));
+    Ipd_BridgeOff();
+
+    s_ipd.stage = IPD_STAGE_REST;
+    s_ipd.wait  = IPD_REST_TICKS;
+    s_ipd.state = ROTOR_IPD_RUNNING;
+}
+
+/**
+ * @brief Advance the sequence by one step (fast loop, after each ADC sample).
+ */
+rotor_ipd_state_t Service_RotorIpd_Process(void)
+{
+    motor_measurements_t meas;
+
+    if (s_ipd.state != ROTOR_IPD_RUNNING)
+        return s_ipd.state;
+
+    /* One step per ADC sample: the pulse sample follows its arming */
+    if (!IMotor_ADC_Measure->get_latest_measurements(&meas))
+        return s_ipd.state;
+
+    if (s_ipd.stage == IPD_STAGE_SAMPLE)
+    {
+        s_ipd.peak_a[s_ipd.vector] = Service_ADC_To_Current(meas.i_peak_raw);
+        Ipd_BridgeOff();
+
+        s_ipd.vector++;
+        s_ipd.stage = IPD_STAGE_REST;
+        s_ipd.wait  = IPD_REST_TICKS;
+        return s_ipd.state;
+    }
+
+    if (s_ipd.wait > 0U)
+    {
+        s_ipd.wait--;
+        return s_ipd.state;
+    }
+
+    if (s_ipd.vector < ROTOR_IPD_VECTORS)
+    {
+        Ipd_ArmPulse(s_ipd.vector);
+        s_ipd.stage = IPD_STAGE_SAMPLE;
+        return s_ipd.state;
+    }
+
+    Service_RotorIpd_Estimate(s_ipd.peak_a, &s_ipd.result);
+    s_ipd.state = ROTOR_IPD_DONE;
+    return s_ipd.state;
+}
+
+/**
+ * @brief Read the result of the last completed detection.
+ */
+bool Service_RotorIpd_GetResult(rotor_ipd_result_t *out)
+{
+    if (s_ipd.state != ROTOR_IPD_DONE)
+        return false;
+
+    if (out != NULL)
+        *out = s_ipd.result;
+    return true;
+}
+
+/**
+ * @brief Estimate the rotor angle from the six peak currents.
+ *
+ * Single-bin DFT over the vector angles: saturation gives the first
+ * harmonic (peak on the north pole), saliency the second one, which six
+ * equally spaced vectors keep out of the first.
+ */
+void Service_RotorIpd_Estimate(const float peak_a[ROTOR_IPD_VECTORS], rotor_ipd_result_t *out)
+{
+    float re = 0.0f, im = 0.0f, mean = 0.0f;
+
+    for (uint8_t k = 0; k < ROTOR_IPD_VECTORS; k++)
+    {
+        float phi = (IPD_VECTOR0_DEG + 60.0f * (float)k) / IPD_DEG_PER_RAD;
+        re   += peak_a[k] * cosf(phi);
+        im   += peak_a[k] * sinf(phi);
+        mean += peak_a[k];
+        out->peak_a[k] = peak_a[k];
+    }
+    mean /= (float)ROTOR_IPD_VECTORS;
+
+    float ampl = (2.0f / (float)ROTOR_IPD_VECTORS) * sqrtf(re * re + im * im);
+    float angle = atan2f(im, re) * IPD_DEG_PER_RAD;
+
+    out->angle_deg = (angle < 0.0f) ? angle + 360.0f : angle;
+    out->contrast  = (mean > 0.0f) ? ampl / mean : 0.0f;
+    out->valid     = mean >= IPD_MIN_CURRENT_A && out->contrast >= IPD_MIN_CONTRAST;
+}
@@ -6,7 +6,7 @@
  * high-frequency control loop (typically 24 kHz).
  *
  * Responsibilities:
- *   - Initialize the underlying Fast Loop driver (IFastLoop, TIM3-based)
+ *   - Initialize the underlying Fast Loop driver (IFastLoop: ADC JEOC or TIM3)
  *   - Register and execute user callbacks at fixed intervals (~41.6 µs)
  *   - Measure runtime execution time for diagnostics
  *   - Maintain runtime statistics (tick count, average duration, etc.)
@@ -19,7 +19,8 @@
 
 #include "service_loop.h"
 #include "i_periodic_loop.h"  // Provides IFastLoop driver interface
-#include "i_time.h"           // Provides ITime->get_time_us()
+#include "i_time.h"           // Provides ITime->get_cycles()
+#include "i_perf.h"           // Cycle-accurate profiling probes
 #include <string.h>
 
 /* ========================================================================== */
@@ -38,6 +39,7 @@ typedef struct
     uint32_t tick_count;        /**< Total number of executed loop cycles */
     uint32_t last_exec_us;      /**< Duration of last callback (µs) */
     uint32_t avg_exec_us;       /**< Exponential moving average of duration (µs) */
+    uint32_t cycles_per_us;     /**< CPU cycles per µs (profiling conversion) */
     bool running;               /**< True if the loop service is currently active */
 } sloop_ctx_t;
 
@@ -45,7 +47,7 @@ typedef struct
 static sloop_ctx_t s_ctx = {0};
 
 /**
- * @brief Reference to the underlying low-level driver (TIM3-based).
+ * @brief Reference to the underlying low-level driver (ADC JEOC or TIM3).
  *
  * Defined in driver_fastloop.c and provides access to hardware-level control.
  */
@@ -59,7 +61,7 @@ extern i_periodic_loop_t* IFastLoop;
  * @brief Internal trampoline executed at every Fast Loop tick (ISR context).
  *
  * This function wraps the control-layer callback to:
- *   1. Measure its execution time in microseconds.
+ *   1. Measure its execution time in CPU cycles (IPerf probe).
  *   2. Update tick count and performance statistics.
  *   3. Call the registered user callback.
  *
@@ -70,13 +72,15 @@ static void SFastLoop_Trampoline(void)
     if (s_ctx.user_cb == NULL)
         return;
 
-    uint32_t start_us = ITime->get_time_us();
+    uint32_t start = ITime->get_cycles();
 
     /* Execute the user callback (e.g., Motor_FastLoop) */
     s_ctx.user_cb();
 
-    uint32_t end_us = ITime->get_time_us();
-    uint32_t delta = end_us - start_us;
+    uint32_t cycles = ITime->get_cycles() - start;
+    uint32_t delta = cycles / s_ctx.cycles_per_us;
+
+    IPerf->record(PERF_PROBE_FASTLOOP, cycles);
 
     /* Update runtime statistics */
     s_ctx.tick_count++;
@@ -92,7 +96,7 @@ static void SFastLoop_Trampoline(void)
  * @brief Initialize the Fast Loop service and its driver.
  *
  * - Clears all runtime statistics and callback pointers.
- * - Initializes the underlying timer driver (TIM3).
+ * - Initializes the underlying driver (ADC JEOC or TIM3).
  * - Registers the internal trampoline callback.
  *
  * @retval true  Initialization successful.
@@ -102,10 +106,21 @@ static bool SFL_Init(void)
 {
     memset(&s_ctx, 0, sizeof(s_ctx));
 
-    /* Initialize the hardware driver (TIM3-based Fast Loop) */
+    /* Initialize the hardware driver (ADC JEOC or TIM3 Fast Loop) */
     if (!IFastLoop->init())
         return false;
 
+    /* Profiling: cycle → µs conversion, overrun budget = one loop period */
+    uint32_t f_cpu = ITime->getSystemFrequency();
+    s_ctx.cycles_per_us = (f_cpu >= 1000000U) ? (f_cpu / 1000000U) : 1U;
+    uint32_t period_cycles = f_cpu / IFastLoop->get_frequency_hz();
+    IPerf->set_budget(PERF_PROBE_FASTLOOP, period_cycles);
+
+    /* The ADC JEOC (TIM1 TRGO) and the TIM5 scheduler events share the same
+     * 24 kHz budget: each must complete within one PWM period. */
+    IPerf->set_budget(PERF_PROBE_ADC_JEOC, period_cycles);
+    IPerf->set_budget(PERF_PROBE_ONESHOT, period_cycles);
+
     /* Register the ISR trampoline with the low-level driver */
     IFastLoop->register_callback(SFastLoop_Trampoline);
 
@@ -19,7 +19,8 @@
 
 #include "service_loop.h"
 #include "i_periodic_loop.h"  // Provides ILowLoop driver interface
-#include "i_time.h"           // Provides ITime->get_time_us()
+#include "i_time.h"           // Provides ITime->get_cycles()
+#include "i_perf.h"           // Cycle-accurate profiling probes
 #include <string.h>
 
 /* ========================================================================== */
@@ -38,6 +39,7 @@ typedef struct
     uint32_t tick_count;        /**< Total number of executed loop cycles */
     uint32_t last_exec_us;      /**< Duration of last callback (µs) */
     uint32_t avg_exec_us;       /**< Exponential moving average of duration (µs) */
+    uint32_t cycles_per_us;     /**< CPU cycles per µs (profiling conversion) */
     bool running;               /**< True if the loop service is currently active */
 } sloop_ctx_t;
 
@@ -59,7 +61,7 @@ extern i_periodic_loop_t* ILowLoop;
  * @brief Trampoline executed at every timer interrupt (ISR context).
  *
  * This internal function acts as a safe wrapper around the user callback:
- *   1. Measures callback execution duration.
+ *   1. Measures callback execution duration in CPU cycles (IPerf probe).
  *   2. Updates tick count and performance statistics.
  *   3. Invokes the registered control-layer callback.
  *
@@ -70,13 +72,15 @@ static void SLowLoop_Trampoline(void)
     if (s_ctx.user_cb == NULL)
         return;
 
-    uint32_t start_us = ITime->get_time_us();
+    uint32_t start = ITime->get_cycles();
 
     /* Execute user-defined control callback */
     s_ctx.user_cb();
 
-    uint32_t end_us = ITime->get_time_us();
-    uint32_t delta = end_us - start_us;
+    uint32_t cycles = ITime->get_cycles() - start;
+    uint32_t delta = cycles / s_ctx.cycles_per_us;
+
+    IPerf->record(PERF_PROBE_LOWLOOP, cycles);
 
     /* Update performance metrics */
     s_ctx.tick_count++;
@@ -106,6 +110,11 @@ static bool SLL_Init(void)
     if (!ILowLoop->init())
         return false;
 
+    /* Profiling: cycle → µs conversion, overrun budget = one loop period */
+    uint32_t f_cpu = ITime->getSystemFrequency();
+    s_ctx.cycles_per_us = (f_cpu >= 1000000U) ? (f_cpu / 1000000U) : 1U;
+    IPerf->set_budget(PERF_PROBE_LOWLOOP, f_cpu / ILowLoop->get_frequency_hz());
+
     /* Register internal ISR callback */
     ILowLoop->register_callback(SLowLoop_Trampoline);
 
@@ -65,4 +65,28 @@ float Service_Get_PhaseC_Current(void)
         return 0.0f;
 
     return Service_ADC_To_Current(s_motor_meas.i_c_raw);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Returns the Phase A current of the last trigger, unfiltered, in amperes.
+ * @return float Phase A current magnitude (A), or 0.0f if no valid measurement available.
+ */
+float Service_Get_PhaseA_Current_Inst(void)
+{
+    if (!s_measurements_valid)
+        return 0.0f;
+
+    return Service_ADC_To_Current(s_motor_meas.i_a_inst_raw);
+}
+
+/**
+ * @brief Returns the Phase B current of the last trigger, unfiltered, in amperes.
+ * @return float Phase B current magnitude (A), or 0.0f if no valid measurement available.
+ */
+float Service_Get_PhaseB_Current_Inst(void)
+{
+    if (!s_measurements_valid)
+        return 0.0f;
+
+    return Service_ADC_To_Current(s_motor_meas.i_b_inst_raw);
+}
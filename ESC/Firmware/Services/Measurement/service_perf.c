@@ -0,0 +1,89 @@
+#include "service_generic.h"
+#include "i_perf.h"
+#include "i_time.h"
+
+/* ========================================================================== */
+/* === Local Helpers ======================================================= */
+/* ========================================================================== */
+
+static const char* const s_probe_names[PERF_PROBE_COUNT] = {
+    "fastloop",
+    "lowloop",
+    "adc_jeoc",
+    "oneshot",
+};
+
+/**
+ * @brief Format a cycle count as "X.YY" µs (no float printf on target).
+ */
+static void perf_cycles_to_us(uint32_t cycles, uint32_t cycles_per_us, char *buf, size_t size)
+{
+    uint32_t centi_us = (uint32_t)(((uint64_t)cycles * 100U) / cycles_per_us);
+
+    snprintf(buf, size, "%lu.%02lu", (unsigned long)(centi_us / 100U), (unsigned long)(centi_us % 100U));
+}
+
+/* ========================================================================== */
+/* === Public API ========================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief Print the execution-time profile of every IPerf probe.
+ *
+ * Example output:
+ *   fastloop: n=24000 min 512 / avg 640 / max 1830 cyc (3.41 / 4.26 / 12.20 us), budget 6250, overruns 0
+ *     hist: 2^9:1200 2^10:22790 2^11:10
+ */
+void Service_Perf_Print(void)
+{
+    uint32_t f_cpu = ITime->getSystemFrequency();
+    uint32_t cycles_per_us = (f_cpu >= 1000000U) ? (f_cpu / 1000000U) : 1U;
+
+    LOG_INFO("Execution profile (CPU cycles @ %lu MHz):", (unsigned long)cycles_per_us);
+
+    for (uint32_t id = 0; id < PERF_PROBE_COUNT; id++)
+    {
+        perf_probe_stats_t st;
+        if (!IPerf->get_stats((perf_probe_id_t)id, &st))
+            continue;
+
+        uint32_t avg = (st.count > 0U) ? (uint32_t)(st.sum_cycles / st.count) : 0U;
+
+        char min_us[16], avg_us[16], max_us[16];
+        perf_cycles_to_us(st.min_cycles, cycles_per_us, min_us, sizeof(min_us));
+        perf_cycles_to_us(avg, cycles_per_us, avg_us, sizeof(avg_us));
+        perf_cycles_to_us(st.max_cycles, cycles_per_us, max_us, sizeof(max_us));
+
+        LOG_INFO("%s: n=%lu min %lu / avg %lu / max %lu cyc (%s / %s / %s us), budget %lu, overruns %lu",
+                 s_probe_names[id], (unsigned long)st.count,
+                 (unsigned long)st.min_cycles, (unsigned long)avg, (unsigned long)st.max_cycles,
+                 min_us, avg_us, max_us,
+                 (unsigned long)st.budget_cycles, (unsigned long)st.overruns);
+
+        /* Non-empty log2 bins only */
+        char line[160];
+        size_t used = (size_t)snprintf(line, sizeof(line), "  hist:");
+
+        for (uint32_t b = 0; b < PERF_HIST_BINS && used < sizeof(line); b++)
+        {
+            if (st.hist[b] == 0U)
+                continue;
+
+            int n = snprintf(line + used, sizeof(line) - used, " 2^%lu:%lu",
+                             (unsigned long)b, (unsigned long)st.hist[b]);
+            if (n < 0)
+                break;
+            used += (size_t)n;
+        }
+
+        LOG_INFO("%s", line);
+    }
+}
+
+/**
+ * @brief Clear the execution-time statistics (budgets are kept).
+ */
+void Service_Perf_Reset(void)
+{
+    IPerf->reset();
+}
@@ -58,6 +58,7 @@ const ascii_command_map_t command_map[] = {
     // Logging / Debug commands
     // ---------------------------------------------------------------------
     {"loglevel",  CMD_LOGLEVEL,"Set logging level",                  "<level:str>"},
+    {"perf",      CMD_PERF,    "Dump and reset loop/ISR profile",    "[none]"},
     // {"logon",     CMD_LOGON,   "Enable logging output",              "[none]"},
     // {"logoff",    CMD_LOGOFF,  "Disable logging output",             "[none]"},
     // {"traceon",   CMD_TRACEON, "Enable trace/debug output",          "[none]"},
@@ -80,6 +81,11 @@ const ascii_command_map_t command_map[] = {
     {"startramp",   CMD_STARTRAMP,  "Start open-loop six-step ramp",           "<ramp_time_ms:int> <direction_cw:int>"},
     {"stopramp",    CMD_STOPRAMP,   "Stop ongoing open-loop six-step ramp",     "[none]"},
     {"getspeed",    CMD_GETSPEED,   "Get current actuator speed in RPM",        "[none]"},
+    {"advget",      CMD_ADVGET,     "Print commutation advance map",            "[none]"},
+    {"advset",      CMD_ADVSET,     "Set advance map cell (degrees)",           "<speed_idx:int> <current_idx:int> <deg:float>"},
+    {"advcal",      CMD_ADVCAL,     "Calibrate advance at operating point",     "[none]"},
+    {"drive",       CMD_DRIVE,      "Select drive mode (motor stopped)",        "<sixstep|foc:str>"},
+    {"settorque",   CMD_SETTORQUE,  "Set actuator current (torque mode)",       "<amps:float>"},
     // {"move",        CMD_MOVE,       "Move actuator to position",                "<pos:int>"},
     // {"take_control",CMD_TAKE_CONTROL,"Take manual control of the system",       "[none]"}
 };
@@ -245,7 +251,7 @@ static void argument_to_string(const protocol_arg_t* arg, char* buffer, size_t b
     switch (arg->type)
     {
         case PROTOCOL_ARG_INT:
-            snprintf(buffer, buf_size, "%ld", arg->value.i);
+            snprintf(buffer, buf_size, "%ld", (long)arg->value.i);
             break;
 
         case PROTOCOL_ARG_FLOAT:
@@ -4,7 +4,7 @@
 #include "i_temperature_sensor.h"
 #include "i_inverter.h"
 #include "i_time.h"
-#include "i_time_oneshot.h"
+#include "i_timer_sched.h"
 
 
 /**
@@ -95,8 +95,8 @@ service_status_t Services_Init(void) {
         return SERVICE_ERROR;
     }
     
-    // Initialize the one-shot timer service
-    if (!IOneShotTimer->init())
+    // Initialize the timer scheduler (commutation, ramp, timeouts)
+    if (!ITimerSched->init())
     {
         return SERVICE_ERROR;
     }
@@ -0,0 +1,23 @@
+/**
+ * @file service_filter.c
+ * @brief Run-time configuration of the ADC channel filters, over IFilter.
+ */
+
+#include "service_filter.h"
+#include "i_filter.h"
+
+/**
+ * @brief Set the filter of a channel.
+ */
+bool Service_Filter_Configure(service_filter_channel_t ch, service_filter_type_t type, float cutoff_hz)
+{
+    return IFilter->configure((filter_channel_t)ch, (filter_type_t)type, cutoff_hz);
+}
+
+/**
+ * @brief Group delay of a channel filter [samples].
+ */
+float Service_Filter_GetDelay(service_filter_channel_t ch)
+{
+    return (float)IFilter->delay_q8((filter_channel_t)ch) * (1.0f / 256.0f);
+}
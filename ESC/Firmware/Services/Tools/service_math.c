@@ -0,0 +1,39 @@
+/**
+ * @file service_math.c
+ * @brief Trigonometry for the control path, over IMath.
+ */
+
+#include "service_math.h"
+#include "i_math.h"
+
+/**
+ * @brief Sine and cosine of an angle [rad].
+ */
+void Service_Math_SinCos(float angle_rad, float *sin_out, float *cos_out)
+{
+    IMath->sin_cos(angle_rad, sin_out, cos_out);
+}
+
+/**
+ * @brief Sine and cosine of @p n angles [rad].
+ */
+void Service_Math_SinCosN(const float *angle_rad, float *sin_out, float *cos_out, uint32_t n)
+{
+    IMath->sin_cos_n(angle_rad, sin_out, cos_out, n);
+}
+
+/**
+ * @brief Angle of the vector (x, y) [rad].
+ */
+float Service_Math_Atan2(float y, float x)
+{
+    return IMath->atan2(y, x);
+}
+
+/**
+ * @brief Length of the vector (x, y).
+ */
+float Service_Math_Magnitude(float x, float y)
+{
+    return IMath->magnitude(x, y);
+}
@@ -1,7 +1,7 @@
 #include "service_generic.h"
 #include "i_led.h"
 #include "i_time.h"
-#include "i_time_oneshot.h"
+#include "i_timer_sched.h"
 
 // Non-blocking status LED blink using ITime->getTick()
 void service_blink_status_Led(uint32_t delay_ms) {
@@ -22,18 +22,18 @@ void LedToggle_Callback(void *ctx)
     (void)ctx; // unused
     ILED->toggle(LED_STATUS);        // Toggle the status LED
 
-    // Re-arm the timer for another 1-second delay
-    IOneShotTimer->start(100000, LedToggle_Callback, NULL);
+    // Re-arm the timer for another 100 ms delay
+    ITimerSched->start(TIMER_EVENT_AUX0, ITimerSched->get_tick_hz() / 10U, LedToggle_Callback, NULL);
 }
 
 /**
- * @brief Simple test of one-shot timer driver.
+ * @brief Simple test of the timer scheduler driver.
  */
 void Service_Test_OneShotTimer(void)
 {
     // Initialize the driver
-    // IOneShotTimer->init();
+    // ITimerSched->init();
 
-    // Start the first one-shot delay (1 second)
-    IOneShotTimer->start(100000, LedToggle_Callback, NULL);
+    // Start the first delay (100 ms)
+    ITimerSched->start(TIMER_EVENT_AUX0, ITimerSched->get_tick_hz() / 10U, LedToggle_Callback, NULL);
 }
\ No newline at end of file
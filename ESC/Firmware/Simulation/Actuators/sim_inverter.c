@@ -0,0 +1,427 @@
+/**
+ * @file sim_inverter.c
+ * @brief Host stand-in of the TIM1 3-phase inverter (i_inverter_t).
+ *
+ * Mirrors the bookkeeping of driver_invertor.c (armed/enabled/fault rules,
+ * duty validation) and tracks the *physical* channel states the CCER writes
+ * produce: enable() starts CHx + CHxN on every phase, disable() stops
+ * them all, set_output_state() starts/stops a single phase regardless of the
+ * status flags (the driver re-enables MOE on its own).
+ *
+ * INVERTER_COMM_PRELOAD mirrors TIM1 CCPC: preload_output_states() only
+ * stores the pattern, applied by Sim_Inverter_OnComEvent() (virtual TIM5
+ * TRGO) or by the next immediate write.
+ *
+ * Duties mirror the preloaded CCR1..3 with RCR = 1: every setter stores
+ * compare ticks, which reach the outputs together at the next TIM1 update
+ * (counter overflow, SIM_EVENT_PWM_UPDATE). get_duties() returns the last
+ * values written, Sim_Inverter_GetState() the ones the PWM applies.
+ *
+ * The ADC trigger compare (CCR4) is preloaded the same way: at the update
+ * event it moves the virtual TRGO (Sim_MotorSensor_SetTrigger).
+ */
+
+#include "i_inverter.h"
+#include "sim_esc.h"
+#include <string.h>
+
+/* === Six-step table (i_inverter.h) ==================================== */
+typedef struct {
+    inverter_phase_t high, low, floating;
+} sim_six_step_entry_t;
+
+static const sim_six_step_entry_t s_six_step_lut[2][6] = {
+    {   /* CW */
+        { PHASE_A, PHASE_B, PHASE_C }, { PHASE_A, PHASE_C, PHASE_B },
+        { PHASE_B, PHASE_C, PHASE_A }, { PHASE_B, PHASE_A, PHASE_C },
+        { PHASE_C, PHASE_A, PHASE_B }, { PHASE_C, PHASE_B, PHASE_A }
+    },
+    {   /* CCW */
+        { PHASE_C, PHASE_B, PHASE_A }, { PHASE_C, PHASE_A, PHASE_B },
+        { PHASE_B, PHASE_A, PHASE_C }, { PHASE_B, PHASE_C, PHASE_A },
+        { PHASE_A, PHASE_C, PHASE_B }, { PHASE_A, PHASE_B, PHASE_C }
+    }
+};
+
+/* === Internal state =================================================== */
+static inverter_status_t    s_status;
+static inverter_duty_t      s_duties;              /* Applied by the PWM */
+static uint16_t             s_compare[PHASE_COUNT]; /* Preload (last written) */
+static uint16_t             s_adc_trigger;          /* CCR4 preload */
+static uint16_t             s_adc_trigger_applied;  /* CCR4 driving TRGO */
+static phase_output_state_t s_state[PHASE_COUNT];
+static uint32_t             s_state_changes;
+static inverter_comm_mode_t s_comm_mode;
+static phase_output_state_t s_preload[PHASE_COUNT];
+static bool                 s_preload_pending;
+static sim_inverter_observer_t s_observer = NULL;
+
+/** Bracket every output change so the plant sees exact switching instants. */
+#define SIM_INVERTER_NOTIFY(when)  do { if (s_observer) s_observer(when); } while (0)
+
+/* ========================================================= */
+/* === Implementation ====================================== */
+/* ========================================================= */
+
+static bool Sim_Inverter_Init(void)
+{
+    memset(&s_status, 0, sizeof(s_status));
+    memset(&s_duties, 0, sizeof(s_duties));
+    memset(s_compare, 0, sizeof(s_compare));
+    s_adc_trigger = s_adc_trigger_applied = SIM_ADC_TRIGGER_CYCLES / SIM_PWM_TICK_CYCLES;
+    Sim_MotorSensor_SetTrigger(SIM_ADC_TRIGGER_CYCLES);
+    Sim_Event_Disarm(SIM_EVENT_PWM_UPDATE);
+    memset(s_state, 0, sizeof(s_state));   // STATE_HIZ
+    s_state_changes = 0;
+    s_comm_mode = INVERTER_COMM_IMMEDIATE;
+    s_preload_pending = false;
+    return true;
+}
+
+/**
+ * @brief Copy the pending preload pattern to the outputs (inside a change bracket).
+ */
+static void Sim_Inverter_ApplyPreload(void)
+{
+    if (!s_preload_pending)
+        return;
+
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        if (s_state[i] != s_preload[i])
+            s_state_changes++;
+        s_state[i] = s_preload[i];
+    }
+    s_preload_pending = false;
+}
+
+/**
+ * @brief TIM1 update event: preloaded compares reach the PWM.
+ */
+static void Sim_Inverter_OnUpdate(void)
+{
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_PRE_CHANGE);
+    for (int i = 0; i < PHASE_COUNT; i++)
+        s_duties.phase_duty[i] = (float)s_compare[i] / (float)SIM_PWM_PERIOD_TICKS;
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_POST_CHANGE);
+
+    if (s_adc_trigger != s_adc_trigger_applied)
+    {
+        s_adc_trigger_applied = s_adc_trigger;
+        Sim_MotorSensor_SetTrigger((uint32_t)s_adc_trigger * SIM_PWM_TICK_CYCLES);
+    }
+}
+
+/**
+ * @brief Schedule the next counter overflow, where the preloads transfer.
+ */
+static void Sim_Inverter_ArmUpdate(void)
+{
+    uint32_t pos = (uint32_t)(Sim_GetCycles() % SIM_PWM_PERIOD_CYCLES);
+    uint32_t delay = (pos < SIM_PWM_UPDATE_CYCLES) ? (SIM_PWM_UPDATE_CYCLES - pos)
+                                                   : (SIM_PWM_PERIOD_CYCLES + SIM_PWM_UPDATE_CYCLES - pos);
+
+    if (!Sim_Event_IsArmed(SIM_EVENT_PWM_UPDATE))
+        Sim_Event_Arm(SIM_EVENT_PWM_UPDATE, delay, 0U, Sim_Inverter_OnUpdate);
+}
+
+/**
+ * @brief Write the preload compares; transferred at the next counter overflow.
+ */
+static void Sim_Inverter_WriteCompare(uint16_t a, uint16_t b, uint16_t c)
+{
+    s_compare[PHASE_A] = a;
+    s_compare[PHASE_B] = b;
+    s_compare[PHASE_C] = c;
+
+    Sim_Inverter_ArmUpdate();
+}
+
+static inline uint16_t Sim_Inverter_DutyToTicks(float duty)
+{
+    return (uint16_t)(duty * (float)SIM_PWM_PERIOD_TICKS);
+}
+
+static bool Sim_Inverter_Arm(void)
+{
+    if (s_status.fault != INVERTER_FAULT_NONE)
+        return false;
+
+    s_status.armed = true;
+    return true;
+}
+
+static bool Sim_Inverter_Enable(void)
+{
+    if (!s_status.armed || s_status.fault != INVERTER_FAULT_NONE)
+        return false;
+
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_PRE_CHANGE);
+    s_preload_pending = false;
+    for (int i = 0; i < PHASE_COUNT; i++)
+        s_state[i] = STATE_PWM_ACTIVE;
+
+    s_status.enabled = true;
+    s_status.running = true;
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_POST_CHANGE);
+    return true;
+}
+
+static bool Sim_Inverter_Disable(void)
+{
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_PRE_CHANGE);
+    s_preload_pending = false;
+    for (int i = 0; i < PHASE_COUNT; i++)
+        s_state[i] = STATE_HIZ;
+
+    s_status.enabled = false;
+    s_status.running = false;
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_POST_CHANGE);
+    return true;
+}
+
+static void Sim_Inverter_EmergencyStop(bool latch_fault)
+{
+    Sim_Inverter_Disable();
+
+    if (latch_fault)
+        s_status.fault = INVERTER_FAULT_HW;
+
+    s_status.armed = false;
+}
+
+static bool Sim_Inverter_SetPhaseDuty(inverter_phase_t phase, float duty)
+{
+    if (phase >= PHASE_COUNT || duty < 0.0f || duty > 1.0f)
+        return false;
+
+    uint16_t compare[PHASE_COUNT] = { s_compare[PHASE_A], s_compare[PHASE_B], s_compare[PHASE_C] };
+    compare[phase] = Sim_Inverter_DutyToTicks(duty);
+    Sim_Inverter_WriteCompare(compare[PHASE_A], compare[PHASE_B], compare[PHASE_C]);
+    return true;
+}
+
+static bool Sim_Inverter_SetAllDuties(const inverter_duty_t* duties)
+{
+    if (!duties) return false;
+
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        if (duties->phase_duty[i] < 0.0f || duties->phase_duty[i] > 1.0f)
+            return false;
+    }
+
+    Sim_Inverter_WriteCompare(Sim_Inverter_DutyToTicks(duties->phase_duty[PHASE_A]),
+                              Sim_Inverter_DutyToTicks(duties->phase_duty[PHASE_B]),
+                              Sim_Inverter_DutyToTicks(duties->phase_duty[PHASE_C]));
+    return true;
+}
+
+static uint16_t Sim_Inverter_GetPeriodTicks(void)
+{
+    return SIM_PWM_PERIOD_TICKS;
+}
+
+static bool Sim_Inverter_SetDutyTicks(const inverter_ticks_t* ticks)
+{
+    if (!ticks) return false;
+
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        if (ticks->compare[i] > SIM_PWM_PERIOD_TICKS)
+            return false;
+    }
+
+    Sim_Inverter_WriteCompare(ticks->compare[PHASE_A], ticks->compare[PHASE_B], ticks->compare[PHASE_C]);
+    return true;
+}
+
+static bool Sim_Inverter_GetDuties(inverter_duty_t* out)
+{
+    if (!out) return false;
+
+    for (int i = 0; i < PHASE_COUNT; i++)
+        out->phase_duty[i] = (float)s_compare[i] / (float)SIM_PWM_PERIOD_TICKS;
+
+    return true;
+}
+
+static void Sim_Inverter_GetStatus(inverter_status_t* out)
+{
+    if (out) *out = s_status;
+}
+
+static bool Sim_Inverter_ClearFaults(void)
+{
+    s_status.fault = INVERTER_FAULT_NONE;
+    return true;
+}
+
+static void Sim_Inverter_NotifyFault(inverter_fault_t fault)
+{
+    s_status.fault = fault;
+    Sim_Inverter_Disable();
+}
+
+/**
+ * @brief Set output state for a single phase.
+ */
+static bool Sim_Inverter_SetOutputState(inverter_phase_t phase, phase_output_state_t state)
+{
+    if (phase >= PHASE_COUNT) return false;
+
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_PRE_CHANGE);
+
+    Sim_Inverter_ApplyPreload();
+
+    if (s_state[phase] != state)
+        s_state_changes++;
+
+    s_state[phase] = state;
+
+    /* FORCE_x: 100 % / 0 % duty (plant treats them as static legs anyway) */
+    if (state == STATE_FORCE_HIGH) { s_compare[phase] = SIM_PWM_PERIOD_TICKS; s_duties.phase_duty[phase] = 1.0f; }
+    if (state == STATE_FORCE_LOW)  { s_compare[phase] = 0U;                   s_duties.phase_duty[phase] = 0.0f; }
+
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_POST_CHANGE);
+    return true;
+}
+
+/**
+ * @brief Select immediate or COM-event commutation.
+ */
+static bool Sim_Inverter_SetCommMode(inverter_comm_mode_t mode)
+{
+    if (mode != INVERTER_COMM_IMMEDIATE && mode != INVERTER_COMM_PRELOAD)
+        return false;
+
+    /* Leaving PRELOAD: the last pattern written drives the outputs */
+    if (mode == INVERTER_COMM_IMMEDIATE && s_preload_pending)
+    {
+        SIM_INVERTER_NOTIFY(SIM_INVERTER_PRE_CHANGE);
+        Sim_Inverter_ApplyPreload();
+        SIM_INVERTER_NOTIFY(SIM_INVERTER_POST_CHANGE);
+    }
+
+    s_comm_mode = mode;
+    return true;
+}
+
+/**
+ * @brief Store the pattern of the next COM event (INVERTER_COMM_PRELOAD only).
+ */
+static bool Sim_Inverter_PreloadOutputStates(const phase_output_state_t states[PHASE_COUNT])
+{
+    if (!states || s_comm_mode != INVERTER_COMM_PRELOAD)
+        return false;
+
+    /* Only the CCxE/CCxNE bits are preloaded: FORCE_x act as PWM_x */
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        if (states[i] == STATE_FORCE_HIGH)     s_preload[i] = STATE_PWM_HIGH;
+        else if (states[i] == STATE_FORCE_LOW) s_preload[i] = STATE_PWM_LOW;
+        else                                   s_preload[i] = states[i];
+    }
+    s_preload_pending = true;
+    return true;
+}
+
+/**
+ * @brief Six-step fast path: same duty on every phase, pattern applied
+ *        now (IMMEDIATE) or preloaded for the COM event (PRELOAD).
+ */
+static inverter_phase_t Sim_Inverter_SixStep(uint8_t step, float duty, bool cw)
+{
+    if (step >= 6U || duty < 0.0f || duty > 1.0f)
+        return PHASE_COUNT;
+
+    const sim_six_step_entry_t *entry = &s_six_step_lut[cw ? 0U : 1U][step];
+
+    uint16_t pulse = Sim_Inverter_DutyToTicks(duty);
+    Sim_Inverter_WriteCompare(pulse, pulse, pulse);
+
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_PRE_CHANGE);
+
+    for (int i = 0; i < PHASE_COUNT; i++)
+        s_preload[i] = STATE_HIZ;
+
+    s_preload[entry->high] = STATE_PWM_HIGH;
+    s_preload[entry->low]  = STATE_PWM_LOW;
+    s_preload_pending = true;
+
+    if (s_comm_mode == INVERTER_COMM_IMMEDIATE)
+        Sim_Inverter_ApplyPreload();
+
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_POST_CHANGE);
+    return entry->floating;
+}
+
+/**
+ * @brief ADC trigger compare (CCR4), transferred at the next counter overflow.
+ */
+static bool Sim_Inverter_SetAdcTrigger(uint16_t ticks)
+{
+    if (ticks == 0U || ticks >= SIM_PWM_PERIOD_TICKS)
+        return false;
+
+    s_adc_trigger = ticks;
+    Sim_Inverter_ArmUpdate();
+    return true;
+}
+
+void Sim_Inverter_OnComEvent(void)
+{
+    if (s_comm_mode != INVERTER_COMM_PRELOAD || !s_preload_pending)
+        return;
+
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_PRE_CHANGE);
+    Sim_Inverter_ApplyPreload();
+    SIM_INVERTER_NOTIFY(SIM_INVERTER_POST_CHANGE);
+}
+
+/* ========================================================= */
+/* === Host inspection ===================================== */
+/* ========================================================= */
+
+void Sim_Inverter_GetState(sim_inverter_state_t *out)
+{
+    if (!out) return;
+
+    out->enabled = false;
+    for (int i = 0; i < PHASE_COUNT; i++)
+    {
+        out->enabled |= (s_state[i] != STATE_HIZ);
+        out->state[i] = s_state[i];
+        out->duty[i]  = s_duties.phase_duty[i];
+    }
+    out->state_changes = s_state_changes;
+}
+
+void Sim_Inverter_SetObserver(sim_inverter_observer_t observer)
+{
+    s_observer = observer;
+}
+
+/* === Global interface instance ======================================= */
+static i_inverter_t s_sim_inverter = {
+    .init             = Sim_Inverter_Init,
+    .arm              = Sim_Inverter_Arm,
+    .enable           = Sim_Inverter_Enable,
+    .disable          = Sim_Inverter_Disable,
+    .emergency_stop   = Sim_Inverter_EmergencyStop,
+    .set_phase_duty   = Sim_Inverter_SetPhaseDuty,
+    .set_all_duties   = Sim_Inverter_SetAllDuties,
+    .get_period_ticks = Sim_Inverter_GetPeriodTicks,
+    .set_duty_ticks   = Sim_Inverter_SetDutyTicks,
+    .get_duties       = Sim_Inverter_GetDuties,
+    .get_status       = Sim_Inverter_GetStatus,
+    .clear_faults     = Sim_Inverter_ClearFaults,
+    .notify_fault     = Sim_Inverter_NotifyFault,
+    .set_output_state = Sim_Inverter_SetOutputState,
+    .set_comm_mode    = Sim_Inverter_SetCommMode,
+    .preload_output_states = Sim_Inverter_PreloadOutputStates,
+    .six_step         = Sim_Inverter_SixStep,
+    .set_adc_trigger  = Sim_Inverter_SetAdcTrigger
+};
+
+i_inverter_t* IInverter = &s_sim_inverter;
@@ -0,0 +1,196 @@
+/**
+ * @file sim_comm.c
+ * @brief Host stand-ins of the debug (USART2) and release (FDCAN2) links.
+ *
+ * IComm_Debug captures everything sent into a text buffer the test can
+ * drain, and optionally mirrors it to stdout. Received lines are injected
+ * with Sim_Comm_InjectLine(), which behaves like the UART driver on ENTER:
+ * the line is latched and the registered RX callback is invoked.
+ *
+ * IComm_Release accepts and discards all traffic.
+ */
+
+#include "i_comm.h"
+#include "sim_esc.h"
+#include <stdio.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------------- */
+/*                           Configuration macros                             */
+/* -------------------------------------------------------------------------- */
+
+#define SIM_COMM_TX_CAPTURE_SIZE   8192U   /**< Captured debug output (oldest dropped) */
+#define SIM_COMM_RX_LINE_SIZE      64U     /**< Same as the UART line buffer */
+
+/* -------------------------------------------------------------------------- */
+/*                           Debug link (USART2)                              */
+/* -------------------------------------------------------------------------- */
+
+static char          s_tx_capture[SIM_COMM_TX_CAPTURE_SIZE];
+static size_t        s_tx_len = 0;
+static bool          s_echo = false;
+
+static char          s_rx_line[SIM_COMM_RX_LINE_SIZE];
+static uint16_t      s_rx_len = 0;
+static bool          s_rx_done = false;
+static rx_callback_t s_rx_cb = NULL;
+
+static bool sim_debug_init(void)
+{
+    s_tx_len  = 0;
+    s_rx_len  = 0;
+    s_rx_done = false;
+    return true;
+}
+
+static comm_status_t sim_debug_send(comm_node_t node, const uint8_t* data, uint16_t length)
+{
+    (void)node;
+
+    if (data == NULL || length == 0)
+        return COMM_ERROR;
+
+    if (s_echo)
+        fwrite(data, 1, length, stdout);
+
+    /* Keep the most recent output when the capture buffer overflows */
+    if (length >= SIM_COMM_TX_CAPTURE_SIZE)
+    {
+        data  += length - (SIM_COMM_TX_CAPTURE_SIZE - 1U);
+        length = (uint16_t)(SIM_COMM_TX_CAPTURE_SIZE - 1U);
+    }
+    if (s_tx_len + length >= SIM_COMM_TX_CAPTURE_SIZE)
+    {
+        size_t drop = s_tx_len + length - (SIM_COMM_TX_CAPTURE_SIZE - 1U);
+        memmove(s_tx_capture, s_tx_capture + drop, s_tx_len - drop);
+        s_tx_len -= drop;
+    }
+
+    memcpy(s_tx_capture + s_tx_len, data, length);
+    s_tx_len += length;
+    return COMM_OK;
+}
+
+static comm_status_t sim_debug_receive(uint8_t* data, uint16_t length)
+{
+    if (data == NULL || length == 0)
+        return COMM_ERROR;
+
+    if (!s_rx_done)
+        return COMM_BUSY;
+
+    uint16_t copy_len = (length < s_rx_len) ? length : s_rx_len;
+    memcpy(data, s_rx_line, copy_len);
+
+    if (copy_len < length)
+        data[copy_len] = '\0';
+
+    s_rx_done = false;
+    s_rx_len  = 0;
+    return COMM_OK;
+}
+
+static bool sim_debug_tx_ready(void)     { return true; }
+static bool sim_debug_rx_available(void) { return s_rx_done; }
+
+static void sim_debug_flush(void)
+{
+    s_rx_done = false;
+    s_rx_len  = 0;
+}
+
+static void sim_debug_set_rx_callback(rx_callback_t cb)
+{
+    s_rx_cb = cb;
+}
+
+static const i_comm_t s_sim_debug_comm = {
+    .init         = sim_debug_init,
+    .send         = sim_debug_send,
+    .receive      = sim_debug_receive,
+    .tx_ready     = sim_debug_tx_ready,
+    .rx_available = sim_debug_rx_available,
+    .flush        = sim_debug_flush,
+    .rx_callback  = sim_debug_set_rx_callback,
+};
+
+const i_comm_t* IComm_Debug = &s_sim_debug_comm;
+
+/* -------------------------------------------------------------------------- */
+/*                           Release link (FDCAN2)                            */
+/* -------------------------------------------------------------------------- */
+
+static bool sim_release_init(void) { return true; }
+
+static comm_status_t sim_release_send(comm_node_t node, const uint8_t* data, uint16_t length)
+{
+    (void)node;
+    return (data == NULL || length == 0) ? COMM_ERROR : COMM_OK;
+}
+
+static comm_status_t sim_release_receive(uint8_t* data, uint16_t length)
+{
+    (void)data;
+    (void)length;
+    return COMM_BUSY;
+}
+
+static bool sim_release_tx_ready(void)     { return true; }
+static bool sim_release_rx_available(void) { return false; }
+static void sim_release_flush(void)        { }
+static void sim_release_set_rx_callback(rx_callback_t cb) { (void)cb; }
+
+static const i_comm_t s_sim_release_comm = {
+    .init         = sim_release_init,
+    .send         = sim_release_send,
+    .receive      = sim_release_receive,
+    .tx_ready     = sim_release_tx_ready,
+    .rx_available = sim_release_rx_available,
+    .flush        = sim_release_flush,
+    .rx_callback  = sim_release_set_rx_callback,
+};
+
+const i_comm_t* IComm_Release = &s_sim_release_comm;
+
+/* -------------------------------------------------------------------------- */
+/*                                 Host API                                   */
+/* -------------------------------------------------------------------------- */
+
+bool Sim_Comm_InjectLine(const char *line)
+{
+    if (line == NULL || s_rx_done)
+        return false;
+
+    size_t len = strlen(line);
+    if (len >= SIM_COMM_RX_LINE_SIZE)
+        len = SIM_COMM_RX_LINE_SIZE - 1U;
+
+    memcpy(s_rx_line, line, len);
+    s_rx_line[len] = '\0';
+    s_rx_len  = (uint16_t)len;
+    s_rx_done = true;
+
+    if (s_rx_cb != NULL)
+        s_rx_cb();
+
+    return true;
+}
+
+size_t Sim_Comm_ReadOutput(char *buf, size_t size)
+{
+    if (buf == NULL || size == 0)
+        return 0;
+
+    size_t n = (s_tx_len < size - 1U) ? s_tx_len : size - 1U;
+    memcpy(buf, s_tx_capture, n);
+    buf[n] = '\0';
+
+    memmove(s_tx_capture, s_tx_capture + n, s_tx_len - n);
+    s_tx_len -= n;
+    return n;
+}
+
+void Sim_Comm_SetEcho(bool echo)
+{
+    s_echo = echo;
+}
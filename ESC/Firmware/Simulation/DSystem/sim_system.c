@@ -0,0 +1,96 @@
+/**
+ * @file sim_system.c
+ * @brief Host stand-in of the system entry points (i_system.h) and of the LEDs.
+ *
+ * DSystem_Init() restarts the virtual clock (power-on), Driver_Init() loads
+ * the default ADC channel filters and starts the free-running hardware of
+ * the board: TIM1 and its TRGO-driven ADC sampling, exactly like
+ * Driver_Init() and SensorsCallbacks_Init() do on target.
+ */
+
+#include "i_system.h"
+#include "i_filter.h"
+#include "i_led.h"
+#include "sim_esc.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ========================================================================== */
+/* === System ============================================================== */
+/* ========================================================================== */
+
+i_status_t DSystem_Init(void)
+{
+    Sim_Reset();
+    return I_OK;
+}
+
+i_status_t Driver_Init(void)
+{
+    if (!IFilter->init())
+        return I_ERROR;
+
+    Sim_MotorSensor_Start();
+    return I_OK;
+}
+
+/**
+ * @brief Software reset: there is no MCU to restart, terminate the process.
+ */
+void DSystem_Reset(void)
+{
+    fprintf(stderr, "[sim] DSystem_Reset() requested at t=%llu cycles\n",
+            (unsigned long long)Sim_GetCycles());
+    exit(EXIT_SUCCESS);
+}
+
+/* ========================================================================== */
+/* === LEDs ================================================================ */
+/* ========================================================================== */
+
+#define SIM_LED_COUNT 3U
+
+static bool s_led_on[SIM_LED_COUNT];
+
+static bool sim_led_init(void)
+{
+    for (uint32_t i = 0; i < SIM_LED_COUNT; i++)
+        s_led_on[i] = false;
+    return true;
+}
+
+static bool sim_led_on(led_id_t led)
+{
+    if ((uint32_t)led >= SIM_LED_COUNT) return false;
+    s_led_on[led] = true;
+    return true;
+}
+
+static bool sim_led_off(led_id_t led)
+{
+    if ((uint32_t)led >= SIM_LED_COUNT) return false;
+    s_led_on[led] = false;
+    return true;
+}
+
+static bool sim_led_toggle(led_id_t led)
+{
+    if ((uint32_t)led >= SIM_LED_COUNT) return false;
+    s_led_on[led] = !s_led_on[led];
+    return true;
+}
+
+static void sim_led_all_off(void)
+{
+    (void)sim_led_init();
+}
+
+static i_led_t s_sim_led = {
+    .init    = sim_led_init,
+    .on      = sim_led_on,
+    .off     = sim_led_off,
+    .toggle  = sim_led_toggle,
+    .all_off = sim_led_all_off,
+};
+
+i_led_t* ILED = &s_sim_led;
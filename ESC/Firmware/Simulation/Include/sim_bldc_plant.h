@@ -0,0 +1,135 @@
+/**
+ * @file sim_bldc_plant.h
+ * @brief 3-phase BLDC motor + inverter plant model for the virtual ESC.
+ *
+ * The plant observes the inverter stand-in (output states and duties written
+ * through IInverter) and integrates the electrical and mechanical equations
+ * of a star-connected trapezoidal-BEMF motor:
+ *
+ *     L_x di_x/dt = v_x - R i_x - e_x - v_n        e_x = Ke ω_m f(θ_e - x·120°)
+ *     J dω_m/dt = Ke Σ f_x i_x - T_load - B ω_m - K_prop ω_m |ω_m|
+ *
+ * The phase inductance may depend on the rotor position (saliency, period
+ * 180°) and drop when the current adds to the magnet flux (saturation,
+ * period 360°): with c_x = -cos(θ_e - x·120°) the magnet flux linkage
+ * direction of phase x,
+ *
+ *     L_x = L (1 - saliency · cos 2(θ_e - x·120°) - sat · c_x · i_x)
+ *
+ * Both default to 0 (constant L). They only matter to inductive position
+ * sensing; the torque ignores the reluctance term.
+ *
+ * Switching is resolved exactly inside each PWM period (center-aligned
+ * TIM1, edges at CCR), off switches conduct through their body diodes
+ * according to the current sign, and undriven phases float at v_n + e_x.
+ * PWM_LOW conducts during the same window as the PWM_HIGH partner
+ * (interface semantics of i_inverter.h), deadtime is neglected.
+ *
+ * On every TIM1 trigger the instantaneous terminal voltages and phase
+ * currents are converted to raw ADC counts (phase dividers, low-side shunt
+ * amplifier) and handed to the IMotor_ADC_Measure stand-in. The divided
+ * terminal voltages of every integration step also drive the BEMF
+ * comparator stand-in, against the star point of the three dividers.
+ */
+
+#ifndef SIM_BLDC_PLANT_H
+#define SIM_BLDC_PLANT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "i_inverter.h"
+
+/* ========================================================================== */
+/* === Parameters / State ================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief Motor, load and measurement-chain parameters.
+ */
+typedef struct {
+    float   r_phase_ohm;        /**< Phase resistance [Ω] */
+    float   l_phase_h;          /**< Phase inductance [H] */
+    float   ke_v_s_per_rad;     /**< Phase BEMF peak per mechanical rad/s [V·s/rad] */
+    float   j_kg_m2;            /**< Rotor + load inertia [kg·m²] */
+    float   b_nm_s_per_rad;     /**< Viscous friction [N·m·s/rad] */
+    float   load_torque_nm;     /**< Constant (Coulomb) load torque [N·m] */
+    float   k_prop_nm_s2;       /**< Propeller load T = k·ω² [N·m·s²/rad²] */
+    uint8_t pole_pairs;         /**< Pole pairs */
+    float   vbus_v;             /**< DC bus voltage [V] */
+    float   v_divider_ratio;    /**< Phase voltage divider (V_phase / V_adc) */
+    float   current_gain_v_a;   /**< Shunt × amplifier gain [V/A] */
+    float   l_saliency;         /**< Phase inductance dip on the magnet axis (fraction of L, 0 = none) */
+    float   l_sat_per_a;        /**< Stator iron saturation by magnet-aligned current [1/A] (0 = none) */
+} sim_bldc_params_t;
+
+/**
+ * @brief Instantaneous plant state.
+ */
+typedef struct {
+    float theta_e_rad;          /**< Electrical angle [0, 2π) */
+    float omega_m_rad_s;        /**< Mechanical speed [rad/s] */
+    float rpm;                  /**< Mechanical speed [RPM] */
+    float i_a[PHASE_COUNT];     /**< Phase currents [A] (positive into the motor) */
+    float e_v[PHASE_COUNT];     /**< Phase back-EMF [V] */
+    float v_term[PHASE_COUNT];  /**< Terminal voltages [V] */
+    float v_neutral;            /**< Star point voltage [V] */
+    float torque_nm;            /**< Electromagnetic torque [N·m] */
+} sim_bldc_state_t;
+
+/**
+ * @brief Commutation accuracy, measured at every six-step pattern change.
+ *
+ * Error = electrical angle at the commutation minus the ideal entry angle of
+ * the new pattern (30° before the BEMF zero-cross of its floating phase,
+ * mirrored for negative rotation). Positive = late.
+ */
+typedef struct {
+    uint32_t count;             /**< Commutations measured */
+    float    last_deg;          /**< Last error [° electrical] */
+    float    mean_deg;          /**< Mean error [° electrical] */
+    float    mean_abs_deg;      /**< Mean absolute error [° electrical] */
+    float    max_abs_deg;       /**< Largest absolute error [° electrical] */
+} sim_bldc_comm_stats_t;
+
+/* ========================================================================== */
+/* === API ================================================================= */
+/* ========================================================================== */
+
+/** Fill @p p with a 12 V, 6 pole-pair outrunner on the bench (small prop). */
+void Sim_BLDC_DefaultParams(sim_bldc_params_t *p);
+
+/**
+ * @brief Connect the plant to the virtual ESC (rotor at rest, θ_e = 0).
+ *
+ * Installs the ADC sample source and the inverter observer, and publishes
+ * the bus voltage on IVoltageSensor. Call after System_Init().
+ */
+void Sim_BLDC_Attach(const sim_bldc_params_t *p);
+
+/** Disconnect the plant (ADC falls back to mid-scale samples). */
+void Sim_BLDC_Detach(void);
+
+/** Change the constant load torque [N·m]. */
+void Sim_BLDC_SetLoadTorque(float torque_nm);
+
+/** Force the rotor state (e.g. already spinning). */
+void Sim_BLDC_SetRotor(float theta_e_rad, float omega_m_rad_s);
+
+/** Integrate up to the current virtual time and read the state. */
+void Sim_BLDC_GetState(sim_bldc_state_t *out);
+
+/** Read the commutation accuracy statistics. */
+void Sim_BLDC_GetCommutationStats(sim_bldc_comm_stats_t *out);
+
+/** Clear the commutation accuracy statistics. */
+void Sim_BLDC_ResetCommutationStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_BLDC_PLANT_H */
@@ -0,0 +1,248 @@
+/**
+ * @file sim_esc.h
+ * @brief Host-side control of the virtual ESC.
+ *
+ * The Simulation layer replaces Board + Drivers when the firmware is built
+ * for the host (ESC_HOST_BUILD). It implements every interface global used by
+ * Services and Control (IInverter, IMotor_ADC_Measure, ITime, ITimerSched,
+ * IFastLoop/ILowLoop, IComm_Debug, ...) on top of a virtual clock counted in
+ * CPU cycles, so that the hot paths run unmodified and deterministically.
+ *
+ * Interrupt sources are modelled as kernel events with the periods of the
+ * real timers (TIM1/TIM3/TIM4/TIM5). Events fire in time order; events due
+ * at the same cycle fire in NVIC priority order (lowest sim_event_id_t first).
+ * ISR execution takes zero virtual time here.
+ *
+ * Typical test:
+ * @code
+ *     System_Init();
+ *     Control_Init();
+ *     Control_Motor_Init();
+ *     Control_Motor_SetSpeed_RPM(3000.0f);
+ *     Sim_Run_ms(2000);
+ * @endcode
+ */
+
+#ifndef SIM_ESC_H
+#define SIM_ESC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "i_inverter.h"
+#include "i_motor_sensor.h"
+#include "i_temperature_sensor.h"
+#include "i_voltage_sensor.h"
+
+/* ========================================================================== */
+/* === Virtual hardware constants (match Board/Source/Peripherals) ========= */
+/* ========================================================================== */
+
+#define SIM_CPU_FREQ_HZ             150000000U  /**< SYSCLK */
+#define SIM_CYCLES_PER_US           (SIM_CPU_FREQ_HZ / 1000000U)
+
+#define SIM_PWM_PERIOD_CYCLES       6250U       /**< TIM1 center-aligned: 2 x (ARR+1) x (PSC+1) → 24 kHz */
+#define SIM_ADC_TRIGGER_CYCLES      10U         /**< TIM1 CH4 (OC4REF → TRGO) at CCR4 = 2, upcounting: centre of the on-time */
+#define SIM_PWM_PERIOD_TICKS        625U        /**< TIM1 ARR + 1: compare value of 100 % duty */
+#define SIM_PWM_TICK_CYCLES         5U          /**< TIM1 PSC + 1: CPU cycles per counter tick */
+#define SIM_PWM_UPDATE_CYCLES       3125U       /**< TIM1 update (RCR = 1): counter overflow, mid off-time */
+#define SIM_FASTLOOP_PERIOD_CYCLES  6250U       /**< TIM3: (ARR+1) x (PSC+1) → 24 kHz */
+#define SIM_LOWLOOP_PERIOD_CYCLES   150000U     /**< TIM4: (ARR+1) x (PSC+1) → 1 kHz */
+
+/** Fast loop run from the injected JEOC (1) or from TIM3 (0), as in driver_fastloop.c */
+#ifndef FASTLOOP_SYNC_TO_ADC
+#define FASTLOOP_SYNC_TO_ADC        1
+#endif
+
+/* ========================================================================== */
+/* === Kernel (virtual clock + interrupt events) =========================== */
+/* ========================================================================== */
+
+/**
+ * @brief Simulated interrupt sources, ordered by NVIC priority.
+ */
+typedef enum {
+    SIM_EVENT_TIM5_CC2 = 0,     /**< TIM5 compare channels of the timer scheduler (prio 1) */
+    SIM_EVENT_TIM5_CC3,
+    SIM_EVENT_TIM5_CC4,
+    SIM_EVENT_FASTLOOP,         /**< TIM3 fast loop (prio 2, unused when FASTLOOP_SYNC_TO_ADC) */
+    SIM_EVENT_ADC_TRIGGER,      /**< TIM1 TRGO → ADC1/2 injected JEOC (prio 3) */
+    SIM_EVENT_LOWLOOP,          /**< TIM4 low loop (prio 3) */
+    SIM_EVENT_PWM_UPDATE,       /**< TIM1 update: preloaded CCR1..3 transfer (hardware, no ISR) */
+    SIM_EVENT_COUNT
+} sim_event_id_t;
+
+/** Handler executed when a kernel event fires. */
+typedef void (*sim_event_handler_t)(void);
+
+/**
+ * @brief Reset the virtual clock to 0 and disarm every event.
+ */
+void Sim_Reset(void);
+
+/**
+ * @brief Current virtual time in CPU cycles (150 MHz).
+ */
+uint64_t Sim_GetCycles(void);
+
+/**
+ * @brief Advance virtual time, firing every event that falls due.
+ * @param cycles Number of CPU cycles to simulate.
+ */
+void Sim_RunCycles(uint64_t cycles);
+
+/** Advance virtual time by @p us microseconds. */
+void Sim_Run_us(uint32_t us);
+
+/** Advance virtual time by @p ms milliseconds. */
+void Sim_Run_ms(uint32_t ms);
+
+/**
+ * @brief Arm a kernel event.
+ * @param id            Event source.
+ * @param delay_cycles  Cycles from now until the first expiry.
+ * @param period_cycles Reload period (0 = one-shot).
+ * @param handler       Function called on expiry.
+ */
+void Sim_Event_Arm(sim_event_id_t id, uint64_t delay_cycles, uint64_t period_cycles, sim_event_handler_t handler);
+
+/** Disarm a kernel event (no-op if not armed). */
+void Sim_Event_Disarm(sim_event_id_t id);
+
+/** @return true if the event is armed. */
+bool Sim_Event_IsArmed(sim_event_id_t id);
+
+/**
+ * @brief Busy-wait equivalent used by ITime->delay_us/delay_ms.
+ *
+ * From thread context the clock advances and events fire; from an event
+ * handler (ISR context) the clock only moves forward, like a blocking ISR.
+ */
+void Sim_Delay_Cycles(uint64_t cycles);
+
+/* ========================================================================== */
+/* === Inverter stand-in =================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief Snapshot of the virtual TIM1 outputs.
+ */
+typedef struct {
+    bool                 enabled;                   /**< At least one channel switching */
+    phase_output_state_t state[PHASE_COUNT];        /**< Per-phase physical output state */
+    float                duty[PHASE_COUNT];         /**< Per-phase duty applied by the PWM (0..1) */
+    uint32_t             state_changes;             /**< Number of output-state transitions */
+} sim_inverter_state_t;
+
+/** Read the current inverter output state. */
+void Sim_Inverter_GetState(sim_inverter_state_t *out);
+
+/**
+ * @brief Notification points around every inverter output/duty change.
+ */
+typedef enum {
+    SIM_INVERTER_PRE_CHANGE = 0,    /**< Old outputs still applied */
+    SIM_INVERTER_POST_CHANGE        /**< New outputs applied */
+} sim_inverter_change_t;
+
+/** Observer of inverter changes (used by the plant model). */
+typedef void (*sim_inverter_observer_t)(sim_inverter_change_t when);
+
+/** Install the inverter observer (NULL to remove). */
+void Sim_Inverter_SetObserver(sim_inverter_observer_t observer);
+
+/**
+ * @brief Virtual TIM1 COM event (TIM5 TRGO from the commutation compare).
+ *
+ * Applies the pattern preloaded in INVERTER_COMM_PRELOAD mode; ignored in
+ * INVERTER_COMM_IMMEDIATE mode or when nothing is pending.
+ */
+void Sim_Inverter_OnComEvent(void);
+
+/* ========================================================================== */
+/* === Motor ADC stand-in ================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief Producer of raw injected-ADC samples, called on every TIM1 trigger.
+ *
+ * The returned sample goes through the same IIR filters as
+ * HAL_ADCEx_InjectedConvCpltCallback() before reaching IMotor_ADC_Measure.
+ */
+typedef void (*sim_adc_source_t)(motor_measurements_t *raw);
+
+/** Install the sample producer (NULL = constant mid-scale samples). */
+void Sim_MotorSensor_SetSource(sim_adc_source_t source);
+
+/** Start the TIM1-synchronous ADC trigger (done by Driver_Init). */
+void Sim_MotorSensor_Start(void);
+
+/**
+ * @brief Move the ADC trigger to @p pos_cycles into the PWM period.
+ *
+ * Called by the inverter stand-in at the update event that transfers a new
+ * CCR4: the next trigger fires at the new position of the next period.
+ */
+void Sim_MotorSensor_SetTrigger(uint32_t pos_cycles);
+
+/**
+ * @brief Fast loop hook called at the end of every injected JEOC.
+ *
+ * Runs the IFastLoop callback when FASTLOOP_SYNC_TO_ADC is set and the loop
+ * is started, like Driver_FastLoop_OnInjectedConversion().
+ */
+void Sim_FastLoop_OnInjectedConversion(void);
+
+/* ========================================================================== */
+/* === BEMF comparator stand-in ============================================ */
+/* ========================================================================== */
+
+/**
+ * @brief Comparator inputs, constant from @p t_cycles until the next call.
+ *
+ * Called by the plant at every integration step with the phase voltages at
+ * the COMPx_INP pins and the star-point voltage at the common INM pin. The
+ * selected comparator feeds the virtual TIM5 CH1 capture; the capture time
+ * of an edge is interpolated linearly between two calls.
+ */
+void Sim_BemfComp_Input(uint64_t t_cycles, const float v_phase[PHASE_COUNT], float v_ref);
+
+/* ========================================================================== */
+/* === Environment sensors stand-in ======================================== */
+/* ========================================================================== */
+
+/** Set the value returned by IVoltageSensor->read(). */
+void Sim_Sensors_SetVoltage(voltage_sensor_id_t id, float volts);
+
+/** Set the value returned by ITemperatureSensor->read(). */
+void Sim_Sensors_SetTemperature(temperature_sensor_id_t id, float celsius);
+
+/* ========================================================================== */
+/* === Debug link stand-in ================================================= */
+/* ========================================================================== */
+
+/**
+ * @brief Deliver one terminal line to IComm_Debug, as if typed + ENTER.
+ * @return false if a previous line is still pending.
+ */
+bool Sim_Comm_InjectLine(const char *line);
+
+/**
+ * @brief Drain the text sent on IComm_Debug since the last call.
+ * @return Number of bytes copied (always NUL-terminated).
+ */
+size_t Sim_Comm_ReadOutput(char *buf, size_t size);
+
+/** Mirror everything sent on IComm_Debug to stdout. */
+void Sim_Comm_SetEcho(bool echo);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_ESC_H */
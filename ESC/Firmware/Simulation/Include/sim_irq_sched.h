@@ -0,0 +1,195 @@
+/**
+ * @file sim_irq_sched.h
+ * @brief Discrete-event model of the ESC interrupt load (NVIC preemption).
+ *
+ * Independent of the virtual ESC clock: ISRs do not run firmware code here,
+ * they consume CPU time according to a cost model. Each source is released
+ * periodically (optionally with jitter) and is dispatched like on the
+ * Cortex-M4 NVIC:
+ *
+ *  - a pending source preempts the running ISR only if its priority number
+ *    is strictly lower (no subpriority bits are used on this board);
+ *  - among pending sources of equal priority the lowest IRQn is taken first;
+ *  - a release while the source is still pending is merged into the same
+ *    pending bit and counted as lost;
+ *  - exception entry costs SIM_IRQ_ENTRY_CYCLES, back-to-back dispatch at
+ *    ISR exit costs SIM_IRQ_TAILCHAIN_CYCLES (tail-chaining).
+ *
+ * Per source it reports latency (release → first handler instruction),
+ * response time (release → handler exit), preemption depth and deadline
+ * misses, which is what drives commutation jitter on TIM5.
+ *
+ * @code
+ *     Sim_IrqSched_Reset(1);
+ *     Sim_IrqSched_AddEscSources(20000.0f);
+ *     Sim_IrqSched_Run(SIM_CPU_FREQ_HZ);        // 1 s
+ *     Sim_IrqSched_PrintReport();
+ * @endcode
+ */
+
+#ifndef SIM_IRQ_SCHED_H
+#define SIM_IRQ_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ========================================================================== */
+/* === Configuration ======================================================= */
+/* ========================================================================== */
+
+#define SIM_IRQ_MAX_SOURCES         8U
+#define SIM_IRQ_ENTRY_CYCLES        12U     /**< Cortex-M4 exception entry (zero wait-state) */
+#define SIM_IRQ_TAILCHAIN_CYCLES    6U      /**< Back-to-back ISR dispatch */
+
+/* NVIC configuration of the board (Board/Source/Peripherals) */
+#define SIM_IRQ_TIM5_PRIO           1U
+#define SIM_IRQ_TIM3_PRIO           2U
+#define SIM_IRQ_ADC1_2_PRIO         3U
+#define SIM_IRQ_TIM4_PRIO           3U
+#define SIM_IRQ_USART2_PRIO         10U
+#define SIM_IRQ_DMA1_CH4_PRIO       10U
+
+#define SIM_IRQ_TIM5_IRQN           50U
+#define SIM_IRQ_TIM3_IRQN           29U
+#define SIM_IRQ_ADC1_2_IRQN         18U
+#define SIM_IRQ_TIM4_IRQN           30U
+#define SIM_IRQ_USART2_IRQN         38U
+#define SIM_IRQ_DMA1_CH4_IRQN       14U
+
+/** Injected conversion time after the TIM1 TRGO (3 ranks, approx.) */
+#define SIM_IRQ_ADC_CONV_CYCLES     160U
+/** USART2 RX character time at 115200 8N1 */
+#define SIM_IRQ_USART2_CHAR_CYCLES  13021U
+
+/* Default ISR cost estimates [cycles], handler body incl. HAL dispatch */
+#define SIM_IRQ_COST_TIM5_MIN       250U    /**< Commutation callback */
+#define SIM_IRQ_COST_TIM5_MAX       400U
+#define SIM_IRQ_COST_TIM3_MIN       450U    /**< Motor_FastLoop + BEMF_Process */
+#define SIM_IRQ_COST_TIM3_MAX       900U
+#define SIM_IRQ_COST_ADC_MIN        200U    /**< JEOC: 6 reads + IIR filters */
+#define SIM_IRQ_COST_ADC_MAX        300U
+#define SIM_IRQ_COST_TIM4_MIN       600U    /**< Motor_LowLoop: speed + PID */
+#define SIM_IRQ_COST_TIM4_MAX       1500U
+#define SIM_IRQ_COST_USART2_MIN     150U    /**< RX byte handling */
+#define SIM_IRQ_COST_USART2_MAX     250U
+#define SIM_IRQ_COST_DMA_MIN        200U    /**< TX complete */
+#define SIM_IRQ_COST_DMA_MAX        300U
+
+/* ========================================================================== */
+/* === Types =============================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief Optional cost callback; returns the handler cost in cycles.
+ *
+ * @param ctx         User context from the source configuration.
+ * @param activation  Activation index of the source (0-based).
+ */
+typedef uint32_t (*sim_irq_cost_fn_t)(void *ctx, uint32_t activation);
+
+/**
+ * @brief Interrupt source configuration.
+ */
+typedef struct {
+    const char       *name;
+    uint16_t          irqn;             /**< Tie-break among equal priorities */
+    uint8_t           priority;         /**< NVIC preemption priority (lower = more urgent) */
+    uint32_t          period_cycles;    /**< Release period (0 = single release) */
+    uint32_t          jitter_cycles;    /**< Uniform extra delay [0, jitter] per period */
+    uint32_t          offset_cycles;    /**< First release time */
+    uint32_t          deadline_cycles;  /**< Relative deadline (0 = period) */
+    uint32_t          cost_min_cycles;  /**< Uniform cost model when cost_fn is NULL */
+    uint32_t          cost_max_cycles;
+    sim_irq_cost_fn_t cost_fn;
+    void             *cost_ctx;
+} sim_irq_source_cfg_t;
+
+/**
+ * @brief Per-source statistics.
+ */
+typedef struct {
+    uint32_t releases;          /**< Releases generated */
+    uint32_t completed;         /**< Handler executions completed */
+    uint32_t lost;              /**< Releases merged into an already pending request */
+    uint32_t deadline_misses;   /**< Completions later than release + deadline */
+    uint32_t preempted;         /**< Times this handler was preempted */
+    uint8_t  max_depth;         /**< Largest nesting level it ran at (1 = from thread) */
+    uint32_t latency_min;       /**< Release → handler start [cycles] */
+    uint32_t latency_max;
+    float    latency_mean;
+    uint32_t response_max;      /**< Release → handler exit [cycles] */
+    uint64_t busy_cycles;       /**< CPU time incl. entry overhead */
+} sim_irq_source_stats_t;
+
+/* ========================================================================== */
+/* === API ================================================================= */
+/* ========================================================================== */
+
+/**
+ * @brief Remove all sources, clear statistics and seed the cost/jitter PRNG.
+ */
+void Sim_IrqSched_Reset(uint32_t seed);
+
+/**
+ * @brief Add a source.
+ * @return Source id (≥ 0), or -1 if the table is full / config invalid.
+ */
+int Sim_IrqSched_AddSource(const sim_irq_source_cfg_t *cfg);
+
+/**
+ * @brief Add the board interrupt set with the default cost estimates.
+ *
+ * TIM3 fast loop, ADC1_2 JEOC, TIM4 low loop, USART2 RX (continuous
+ * traffic) and DMA1_CH4 TX complete (one log line per ms). When
+ * @p commutation_rpm > 0, TIM5 fires once per six-step commutation at that
+ * mechanical speed (6 pole pairs) with a random phase against TIM3.
+ *
+ * @return Id of the TIM5 source, or -1 if not added.
+ */
+int Sim_IrqSched_AddEscSources(float commutation_rpm);
+
+/**
+ * @brief Change the cost model of a source.
+ */
+bool Sim_IrqSched_SetCost(int id, uint32_t min_cycles, uint32_t max_cycles, sim_irq_cost_fn_t fn, void *ctx);
+
+/**
+ * @brief Simulate @p cycles more CPU cycles.
+ */
+void Sim_IrqSched_Run(uint64_t cycles);
+
+/**
+ * @brief Look up a source by name.
+ * @return Source id, or -1.
+ */
+int Sim_IrqSched_Find(const char *name);
+
+/**
+ * @brief Copy the statistics of a source.
+ */
+bool Sim_IrqSched_GetStats(int id, sim_irq_source_stats_t *out);
+
+/**
+ * @brief Deepest ISR nesting observed.
+ */
+uint8_t Sim_IrqSched_GetMaxDepth(void);
+
+/**
+ * @brief CPU time spent in ISRs, 0..1.
+ */
+float Sim_IrqSched_GetLoad(void);
+
+/**
+ * @brief Print a per-source table (latency in µs, misses, depth, CPU share).
+ */
+void Sim_IrqSched_PrintReport(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_IRQ_SCHED_H */
@@ -0,0 +1,40 @@
+/**
+ * @file sim_test.h
+ * @brief Check and summary helpers shared by the simulation tests (test_*_sim.c).
+ *
+ * Each test is its own executable: it includes this header once, checks
+ * with SIM_CHECK() (a failure is printed and counted, the test goes on)
+ * and ends main() with `return Sim_Test_Summary(__FILE__);`.
+ */
+
+#ifndef SIM_TEST_H
+#define SIM_TEST_H
+
+#include <stdio.h>
+
+/** Failed checks of this test executable */
+static int s_failures = 0;
+
+/**
+ * @brief Check a condition: print and count it if false.
+ */
+#define SIM_CHECK(cond)                                                   \
+    do {                                                                  \
+        if (!(cond)) {                                                    \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);        \
+            s_failures++;                                                 \
+        }                                                                 \
+    } while (0)
+
+/**
+ * @brief Print the failure count of the test.
+ * @param file Test source (__FILE__)
+ * @return Exit status of the test: 0 if every check passed
+ */
+static inline int Sim_Test_Summary(const char *file)
+{
+    printf("%s: %d failure(s)\n", file, s_failures);
+    return (s_failures == 0) ? 0 : 1;
+}
+
+#endif /* SIM_TEST_H */
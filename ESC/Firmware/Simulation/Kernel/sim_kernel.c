@@ -0,0 +1,149 @@
+/**
+ * @file sim_kernel.c
+ * @brief Virtual clock and interrupt event dispatcher of the virtual ESC.
+ *
+ * Time is counted in CPU cycles (150 MHz) so every timer of the real board
+ * has an exact integer period. The kernel keeps one slot per interrupt
+ * source; Sim_RunCycles() repeatedly picks the earliest armed slot, moves the
+ * clock to its expiry and calls its handler. Ties are broken by slot index,
+ * which follows NVIC priority.
+ */
+
+#include "sim_esc.h"
+#include <string.h>
+
+/* ========================================================================== */
+/* === Module State ======================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief One interrupt source.
+ */
+typedef struct {
+    bool                armed;          /**< Slot active */
+    uint64_t            due_cycles;     /**< Absolute expiry time */
+    uint64_t            period_cycles;  /**< Reload period (0 = one-shot) */
+    sim_event_handler_t handler;        /**< ISR body */
+} sim_event_t;
+
+static sim_event_t s_events[SIM_EVENT_COUNT];
+static uint64_t    s_now_cycles = 0;
+static uint32_t    s_isr_depth  = 0;    /**< > 0 while a handler runs */
+
+/* ========================================================================== */
+/* === Internal Helpers ==================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief Return the next event due at or before @p limit, or -1.
+ */
+static int sim_next_event(uint64_t limit)
+{
+    int next = -1;
+
+    for (int i = 0; i < SIM_EVENT_COUNT; i++)
+    {
+        if (!s_events[i].armed || s_events[i].due_cycles > limit)
+            continue;
+
+        if (next < 0 || s_events[i].due_cycles < s_events[next].due_cycles)
+            next = i;
+    }
+
+    return next;
+}
+
+/**
+ * @brief Fire one event: advance the clock, reload or disarm, run the handler.
+ *
+ * The slot is updated before the handler so that the handler may re-arm or
+ * disarm its own source (e.g. a one-shot restarted from its callback).
+ */
+static void sim_fire(int id)
+{
+    sim_event_t *ev = &s_events[id];
+
+    if (ev->due_cycles > s_now_cycles)
+        s_now_cycles = ev->due_cycles;
+
+    sim_event_handler_t handler = ev->handler;
+
+    if (ev->period_cycles != 0U)
+        ev->due_cycles += ev->period_cycles;
+    else
+        ev->armed = false;
+
+    if (handler != NULL)
+    {
+        s_isr_depth++;
+        handler();
+        s_isr_depth--;
+    }
+}
+
+/* ========================================================================== */
+/* === Public API ========================================================== */
+/* ========================================================================== */
+
+void Sim_Reset(void)
+{
+    memset(s_events, 0, sizeof(s_events));
+    s_now_cycles = 0;
+    s_isr_depth  = 0;
+}
+
+uint64_t Sim_GetCycles(void)
+{
+    return s_now_cycles;
+}
+
+void Sim_RunCycles(uint64_t cycles)
+{
+    uint64_t end = s_now_cycles + cycles;
+    int id;
+
+    while ((id = sim_next_event(end)) >= 0)
+        sim_fire(id);
+
+    s_now_cycles = end;
+}
+
+void Sim_Run_us(uint32_t us)
+{
+    Sim_RunCycles((uint64_t)us * SIM_CYCLES_PER_US);
+}
+
+void Sim_Run_ms(uint32_t ms)
+{
+    Sim_RunCycles((uint64_t)ms * 1000U * SIM_CYCLES_PER_US);
+}
+
+void Sim_Event_Arm(sim_event_id_t id, uint64_t delay_cycles, uint64_t period_cycles, sim_event_handler_t handler)
+{
+    if (id >= SIM_EVENT_COUNT)
+        return;
+
+    s_events[id].armed         = true;
+    s_events[id].due_cycles    = s_now_cycles + delay_cycles;
+    s_events[id].period_cycles = period_cycles;
+    s_events[id].handler       = handler;
+}
+
+void Sim_Event_Disarm(sim_event_id_t id)
+{
+    if (id < SIM_EVENT_COUNT)
+        s_events[id].armed = false;
+}
+
+bool Sim_Event_IsArmed(sim_event_id_t id)
+{
+    return (id < SIM_EVENT_COUNT) && s_events[id].armed;
+}
+
+void Sim_Delay_Cycles(uint64_t cycles)
+{
+    if (s_isr_depth > 0U)
+        s_now_cycles += cycles;     // Blocking ISR: nothing else runs meanwhile
+    else
+        Sim_RunCycles(cycles);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file sim_cordic.c
+ * @brief Software CORDIC under the math front end (driver_math.h hooks).
+ *
+ * The front end itself is Drivers/Miscellaneous/driver_math.c, linked
+ * unchanged. This model runs the fixed-point algorithm of the coprocessor:
+ * q1.31 arguments and results, 4 × MATH_CORDIC_PRECISION iterations with
+ * an arctangent table in the q1.31 angle format, gain compensated by
+ * starting the rotation at 1/K (cosine) or scaling the final x (modulus),
+ * results saturated to q1.31. Angles beyond ±π/2 are first rotated by π
+ * (the iterations only converge within ±99.9°).
+ */
+
+#include "../../Drivers/Miscellaneous/driver_math.h"
+
+#define SIM_CORDIC_ITERATIONS   (4U * MATH_CORDIC_PRECISION)
+
+#define SIM_CORDIC_HALF_PI      0x40000000      /**< π/2 in q1.31 angle units */
+#define SIM_CORDIC_PI           0x80000000LL    /**< π, as a 64-bit accumulator value */
+#define SIM_CORDIC_INV_GAIN     1304065748LL    /**< 1/K of 24 iterations, q1.31 */
+
+/** atan(2^-i) / π in q1.31 */
+static const int32_t s_atan_q31[SIM_CORDIC_ITERATIONS] = {
+    536870912, 316933406, 167458907, 85004756, 42667331, 21354465,
+    10679838,  5340245,   2670163,   1335087,  667544,   333772,
+    166886,    83443,     41722,     20861,    10430,    5215,
+    2608,      1304,      652,       326,      163,      81
+};
+
+static int32_t sim_cordic_sat(int64_t v)
+{
+    if (v > INT32_MAX) return INT32_MAX;
+    if (v < INT32_MIN) return INT32_MIN;
+    return (int32_t)v;
+}
+
+void Math_HW_CosSin(const int32_t *angle, int32_t *cos_out, int32_t *sin_out, uint32_t n)
+{
+    for (uint32_t k = 0; k < n; k++)
+    {
+        int64_t x = SIM_CORDIC_INV_GAIN;
+        int64_t y = 0;
+        int64_t z = angle[k];
+
+        if (z > SIM_CORDIC_HALF_PI || z < -SIM_CORDIC_HALF_PI)
+        {
+            x = -x;
+            z += (z > 0) ? -SIM_CORDIC_PI : SIM_CORDIC_PI;
+        }
+
+        for (uint32_t i = 0; i < SIM_CORDIC_ITERATIONS; i++)
+        {
+            int64_t dx = y >> i;
+            int64_t dy = x >> i;
+
+            if (z >= 0)
+            {
+                x -= dx;
+                y += dy;
+                z -= s_atan_q31[i];
+            }
+            else
+            {
+                x += dx;
+                y -= dy;
+                z += s_atan_q31[i];
+            }
+        }
+
+        cos_out[k] = sim_cordic_sat(x);
+        sin_out[k] = sim_cordic_sat(y);
+    }
+}
+
+void Math_HW_Phase(int32_t x_in, int32_t y_in, int32_t *phase, int32_t *modulus)
+{
+    int64_t x = x_in;
+    int64_t y = y_in;
+    int64_t z = 0;
+
+    if (x < 0)
+    {
+        x = -x;
+        y = -y;
+        z = (y_in >= 0) ? SIM_CORDIC_PI : -SIM_CORDIC_PI;
+    }
+
+    for (uint32_t i = 0; i < SIM_CORDIC_ITERATIONS; i++)
+    {
+        int64_t dx = y >> i;
+        int64_t dy = x >> i;
+
+        if (y < 0)
+        {
+            x -= dx;
+            y += dy;
+            z -= s_atan_q31[i];
+        }
+        else
+        {
+            x += dx;
+            y -= dy;
+            z += s_atan_q31[i];
+        }
+    }
+
+    *phase   = sim_cordic_sat(z);
+    *modulus = sim_cordic_sat((x * SIM_CORDIC_INV_GAIN) >> 31);
+}
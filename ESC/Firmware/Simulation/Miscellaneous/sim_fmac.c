@@ -0,0 +1,47 @@
+/**
+ * @file sim_fmac.c
+ * @brief Software FMAC under the filter front end (driver_filter.h hooks).
+ *
+ * The front end itself is Drivers/Miscellaneous/driver_filter.c, linked
+ * unchanged. This model runs the arithmetic of the FMAC IIR function:
+ * q1.15 samples and coefficients, products accumulated exactly, the sum
+ * shifted by the gain R, truncated to q1.15 and saturated (CLIPEN).
+ */
+
+#include "../../Drivers/Miscellaneous/driver_filter.h"
+#include "i_filter.h"
+
+/** Coefficient memory (the X2 slots of the FMAC) */
+static int16_t s_coef[FILTER_CH_COUNT][FILTER_COEF_COUNT];
+
+void Filter_HW_Load(uint32_t slot, const int16_t *coef)
+{
+    if (slot >= FILTER_CH_COUNT)
+        return;
+
+    for (uint32_t k = 0; k < FILTER_COEF_COUNT; k++)
+        s_coef[slot][k] = coef[k];
+}
+
+int16_t Filter_HW_Run(uint32_t slot, filter_hw_state_t *state, int16_t x)
+{
+    const int16_t *c = s_coef[slot];
+
+    int64_t acc = (int64_t)c[0] * x
+                + (int64_t)c[1] * state->x1
+                + (int64_t)c[2] * state->x2
+                + (int64_t)c[3] * state->y1
+                + (int64_t)c[4] * state->y2;
+
+    acc >>= (15U - FILTER_GAIN_SHIFT);
+    if (acc >  INT16_MAX) acc = INT16_MAX;
+    if (acc <  INT16_MIN) acc = INT16_MIN;
+
+    int16_t y = (int16_t)acc;
+
+    state->x2 = state->x1;
+    state->x1 = x;
+    state->y2 = state->y1;
+    state->y1 = y;
+    return y;
+}
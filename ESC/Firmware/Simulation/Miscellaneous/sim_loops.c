@@ -0,0 +1,128 @@
+/**
+ * @file sim_loops.c
+ * @brief Host stand-ins of the fast loop and TIM4 low loop (i_periodic_loop_t).
+ *
+ * The fast loop follows driver_fastloop.c: with FASTLOOP_SYNC_TO_ADC it runs
+ * from the end of the virtual injected JEOC (TIM1 TRGO), otherwise from the
+ * TIM3 event.
+ */
+
+#include "i_periodic_loop.h"
+#include "sim_esc.h"
+
+/* ========================================================================== */
+/* === Fast Loop (ADC JEOC or TIM3, 24 kHz) ================================ */
+/* ========================================================================== */
+
+static periodic_callback_t s_fast_cb = NULL;
+static bool                s_fast_sync_running = false;
+
+static void sim_fastloop_on_tick(void)
+{
+    if (s_fast_cb != NULL)
+        s_fast_cb();
+}
+
+static bool sim_fastloop_init(void)
+{
+    s_fast_cb = NULL;
+    s_fast_sync_running = false;
+    Sim_Event_Disarm(SIM_EVENT_FASTLOOP);
+    return true;
+}
+
+static void sim_fastloop_register_callback(periodic_callback_t cb)
+{
+    s_fast_cb = cb;
+}
+
+static void sim_fastloop_start(void)
+{
+#if FASTLOOP_SYNC_TO_ADC
+    s_fast_sync_running = true;
+#else
+    Sim_Event_Arm(SIM_EVENT_FASTLOOP, SIM_FASTLOOP_PERIOD_CYCLES, SIM_FASTLOOP_PERIOD_CYCLES, sim_fastloop_on_tick);
+#endif
+}
+
+static void sim_fastloop_stop(void)
+{
+    s_fast_sync_running = false;
+    Sim_Event_Disarm(SIM_EVENT_FASTLOOP);
+}
+
+static uint32_t sim_fastloop_get_frequency_hz(void)
+{
+#if FASTLOOP_SYNC_TO_ADC
+    return SIM_CPU_FREQ_HZ / SIM_PWM_PERIOD_CYCLES;
+#else
+    return SIM_CPU_FREQ_HZ / SIM_FASTLOOP_PERIOD_CYCLES;
+#endif
+}
+
+void Sim_FastLoop_OnInjectedConversion(void)
+{
+    if (s_fast_sync_running)
+        sim_fastloop_on_tick();
+}
+
+static i_periodic_loop_t s_sim_fastloop_iface = {
+    .init              = sim_fastloop_init,
+    .register_callback = sim_fastloop_register_callback,
+    .start             = sim_fastloop_start,
+    .stop              = sim_fastloop_stop,
+    .get_frequency_hz  = sim_fastloop_get_frequency_hz,
+    .trigger_once      = sim_fastloop_on_tick,
+};
+
+i_periodic_loop_t* IFastLoop = &s_sim_fastloop_iface;
+
+/* ========================================================================== */
+/* === Low Loop (TIM4, 1 kHz) ============================================== */
+/* ========================================================================== */
+
+static periodic_callback_t s_low_cb = NULL;
+
+static void sim_lowloop_on_tick(void)
+{
+    if (s_low_cb != NULL)
+        s_low_cb();
+}
+
+static bool sim_lowloop_init(void)
+{
+    s_low_cb = NULL;
+    Sim_Event_Disarm(SIM_EVENT_LOWLOOP);
+    return true;
+}
+
+static void sim_lowloop_register_callback(periodic_callback_t cb)
+{
+    s_low_cb = cb;
+}
+
+static void sim_lowloop_start(void)
+{
+    Sim_Event_Arm(SIM_EVENT_LOWLOOP, SIM_LOWLOOP_PERIOD_CYCLES, SIM_LOWLOOP_PERIOD_CYCLES, sim_lowloop_on_tick);
+}
+
+static void sim_lowloop_stop(void)
+{
+    Sim_Event_Disarm(SIM_EVENT_LOWLOOP);
+}
+
+static uint32_t sim_lowloop_get_frequency_hz(void)
+{
+    return SIM_CPU_FREQ_HZ / SIM_LOWLOOP_PERIOD_CYCLES;
+}
+
+static i_periodic_loop_t s_sim_lowloop_iface = {
+    .init              = sim_lowloop_init,
+    .register_callback = sim_lowloop_register_callback,
+    .start             = sim_lowloop_start,
+    .stop              = sim_lowloop_stop,
+    .get_frequency_hz  = sim_lowloop_get_frequency_hz,
+    .trigger_once      = sim_lowloop_on_tick,
+};
+
+i_periodic_loop_t* ILowLoop = &s_sim_lowloop_iface;
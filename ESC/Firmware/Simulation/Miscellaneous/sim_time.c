@@ -0,0 +1,63 @@
+/**
+ * @file sim_time.c
+ * @brief Host stand-in of the time driver (i_time_t) on the virtual clock.
+ *
+ * get_time_us() mirrors the TIM2 1 µs free-running counter (32-bit wrap),
+ * getTick() mirrors the HAL 1 ms tick, get_cycles() the DWT cycle counter
+ * (handlers take zero virtual time, so profiled durations are 0 on host).
+ */
+
+#include "i_time.h"
+#include "sim_esc.h"
+
+static bool sim_time_init(void)
+{
+    return true;
+}
+
+static void sim_time_delay_ms(uint32_t ms)
+{
+    Sim_Delay_Cycles((uint64_t)ms * 1000U * SIM_CYCLES_PER_US);
+}
+
+static void sim_time_delay_us(uint32_t us)
+{
+    Sim_Delay_Cycles((uint64_t)us * SIM_CYCLES_PER_US);
+}
+
+static uint32_t sim_time_get_tick(void)
+{
+    return (uint32_t)(Sim_GetCycles() / (1000U * SIM_CYCLES_PER_US));
+}
+
+static uint32_t sim_time_get_system_frequency(void)
+{
+    return SIM_CPU_FREQ_HZ;
+}
+
+static uint32_t sim_time_get_us(void)
+{
+    return (uint32_t)(Sim_GetCycles() / SIM_CYCLES_PER_US);
+}
+
+static uint32_t sim_time_get_cycles(void)
+{
+    return (uint32_t)Sim_GetCycles();
+}
+
+/* -------------------------------------------------------------------------- */
+/*                   Global time driver interface instance                    */
+/* -------------------------------------------------------------------------- */
+
+static i_time_t s_sim_time = {
+    .init               = sim_time_init,
+    .getTick            = sim_time_get_tick,
+    .delay_ms           = sim_time_delay_ms,
+    .getSystemFrequency = sim_time_get_system_frequency,
+    .delay_us           = sim_time_delay_us,
+    .get_time_us        = sim_time_get_us,
+    .get_cycles         = sim_time_get_cycles
+};
+
+/** Global pointer to the time driver instance */
+i_time_t* ITime = &s_sim_time;
@@ -0,0 +1,87 @@
+/**
+ * @file sim_timer_sched.c
+ * @brief Virtual TIM5 under the timer scheduler (driver_timer_sched.h hooks).
+ *
+ * The scheduler logic itself is Drivers/Miscellaneous/driver_timer_sched.c,
+ * linked unchanged. Like on target, TIM5 runs free at the CPU clock
+ * (PSC = 0), so one tick is one virtual cycle; each compare channel
+ * (CC2..CC4, CH1 being the BEMF capture of sim_bemf_comp.c) is a kernel
+ * event, CC2 first when several are due at the same cycle.
+ *
+ * A channel armed as trigger raises TRGO at its match: the virtual TIM1
+ * COM event is applied before the compare interrupt runs, like on target
+ * where the hardware switches the outputs ahead of the ISR.
+ */
+
+#include "../../Drivers/Miscellaneous/driver_timer_sched.h"
+#include "sim_esc.h"
+
+static bool s_cc_trigger[TIMER_SCHED_HW_CHANNELS];
+
+static void sim_tim5_match(uint8_t ch)
+{
+    if (s_cc_trigger[ch])
+    {
+        s_cc_trigger[ch] = false;
+        Sim_Inverter_OnComEvent();
+    }
+
+    TimerSched_OnCompare(ch);
+}
+
+static void sim_tim5_cc2(void) { sim_tim5_match(0U); }
+static void sim_tim5_cc3(void) { sim_tim5_match(1U); }
+static void sim_tim5_cc4(void) { sim_tim5_match(2U); }
+
+static const sim_event_handler_t s_cc_handler[TIMER_SCHED_HW_CHANNELS] = {
+    sim_tim5_cc2, sim_tim5_cc3, sim_tim5_cc4
+};
+
+bool TimerSched_HW_Init(void)
+{
+    for (uint8_t ch = 0; ch < TIMER_SCHED_HW_CHANNELS; ch++)
+    {
+        s_cc_trigger[ch] = false;
+        Sim_Event_Disarm((sim_event_id_t)(SIM_EVENT_TIM5_CC2 + ch));
+    }
+    return true;
+}
+
+uint32_t TimerSched_HW_Now(void)
+{
+    return (uint32_t)Sim_GetCycles();
+}
+
+uint32_t TimerSched_HW_TickHz(void)
+{
+    return SIM_CPU_FREQ_HZ;
+}
+
+void TimerSched_HW_SetCompare(uint8_t ch, uint32_t deadline, bool trigger)
+{
+    int32_t delay = (int32_t)(deadline - TimerSched_HW_Now());
+
+    /* Already due: software compare event, fires at the current cycle */
+    if (delay < 0)
+        delay = 0;
+
+    s_cc_trigger[ch] = trigger;
+    Sim_Event_Arm((sim_event_id_t)(SIM_EVENT_TIM5_CC2 + ch), (uint64_t)delay, 0U, s_cc_handler[ch]);
+}
+
+void TimerSched_HW_DisableCompare(uint8_t ch)
+{
+    s_cc_trigger[ch] = false;
+    Sim_Event_Disarm((sim_event_id_t)(SIM_EVENT_TIM5_CC2 + ch));
+}
+
+/* ISRs do not preempt each other on the host */
+uint32_t TimerSched_HW_Lock(void)
+{
+    return 0U;
+}
+
+void TimerSched_HW_Unlock(uint32_t state)
+{
+    (void)state;
+}
@@ -0,0 +1,559 @@
+/**
+ * @file sim_bldc_plant.c
+ * @brief Trapezoidal BLDC motor + 3-phase bridge model (see sim_bldc_plant.h).
+ *
+ * The model is advanced lazily: every inverter change (observer) and every
+ * ADC trigger first integrates from the last update to the current virtual
+ * time with the switch pattern that was applied over that interval. Inside a
+ * PWM period the integration is split at the CCR edges of each phase, and
+ * long intervals are sub-stepped for the explicit Euler solver.
+ */
+
+#include "sim_bldc_plant.h"
+#include "sim_esc.h"
+
+#include <math.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* === Configuration ======================================================= */
+/* ========================================================================== */
+
+#define PLANT_MAX_STEP_CYCLES   150U        /**< 1 µs Euler step */
+#define PLANT_HALF_PERIOD       (SIM_PWM_PERIOD_CYCLES / 2U)
+#define PLANT_DIODE_EPS_A       1e-4f       /**< Diode conduction threshold */
+#define PLANT_COMM_MIN_RPM      50.0f       /**< Ignore commutations at standstill */
+#define PLANT_L_MIN_RATIO       0.2f        /**< Floor of the saturated inductance (fraction of L) */
+
+#define PLANT_ADC_VREF          3.3f
+#define PLANT_ADC_MAX           4095.0f
+
+#define PLANT_PI                3.14159265358979f
+#define PLANT_TWO_PI            6.28318530717959f
+#define PLANT_DEG_PER_RAD       57.2957795130823f
+
+/* ========================================================================== */
+/* === Local Types ========================================================= */
+/* ========================================================================== */
+
+/** Instantaneous state of one half-bridge. */
+typedef enum {
+    LEG_OFF = 0,    /**< Both switches off (diodes / floating) */
+    LEG_HIGH,       /**< High-side switch on */
+    LEG_LOW         /**< Low-side switch on */
+} leg_state_t;
+
+/* ========================================================================== */
+/* === Module State ======================================================== */
+/* ========================================================================== */
+
+static sim_bldc_params_t     s_p;
+static bool                  s_attached = false;
+
+static uint64_t              s_t_cycles;            /**< Time of the plant state */
+static float                 s_theta_e;
+static float                 s_theta_m;
+static float                 s_omega_m;
+static float                 s_i[PHASE_COUNT];
+static float                 s_e[PHASE_COUNT];
+static float                 s_v[PHASE_COUNT];
+static float                 s_vn;
+static float                 s_torque;
+
+/** Output pattern applied since s_t_cycles (copied from the inverter). */
+static sim_inverter_state_t  s_inv;
+
+/** Last six-step pattern seen, as (high phase, low phase); -1 = none. */
+static int                   s_last_high = -1;
+static int                   s_last_low  = -1;
+static sim_bldc_comm_stats_t s_comm;
+static double                s_comm_sum_deg;
+static double                s_comm_sum_abs_deg;
+
+/* ========================================================================== */
+/* === Electrical helpers ================================================== */
+/* ========================================================================== */
+
+static float wrap_2pi(float x)
+{
+    x = fmodf(x, PLANT_TWO_PI);
+    return (x < 0.0f) ? x + PLANT_TWO_PI : x;
+}
+
+static float wrap_pm180(float deg)
+{
+    deg = fmodf(deg + 180.0f, 360.0f);
+    return (deg < 0.0f) ? deg + 180.0f : deg - 180.0f;
+}
+
+/**
+ * @brief Normalised trapezoidal BEMF shape, 120° flat tops, f(0) = 0 rising.
+ */
+static float bemf_shape(float theta)
+{
+    const float k = PLANT_PI / 6.0f;
+    float x = wrap_2pi(theta);
+
+    if (x < k)               return x / k;
+    if (x < 5.0f * k)        return 1.0f;
+    if (x < 7.0f * k)        return 1.0f - (x - 5.0f * k) / k;
+    if (x < 11.0f * k)       return -1.0f;
+    return -1.0f + (x - 11.0f * k) / k;
+}
+
+/**
+ * @brief Inductance of phase @p x at the present rotor angle and current.
+ *
+ * Saliency dips L on the magnet axis (both poles); saturation lowers it
+ * further when i_x adds to the magnet flux of the phase and raises it when
+ * it opposes it, which tells the poles apart.
+ */
+static float phase_inductance(int x)
+{
+    if (s_p.l_saliency == 0.0f && s_p.l_sat_per_a == 0.0f)
+        return s_p.l_phase_h;
+
+    float angle = s_theta_e - (float)x * (PLANT_TWO_PI / 3.0f);
+    float c = -cosf(angle);
+    float k = 1.0f - s_p.l_saliency * cosf(2.0f * angle) - s_p.l_sat_per_a * c * s_i[x];
+
+    return s_p.l_phase_h * fmaxf(k, PLANT_L_MIN_RATIO);
+}
+
+/**
+ * @brief Half-bridge state at position @p pos of the PWM period.
+ *
+ * Center-aligned PWM mode 1: the channel is active while CNT < CCR, i.e.
+ * during the first and last (duty × T/2) of the period.
+ */
+static leg_state_t leg_state(int ph, uint32_t pos)
+{
+    uint32_t active_cycles = (uint32_t)(s_inv.duty[ph] * (float)PLANT_HALF_PERIOD + 0.5f);
+    bool active = (pos < active_cycles) || (pos >= SIM_PWM_PERIOD_CYCLES - active_cycles);
+
+    switch (s_inv.state[ph])
+    {
+        case STATE_PWM_ACTIVE: return active ? LEG_HIGH : LEG_LOW;
+        case STATE_PWM_HIGH:   return active ? LEG_HIGH : LEG_OFF;
+        case STATE_PWM_LOW:    return active ? LEG_LOW  : LEG_OFF;
+        case STATE_FORCE_HIGH: return LEG_HIGH;
+        case STATE_FORCE_LOW:  return LEG_LOW;
+        case STATE_HIZ:
+        default:               return LEG_OFF;
+    }
+}
+
+/**
+ * @brief Solve terminal and star-point voltages for the given leg states.
+ *
+ * @param legs       Half-bridge states.
+ * @param connected  Out: phase is part of a current path.
+ *
+ * Off legs conduct through a body diode while current flows; undriven,
+ * currentless phases float at v_n + e_x and start conducting when that
+ * exceeds the rails. The star point follows from Σ di_x = 0 over the
+ * connected phases, each weighted by 1 / L_x (R·i_x included: with
+ * unequal inductances it does not drop out of the sum).
+ */
+static void solve_terminals(const leg_state_t legs[PHASE_COUNT], bool connected[PHASE_COUNT])
+{
+    const float vbus = s_p.vbus_v;
+    float w[PHASE_COUNT];
+
+    for (int x = 0; x < PHASE_COUNT; x++)
+    {
+        connected[x] = true;
+        w[x] = s_p.l_phase_h / phase_inductance(x);
+
+        if (legs[x] == LEG_HIGH)                    s_v[x] = vbus;
+        else if (legs[x] == LEG_LOW)                s_v[x] = 0.0f;
+        else if (s_i[x] >  PLANT_DIODE_EPS_A)       s_v[x] = 0.0f;   // Low-side diode
+        else if (s_i[x] < -PLANT_DIODE_EPS_A)       s_v[x] = vbus;   // High-side diode
+        else                                        connected[x] = false;
+    }
+
+    for (int iter = 0; iter < PHASE_COUNT; iter++)
+    {
+        int n = 0;
+        float sum = 0.0f, w_sum = 0.0f;
+
+        for (int x = 0; x < PHASE_COUNT; x++)
+        {
+            if (connected[x]) { sum += w[x] * (s_v[x] - s_p.r_phase_ohm * s_i[x] - s_e[x]); w_sum += w[x]; n++; }
+        }
+
+        if (n > 0)
+            s_vn = sum / w_sum;
+        else
+            s_vn = -(s_e[PHASE_A] + s_e[PHASE_B] + s_e[PHASE_C]) / 3.0f;   // Held by the ADC dividers
+
+        /* Floating phases: clamp by the body diodes when beyond the rails */
+        int worst = -1;
+        float worst_excess = 0.0f;
+
+        for (int x = 0; x < PHASE_COUNT; x++)
+        {
+            if (connected[x])
+                continue;
+
+            s_v[x] = s_vn + s_e[x];
+
+            float excess = (s_v[x] > vbus) ? s_v[x] - vbus : ((s_v[x] < 0.0f) ? -s_v[x] : 0.0f);
+            if (n > 0 && excess > worst_excess)
+            {
+                worst_excess = excess;
+                worst = x;
+            }
+        }
+
+        if (worst < 0)
+            return;
+
+        s_v[worst] = (s_v[worst] > vbus) ? vbus : 0.0f;
+        connected[worst] = true;
+    }
+}
+
+/**
+ * @brief Integrate the model over @p cycles with constant leg states.
+ */
+static void integrate(uint32_t pos, uint32_t cycles)
+{
+    const float dt = (float)cycles / (float)SIM_CPU_FREQ_HZ;
+    leg_state_t legs[PHASE_COUNT];
+    bool connected[PHASE_COUNT];
+
+    for (int x = 0; x < PHASE_COUNT; x++)
+    {
+        legs[x] = leg_state(x, pos);
+        s_e[x]  = s_p.ke_v_s_per_rad * s_omega_m * bemf_shape(s_theta_e - (float)x * (PLANT_TWO_PI / 3.0f));
+    }
+
+    solve_terminals(legs, connected);
+
+    /* --- Electrical --- */
+    float shape_torque = 0.0f;
+    float inv_l[PHASE_COUNT] = { 0.0f, 0.0f, 0.0f };
+    float i_sum = 0.0f, inv_l_sum = 0.0f;
+
+    for (int x = 0; x < PHASE_COUNT; x++)
+    {
+        if (!connected[x])
+        {
+            s_i[x] = 0.0f;
+            continue;
+        }
+
+        float i_prev = s_i[x];
+        float l = phase_inductance(x);
+        float di = (s_v[x] - s_p.r_phase_ohm * s_i[x] - s_e[x] - s_vn) / l;
+        s_i[x] += di * dt;
+
+        /* A diode cannot reverse: current extinguishes at zero */
+        if (legs[x] == LEG_OFF && (i_prev * s_i[x]) < 0.0f)
+        {
+            s_i[x] = 0.0f;
+            continue;
+        }
+
+        inv_l[x]   = 1.0f / l;
+        i_sum     += s_i[x];
+        inv_l_sum += inv_l[x];
+    }
+
+    /* The star point takes no current: what a blocking diode cut off in
+     * mid-step is shared by the phases still conducting (1 / L_x each) */
+    if (inv_l_sum > 0.0f)
+    {
+        for (int x = 0; x < PHASE_COUNT; x++)
+            s_i[x] -= i_sum * inv_l[x] / inv_l_sum;
+    }
+
+    for (int x = 0; x < PHASE_COUNT; x++)
+        shape_torque += bemf_shape(s_theta_e - (float)x * (PLANT_TWO_PI / 3.0f)) * s_i[x];
+
+    /* --- Mechanical --- */
+    s_torque = s_p.ke_v_s_per_rad * shape_torque;
+
+    float drag = s_p.b_nm_s_per_rad * s_omega_m + s_p.k_prop_nm_s2 * s_omega_m * fabsf(s_omega_m);
+    float net  = s_torque - drag;
+
+    if (s_omega_m == 0.0f && fabsf(net) <= s_p.load_torque_nm)
+    {
+        net = 0.0f;                                             // Static friction holds
+    }
+    else
+    {
+        float dir = (s_omega_m != 0.0f) ? copysignf(1.0f, s_omega_m) : copysignf(1.0f, net);
+        net -= dir * s_p.load_torque_nm;
+    }
+
+    float omega_next = s_omega_m + net / s_p.j_kg_m2 * dt;
+
+    if (s_omega_m != 0.0f && omega_next * s_omega_m < 0.0f && fabsf(s_torque) <= s_p.load_torque_nm)
+        omega_next = 0.0f;                                      // Friction stops, does not reverse
+
+    s_theta_m = wrap_2pi(s_theta_m + 0.5f * (s_omega_m + omega_next) * dt);
+    s_omega_m = omega_next;
+    s_theta_e = wrap_2pi(s_theta_m * (float)s_p.pole_pairs);
+}
+
+/**
+ * @brief Hand the terminal voltages of the step just integrated to the
+ *        BEMF comparators (phase dividers on INP, their star point on INM).
+ */
+static void feed_comparators(void)
+{
+    float pin[PHASE_COUNT];
+    float star = 0.0f;
+
+    for (int x = 0; x < PHASE_COUNT; x++)
+    {
+        pin[x] = s_v[x] / s_p.v_divider_ratio;
+        star  += pin[x] / (float)PHASE_COUNT;
+    }
+
+    Sim_BemfComp_Input(s_t_cycles, pin, star);
+}
+
+/**
+ * @brief Advance the model to @p t_end, splitting at every PWM edge.
+ */
+static void advance_to(uint64_t t_end)
+{
+    while (s_t_cycles < t_end)
+    {
+        uint32_t pos = (uint32_t)(s_t_cycles % SIM_PWM_PERIOD_CYCLES);
+        uint32_t next = SIM_PWM_PERIOD_CYCLES;
+
+        /* Nearest switching edge after pos */
+        for (int x = 0; x < PHASE_COUNT; x++)
+        {
+            uint32_t a = (uint32_t)(s_inv.duty[x] * (float)PLANT_HALF_PERIOD + 0.5f);
+            uint32_t edges[2] = { a, SIM_PWM_PERIOD_CYCLES - a };
+
+            for (int k = 0; k < 2; k++)
+            {
+                if (edges[k] > pos && edges[k] < next)
+                    next = edges[k];
+            }
+        }
+
+        uint64_t step = next - pos;
+        if (step > PLANT_MAX_STEP_CYCLES)    step = PLANT_MAX_STEP_CYCLES;
+        if (step > t_end - s_t_cycles)       step = t_end - s_t_cycles;
+
+        integrate(pos, (uint32_t)step);
+        feed_comparators();
+        s_t_cycles += step;
+    }
+}
+
+/* ========================================================================== */
+/* === Commutation accuracy ================================================ */
+/* ========================================================================== */
+
+/**
+ * @brief Record the angle error when a new six-step pattern gets applied.
+ *
+ * The pattern "high h, low l" delivers its peak torque over the 60° window
+ * where f_h = +1 and f_l = -1; for forward rotation it should be entered at
+ * the window start. Reverse rotation needs the opposite torque: the same
+ * pattern is entered at the end of the mirrored window (180° away).
+ */
+static void track_commutation(void)
+{
+    int high = -1, low = -1, hiz = 0;
+
+    for (int x = 0; x < PHASE_COUNT; x++)
+    {
+        switch (s_inv.state[x])
+        {
+            case STATE_PWM_HIGH: case STATE_FORCE_HIGH: high = x; break;
+            case STATE_PWM_LOW:  case STATE_FORCE_LOW:  low = x;  break;
+            case STATE_HIZ:                             hiz++;    break;
+            default:                                              break;
+        }
+    }
+
+    if (high < 0 || low < 0 || hiz != 1 || (high == s_last_high && low == s_last_low))
+        return;
+
+    s_last_high = high;
+    s_last_low  = low;
+
+    float rpm = s_omega_m * 60.0f / PLANT_TWO_PI;
+    if (fabsf(rpm) < PLANT_COMM_MIN_RPM)
+        return;
+
+    /* Window start of "high h, low l": f_h flat-top starts at 30° + h·120°,
+     * f_l negative flat-top starts at 210° + l·120°; the overlap starts at
+     * the later of the two (mod 360°). */
+    float start_h = 30.0f + 120.0f * (float)high;
+    float start_l = 210.0f + 120.0f * (float)low;
+    float d = wrap_pm180(start_l - start_h);
+    float window_start = (d > 0.0f) ? start_l : start_h;
+
+    float theta_deg = s_theta_e * PLANT_DEG_PER_RAD;
+    float err = (rpm > 0.0f) ? wrap_pm180(theta_deg - window_start)
+                             : wrap_pm180((window_start + 240.0f) - theta_deg);
+
+    s_comm.count++;
+    s_comm.last_deg = err;
+    s_comm_sum_deg     += err;
+    s_comm_sum_abs_deg += fabsf(err);
+    s_comm.mean_deg     = (float)(s_comm_sum_deg / s_comm.count);
+    s_comm.mean_abs_deg = (float)(s_comm_sum_abs_deg / s_comm.count);
+    if (fabsf(err) > s_comm.max_abs_deg)
+        s_comm.max_abs_deg = fabsf(err);
+}
+
+/* ========================================================================== */
+/* === Simulation hooks ==================================================== */
+/* ========================================================================== */
+
+static void plant_on_inverter_change(sim_inverter_change_t when)
+{
+    if (when == SIM_INVERTER_PRE_CHANGE)
+    {
+        advance_to(Sim_GetCycles());
+        return;
+    }
+
+    Sim_Inverter_GetState(&s_inv);
+    track_commutation();
+}
+
+static uint16_t to_adc(float v_adc)
+{
+    float raw = v_adc * (PLANT_ADC_MAX / PLANT_ADC_VREF);
+    if (raw < 0.0f)         return 0;
+    if (raw > PLANT_ADC_MAX) return (uint16_t)PLANT_ADC_MAX;
+    return (uint16_t)(raw + 0.5f);
+}
+
+/**
+ * @brief ADC source: instantaneous sample at the TIM1 trigger position.
+ */
+static void plant_sample_adc(motor_measurements_t *raw)
+{
+    advance_to(Sim_GetCycles());
+
+    leg_state_t legs[PHASE_COUNT];
+    bool connected[PHASE_COUNT];
+    uint32_t pos = (uint32_t)(s_t_cycles % SIM_PWM_PERIOD_CYCLES);
+
+    for (int x = 0; x < PHASE_COUNT; x++)
+        legs[x] = leg_state(x, pos);
+
+    solve_terminals(legs, connected);
+
+    /* Unidirectional low-side shunt amplifiers: magnitude only */
+    raw->i_a_raw = to_adc(fabsf(s_i[PHASE_A]) * s_p.current_gain_v_a);
+    raw->i_b_raw = to_adc(fabsf(s_i[PHASE_B]) * s_p.current_gain_v_a);
+    raw->i_c_raw = to_adc(fabsf(s_i[PHASE_C]) * s_p.current_gain_v_a);
+
+    raw->v_phase_a_raw = to_adc(s_v[PHASE_A] / s_p.v_divider_ratio);
+    raw->v_phase_b_raw = to_adc(s_v[PHASE_B] / s_p.v_divider_ratio);
+    raw->v_phase_c_raw = to_adc(s_v[PHASE_C] / s_p.v_divider_ratio);
+    raw->v_bus_raw     = to_adc(s_p.vbus_v / s_p.v_divider_ratio);
+
+    /* On-time: a high-side switch of the bridge conducts */
+    raw->v_on_time = (legs[PHASE_A] == LEG_HIGH) || (legs[PHASE_B] == LEG_HIGH) || (legs[PHASE_C] == LEG_HIGH);
+}
+
+/* ========================================================================== */
+/* === Public API ========================================================== */
+/* ========================================================================== */
+
+void Sim_BLDC_DefaultParams(sim_bldc_params_t *p)
+{
+    if (!p) return;
+
+    p->r_phase_ohm       = 0.10f;
+    p->l_phase_h         = 30e-6f;
+    p->ke_v_s_per_rad    = 0.0052f;     // ≈ 920 KV (line-line peak = 2 × phase)
+    p->j_kg_m2           = 2.0e-5f;
+    p->b_nm_s_per_rad    = 1.0e-6f;
+    p->load_torque_nm    = 0.002f;
+    p->k_prop_nm_s2      = 2.0e-8f;
+    p->pole_pairs        = 6;
+    p->vbus_v            = 12.0f;
+    p->v_divider_ratio   = 11.0f;       // Same divider as VBUS_SENS
+    p->current_gain_v_a  = 20.0f * 0.01f;
+    p->l_saliency        = 0.0f;
+    p->l_sat_per_a       = 0.0f;
+}
+
+void Sim_BLDC_Attach(const sim_bldc_params_t *p)
+{
+    if (p) s_p = *p;
+    else   Sim_BLDC_DefaultParams(&s_p);
+
+    s_t_cycles = Sim_GetCycles();
+    s_theta_e = s_theta_m = s_omega_m = 0.0f;
+    s_vn = s_torque = 0.0f;
+    memset(s_i, 0, sizeof(s_i));
+    memset(s_e, 0, sizeof(s_e));
+    memset(s_v, 0, sizeof(s_v));
+    Sim_BLDC_ResetCommutationStats();
+
+    Sim_Inverter_GetState(&s_inv);
+    Sim_Inverter_SetObserver(plant_on_inverter_change);
+    Sim_MotorSensor_SetSource(plant_sample_adc);
+    Sim_Sensors_SetVoltage(VOLTAGE_BUS, s_p.vbus_v);
+
+    s_attached = true;
+}
+
+void Sim_BLDC_Detach(void)
+{
+    Sim_Inverter_SetObserver(NULL);
+    Sim_MotorSensor_SetSource(NULL);
+    s_attached = false;
+}
+
+void Sim_BLDC_SetLoadTorque(float torque_nm)
+{
+    advance_to(Sim_GetCycles());
+    s_p.load_torque_nm = torque_nm;
+}
+
+void Sim_BLDC_SetRotor(float theta_e_rad, float omega_m_rad_s)
+{
+    advance_to(Sim_GetCycles());
+    s_theta_e = wrap_2pi(theta_e_rad);
+    s_theta_m = (s_p.pole_pairs != 0U) ? s_theta_e / (float)s_p.pole_pairs : 0.0f;
+    s_omega_m = omega_m_rad_s;
+}
+
+void Sim_BLDC_GetState(sim_bldc_state_t *out)
+{
+    if (!out) return;
+
+    if (s_attached)
+        advance_to(Sim_GetCycles());
+
+    out->theta_e_rad   = s_theta_e;
+    out->omega_m_rad_s = s_omega_m;
+    out->rpm           = s_omega_m * 60.0f / PLANT_TWO_PI;
+    for (int x = 0; x < PHASE_COUNT; x++)
+    {
+        out->i_a[x]    = s_i[x];
+        out->e_v[x]    = s_e[x];
+        out->v_term[x] = s_v[x];
+    }
+    out->v_neutral = s_vn;
+    out->torque_nm = s_torque;
+}
+
+void Sim_BLDC_GetCommutationStats(sim_bldc_comm_stats_t *out)
+{
+    if (out) *out = s_comm;
+}
+
+void Sim_BLDC_ResetCommutationStats(void)
+{
+    memset(&s_comm, 0, sizeof(s_comm));
+    s_comm_sum_deg = s_comm_sum_abs_deg = 0.0;
+}
@@ -0,0 +1,375 @@
+/**
+ * @file sim_irq_sched.c
+ * @brief Discrete-event NVIC model (see sim_irq_sched.h).
+ *
+ * Time advances from event to event: the next source release or the
+ * completion of the running (innermost) handler. Only the innermost handler
+ * consumes CPU time; preempted handlers keep their remaining cost.
+ */
+
+#include "sim_irq_sched.h"
+#include "sim_esc.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* === Local Types ========================================================= */
+/* ========================================================================== */
+
+typedef struct {
+    sim_irq_source_cfg_t   cfg;
+    sim_irq_source_stats_t st;
+    uint64_t               next_release;    /**< UINT64_MAX = none */
+    bool                   pending;
+    uint64_t               pending_release;
+    uint32_t               dispatched;
+    double                 latency_sum;
+} irq_source_t;
+
+/** One nesting level of the ISR stack. */
+typedef struct {
+    int      id;
+    uint64_t release;
+    uint32_t remaining;
+} irq_frame_t;
+
+/* ========================================================================== */
+/* === Module State ======================================================== */
+/* ========================================================================== */
+
+static irq_source_t s_src[SIM_IRQ_MAX_SOURCES];
+static uint8_t      s_src_count = 0;
+
+static irq_frame_t  s_stack[SIM_IRQ_MAX_SOURCES];
+static uint8_t      s_depth = 0;
+static uint8_t      s_max_depth = 0;
+
+static uint64_t     s_now = 0;
+static uint64_t     s_busy = 0;
+static bool         s_tailchain = false;
+static uint32_t     s_rng = 1U;
+
+/* ========================================================================== */
+/* === Helpers ============================================================= */
+/* ========================================================================== */
+
+/** xorshift32: deterministic, seedable */
+static uint32_t irq_rand(void)
+{
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+static uint32_t irq_rand_range(uint32_t lo, uint32_t hi)
+{
+    return (hi > lo) ? lo + irq_rand() % (hi - lo + 1U) : lo;
+}
+
+static uint32_t irq_cost(irq_source_t *src)
+{
+    uint32_t n = src->dispatched++;
+
+    if (src->cfg.cost_fn)
+        return src->cfg.cost_fn(src->cfg.cost_ctx, n);
+
+    return irq_rand_range(src->cfg.cost_min_cycles, src->cfg.cost_max_cycles);
+}
+
+static uint32_t irq_deadline(const irq_source_t *src)
+{
+    return (src->cfg.deadline_cycles != 0U) ? src->cfg.deadline_cycles : src->cfg.period_cycles;
+}
+
+/* ========================================================================== */
+/* === Event processing ==================================================== */
+/* ========================================================================== */
+
+/**
+ * @brief Start the most urgent pending source if it may preempt.
+ */
+static void irq_dispatch(void)
+{
+    int best = -1;
+
+    for (int i = 0; i < s_src_count; i++)
+    {
+        if (!s_src[i].pending)
+            continue;
+
+        if (best < 0 ||
+            s_src[i].cfg.priority < s_src[best].cfg.priority ||
+            (s_src[i].cfg.priority == s_src[best].cfg.priority && s_src[i].cfg.irqn < s_src[best].cfg.irqn))
+        {
+            best = i;
+        }
+    }
+
+    bool tailchain = s_tailchain;
+    s_tailchain = false;
+
+    if (best < 0)
+        return;
+
+    if (s_depth > 0)
+    {
+        irq_source_t *top = &s_src[s_stack[s_depth - 1].id];
+        if (s_src[best].cfg.priority >= top->cfg.priority)
+            return;
+
+        top->st.preempted++;
+        tailchain = false;      // Preemption, not a return
+    }
+
+    irq_source_t *src = &s_src[best];
+    uint32_t entry = tailchain ? SIM_IRQ_TAILCHAIN_CYCLES : SIM_IRQ_ENTRY_CYCLES;
+    uint32_t latency = (uint32_t)(s_now - src->pending_release) + entry;
+
+    s_stack[s_depth].id        = best;
+    s_stack[s_depth].release   = src->pending_release;
+    s_stack[s_depth].remaining = entry + irq_cost(src);
+    s_depth++;
+
+    src->pending = false;
+
+    if (s_depth > s_max_depth)     s_max_depth = s_depth;
+    if (s_depth > src->st.max_depth) src->st.max_depth = s_depth;
+
+    if (src->dispatched == 1U)
+        src->st.latency_min = latency;
+    if (latency < src->st.latency_min) src->st.latency_min = latency;
+    if (latency > src->st.latency_max) src->st.latency_max = latency;
+    src->latency_sum += latency;
+    src->st.latency_mean = (float)(src->latency_sum / src->dispatched);
+}
+
+/**
+ * @brief Innermost handler returns.
+ */
+static void irq_complete(void)
+{
+    irq_frame_t *f = &s_stack[--s_depth];
+    irq_source_t *src = &s_src[f->id];
+    uint32_t response = (uint32_t)(s_now - f->release);
+    uint32_t deadline = irq_deadline(src);
+
+    src->st.completed++;
+    if (response > src->st.response_max)
+        src->st.response_max = response;
+    if (deadline != 0U && response > deadline)
+        src->st.deadline_misses++;
+
+    s_tailchain = true;
+}
+
+/**
+ * @brief Set the pending bit of every source released at s_now.
+ */
+static void irq_release_due(void)
+{
+    for (int i = 0; i < s_src_count; i++)
+    {
+        irq_source_t *src = &s_src[i];
+
+        while (src->next_release <= s_now)
+        {
+            src->st.releases++;
+
+            if (src->pending)
+            {
+                src->st.lost++;                 // Single pending bit per IRQ
+            }
+            else
+            {
+                src->pending = true;
+                src->pending_release = src->next_release;
+            }
+
+            if (src->cfg.period_cycles == 0U)
+                src->next_release = UINT64_MAX;
+            else
+                src->next_release += src->cfg.period_cycles + irq_rand_range(0U, src->cfg.jitter_cycles);
+        }
+    }
+}
+
+/* ========================================================================== */
+/* === Public API ========================================================== */
+/* ========================================================================== */
+
+void Sim_IrqSched_Reset(uint32_t seed)
+{
+    memset(s_src, 0, sizeof(s_src));
+    memset(s_stack, 0, sizeof(s_stack));
+    s_src_count = 0;
+    s_depth = s_max_depth = 0;
+    s_now = s_busy = 0;
+    s_tailchain = false;
+    s_rng = (seed != 0U) ? seed : 1U;
+}
+
+int Sim_IrqSched_AddSource(const sim_irq_source_cfg_t *cfg)
+{
+    if (!cfg || s_src_count >= SIM_IRQ_MAX_SOURCES || cfg->cost_max_cycles < cfg->cost_min_cycles)
+        return -1;
+
+    irq_source_t *src = &s_src[s_src_count];
+    memset(src, 0, sizeof(*src));
+    src->cfg = *cfg;
+    if (!src->cfg.name)
+        src->cfg.name = "?";
+    src->next_release = s_now + cfg->offset_cycles;
+
+    return s_src_count++;
+}
+
+int Sim_IrqSched_AddEscSources(float commutation_rpm)
+{
+    const sim_irq_source_cfg_t table[] = {
+        { "TIM3 fast",  SIM_IRQ_TIM3_IRQN,     SIM_IRQ_TIM3_PRIO,     SIM_FASTLOOP_PERIOD_CYCLES, 0, 0,
+          0, SIM_IRQ_COST_TIM3_MIN, SIM_IRQ_COST_TIM3_MAX, NULL, NULL },
+        { "ADC JEOC",   SIM_IRQ_ADC1_2_IRQN,   SIM_IRQ_ADC1_2_PRIO,   SIM_PWM_PERIOD_CYCLES, 0,
+          SIM_ADC_TRIGGER_CYCLES + SIM_IRQ_ADC_CONV_CYCLES,
+          0, SIM_IRQ_COST_ADC_MIN, SIM_IRQ_COST_ADC_MAX, NULL, NULL },
+        { "TIM4 low",   SIM_IRQ_TIM4_IRQN,     SIM_IRQ_TIM4_PRIO,     SIM_LOWLOOP_PERIOD_CYCLES, 0, 0,
+          0, SIM_IRQ_COST_TIM4_MIN, SIM_IRQ_COST_TIM4_MAX, NULL, NULL },
+        { "USART2 RX",  SIM_IRQ_USART2_IRQN,   SIM_IRQ_USART2_PRIO,   SIM_IRQ_USART2_CHAR_CYCLES, 0, 0,
+          0, SIM_IRQ_COST_USART2_MIN, SIM_IRQ_COST_USART2_MAX, NULL, NULL },
+        { "DMA1 CH4",   SIM_IRQ_DMA1_CH4_IRQN, SIM_IRQ_DMA1_CH4_PRIO, SIM_LOWLOOP_PERIOD_CYCLES, 0, 0,
+          0, SIM_IRQ_COST_DMA_MIN, SIM_IRQ_COST_DMA_MAX, NULL, NULL },
+    };
+
+    for (size_t i = 0; i < sizeof(table) / sizeof(table[0]); i++)
+        Sim_IrqSched_AddSource(&table[i]);
+
+    if (commutation_rpm <= 0.0f)
+        return -1;
+
+    /* One commutation per 60° electrical, 6 pole pairs; the phase against
+     * TIM3 is random over one fast-loop period (commutation is scheduled
+     * from a ZC detected in the fast loop). */
+    float comm_hz = commutation_rpm / 60.0f * 6.0f * 6.0f;
+    uint32_t period = (uint32_t)((float)SIM_CPU_FREQ_HZ / comm_hz);
+    uint32_t jitter = (period > SIM_FASTLOOP_PERIOD_CYCLES) ? SIM_FASTLOOP_PERIOD_CYCLES : period / 2U;
+
+    sim_irq_source_cfg_t tim5 = {
+        .name            = "TIM5 comm",
+        .irqn            = SIM_IRQ_TIM5_IRQN,
+        .priority        = SIM_IRQ_TIM5_PRIO,
+        .period_cycles   = period - jitter / 2U,
+        .jitter_cycles   = jitter,
+        .offset_cycles   = period / 2U,
+        .deadline_cycles = 5U * SIM_CYCLES_PER_US,     // Commutation budget: 5 µs
+        .cost_min_cycles = SIM_IRQ_COST_TIM5_MIN,
+        .cost_max_cycles = SIM_IRQ_COST_TIM5_MAX,
+    };
+
+    return Sim_IrqSched_AddSource(&tim5);
+}
+
+bool Sim_IrqSched_SetCost(int id, uint32_t min_cycles, uint32_t max_cycles, sim_irq_cost_fn_t fn, void *ctx)
+{
+    if (id < 0 || id >= s_src_count || max_cycles < min_cycles)
+        return false;
+
+    s_src[id].cfg.cost_min_cycles = min_cycles;
+    s_src[id].cfg.cost_max_cycles = max_cycles;
+    s_src[id].cfg.cost_fn  = fn;
+    s_src[id].cfg.cost_ctx = ctx;
+    return true;
+}
+
+void Sim_IrqSched_Run(uint64_t cycles)
+{
+    const uint64_t t_end = s_now + cycles;
+
+    while (s_now < t_end)
+    {
+        irq_dispatch();
+
+        uint64_t t_next = t_end;
+        bool done = false;
+
+        for (int i = 0; i < s_src_count; i++)
+        {
+            if (s_src[i].next_release < t_next)
+                t_next = s_src[i].next_release;
+        }
+
+        if (s_depth > 0)
+        {
+            irq_frame_t *top = &s_stack[s_depth - 1];
+            if (s_now + top->remaining <= t_next)
+            {
+                t_next = s_now + top->remaining;
+                done = true;
+            }
+
+            uint32_t dt = (uint32_t)(t_next - s_now);
+            top->remaining -= dt;
+            s_src[top->id].st.busy_cycles += dt;
+            s_busy += dt;
+        }
+
+        s_now = t_next;
+
+        if (done)
+            irq_complete();
+
+        irq_release_due();
+    }
+}
+
+int Sim_IrqSched_Find(const char *name)
+{
+    for (int i = 0; name && i < s_src_count; i++)
+    {
+        if (strcmp(s_src[i].cfg.name, name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+bool Sim_IrqSched_GetStats(int id, sim_irq_source_stats_t *out)
+{
+    if (id < 0 || id >= s_src_count || !out)
+        return false;
+
+    *out = s_src[id].st;
+    return true;
+}
+
+uint8_t Sim_IrqSched_GetMaxDepth(void)
+{
+    return s_max_depth;
+}
+
+float Sim_IrqSched_GetLoad(void)
+{
+    return (s_now > 0U) ? (float)((double)s_busy / (double)s_now) : 0.0f;
+}
+
+void Sim_IrqSched_PrintReport(void)
+{
+    const float us = (float)SIM_CYCLES_PER_US;
+
+    printf("IRQ model: %.3f ms simulated, ISR load %.1f %%, max nesting %u\n",
+           (double)s_now / (double)SIM_CPU_FREQ_HZ * 1e3, Sim_IrqSched_GetLoad() * 100.0f, s_max_depth);
+    printf("%-10s %4s %8s %6s %6s %8s %8s %8s %8s %5s %6s %6s\n",
+           "source", "prio", "releases", "lost", "miss",
+           "lat_min", "lat_avg", "lat_max", "resp_max", "depth", "preem", "cpu%");
+
+    for (int i = 0; i < s_src_count; i++)
+    {
+        const irq_source_t *src = &s_src[i];
+        printf("%-10s %4u %8lu %6lu %6lu %7.2fu %7.2fu %7.2fu %7.2fu %5u %6lu %6.2f\n",
+               src->cfg.name, src->cfg.priority,
+               (unsigned long)src->st.releases, (unsigned long)src->st.lost,
+               (unsigned long)src->st.deadline_misses,
+               src->st.latency_min / us, src->st.latency_mean / us, src->st.latency_max / us,
+               src->st.response_max / us, src->st.max_depth, (unsigned long)src->st.preempted,
+               (s_now > 0U) ? (double)src->st.busy_cycles * 100.0 / (double)s_now : 0.0);
+    }
+}
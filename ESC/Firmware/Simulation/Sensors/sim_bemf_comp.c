@@ -0,0 +1,116 @@
+/**
+ * @file sim_bemf_comp.c
+ * @brief Host stand-in of the BEMF comparators + TIM5 CH1 capture (i_bemf_comparator_t).
+ *
+ * The plant pushes the comparator input voltages at every integration step
+ * (Sim_BemfComp_Input). Each comparator output is "phase above reference";
+ * an edge of the selected phase with the armed polarity latches the capture,
+ * at the instant where the linearly interpolated difference crosses zero,
+ * in virtual cycles (= TIM5 ticks of sim_timer_sched.c).
+ *
+ * Like driver_bemf_comp.c the capture is polled (no interrupt) and keeps the
+ * latest edge until it is read.
+ */
+
+#include "i_bemf_comparator.h"
+#include "sim_esc.h"
+
+/* ========================================================================== */
+/* === Module State ======================================================== */
+/* ========================================================================== */
+
+static bool             s_armed;
+static uint8_t          s_phase;
+static bemf_comp_edge_t s_edge;
+static uint64_t         s_armed_at;
+static bool             s_captured;
+static uint32_t         s_capture_ticks;
+
+/** Last comparator inputs (difference phase - reference) and their time */
+static bool             s_have_input;
+static uint64_t         s_input_at;
+static float            s_diff[PHASE_COUNT];
+
+/* ========================================================================== */
+/* === Plant Hook ========================================================== */
+/* ========================================================================== */
+
+void Sim_BemfComp_Input(uint64_t t_cycles, const float v_phase[PHASE_COUNT], float v_ref)
+{
+    float prev = s_diff[s_phase];
+
+    for (int ph = 0; ph < PHASE_COUNT; ph++)
+        s_diff[ph] = v_phase[ph] - v_ref;
+
+    if (s_armed && s_have_input)
+    {
+        float now = s_diff[s_phase];
+        bool edge = (s_edge == BEMF_COMP_EDGE_RISING) ? (prev <= 0.0f && now > 0.0f)
+                                                      : (prev > 0.0f && now <= 0.0f);
+        if (edge)
+        {
+            float frac = prev / (prev - now);
+            uint64_t at = s_input_at + (uint64_t)(frac * (float)(t_cycles - s_input_at) + 0.5f);
+
+            /* The plant may catch up after arm(): earlier edges are not seen */
+            if (at >= s_armed_at)
+            {
+                s_capture_ticks = (uint32_t)at;
+                s_captured = true;
+            }
+        }
+    }
+
+    s_input_at   = t_cycles;
+    s_have_input = true;
+}
+
+/* ========================================================================== */
+/* === Interface Implementation =========================================== */
+/* ========================================================================== */
+
+static bool sim_bemf_comp_init(void)
+{
+    s_armed      = false;
+    s_captured   = false;
+    s_have_input = false;
+    return true;
+}
+
+static bool sim_bemf_comp_arm(uint8_t phase, bemf_comp_edge_t edge)
+{
+    if (phase >= PHASE_COUNT)
+        return false;
+
+    s_phase    = phase;
+    s_edge     = edge;
+    s_armed_at = Sim_GetCycles();
+    s_captured = false;
+    s_armed    = true;
+    return true;
+}
+
+static void sim_bemf_comp_disarm(void)
+{
+    s_armed    = false;
+    s_captured = false;
+}
+
+static bool sim_bemf_comp_get_capture(uint32_t *ticks)
+{
+    if (ticks == NULL || !s_captured)
+        return false;
+
+    *ticks = s_capture_ticks;
+    s_captured = false;
+    return true;
+}
+
+static i_bemf_comparator_t s_sim_bemf_comp_interface = {
+    .init        = sim_bemf_comp_init,
+    .arm         = sim_bemf_comp_arm,
+    .disarm      = sim_bemf_comp_disarm,
+    .get_capture = sim_bemf_comp_get_capture,
+};
+
+i_bemf_comparator_t* IBemfComparator = &s_sim_bemf_comp_interface;
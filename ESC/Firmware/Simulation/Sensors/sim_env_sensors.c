@@ -0,0 +1,85 @@
+/**
+ * @file sim_env_sensors.c
+ * @brief Host stand-ins of the voltage and temperature sensor managers.
+ *
+ * Values are static and set by the test through Sim_Sensors_Set*().
+ */
+
+#include "i_voltage_sensor.h"
+#include "i_temperature_sensor.h"
+#include "sim_esc.h"
+
+/* ========================================================================== */
+/* === Voltage sensors ===================================================== */
+/* ========================================================================== */
+
+static float s_voltage[VOLT_SENSOR_COUNT] = {
+    [VOLTAGE_BUS] = 12.0f,
+    [VOLTAGE_3V3] = 3.3f,
+    [VOLTAGE_12V] = 12.0f,
+};
+
+static bool sim_voltage_init(void)   { return true; }
+static void sim_voltage_update(void) { }
+static void sim_voltage_reset(void)  { }
+
+static bool sim_voltage_read(voltage_sensor_id_t id, float* voltage)
+{
+    if (id >= VOLT_SENSOR_COUNT || voltage == NULL)
+        return false;
+
+    *voltage = s_voltage[id];
+    return true;
+}
+
+static i_voltage_sensor_t s_sim_voltage_sensor = {
+    .init   = sim_voltage_init,
+    .update = sim_voltage_update,
+    .read   = sim_voltage_read,
+    .reset  = sim_voltage_reset,
+};
+
+i_voltage_sensor_t* IVoltageSensor = &s_sim_voltage_sensor;
+
+void Sim_Sensors_SetVoltage(voltage_sensor_id_t id, float volts)
+{
+    if (id < VOLT_SENSOR_COUNT)
+        s_voltage[id] = volts;
+}
+
+/* ========================================================================== */
+/* === Temperature sensors ================================================= */
+/* ========================================================================== */
+
+static float s_temperature[TEMP_SENSOR_COUNT] = {
+    [TEMP_MCU] = 25.0f,
+    [TEMP_PCB] = 25.0f,
+};
+
+static bool sim_temperature_init(void)      { return true; }
+static void sim_temperature_update(void)    { }
+static void sim_temperature_calibrate(void) { }
+
+static bool sim_temperature_read(temperature_sensor_id_t id, float* temp_value)
+{
+    if (id >= TEMP_SENSOR_COUNT || temp_value == NULL)
+        return false;
+
+    *temp_value = s_temperature[id];
+    return true;
+}
+
+static i_temperature_sensor_t s_sim_temperature_sensor = {
+    .init      = sim_temperature_init,
+    .read      = sim_temperature_read,
+    .update    = sim_temperature_update,
+    .calibrate = sim_temperature_calibrate,
+};
+
+i_temperature_sensor_t* ITemperatureSensor = &s_sim_temperature_sensor;
+
+void Sim_Sensors_SetTemperature(temperature_sensor_id_t id, float celsius)
+{
+    if (id < TEMP_SENSOR_COUNT)
+        s_temperature[id] = celsius;
+}
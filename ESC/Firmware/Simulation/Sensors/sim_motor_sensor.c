@@ -0,0 +1,140 @@
+/**
+ * @file sim_motor_sensor.c
+ * @brief Host stand-in of the injected-ADC motor measurements (i_motor_sensor_t).
+ *
+ * On every virtual TIM1 TRGO the installed sample source produces one raw
+ * sample set, which is filtered exactly like HAL_ADCEx_InjectedConvCpltCallback()
+ * (IFilter: the FMAC front end, over its software model) and published with the
+ * same "new data" handshake as motor_sensors.c.
+ *
+ * The conversion is instantaneous: the phase voltages are time-stamped with
+ * the trigger instant, minus the group delay of the voltage filter.
+ */
+
+#include "i_motor_sensor.h"
+#include "i_perf.h"
+#include "i_time.h"
+#include "i_filter.h"
+#include "sim_esc.h"
+#include <string.h>
+
+/* ========================================================================== */
+/* === Configuration ======================================================= */
+/* ========================================================================== */
+
+#define SIM_ADC_MID_SCALE 2048U     /**< Default sample without a source */
+
+/* ========================================================================== */
+/* === Module State ======================================================== */
+/* ========================================================================== */
+
+static sim_adc_source_t      s_source = NULL;
+static motor_measurements_t  s_buffer;
+static bool                  s_new_data_ready = false;
+
+static bool     s_filter_init = false;
+static uint32_t s_prev_sample_ticks;
+
+/* ========================================================================== */
+/* === ADC trigger (TIM1 TRGO → JEOC) ====================================== */
+/* ========================================================================== */
+
+static void sim_adc_on_injected_eoc(void)
+{
+    uint32_t t0 = ITime->get_cycles();
+    uint32_t t_sample = (uint32_t)Sim_GetCycles();
+
+    motor_measurements_t raw = {
+        .i_a_raw = SIM_ADC_MID_SCALE, .i_b_raw = SIM_ADC_MID_SCALE, .i_c_raw = SIM_ADC_MID_SCALE,
+        .v_phase_a_raw = 0, .v_phase_b_raw = 0, .v_phase_c_raw = 0, .v_bus_raw = 0,
+        .v_on_time = false,
+    };
+
+    if (s_source != NULL)
+        s_source(&raw);
+
+    if (!s_filter_init)
+    {
+        IFilter->reset();
+        s_prev_sample_ticks = t_sample;
+        s_filter_init = true;
+    }
+
+    uint16_t in[FILTER_CH_COUNT] = {
+        [FILTER_CH_I_A] = raw.i_a_raw, [FILTER_CH_I_B] = raw.i_b_raw,
+        [FILTER_CH_V_A] = raw.v_phase_a_raw, [FILTER_CH_V_B] = raw.v_phase_b_raw,
+        [FILTER_CH_V_C] = raw.v_phase_c_raw, [FILTER_CH_V_BUS] = raw.v_bus_raw,
+    };
+    uint16_t filt[FILTER_CH_COUNT];
+    IFilter->process(in, filt);
+
+    s_buffer.i_a_raw       = filt[FILTER_CH_I_A];
+    s_buffer.i_b_raw       = filt[FILTER_CH_I_B];
+    s_buffer.i_c_raw       = raw.i_c_raw;
+    s_buffer.i_peak_raw    = (raw.i_a_raw > raw.i_b_raw) ? raw.i_a_raw : raw.i_b_raw;
+    s_buffer.i_a_inst_raw  = raw.i_a_raw;
+    s_buffer.i_b_inst_raw  = raw.i_b_raw;
+    s_buffer.v_phase_a_raw = filt[FILTER_CH_V_A];
+    s_buffer.v_phase_b_raw = filt[FILTER_CH_V_B];
+    s_buffer.v_phase_c_raw = filt[FILTER_CH_V_C];
+    s_buffer.v_bus_raw     = filt[FILTER_CH_V_BUS];
+    s_buffer.v_on_time     = raw.v_on_time;
+    s_buffer.v_sample_ticks = t_sample - ((IFilter->delay_q8(FILTER_CH_V_A) * (t_sample - s_prev_sample_ticks)) >> 8);
+    s_prev_sample_ticks = t_sample;
+
+    s_new_data_ready = true;
+
+    IPerf->record(PERF_PROBE_ADC_JEOC, ITime->get_cycles() - t0);
+
+    Sim_FastLoop_OnInjectedConversion();
+}
+
+/* ========================================================================== */
+/* === Interface Implementation =========================================== */
+/* ========================================================================== */
+
+static bool sim_get_latest_measurements(motor_measurements_t *meas)
+{
+    if (!s_new_data_ready)
+        return false;
+
+    memcpy(meas, &s_buffer, sizeof(motor_measurements_t));
+    s_new_data_ready = false;
+    return true;
+}
+
+static i_motor_sensor_t s_sim_adc_interface = {
+    .get_latest_measurements = sim_get_latest_measurements
+};
+
+i_motor_sensor_t* IMotor_ADC_Measure = &s_sim_adc_interface;
+
+/* ========================================================================== */
+/* === Host API ============================================================ */
+/* ========================================================================== */
+
+void Sim_MotorSensor_SetSource(sim_adc_source_t source)
+{
+    s_source = source;
+}
+
+void Sim_MotorSensor_SetTrigger(uint32_t pos_cycles)
+{
+    if (!Sim_Event_IsArmed(SIM_EVENT_ADC_TRIGGER))
+        return;
+
+    /* Next occurrence of the new position (the current one if still ahead) */
+    uint32_t pos   = (uint32_t)(Sim_GetCycles() % SIM_PWM_PERIOD_CYCLES);
+    uint32_t delay = (pos_cycles + SIM_PWM_PERIOD_CYCLES - pos) % SIM_PWM_PERIOD_CYCLES;
+    if (delay == 0U)
+        delay = SIM_PWM_PERIOD_CYCLES;
+
+    Sim_Event_Arm(SIM_EVENT_ADC_TRIGGER, delay, SIM_PWM_PERIOD_CYCLES, sim_adc_on_injected_eoc);
+}
+
+void Sim_MotorSensor_Start(void)
+{
+    s_filter_init    = false;
+    s_new_data_ready = false;
+    Sim_Event_Arm(SIM_EVENT_ADC_TRIGGER, SIM_ADC_TRIGGER_CYCLES, SIM_PWM_PERIOD_CYCLES, sim_adc_on_injected_eoc);
+}
@@ -0,0 +1,164 @@
+/**
+ * @file test_bemf_demag_sim.c
+ * @brief Post-commutation demagnetisation blanking of the BEMF monitor (ADC
+ *        backend) against the BLDC plant model, under heavy load.
+ *
+ * The rotor is driven in six-step at the ideal commutation angles at a duty
+ * well above the BEMF. After each commutation the released phase first reads
+ * as an already crossed BEMF (clamped by the freewheeling diode, then the
+ * voltage filter settling from the level it was driven to), and swings back
+ * across the neutral in the wrong direction. Without the commutation
+ * notifications the monitor reports some of these as zero-crosses; with
+ * them it waits for the end of the clamping and the blanking window, and
+ * reports exactly the real crossing of every step.
+ */
+
+#include "control.h"
+#include "i_time.h"
+#include "service_bemf_monitor.h"
+#include "service_bldc_motor.h"
+#include "sim_bldc_plant.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define TEST_SPEED_RAD_S    314.159265f     /**< 3000 rpm mechanical */
+#define TEST_START_RAD      0.55f           /**< θe ≈ 31.5°: start of step 0 */
+#define TEST_DUTY           0.45f           /**< ≈ 5.4 V against ≈ 3.3 V line BEMF */
+#define TEST_RUN_MS         60U
+#define TEST_POLL_CYCLES    150U            /**< Commutation / polling granularity: 1 µs */
+#define TEST_MAX_ERR_US     20.0f
+#define TEST_REAL_ZC_US     100.0f          /**< Farther from the crossing: not a real ZC */
+
+#define TEST_DEG_PER_RAD    57.2957795f
+
+typedef struct {
+    uint32_t steps;
+    uint32_t zc_count;                      /**< Reported ZCs at the real crossing */
+    uint32_t false_count;                   /**< Reported ZCs anywhere else */
+    float    max_err_us;
+    float    max_current_a;
+    float    ideal_period_us;               /**< 60° period at the end of the run */
+    bemf_status_t status;
+} test_result_t;
+
+static float test_wrap180(float deg)
+{
+    deg = fmodf(deg + 180.0f, 360.0f);
+    return (deg < 0.0f) ? deg + 180.0f : deg - 180.0f;
+}
+
+/** CW six-step k is ideal over θe ∈ [30° + 60k, 90° + 60k), floating ZC at its middle */
+static uint8_t test_step_at(float theta_e_rad)
+{
+    float deg = fmodf(theta_e_rad * TEST_DEG_PER_RAD - 30.0f + 360.0f, 360.0f);
+    return (uint8_t)((uint8_t)(deg / 60.0f) % 6U);
+}
+
+/** Error of the reported ZC time to the geometric crossing of step @p step [µs] */
+static float test_zc_error_us(uint8_t step)
+{
+    sim_bldc_state_t st;
+    Sim_BLDC_GetState(&st);
+
+    float omega_e_deg_us = st.omega_m_rad_s * 6.0f * TEST_DEG_PER_RAD * 1e-6f;
+    float behind_deg = test_wrap180(st.theta_e_rad * TEST_DEG_PER_RAD - (60.0f + 60.0f * (float)step));
+    uint32_t now_us = ITime->get_time_us();
+
+    return (float)(int32_t)(SBemfMonitor->get_last_zc_time_us() - now_us) + behind_deg / omega_e_deg_us;
+}
+
+/** Drive the rotor at constant speed, with or without commutation notifications */
+static void test_run(bool notify, test_result_t *res)
+{
+    *res = (test_result_t){ 0 };
+
+    SBemfMonitor->reset();
+    Sim_BLDC_SetRotor(TEST_START_RAD, TEST_SPEED_RAD_S);
+
+    uint8_t step = 0xFFU;
+    s_motor_phase_t floating = S_MOTOR_PHASE_A;
+    uint64_t t_end = Sim_GetCycles() + (uint64_t)TEST_RUN_MS * 1000U * SIM_CYCLES_PER_US;
+
+    while (Sim_GetCycles() < t_end)
+    {
+        Sim_RunCycles(TEST_POLL_CYCLES);
+
+        sim_bldc_state_t st;
+        Sim_BLDC_GetState(&st);
+        for (int ph = 0; ph < PHASE_COUNT; ph++)
+            res->max_current_a = fmaxf(res->max_current_a, fabsf(st.i_a[ph]));
+
+        uint8_t k = test_step_at(st.theta_e_rad);
+        if (k != step)
+        {
+            step = k;
+            floating = (s_motor_phase_t)Inverter_SixStepCommutate(k, TEST_DUTY, true);
+            if (notify)
+                SBemfMonitor->commutated(floating, (k & 1U) != 0U);
+            res->steps++;
+        }
+
+        SBemfMonitor->process(floating);
+        SBemfMonitor->get_status(&res->status);
+        if (!res->status.zero_cross_detected)
+            continue;
+
+        SBemfMonitor->clear_flag();
+
+        float err_us = test_zc_error_us(step);
+        if (fabsf(err_us) > TEST_REAL_ZC_US)
+        {
+            res->false_count++;
+            continue;
+        }
+
+        res->max_err_us = fmaxf(res->max_err_us, fabsf(err_us));
+        res->zc_count++;
+    }
+
+    sim_bldc_state_t st;
+    Sim_BLDC_GetState(&st);
+    res->ideal_period_us = 1e6f / (6.0f * st.omega_m_rad_s * 6.0f / 6.28318531f);
+}
+
+int main(void)
+{
+    /* No Control_Motor_Init(): the test is the only consumer of the ADC samples */
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+
+    sim_bldc_params_t params;
+    Sim_BLDC_DefaultParams(&params);
+    Sim_BLDC_Attach(&params);
+    SIM_CHECK(SBemfMonitor->init());
+
+    test_result_t res;
+
+    /* --- Without commutation notifications: demag spikes taken for ZCs --- */
+    test_run(false, &res);
+    printf("unblanked: %lu steps, %lu zero-crosses, %lu false, peak %.1f A\n",
+           (unsigned long)res.steps, (unsigned long)res.zc_count,
+           (unsigned long)res.false_count, res.max_current_a);
+    SIM_CHECK(res.false_count > 0U);
+
+    /* --- Blanked: one zero-cross per step, at the real crossing --- */
+    test_run(true, &res);
+    printf("blanked:   %lu steps, %lu zero-crosses, %lu false, max error %.1f us, "
+           "period %.1f us (ideal %.1f us)\n",
+           (unsigned long)res.steps, (unsigned long)res.zc_count, (unsigned long)res.false_count,
+           res.max_err_us, res.status.period_us, res.ideal_period_us);
+    SIM_CHECK(res.steps > 40U);
+    SIM_CHECK(res.false_count == 0U);
+    SIM_CHECK(res.zc_count + 4U >= res.steps);  // First ZC per phase bootstraps, last step may still run
+    SIM_CHECK(res.status.valid);
+    SIM_CHECK(res.max_err_us < TEST_MAX_ERR_US);
+    SIM_CHECK(fabsf(res.status.period_us - res.ideal_period_us) < 0.02f * res.ideal_period_us);
+
+    Sim_BLDC_Detach();
+
+    return Sim_Test_Summary(__FILE__);
+}
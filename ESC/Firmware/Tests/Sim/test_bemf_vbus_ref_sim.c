@@ -0,0 +1,166 @@
+/**
+ * @file test_bemf_vbus_ref_sim.c
+ * @brief Vbus/2 zero-cross reference of the BEMF monitor (ADC backend) at
+ *        low duty and low speed, against the BLDC plant model.
+ *
+ * The bus voltage is sampled on the same trigger as the phase voltages, at
+ * the centre of the PWM on-time, where the star point of the six-step drive
+ * sits at Vbus/2. First the measurement path is checked (bus sample at the
+ * phase divider scale, on-time flag following the bridge state), then the
+ * rotor is driven at the ideal commutation angles with a duty just above
+ * the BEMF: every step must give exactly one zero-cross at the geometric
+ * crossing, with a BEMF slope of a few millivolts per sample.
+ */
+
+#include "control.h"
+#include "i_inverter.h"
+#include "i_motor_sensor.h"
+#include "i_time.h"
+#include "service_bemf_monitor.h"
+#include "service_bldc_motor.h"
+#include "sim_bldc_plant.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define TEST_SPEED_RAD_S    104.719755f     /**< 1000 rpm mechanical */
+#define TEST_START_RAD      0.0917f         /**< θe ≈ 31.5°: start of step 0 */
+#define TEST_DUTY           0.12f           /**< ≈ 1.4 V against ≈ 1.1 V line BEMF */
+#define TEST_RUN_MS         120U
+#define TEST_POLL_CYCLES    150U            /**< Commutation / polling granularity: 1 µs */
+#define TEST_MAX_ERR_US     20.0f
+#define TEST_REAL_ZC_US     200.0f          /**< Farther from the crossing: not a real ZC */
+
+#define TEST_DEG_PER_RAD    57.2957795f
+#define TEST_ADC_LSB_V      (3.3f / 4095.0f)
+
+static float test_wrap180(float deg)
+{
+    deg = fmodf(deg + 180.0f, 360.0f);
+    return (deg < 0.0f) ? deg + 180.0f : deg - 180.0f;
+}
+
+/** CW six-step k is ideal over θe ∈ [30° + 60k, 90° + 60k), floating ZC at its middle */
+static uint8_t test_step_at(float theta_e_rad)
+{
+    float deg = fmodf(theta_e_rad * TEST_DEG_PER_RAD - 30.0f + 360.0f, 360.0f);
+    return (uint8_t)((uint8_t)(deg / 60.0f) % 6U);
+}
+
+/** Ideal zero-cross time of step @p step, from the plant angle and speed */
+static float test_ideal_zc_us(uint8_t step, uint32_t now_us)
+{
+    sim_bldc_state_t st;
+    Sim_BLDC_GetState(&st);
+
+    float omega_e_deg_us = st.omega_m_rad_s * 6.0f * TEST_DEG_PER_RAD * 1e-6f;
+    float behind_deg = test_wrap180(st.theta_e_rad * TEST_DEG_PER_RAD - (60.0f + 60.0f * (float)step));
+    return (float)now_us - behind_deg / omega_e_deg_us;
+}
+
+/** Latest measurement set after one more PWM period */
+static motor_measurements_t test_next_measurement(void)
+{
+    motor_measurements_t meas = { 0 };
+
+    Sim_RunCycles(SIM_PWM_PERIOD_CYCLES);
+    SIM_CHECK(IMotor_ADC_Measure->get_latest_measurements(&meas));
+    return meas;
+}
+
+int main(void)
+{
+    /* No Control_Motor_Init(): the test is the only consumer of the ADC samples */
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+
+    sim_bldc_params_t params;
+    Sim_BLDC_DefaultParams(&params);
+    Sim_BLDC_Attach(&params);
+
+    /* --- Measurement path: bus sample and on-time flag --- */
+    Sim_BLDC_SetRotor(TEST_START_RAD, 0.0f);
+
+    motor_measurements_t meas = test_next_measurement();
+    float vbus_v = (float)meas.v_bus_raw * TEST_ADC_LSB_V * params.v_divider_ratio;
+    printf("bus sample %u (%.2f V), bridge off: on-time %d\n",
+           (unsigned)meas.v_bus_raw, vbus_v, (int)meas.v_on_time);
+    SIM_CHECK(fabsf(vbus_v - params.vbus_v) < 0.05f);
+    SIM_CHECK(!meas.v_on_time);
+
+    (void)Inverter_SixStepCommutate(0U, TEST_DUTY, true);
+    (void)test_next_measurement();                      // Filter history of the bridge off
+    meas = test_next_measurement();
+    printf("bridge at %.0f %% duty: on-time %d\n", TEST_DUTY * 100.0f, (int)meas.v_on_time);
+    SIM_CHECK(meas.v_on_time);
+
+    IInverter->disable();
+
+    /* --- Zero-crosses at low duty and low speed --- */
+    SIM_CHECK(SBemfMonitor->init());
+    SBemfMonitor->reset();
+    Sim_BLDC_SetRotor(TEST_START_RAD, TEST_SPEED_RAD_S);
+
+    uint8_t  step = 0xFFU;
+    uint32_t steps = 0, zc_count = 0, false_count = 0;
+    float    max_err_us = 0.0f;
+    bemf_status_t status = { 0 };
+    s_motor_phase_t floating = S_MOTOR_PHASE_A;
+    uint64_t t_end = Sim_GetCycles() + (uint64_t)TEST_RUN_MS * 1000U * SIM_CYCLES_PER_US;
+
+    while (Sim_GetCycles() < t_end)
+    {
+        Sim_RunCycles(TEST_POLL_CYCLES);
+
+        sim_bldc_state_t st;
+        Sim_BLDC_GetState(&st);
+
+        uint8_t k = test_step_at(st.theta_e_rad);
+        if (k != step)
+        {
+            step = k;
+            floating = (s_motor_phase_t)Inverter_SixStepCommutate(k, TEST_DUTY, true);
+            SBemfMonitor->commutated(floating, (k & 1U) != 0U);
+            steps++;
+        }
+
+        SBemfMonitor->process(floating);
+        SBemfMonitor->get_status(&status);
+        if (!status.zero_cross_detected)
+            continue;
+
+        SIM_CHECK(status.floating_phase == floating);
+        SBemfMonitor->clear_flag();
+
+        uint32_t now_us = ITime->get_time_us();
+        float ideal_us = test_ideal_zc_us(step, now_us);
+        float err_us = (float)(int32_t)(SBemfMonitor->get_last_zc_time_us() - now_us) + ((float)now_us - ideal_us);
+        if (fabsf(err_us) > TEST_REAL_ZC_US)
+        {
+            false_count++;
+            continue;
+        }
+
+        if (fabsf(err_us) > max_err_us)
+            max_err_us = fabsf(err_us);
+        zc_count++;
+    }
+
+    sim_bldc_state_t st;
+    Sim_BLDC_GetState(&st);
+    printf("%lu steps, %lu zero-crosses (+ %lu false), max error %.1f us, speed %.0f rpm\n",
+           (unsigned long)steps, (unsigned long)zc_count, (unsigned long)false_count,
+           max_err_us, st.rpm);
+
+    SIM_CHECK(steps > 30U);
+    SIM_CHECK(false_count == 0U);
+    SIM_CHECK(zc_count + 4U >= steps);      // First ZC per phase bootstraps, last step may still run
+    SIM_CHECK(max_err_us < TEST_MAX_ERR_US);
+
+    Sim_BLDC_Detach();
+
+    return Sim_Test_Summary(__FILE__);
+}
@@ -0,0 +1,143 @@
+/**
+ * @file test_bldc_plant_sim.c
+ * @brief Six-step start-up sequence against the BLDC plant model.
+ *
+ * The plant feeds the ADC with terminal voltages and shunt currents, so
+ * Motor_FastLoop, the BEMF monitor and the open→closed loop handover run on
+ * physically generated waveforms. The test checks the plant physics
+ * (alignment angle and current, current decay after stop) and bounds the
+ * start-up metrics: time-to-lock, speed settling and closed-loop
+ * commutation error. A reversal restarts the other way and must reach
+ * closed loop as well.
+ */
+
+#include "control.h"
+#include "control_six_step.h"
+#include "sim_bldc_plant.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define TEST_SPEED_RPM      3000.0f
+#define TEST_ALIGN_MS       500U        /**< Matches Control_Motor_SetSpeed_RPM */
+#define TEST_RUN_MS         3000U
+#define TEST_SETTLE_BAND    0.10f       /**< ±10 % of command */
+#define TEST_REVERSE_MS     10000U      /**< Coast down to the restart speed, align, ramp */
+#define TEST_STALE_RPM      150.0f      /**< Restart ramp: measured speed at most this above the rotor's */
+#define TEST_CL_SETTLE_MS   200U        /**< After the handover: commutation error counted from here */
+#define TEST_MAX_LOCK_MS    1000U       /**< Handover before the ramp ends */
+#define TEST_MAX_SETTLE_MS  1200U       /**< Within TEST_SETTLE_BAND, for good */
+#define TEST_MEAN_ERR_DEG   10.0f       /**< Closed loop: mean |commutation error| */
+#define TEST_MAX_ERR_DEG    15.0f       /**< Closed loop: worst commutation, well inside a 60° step */
+
+int main(void)
+{
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+    Control_Motor_Init();
+
+    sim_bldc_params_t params;
+    Sim_BLDC_DefaultParams(&params);
+    Sim_BLDC_Attach(&params);
+
+    sim_bldc_state_t st;
+    sim_bldc_comm_stats_t cs;
+
+    /* --- Alignment: A sources, B sinks → rotor settles near θe = 150° --- */
+    Control_Motor_SetSpeed_RPM(TEST_SPEED_RPM);
+    Sim_Run_ms(TEST_ALIGN_MS - 10U);
+    Sim_BLDC_GetState(&st);
+
+    float align_deg = st.theta_e_rad * (180.0f / 3.14159265f);
+    float align_i   = 0.10f * params.vbus_v / (2.0f * params.r_phase_ohm);
+    printf("align: theta_e %.1f deg, i_a %.2f A (expected %.2f A)\n", align_deg, st.i_a[PHASE_A], align_i);
+    SIM_CHECK(align_deg > 120.0f && align_deg < 180.0f);
+    SIM_CHECK(fabsf(st.i_a[PHASE_A] - align_i) < 0.2f * align_i);
+    SIM_CHECK(fabsf(st.i_a[PHASE_A] + st.i_a[PHASE_B]) < 1.0f);
+
+    /* --- Start-up: open-loop ramp, handover, closed loop --- */
+    Sim_Run_ms(10U);
+    Sim_BLDC_ResetCommutationStats();
+
+    int32_t lock_ms = -1;
+    int32_t settle_ms = -1;
+    float max_rpm = 0.0f;
+
+    for (uint32_t ms = 0; ms < TEST_RUN_MS; ms++)
+    {
+        Sim_Run_ms(1U);
+        Sim_BLDC_GetState(&st);
+
+        if (fabsf(st.rpm) > max_rpm)
+            max_rpm = fabsf(st.rpm);
+
+        if (lock_ms < 0 && Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP)
+            lock_ms = (int32_t)ms;
+
+        /* Commutation error of the closed loop: counted once the handover step is past */
+        if (lock_ms >= 0 && ms == (uint32_t)lock_ms + TEST_CL_SETTLE_MS)
+            Sim_BLDC_ResetCommutationStats();
+
+        bool in_band = fabsf(st.rpm - TEST_SPEED_RPM) < TEST_SETTLE_BAND * TEST_SPEED_RPM;
+        if (!in_band)
+            settle_ms = -1;
+        else if (settle_ms < 0)
+            settle_ms = (int32_t)ms;
+
+        if ((ms + 1U) % 250U == 0U)
+        {
+            printf("%4u ms: mode %d, %7.1f rpm, i %6.2f %6.2f %6.2f A\n",
+                   (unsigned)(ms + 1U), (int)Control_Motor_GetMode(), st.rpm,
+                   st.i_a[PHASE_A], st.i_a[PHASE_B], st.i_a[PHASE_C]);
+        }
+    }
+
+    Sim_BLDC_GetCommutationStats(&cs);
+    printf("time-to-lock: %ld ms, settled (±%.0f %%): %ld ms, final %.1f rpm, peak %.1f rpm\n",
+           (long)lock_ms, TEST_SETTLE_BAND * 100.0f, (long)settle_ms, st.rpm, max_rpm);
+    printf("closed-loop commutation error: %lu comm., mean %.1f deg, mean |err| %.1f deg, max |err| %.1f deg\n",
+           (unsigned long)cs.count, cs.mean_deg, cs.mean_abs_deg, cs.max_abs_deg);
+
+    SIM_CHECK(lock_ms >= 0 && lock_ms < (int32_t)TEST_MAX_LOCK_MS);
+    SIM_CHECK(settle_ms >= 0 && settle_ms < (int32_t)TEST_MAX_SETTLE_MS);
+    SIM_CHECK(fabsf(st.rpm - TEST_SPEED_RPM) < TEST_SETTLE_BAND * TEST_SPEED_RPM);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP);
+    SIM_CHECK(cs.count > 1000U);
+    SIM_CHECK(cs.mean_abs_deg < TEST_MEAN_ERR_DEG);
+    SIM_CHECK(cs.max_abs_deg < TEST_MAX_ERR_DEG);
+
+    /* --- Reversal: coast down, re-align, ramp the other way up to closed loop --- */
+    Control_Motor_SetSpeed_RPM(-TEST_SPEED_RPM);
+    int32_t rev_ms = -1;
+    float stale_rpm = 0.0f;                     // Ramp: measured speed above the rotor's
+    for (uint32_t ms = 0; ms < TEST_REVERSE_MS && rev_ms < 0; ms++)
+    {
+        Sim_Run_ms(1U);
+        Sim_BLDC_GetState(&st);
+        if (Control_Motor_GetMode() == CONTROL_MOTOR_MODE_OPEN_LOOP)
+            stale_rpm = fmaxf(stale_rpm, fabsf(Control_Motor_GetMeasuredSpeed_RPM()) - fabsf(st.rpm));
+        if (Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP && Control_Motor_GetMeasuredSpeed_RPM() < 0.0f)
+            rev_ms = (int32_t)ms;
+    }
+    Sim_Run_ms(1000U);
+    Sim_BLDC_GetState(&st);
+    printf("reversal: closed loop CCW after %ld ms, %.1f rpm 1 s later, ramp: measured speed over by %.0f rpm at most\n",
+           (long)rev_ms, st.rpm, stale_rpm);
+    SIM_CHECK(rev_ms >= 0);
+    SIM_CHECK(stale_rpm < TEST_STALE_RPM);
+    SIM_CHECK(fabsf(st.rpm + TEST_SPEED_RPM) < TEST_SETTLE_BAND * TEST_SPEED_RPM);
+
+    /* --- Stop: all phases Hi-Z, currents decay through the body diodes --- */
+    Control_Motor_Stop();
+    Sim_Run_ms(5U);
+    Sim_BLDC_GetState(&st);
+    SIM_CHECK(fabsf(st.i_a[PHASE_A]) < 0.01f);
+    SIM_CHECK(fabsf(st.i_a[PHASE_B]) < 0.01f);
+    SIM_CHECK(fabsf(st.i_a[PHASE_C]) < 0.01f);
+
+    Sim_BLDC_Detach();
+
+    return Sim_Test_Summary(__FILE__);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file test_comm_advance_sim.c
+ * @brief Commutation advance map (service_comm_advance): interpolation,
+ *        live tuning over the debug protocol and auto-calibration.
+ *
+ * The calibration is run against a synthetic operating point whose phase
+ * current is a parabola of the advance: the sweep must store its minimum
+ * in the nearest cell, overriding the lookup while it runs.
+ */
+
+#include "control.h"
+#include "control_six_step.h"
+#include "service_comm_advance.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_CAL_SPEED_HZ     480.0f      /**< Nearest speed breakpoint: 500 Hz (row 3) */
+#define TEST_CAL_CURRENT_A    9.0f        /**< Nearest current breakpoint: 10 A (column 2) */
+#define TEST_OPT_DEG          13.3f       /**< Advance of minimum current */
+
+static char s_out[4096];
+
+/** Synthetic phase current at the operating point for a given advance */
+static float test_current_a(float advance_deg)
+{
+    float d = advance_deg - TEST_OPT_DEG;
+    return TEST_CAL_CURRENT_A + 0.02f * d * d;
+}
+
+static void test_command(const char *line)
+{
+    Sim_Comm_ReadOutput(s_out, sizeof(s_out));
+    SIM_CHECK(Sim_Comm_InjectLine(line));
+    command_handler_debug_process();
+    Sim_Comm_ReadOutput(s_out, sizeof(s_out));
+    printf("%s", s_out);
+}
+
+int main(void)
+{
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+    Control_Motor_Init();
+
+    /* --- Lookup: breakpoints, bilinear interpolation, clamping --- */
+    float cell;
+    SIM_CHECK(Service_CommAdvance_GetCell(3U, 2U, &cell));
+    SIM_CHECK(fabsf(Service_CommAdvance_Get(500.0f, 10.0f) - cell) < 1e-4f);
+
+    SIM_CHECK(Service_CommAdvance_SetCell(1U, 1U, 2.0f) && Service_CommAdvance_SetCell(1U, 2U, 4.0f));
+    SIM_CHECK(Service_CommAdvance_SetCell(2U, 1U, 6.0f) && Service_CommAdvance_SetCell(2U, 2U, 12.0f));
+    float mid = Service_CommAdvance_Get(175.0f, 7.5f);            // Centre of the cell: mean of the corners
+    SIM_CHECK(fabsf(mid - 6.0f) < 1e-4f);
+
+    float top;
+    SIM_CHECK(Service_CommAdvance_GetCell(COMM_ADV_SPEED_POINTS - 1U, COMM_ADV_CURRENT_POINTS - 1U, &top));
+    SIM_CHECK(Service_CommAdvance_Get(5000.0f, 100.0f) == top);
+    SIM_CHECK(Service_CommAdvance_Get(-10.0f, -1.0f) == 0.0f);
+
+    SIM_CHECK(!Service_CommAdvance_SetCell(COMM_ADV_SPEED_POINTS, 0U, 5.0f));
+    SIM_CHECK(!Service_CommAdvance_SetCell(0U, 0U, COMM_ADV_MAX_DEG + 1.0f));
+    SIM_CHECK(!Service_CommAdvance_SetCell(0U, 0U, -1.0f));
+
+    /* --- Live tuning over the debug protocol --- */
+    test_command("advset 4 3 17.5");
+    SIM_CHECK(Service_CommAdvance_GetCell(4U, 3U, &cell) && fabsf(cell - 17.5f) < 1e-4f);
+    test_command("advset 4 3 18");
+    SIM_CHECK(Service_CommAdvance_GetCell(4U, 3U, &cell) && cell == 18.0f);
+    test_command("advset 9 3 5");
+    SIM_CHECK(strstr(s_out, "Invalid cell") != NULL);
+    test_command("advget");
+    SIM_CHECK(strstr(s_out, "18.0") != NULL);
+    test_command("advcal");
+    SIM_CHECK(strstr(s_out, "closed loop") != NULL);           // Motor stopped: refused
+    SIM_CHECK(!Service_CommAdvance_CalActive());
+
+    /* --- Auto-calibration: minimum-current advance of the nearest cell --- */
+    SIM_CHECK(Service_CommAdvance_CalStart(TEST_CAL_SPEED_HZ, TEST_CAL_CURRENT_A));
+    SIM_CHECK(!Service_CommAdvance_CalStart(TEST_CAL_SPEED_HZ, TEST_CAL_CURRENT_A));
+
+    uint32_t ms = 0;
+    float max_adv = 0.0f;
+    while (Service_CommAdvance_CalActive() && ms < 10000U)
+    {
+        float adv = Service_CommAdvance_Get(TEST_CAL_SPEED_HZ, TEST_CAL_CURRENT_A);   // Sweep override
+        max_adv = fmaxf(max_adv, adv);
+        Service_CommAdvance_CalTick(TEST_CAL_SPEED_HZ, test_current_a(adv));
+        ms++;
+    }
+
+    SIM_CHECK(Service_CommAdvance_GetCell(3U, 2U, &cell));
+    printf("calibration: %lu ms, sweep up to %.1f deg, cell [3][2] = %.2f deg (optimum %.2f)\n",
+           (unsigned long)ms, max_adv, cell, TEST_OPT_DEG);
+    SIM_CHECK(!Service_CommAdvance_CalActive());
+    SIM_CHECK(max_adv > TEST_OPT_DEG);
+    SIM_CHECK(fabsf(cell - TEST_OPT_DEG) < 0.1f);
+    SIM_CHECK(fabsf(Service_CommAdvance_Get(500.0f, 10.0f) - cell) < 1e-4f);
+
+    /* --- Speed drift: aborted, table unchanged --- */
+    SIM_CHECK(Service_CommAdvance_CalStart(TEST_CAL_SPEED_HZ, TEST_CAL_CURRENT_A));
+    Service_CommAdvance_CalTick(TEST_CAL_SPEED_HZ, TEST_CAL_CURRENT_A);
+    Service_CommAdvance_CalTick(2.0f * TEST_CAL_SPEED_HZ, TEST_CAL_CURRENT_A);
+    SIM_CHECK(!Service_CommAdvance_CalActive());
+    float after;
+    SIM_CHECK(Service_CommAdvance_GetCell(3U, 2U, &after) && after == cell);
+
+    return Sim_Test_Summary(__FILE__);
+}
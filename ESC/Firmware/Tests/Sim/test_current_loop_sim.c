@@ -0,0 +1,171 @@
+/**
+ * @file test_current_loop_sim.c
+ * @brief Six-step cascade (speed PI → current PI → duty) against the BLDC plant.
+ *
+ * The rotor is caught spinning, then:
+ *  - speed mode: the speed is held, and a load step is absorbed by the
+ *    current loop (bounded current, speed back on target)
+ *  - torque mode: the current of the driven pair follows the command, the
+ *    speed is left to the load; set over the debug protocol as well
+ *  - torque mode is refused while the FOC drive is selected
+ */
+
+#include "control.h"
+#include "control_drive.h"
+#include "control_six_step.h"
+#include "sim_bldc_plant.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_RPM            3000.0f     /**< 300 Hz electrical */
+#define TEST_LOAD_NM        0.02f       /**< Load step (about 2 A more in the pair) */
+#define TEST_TICK_US        42U         /**< About one PWM period */
+
+static char s_out[4096];
+
+static float test_rad_s(float rpm)
+{
+    return rpm * (2.0f * 3.14159265f / 60.0f);
+}
+
+/**
+ * @brief Current of the driven pair: the largest phase current (the one
+ *        entering through the high side).
+ */
+static float test_pair_current(const sim_bldc_state_t *st)
+{
+    float i = st->i_a[0];
+    for (uint32_t p = 1; p < PHASE_COUNT; p++)
+        i = fmaxf(i, st->i_a[p]);
+    return i;
+}
+
+/**
+ * @brief Run @p ms, recording the mean and peak pair current.
+ */
+static void test_run(uint32_t ms, float *mean_a, float *peak_a)
+{
+    sim_bldc_state_t st;
+    uint32_t n = (ms * 1000U) / TEST_TICK_US;
+    float sum = 0.0f, peak = 0.0f;
+
+    for (uint32_t k = 0; k < n; k++)
+    {
+        Sim_Run_us(TEST_TICK_US);
+        Sim_BLDC_GetState(&st);
+        float i = test_pair_current(&st);
+        sum += i;
+        peak = fmaxf(peak, i);
+    }
+
+    *mean_a = sum / (float)n;
+    *peak_a = peak;
+}
+
+static void test_command(const char *line)
+{
+    Sim_Comm_ReadOutput(s_out, sizeof(s_out));
+    SIM_CHECK(Sim_Comm_InjectLine(line));
+    command_handler_debug_process();
+    Sim_Comm_ReadOutput(s_out, sizeof(s_out));
+    printf("%s", s_out);
+}
+
+/** Catch the rotor spinning at TEST_RPM in speed mode */
+static void test_start(void)
+{
+    Sim_BLDC_SetRotor(1.0f, test_rad_s(TEST_RPM));
+    Control_Motor_SetSpeed_RPM(TEST_RPM);
+    for (uint32_t ms = 0; ms < 40U && Control_Motor_GetMode() != CONTROL_MOTOR_MODE_CLOSED_LOOP; ms++)
+        Sim_Run_ms(1U);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP);
+}
+
+int main(void)
+{
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+    Control_Motor_Init();
+
+    sim_bldc_params_t params;
+    Sim_BLDC_DefaultParams(&params);
+    Sim_BLDC_Attach(&params);
+
+    sim_bldc_state_t st;
+    control_motor_desync_stats_t ds;
+    float mean, peak;
+
+    /* --- Speed mode: held on target --- */
+    test_start();
+    test_run(300U, &mean, &peak);
+    Sim_BLDC_GetState(&st);
+    printf("speed: %.0f rpm, pair current mean %.2f A, peak %.2f A\n", st.rpm, mean, peak);
+    SIM_CHECK(fabsf(st.rpm - TEST_RPM) < 0.03f * TEST_RPM);
+
+    /* --- Load step: current bounded, speed recovered --- */
+    float before = mean;
+    Sim_BLDC_SetLoadTorque(TEST_LOAD_NM);
+    test_run(50U, &mean, &peak);
+    Sim_BLDC_GetState(&st);
+    printf("load step: %.0f rpm after 50 ms, pair current peak %.2f A\n", st.rpm, peak);
+    SIM_CHECK(peak < 1.5f * CONTROL_MOTOR_CURRENT_MAX_A);
+    SIM_CHECK(st.rpm > 0.8f * TEST_RPM);
+
+    test_run(400U, &mean, &peak);
+    Sim_BLDC_GetState(&st);
+    printf("loaded: %.0f rpm, pair current mean %.2f A (%.2f A unloaded)\n", st.rpm, mean, before);
+    SIM_CHECK(fabsf(st.rpm - TEST_RPM) < 0.03f * TEST_RPM);
+    SIM_CHECK(mean > before + 0.5f);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP);
+
+    /* --- Torque mode: pair current on the command, speed left to the load --- */
+    const float cmd[] = { 3.0f, 5.0f };
+    float rpm_at[2];
+    for (uint32_t i = 0; i < 2U; i++)
+    {
+        Control_Motor_SetTorqueCurrent_A(cmd[i]);
+        test_run(300U, &mean, &peak);                   // Settle
+        test_run(100U, &mean, &peak);
+        Sim_BLDC_GetState(&st);
+        rpm_at[i] = st.rpm;
+        printf("torque %.1f A: pair current mean %.2f A, %.0f rpm\n", cmd[i], mean, st.rpm);
+        SIM_CHECK(fabsf(mean - cmd[i]) < 0.25f * cmd[i]);
+        SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP);
+    }
+    SIM_CHECK(rpm_at[1] > rpm_at[0] + 100.0f);
+
+    /* --- Debug protocol: settorque --- */
+    test_command("settorque 3.0");
+    SIM_CHECK(strstr(s_out, "3000 mA") != NULL);
+    test_run(300U, &mean, &peak);
+    test_run(100U, &mean, &peak);
+    printf("settorque 3.0: pair current mean %.2f A\n", mean);
+    SIM_CHECK(fabsf(mean - 3.0f) < 0.75f);
+    test_command("settorque 100");
+    SIM_CHECK(strstr(s_out, "Invalid current") != NULL);
+
+    /* --- Back to speed mode without a torque step --- */
+    Control_Motor_SetSpeed_RPM(TEST_RPM);
+    test_run(500U, &mean, &peak);
+    Sim_BLDC_GetState(&st);
+    printf("speed again: %.0f rpm\n", st.rpm);
+    SIM_CHECK(fabsf(st.rpm - TEST_RPM) < 0.03f * TEST_RPM);
+
+    Control_Motor_GetDesyncStats(&ds);
+    SIM_CHECK(ds.events == 0U);
+
+    Control_Motor_Stop();
+
+    /* --- FOC drive: no torque mode --- */
+    SIM_CHECK(Control_Drive_Select(CONTROL_DRIVE_FOC));
+    SIM_CHECK(!Control_Drive_SetTorqueCurrent_A(2.0f));
+    test_command("settorque 2");
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_STOPPED);
+    SIM_CHECK(Control_Drive_Select(CONTROL_DRIVE_SIX_STEP));
+
+    return Sim_Test_Summary(__FILE__);
+}
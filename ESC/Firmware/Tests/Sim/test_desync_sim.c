@@ -0,0 +1,172 @@
+/**
+ * @file test_desync_sim.c
+ * @brief Desync detector (service_desync) and re-sync ramp.
+ *
+ * Zero-cross streams and current traces are generated synthetically:
+ *  - a steady / accelerating rotor and a single noisy edge must not trip
+ *  - stopped crossings (stale period), repeated period jumps, crossings
+ *    drifting off their window and a current spike must trip, with the
+ *    right cause and within a bounded time
+ * The re-sync ramp must start from the requested step at the requested
+ * frequency, and the recovery policy / counters must be reachable.
+ */
+
+#include "control.h"
+#include "control_six_step.h"
+#include "service_bldc_motor.h"
+#include "service_desync.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define TEST_PERIOD_US      500.0f      /**< 333 Hz electrical */
+#define TEST_TICK_US        (1e6f / 24000.0f)
+#define TEST_CURRENT_A      4.0f
+
+/**
+ * @brief Run fast-loop ticks from @p t0_us to @p t1_us, feeding crossings
+ *        every @p period_us from @p zc_us on (none if period is 0).
+ *
+ * @return Cause of the first trip, with its time in @p trip_us
+ */
+static desync_cause_t test_run(desync_detector_t *d, float t0_us, float t1_us,
+                               float zc_us, float period_us, float current_a, float *trip_us)
+{
+    for (float t = t0_us; t < t1_us; t += TEST_TICK_US)
+    {
+        desync_cause_t cause = DESYNC_NONE;
+        if (period_us > 0.0f && t >= zc_us)
+        {
+            cause = Service_Desync_OnZeroCross(d, (uint32_t)zc_us);
+            zc_us += period_us;
+        }
+        if (cause == DESYNC_NONE)
+            cause = Service_Desync_Tick(d, (uint32_t)t, current_a);
+        if (cause != DESYNC_NONE)
+        {
+            *trip_us = t;
+            return cause;
+        }
+    }
+    return DESYNC_NONE;
+}
+
+int main(void)
+{
+    desync_detector_t d;
+    float trip_us = 0.0f;
+    Service_Desync_Init(&d);
+
+    /* --- Disarmed: never trips --- */
+    SIM_CHECK(Service_Desync_Tick(&d, 1000000U, 100.0f) == DESYNC_NONE);
+
+    /* --- Steady rotor: in sync --- */
+    Service_Desync_Arm(&d, 1000U, TEST_PERIOD_US, TEST_CURRENT_A);
+    SIM_CHECK(test_run(&d, 1000.0f, 101000.0f, 1000.0f + TEST_PERIOD_US, TEST_PERIOD_US, TEST_CURRENT_A, &trip_us) == DESYNC_NONE);
+
+    /* --- Acceleration: 1 % shorter period per crossing --- */
+    Service_Desync_Arm(&d, 1000U, TEST_PERIOD_US, TEST_CURRENT_A);
+    float zc = 1000.0f, period = TEST_PERIOD_US;
+    desync_cause_t cause = DESYNC_NONE;
+    for (int k = 0; k < 100 && cause == DESYNC_NONE; k++)
+    {
+        period *= 0.99f;
+        zc += period;
+        cause = Service_Desync_OnZeroCross(&d, (uint32_t)zc);
+    }
+    SIM_CHECK(cause == DESYNC_NONE);
+    SIM_CHECK(fabsf(d.period_us - period) < 0.05f * period);
+
+    /* --- Single noisy edge (mid-step), taken instead of that step's crossing --- */
+    Service_Desync_Arm(&d, 1000U, TEST_PERIOD_US, TEST_CURRENT_A);
+    for (int k = 1; k <= 10; k++)
+        SIM_CHECK(Service_Desync_OnZeroCross(&d, (uint32_t)(1000.0f + TEST_PERIOD_US * (float)k)) == DESYNC_NONE);
+    SIM_CHECK(Service_Desync_OnZeroCross(&d, (uint32_t)(1000.0f + TEST_PERIOD_US * 10.5f)) == DESYNC_NONE);
+    SIM_CHECK(Service_Desync_OnZeroCross(&d, (uint32_t)(1000.0f + TEST_PERIOD_US * 12.0f)) == DESYNC_NONE);
+    SIM_CHECK(Service_Desync_OnZeroCross(&d, (uint32_t)(1000.0f + TEST_PERIOD_US * 13.0f)) == DESYNC_NONE);
+    SIM_CHECK(d.strikes == 0U && d.armed);
+
+    /* --- Crossings stop: stale period, tripped within 2.5 periods --- */
+    Service_Desync_Arm(&d, 1000U, TEST_PERIOD_US, TEST_CURRENT_A);
+    cause = test_run(&d, 1000.0f, 101000.0f, 1000.0f + TEST_PERIOD_US, TEST_PERIOD_US, TEST_CURRENT_A, &trip_us);
+    SIM_CHECK(cause == DESYNC_NONE);
+    float last_zc = (float)d.last_zc_us;
+    cause = test_run(&d, 101000.0f, 201000.0f, 0.0f, 0.0f, TEST_CURRENT_A, &trip_us);
+    printf("ZC stop: %s after %.0f us\n", Service_Desync_CauseName(cause), trip_us - last_zc);
+    SIM_CHECK(cause == DESYNC_ZC_TIMEOUT);
+    SIM_CHECK(trip_us - last_zc <= 2.5f * TEST_PERIOD_US + TEST_TICK_US);
+    SIM_CHECK(!d.armed);
+
+    /* --- Period halves (rotor slipping a pole): jump after two events --- */
+    Service_Desync_Arm(&d, 1000U, TEST_PERIOD_US, TEST_CURRENT_A);
+    for (int k = 1; k <= 4; k++)
+        (void)Service_Desync_OnZeroCross(&d, (uint32_t)(1000.0f + TEST_PERIOD_US * (float)k));
+    zc = 1000.0f + 4.0f * TEST_PERIOD_US;
+    SIM_CHECK(Service_Desync_OnZeroCross(&d, (uint32_t)(zc += 0.4f * TEST_PERIOD_US)) == DESYNC_NONE);
+    cause = Service_Desync_OnZeroCross(&d, (uint32_t)(zc += 0.4f * TEST_PERIOD_US));
+    SIM_CHECK(cause == DESYNC_PERIOD_JUMP);
+
+    /* --- Crossings drifting off their window: three misses --- */
+    Service_Desync_Arm(&d, 1000U, TEST_PERIOD_US, TEST_CURRENT_A);
+    for (int k = 1; k <= 4; k++)
+        (void)Service_Desync_OnZeroCross(&d, (uint32_t)(1000.0f + TEST_PERIOD_US * (float)k));
+    zc = 1000.0f + 4.0f * TEST_PERIOD_US;
+    cause = DESYNC_NONE;
+    int misses = 0;
+    while (cause == DESYNC_NONE && misses < 10)
+    {
+        cause = Service_Desync_OnZeroCross(&d, (uint32_t)(zc += 1.5f * TEST_PERIOD_US));
+        misses++;
+    }
+    SIM_CHECK(cause == DESYNC_ZC_WINDOW && misses == 3);
+
+    /* --- Current spike: tripped after 0.5 ms, slow rise tolerated --- */
+    Service_Desync_Arm(&d, 1000U, TEST_PERIOD_US, TEST_CURRENT_A);
+    cause = DESYNC_NONE;
+    float t = 1000.0f, i = TEST_CURRENT_A;
+    for (; t < 101000.0f && cause == DESYNC_NONE; t += TEST_TICK_US)
+    {
+        i = TEST_CURRENT_A + 4.0f * (t - 1000.0f) / 100000.0f;     // +4 A over 100 ms
+        d.last_zc_us = (uint32_t)t;                                 // Crossings on time
+        cause = Service_Desync_Tick(&d, (uint32_t)t, i);
+    }
+    SIM_CHECK(cause == DESYNC_NONE);
+
+    float t_spike = t;
+    for (; t < t_spike + 5000.0f && cause == DESYNC_NONE; t += TEST_TICK_US)
+    {
+        d.last_zc_us = (uint32_t)t;
+        cause = Service_Desync_Tick(&d, (uint32_t)t, 30.0f);
+    }
+    printf("current spike: %s after %.0f us\n", Service_Desync_CauseName(cause), t - t_spike);
+    SIM_CHECK(cause == DESYNC_CURRENT_SPIKE);
+    SIM_CHECK(t - t_spike < 600.0f);
+
+    /* --- Re-sync ramp: from the given step, constant frequency --- */
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+    Control_Motor_Init();
+
+    uint8_t step;
+    float duty;
+    bool cw;
+    Service_Motor_OpenLoopRamp_Resync(3U, 0.4f, 300.0f, 50U, true, NULL, NULL);
+    Service_Motor_OpenLoopRamp_GetState(&step, &duty, &cw);
+    SIM_CHECK(step == 3U && duty == 0.4f && cw);
+
+    Sim_Run_us((uint32_t)(1000000.0f / (6.0f * 300.0f) * 2.5f));   // Two more steps
+    Service_Motor_OpenLoopRamp_GetState(&step, &duty, &cw);
+    SIM_CHECK(step == 5U && duty == 0.4f);
+    Service_Motor_Stop();
+
+    /* --- Policy and counters reachable --- */
+    control_motor_desync_policy_t policy = { .enabled = false, .max_resyncs = 1, .max_restarts = 1, .stable_ms = 100 };
+    Control_Motor_SetDesyncPolicy(&policy);
+    control_motor_desync_stats_t stats;
+    Control_Motor_GetDesyncStats(&stats);
+    SIM_CHECK(stats.events == 0U && stats.recovered == 0U);
+
+    return Sim_Test_Summary(__FILE__);
+}
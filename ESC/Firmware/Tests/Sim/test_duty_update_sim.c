@@ -0,0 +1,107 @@
+/**
+ * @file test_duty_update_sim.c
+ * @brief Preload-synchronized duty updates of the virtual TIM1 (IInverter).
+ *
+ * Compare values written through set_duty_ticks() (or the float setters)
+ * must reach the PWM together, exactly at the next update event (counter
+ * overflow with RCR = 1, mid off-time), never in the middle of a period.
+ */
+
+#include "control.h"
+#include "i_inverter.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+static uint32_t s_change_count;
+static uint64_t s_change_at;
+
+static void test_observer(sim_inverter_change_t when)
+{
+    if (when == SIM_INVERTER_POST_CHANGE)
+    {
+        s_change_count++;
+        s_change_at = Sim_GetCycles();
+    }
+}
+
+/** Run to position @p pos (cycles) of the next PWM period */
+static void test_goto_pwm_position(uint32_t pos)
+{
+    uint32_t now = (uint32_t)(Sim_GetCycles() % SIM_PWM_PERIOD_CYCLES);
+
+    Sim_RunCycles((SIM_PWM_PERIOD_CYCLES - now) + pos);
+}
+
+static bool test_applied_ticks(uint16_t a, uint16_t b, uint16_t c)
+{
+    sim_inverter_state_t inv;
+
+    Sim_Inverter_GetState(&inv);
+    return inv.duty[PHASE_A] == (float)a / (float)SIM_PWM_PERIOD_TICKS &&
+           inv.duty[PHASE_B] == (float)b / (float)SIM_PWM_PERIOD_TICKS &&
+           inv.duty[PHASE_C] == (float)c / (float)SIM_PWM_PERIOD_TICKS;
+}
+
+int main(void)
+{
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    Sim_Inverter_SetObserver(test_observer);
+
+    uint16_t period = IInverter->get_period_ticks();
+    SIM_CHECK(period == SIM_PWM_PERIOD_TICKS);
+
+    /* --- Out of range / NULL rejected --- */
+    SIM_CHECK(!IInverter->set_duty_ticks(NULL));
+    SIM_CHECK(!IInverter->set_duty_ticks(&(inverter_ticks_t){ .compare = { 0U, (uint16_t)(period + 1U), 0U } }));
+
+    /* --- Written mid-period, applied together at the counter overflow --- */
+    test_goto_pwm_position(1000U);
+    s_change_count = 0;
+    uint64_t t_write = Sim_GetCycles();
+    SIM_CHECK(IInverter->set_duty_ticks(&(inverter_ticks_t){ .compare = { 100U, 200U, 300U } }));
+
+    inverter_duty_t duties;
+    SIM_CHECK(IInverter->get_duties(&duties));
+    SIM_CHECK(duties.phase_duty[PHASE_B] == 200.0f / (float)SIM_PWM_PERIOD_TICKS);
+    SIM_CHECK(!test_applied_ticks(100U, 200U, 300U));
+
+    Sim_RunCycles(SIM_PWM_UPDATE_CYCLES - 1000U - 1U);
+    SIM_CHECK(s_change_count == 0U);
+    Sim_RunCycles(1U);
+    SIM_CHECK(s_change_count == 1U);
+    SIM_CHECK(s_change_at == t_write + (SIM_PWM_UPDATE_CYCLES - 1000U));
+    SIM_CHECK(s_change_at % SIM_PWM_PERIOD_CYCLES == SIM_PWM_UPDATE_CYCLES);
+    SIM_CHECK(test_applied_ticks(100U, 200U, 300U));
+
+    /* --- Several writes in one period: one transfer, last values win --- */
+    test_goto_pwm_position(200U);
+    s_change_count = 0;
+    IInverter->set_duty_ticks(&(inverter_ticks_t){ .compare = { 10U, 20U, 30U } });
+    Sim_RunCycles(500U);
+    IInverter->set_all_duties(&(inverter_duty_t){ .phase_duty = { 0.2f, 0.4f, 0.6f } });
+    Sim_RunCycles(500U);
+    IInverter->set_duty_ticks(&(inverter_ticks_t){ .compare = { 400U, 500U, 625U } });
+    Sim_RunCycles(SIM_PWM_PERIOD_CYCLES);
+    SIM_CHECK(s_change_count == 1U);
+    SIM_CHECK(s_change_at % SIM_PWM_PERIOD_CYCLES == SIM_PWM_UPDATE_CYCLES);
+    SIM_CHECK(test_applied_ticks(400U, 500U, 625U));
+
+    /* --- Written after the overflow: waits for the next period --- */
+    test_goto_pwm_position(SIM_PWM_UPDATE_CYCLES + 100U);
+    s_change_count = 0;
+    t_write = Sim_GetCycles();
+    IInverter->set_phase_duty(PHASE_C, 0.0f);
+    Sim_RunCycles(SIM_PWM_PERIOD_CYCLES - 101U);
+    SIM_CHECK(s_change_count == 0U);
+    Sim_RunCycles(1U);
+    SIM_CHECK(s_change_count == 1U);
+    SIM_CHECK(s_change_at == t_write + SIM_PWM_PERIOD_CYCLES - 100U);
+    SIM_CHECK(test_applied_ticks(400U, 500U, 0U));
+
+    Sim_Inverter_SetObserver(NULL);
+
+    return Sim_Test_Summary(__FILE__);
+}
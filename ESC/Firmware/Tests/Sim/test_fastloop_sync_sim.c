@@ -0,0 +1,77 @@
+/**
+ * @file test_fastloop_sync_sim.c
+ * @brief Fast loop executed from the injected ADC end-of-conversion.
+ *
+ * With FASTLOOP_SYNC_TO_ADC the fast-loop callback must run once per PWM
+ * period, at the ADC trigger phase, and always find the sample of the
+ * current period in IMotor_ADC_Measure (no missing / stale data).
+ */
+
+#include "control.h"
+#include "i_motor_sensor.h"
+#include "i_perf.h"
+#include "service_loop.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <stdio.h>
+
+static uint32_t s_ticks;
+static uint32_t s_fresh;
+static uint32_t s_off_phase;
+
+static void test_fastloop_cb(void)
+{
+    motor_measurements_t meas;
+
+    s_ticks++;
+    if (IMotor_ADC_Measure->get_latest_measurements(&meas))
+        s_fresh++;
+    if (Sim_GetCycles() % SIM_PWM_PERIOD_CYCLES != SIM_ADC_TRIGGER_CYCLES)
+        s_off_phase++;
+}
+
+int main(void)
+{
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+
+    SIM_CHECK(SFastLoop->init());
+    SFastLoop->register_callback(test_fastloop_cb);
+
+    /* Loop rate follows TIM1 */
+    SIM_CHECK(SFastLoop->get_frequency_hz() == SIM_CPU_FREQ_HZ / SIM_PWM_PERIOD_CYCLES);
+
+    perf_probe_stats_t fast, jeoc;
+
+    /* --- Running: one tick per conversion, phase-locked, always fresh --- */
+    IPerf->reset();
+    SFastLoop->start();
+    Sim_Run_ms(100);
+
+    IPerf->get_stats(PERF_PROBE_FASTLOOP, &fast);
+    IPerf->get_stats(PERF_PROBE_ADC_JEOC, &jeoc);
+    printf("ticks %lu, fresh %lu, off-phase %lu, JEOC %lu\n",
+           (unsigned long)s_ticks, (unsigned long)s_fresh,
+           (unsigned long)s_off_phase, (unsigned long)jeoc.count);
+
+    SIM_CHECK(s_ticks >= 2399U && s_ticks <= 2400U);
+    SIM_CHECK(s_fresh == s_ticks);
+    SIM_CHECK(s_off_phase == 0U);
+    SIM_CHECK(fast.count == s_ticks);
+    SIM_CHECK(jeoc.count == s_ticks);
+
+    /* TIM3 is not used any more */
+    SIM_CHECK(!Sim_Event_IsArmed(SIM_EVENT_FASTLOOP));
+
+    /* --- Stopped: conversions go on, the callback does not --- */
+    SFastLoop->stop();
+    uint32_t ticks = s_ticks;
+    Sim_Run_ms(10);
+    IPerf->get_stats(PERF_PROBE_ADC_JEOC, &jeoc);
+
+    SIM_CHECK(s_ticks == ticks);
+    SIM_CHECK(jeoc.count > fast.count);
+
+    return Sim_Test_Summary(__FILE__);
+}
@@ -0,0 +1,255 @@
+/**
+ * @file test_filter_sim.c
+ * @brief ADC channel filters (FMAC front end over its software model).
+ *
+ *  - frequency response of first- and second-order sections against the
+ *    analog prototypes (sine sweep, gain measured in steady state)
+ *  - exact unity DC gain, start in steady state, full-scale input, step
+ *    settling within the truncation dead band (±1 count)
+ *  - default sections equal to the former shift IIRs, sample for sample
+ *  - group delay of a ramp, invalid settings rejected
+ */
+
+#include "i_filter.h"
+#include "service_filter.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_PI             3.14159265358979
+#define TEST_FS_HZ          24000.0
+#define TEST_MID            2048.0
+#define TEST_AMPLITUDE      1500.0
+
+/**
+ * @brief Frequency actually applied: a whole number of samples per period.
+ */
+static double actual_freq(double freq_hz)
+{
+    return TEST_FS_HZ / (double)(uint32_t)(TEST_FS_HZ / freq_hz + 0.5);
+}
+
+/**
+ * @brief Gain of channel I_A at @p freq_hz: sine around mid-scale, settled,
+ * amplitude from the projection on sin/cos over whole periods.
+ */
+static double measure_gain(double freq_hz)
+{
+    uint16_t raw[FILTER_CH_COUNT], out[FILTER_CH_COUNT];
+    const uint32_t settle = 4800U;
+    const uint32_t period = (uint32_t)(TEST_FS_HZ / freq_hz + 0.5);
+    const uint32_t n      = period * (uint32_t)(2400U / period + 1U);
+    double ps = 0.0, pc = 0.0;
+
+    IFilter->reset();
+
+    for (uint32_t k = 0; k < settle + n; k++)
+    {
+        double w = 2.0 * TEST_PI * (double)k / (double)period;
+        for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+            raw[ch] = (uint16_t)(TEST_MID + TEST_AMPLITUDE * sin(w) + 0.5);
+
+        IFilter->process(raw, out);
+
+        if (k >= settle)
+        {
+            ps += ((double)out[FILTER_CH_I_A] - TEST_MID) * sin(w);
+            pc += ((double)out[FILTER_CH_I_A] - TEST_MID) * cos(w);
+        }
+    }
+
+    return 2.0 * sqrt(ps * ps + pc * pc) / (double)n / TEST_AMPLITUDE;
+}
+
+static void test_response_lowpass2(void)
+{
+    const double fc = 1000.0;
+    const double f[] = { 100.0, 500.0, 1000.0, 2000.0, 4000.0 };
+    double worst = 0.0;
+
+    SIM_CHECK(IFilter->configure(FILTER_CH_I_A, FILTER_TYPE_LOWPASS2, (float)fc));
+
+    /* Bilinear Butterworth: |H|² = 1 / (1 + (tan(πf/fs) / tan(πfc/fs))^4) */
+    for (uint32_t i = 0; i < sizeof(f) / sizeof(f[0]); i++)
+    {
+        double fa  = actual_freq(f[i]);
+        double r   = tan(TEST_PI * fa / TEST_FS_HZ) / tan(TEST_PI * fc / TEST_FS_HZ);
+        double ref = 1.0 / sqrt(1.0 + r * r * r * r);
+        double g   = measure_gain(fa);
+        double err = fabs(20.0 * log10(g / ref));
+
+        printf("lowpass2 %.0f Hz: %.4f (%.4f)\n", fa, g, ref);
+        if (err > worst) worst = err;
+    }
+    SIM_CHECK(worst < 0.1);                         // dB
+
+    /* -3 dB at the cutoff */
+    double g = measure_gain(fc);
+    SIM_CHECK(fabs(20.0 * log10(g) + 3.01) < 0.1);
+}
+
+static void test_response_lowpass1(void)
+{
+    const double fc = 500.0;
+    const double f[] = { 100.0, 500.0, 2000.0, 6000.0 };
+    double worst = 0.0;
+
+    SIM_CHECK(IFilter->configure(FILTER_CH_I_A, FILTER_TYPE_LOWPASS1, (float)fc));
+
+    /* y += (1 - p)(x - y), p set for -3 dB at fc */
+    double c = cos(2.0 * TEST_PI * fc / TEST_FS_HZ);
+    double p = (2.0 - c) - sqrt((2.0 - c) * (2.0 - c) - 1.0);
+
+    for (uint32_t i = 0; i < sizeof(f) / sizeof(f[0]); i++)
+    {
+        double fa  = actual_freq(f[i]);
+        double cw  = cos(2.0 * TEST_PI * fa / TEST_FS_HZ);
+        double ref = (1.0 - p) / sqrt(1.0 - 2.0 * p * cw + p * p);
+        double g   = measure_gain(fa);
+        double err = fabs(20.0 * log10(g / ref));
+
+        printf("lowpass1 %.0f Hz: %.4f (%.4f)\n", fa, g, ref);
+        if (err > worst) worst = err;
+    }
+    SIM_CHECK(worst < 0.1);
+}
+
+static void test_dc_and_range(void)
+{
+    uint16_t raw[FILTER_CH_COUNT], out[FILTER_CH_COUNT];
+    const uint16_t levels[] = { 0U, 1U, 1234U, 4095U };
+
+    SIM_CHECK(IFilter->configure(FILTER_CH_I_A, FILTER_TYPE_LOWPASS2, 800.0f));
+
+    for (uint32_t i = 0; i < sizeof(levels) / sizeof(levels[0]); i++)
+    {
+        uint32_t mismatch = 0;
+
+        /* Starts in steady state: exact from the first sample on */
+        IFilter->reset();
+        for (uint32_t k = 0; k < 2000U; k++)
+        {
+            for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+                raw[ch] = levels[i];
+            IFilter->process(raw, out);
+            for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+                if (out[ch] != levels[i]) mismatch++;
+        }
+        SIM_CHECK(mismatch == 0U);
+    }
+
+    /* Steps up and down settle within the dead band */
+    const uint16_t steps[][2] = { { 100U, 3900U }, { 3900U, 100U }, { 2000U, 2003U }, { 2003U, 2000U } };
+    for (uint32_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+    {
+        IFilter->reset();
+        for (uint32_t k = 0; k < 4800U; k++)
+        {
+            for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+                raw[ch] = (k == 0U) ? steps[i][0] : steps[i][1];
+            IFilter->process(raw, out);
+        }
+        for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+            SIM_CHECK(abs((int)out[ch] - (int)steps[i][1]) <= 1);
+    }
+}
+
+/**
+ * @brief The default sections are the former shift IIRs (α = 5 on currents,
+ * 1 on voltages): y = y - y/2^α + x, output y >> α.
+ */
+static void test_defaults_match_shift_iir(void)
+{
+    uint16_t raw[FILTER_CH_COUNT], out[FILTER_CH_COUNT];
+    uint32_t filt[FILTER_CH_COUNT];
+    uint32_t worst = 0;
+    uint32_t seed  = 12345U;
+
+    SIM_CHECK(IFilter->configure(FILTER_CH_I_A, FILTER_TYPE_LOWPASS1, 121.28f));
+    IFilter->reset();
+
+    for (uint32_t k = 0; k < 48000U; k++)
+    {
+        for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+        {
+            seed = seed * 1103515245U + 12345U;
+            double w = 2.0 * TEST_PI * 300.0 * (double)k / TEST_FS_HZ;
+            raw[ch] = (uint16_t)(TEST_MID + 1200.0 * sin(w + ch) + (double)((seed >> 16) % 400U) - 200.0);
+        }
+
+        IFilter->process(raw, out);
+
+        for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+        {
+            uint32_t alpha = (ch <= FILTER_CH_I_B) ? 5U : 1U;
+            if (k == 0U)
+                filt[ch] = (uint32_t)raw[ch] << alpha;
+            filt[ch] = filt[ch] - (filt[ch] >> alpha) + raw[ch];
+
+            uint32_t ref = filt[ch] >> alpha;
+            uint32_t d   = (out[ch] > ref) ? (out[ch] - ref) : (ref - out[ch]);
+            if (d > worst) worst = d;
+        }
+    }
+    printf("defaults vs shift IIR: max deviation %u count(s)\n", worst);
+    SIM_CHECK(worst <= 1U);
+
+    /* Same group delay as before on the voltages: 2^α - 1 = 1 sample */
+    SIM_CHECK(IFilter->delay_q8(FILTER_CH_V_A) == 256U);
+    SIM_CHECK(IFilter->delay_q8(FILTER_CH_I_A) == 31U * 256U);
+}
+
+static void test_delay(void)
+{
+    uint16_t raw[FILTER_CH_COUNT], out[FILTER_CH_COUNT];
+
+    SIM_CHECK(Service_Filter_Configure(SERVICE_FILTER_VOLTAGE_A, SERVICE_FILTER_LOWPASS2, 2000.0f));
+    double delay = (double)Service_Filter_GetDelay(SERVICE_FILTER_VOLTAGE_A);
+
+    /* Ramp of 1 count per sample: the output trails by the group delay */
+    IFilter->reset();
+    for (uint32_t k = 0; k < 3000U; k++)
+    {
+        for (uint32_t ch = 0; ch < FILTER_CH_COUNT; ch++)
+            raw[ch] = (uint16_t)(500U + k);
+        IFilter->process(raw, out);
+    }
+    double lag = (double)(500U + 2999U) - (double)out[FILTER_CH_V_A];
+    printf("lowpass2 2 kHz: group delay %.3f, ramp lag %.1f\n", delay, lag);
+    SIM_CHECK(delay > 1.0 && delay < 3.0);
+    SIM_CHECK(fabs(lag - delay) <= 1.0);            // Output truncated to whole counts
+
+    SIM_CHECK(Service_Filter_Configure(SERVICE_FILTER_VOLTAGE_A, SERVICE_FILTER_BYPASS, 0.0f));
+    SIM_CHECK(Service_Filter_GetDelay(SERVICE_FILTER_VOLTAGE_A) == 0.0f);
+    IFilter->process(raw, out);
+    SIM_CHECK(out[FILTER_CH_V_A] == raw[FILTER_CH_V_A]);
+}
+
+static void test_invalid(void)
+{
+    SIM_CHECK(!IFilter->configure(FILTER_CH_I_B, FILTER_TYPE_LOWPASS2, 0.0f));
+    SIM_CHECK(!IFilter->configure(FILTER_CH_I_B, FILTER_TYPE_LOWPASS2, 12000.0f));
+    SIM_CHECK(!IFilter->configure(FILTER_CH_I_B, FILTER_TYPE_LOWPASS1, -5.0f));
+    SIM_CHECK(!IFilter->configure(FILTER_CH_COUNT, FILTER_TYPE_LOWPASS1, 100.0f));
+    SIM_CHECK(!IFilter->configure(FILTER_CH_I_B, FILTER_TYPE_LOWPASS2, 500.0f));   // Dead band above ±1 count
+    SIM_CHECK(!IFilter->configure(FILTER_CH_I_B, FILTER_TYPE_LOWPASS1, 100.0f));
+
+    /* Rejected settings leave the channel as it was */
+    SIM_CHECK(IFilter->delay_q8(FILTER_CH_I_B) == 31U * 256U);
+}
+
+int main(void)
+{
+    SIM_CHECK(IFilter->init());
+
+    test_defaults_match_shift_iir();
+    test_response_lowpass2();
+    test_response_lowpass1();
+    test_dc_and_range();
+    test_delay();
+    test_invalid();
+
+    return Sim_Test_Summary(__FILE__);
+}
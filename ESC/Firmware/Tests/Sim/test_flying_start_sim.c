@@ -0,0 +1,135 @@
+/**
+ * @file test_flying_start_sim.c
+ * @brief Flying start against the BLDC plant model.
+ *
+ * The rotor is set spinning before the start command (windmilling prop):
+ *  - in the commanded direction it must be caught from the coasting BEMF
+ *    and driven in closed loop within a few electrical turns, without
+ *    alignment, with correctly timed commutations
+ *  - at rest, or turning the other way, the start falls back to
+ *    alignment + ramp after the listening time; from rest the ramp hands
+ *    over to closed loop on the commanded speed
+ */
+
+#include "control.h"
+#include "control_drive.h"
+#include "control_six_step.h"
+#include "sim_bldc_plant.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define TEST_RPM            3000.0f     /**< 300 Hz electrical */
+#define TEST_LISTEN_MS      40U         /**< CATCH_LISTEN_MS */
+#define TEST_SETTLE_MS      2U          /**< Entry step (applied mid-window) left out of the stats */
+#define TEST_MAX_LOCK_MS    1000U       /**< Start from rest: handover within the open-loop ramp */
+#define TEST_RAMP_SETTLE_MS 500U        /**< Start from rest: speed on the command after this */
+
+static float test_rad_s(float rpm)
+{
+    return rpm * (2.0f * 3.14159265f / 60.0f);
+}
+
+/** Run until closed loop (1 ms steps); returns the time [ms], -1 if never */
+static int test_time_to_closed_loop(uint32_t max_ms)
+{
+    for (uint32_t ms = 0; ms < max_ms; ms++)
+    {
+        if (Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP)
+            return (int)ms;
+        Sim_Run_ms(1U);
+    }
+    return -1;
+}
+
+int main(void)
+{
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+    Control_Motor_Init();
+
+    sim_bldc_params_t params;
+    Sim_BLDC_DefaultParams(&params);
+    Sim_BLDC_Attach(&params);
+
+    sim_bldc_state_t st;
+    sim_bldc_comm_stats_t cs;
+
+    /* --- Windmilling in the commanded direction: caught in closed loop --- */
+    Sim_BLDC_SetRotor(1.0f, test_rad_s(TEST_RPM));
+    Control_Motor_SetSpeed_RPM(TEST_RPM);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CATCHING);
+
+    int catch_ms = test_time_to_closed_loop(TEST_LISTEN_MS);
+    Sim_Run_ms(TEST_SETTLE_MS);
+    Sim_BLDC_ResetCommutationStats();
+    Sim_Run_ms(20U);
+    Sim_BLDC_GetCommutationStats(&cs);
+    Sim_BLDC_GetState(&st);
+
+    printf("caught: %d ms, %.0f rpm after 20 ms, commutation error mean %.1f deg, max |err| %.1f deg (%lu comm.)\n",
+           catch_ms, st.rpm, cs.mean_deg, cs.max_abs_deg, (unsigned long)cs.count);
+    SIM_CHECK(catch_ms >= 0 && catch_ms < 15);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP);
+    SIM_CHECK(st.rpm > 0.8f * TEST_RPM);
+    SIM_CHECK(fabsf(Control_Drive_GetSpeed_RPM() - st.rpm) < 0.05f * TEST_RPM);
+    SIM_CHECK(cs.count > 30U);                                  // 36 steps in 20 ms at 300 Hz
+    SIM_CHECK(cs.max_abs_deg < 20.0f);
+
+    Control_Motor_Stop();
+
+    SIM_CHECK(Control_Drive_GetSpeed_RPM() == 0.0f);
+
+    /* --- Rotor at rest: alignment after the listening time --- */
+    Sim_BLDC_SetRotor(1.0f, 0.0f);
+    Control_Motor_SetSpeed_RPM(TEST_RPM);
+    Sim_Run_ms(TEST_LISTEN_MS / 2U);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CATCHING);
+    Sim_Run_ms(TEST_LISTEN_MS);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_STOPPED);   // Aligning
+    Sim_Run_ms(500U);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_OPEN_LOOP);
+
+    int lock_ms = test_time_to_closed_loop(TEST_MAX_LOCK_MS);
+    Sim_Run_ms(TEST_RAMP_SETTLE_MS);
+    Sim_BLDC_GetState(&st);
+    printf("from rest: closed loop %d ms into the ramp, %.0f rpm %u ms later\n",
+           lock_ms, st.rpm, (unsigned)TEST_RAMP_SETTLE_MS);
+    SIM_CHECK(lock_ms >= 0);
+    SIM_CHECK(fabsf(st.rpm - TEST_RPM) < 0.1f * TEST_RPM);
+
+    Control_Motor_Stop();
+
+    /* --- Turning backwards: not driven, alignment instead --- */
+    Sim_BLDC_SetRotor(1.0f, -test_rad_s(TEST_RPM));
+    Control_Motor_SetSpeed_RPM(TEST_RPM);
+    Sim_Run_ms(TEST_LISTEN_MS + 5U);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_STOPPED);
+
+    Control_Motor_Stop();
+
+    /* --- Windmilling CCW, commanded CCW --- */
+    Sim_BLDC_SetRotor(4.0f, -test_rad_s(TEST_RPM));
+    Control_Motor_SetSpeed_RPM(-TEST_RPM);
+    catch_ms = test_time_to_closed_loop(TEST_LISTEN_MS);
+    Sim_Run_ms(TEST_SETTLE_MS);
+    Sim_BLDC_ResetCommutationStats();
+    Sim_Run_ms(20U);
+    Sim_BLDC_GetCommutationStats(&cs);
+    Sim_BLDC_GetState(&st);
+
+    printf("caught CCW: %d ms, %.0f rpm after 20 ms, max |err| %.1f deg (%lu comm.)\n",
+           catch_ms, st.rpm, cs.max_abs_deg, (unsigned long)cs.count);
+    SIM_CHECK(catch_ms >= 0 && catch_ms < 15);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP);
+    SIM_CHECK(st.rpm < -0.8f * TEST_RPM);
+    SIM_CHECK(fabsf(Control_Drive_GetSpeed_RPM() - st.rpm) < 0.05f * TEST_RPM);   // Signed like FOC
+    SIM_CHECK(cs.count > 30U);
+    SIM_CHECK(cs.max_abs_deg < 20.0f);
+
+    Control_Motor_Stop();
+
+    return Sim_Test_Summary(__FILE__);
+}
@@ -0,0 +1,159 @@
+/**
+ * @file test_foc_sim.c
+ * @brief Sensorless FOC against the BLDC plant model.
+ *
+ *  - transforms, duties of a known vector
+ *  - from standstill: alignment, I/f start and switch to the observer;
+ *    the speed loop then holds the target, with the observer angle on the
+ *    rotor angle and no more current than the light-load minimum
+ *  - reversal (brake, restart CCW) and stop on a zero command
+ *  - runtime drive selection: refused while turning, six-step usable again
+ *    after FOC (flying start)
+ */
+
+#include "control.h"
+#include "control_drive.h"
+#include "control_foc.h"
+#include "control_six_step.h"
+#include "service_foc.h"
+#include "service_modulator.h"
+#include "sim_bldc_plant.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define TEST_RPM            3000.0f
+#define TEST_PI             3.14159265f
+
+/** Run until RUNNING (1 ms steps); returns the time [ms], -1 if never */
+static int test_time_to_running(uint32_t max_ms)
+{
+    for (uint32_t ms = 0; ms < max_ms; ms++)
+    {
+        if (Control_Foc_GetMode() == CONTROL_FOC_MODE_RUNNING)
+            return (int)ms;
+        Sim_Run_ms(1U);
+    }
+    return -1;
+}
+
+/** Observer angle minus plant angle [°, -180 – 180], worst over @p ms */
+static float test_max_angle_error(uint32_t ms, float *mean_out)
+{
+    float worst = 0.0f, sum = 0.0f;
+
+    for (uint32_t k = 0; k < ms * 4U; k++)
+    {
+        sim_bldc_state_t st;
+        control_foc_state_t fs;
+
+        Sim_Run_us(250U);
+        Sim_BLDC_GetState(&st);
+        Control_Foc_GetState(&fs);
+
+        float err = fs.theta_deg - st.theta_e_rad * (180.0f / TEST_PI);
+        err = fmodf(err + 540.0f, 360.0f) - 180.0f;
+        sum += err;
+        if (fabsf(err) > fabsf(worst))
+            worst = err;
+    }
+    *mean_out = sum / (float)(ms * 4U);
+    return worst;
+}
+
+static void test_transforms(void)
+{
+    /* Balanced currents 1 A at 30°: i_a = cos 30°, i_b = cos(30° - 120°) */
+    foc_ab_t ab = Service_Foc_Clarke(cosf(TEST_PI / 6.0f), cosf(-TEST_PI / 2.0f));
+    SIM_CHECK(fabsf(ab.alpha - cosf(TEST_PI / 6.0f)) < 1e-4f);
+    SIM_CHECK(fabsf(ab.beta  - sinf(TEST_PI / 6.0f)) < 1e-4f);
+
+    /* In the frame at 30° the vector is all d */
+    foc_dq_t dq = Service_Foc_Park(&ab, sinf(TEST_PI / 6.0f), cosf(TEST_PI / 6.0f));
+    SIM_CHECK(fabsf(dq.d - 1.0f) < 1e-4f && fabsf(dq.q) < 1e-4f);
+
+    foc_ab_t back = Service_Foc_InvPark(&dq, sinf(TEST_PI / 6.0f), cosf(TEST_PI / 6.0f));
+    SIM_CHECK(fabsf(back.alpha - ab.alpha) < 1e-4f && fabsf(back.beta - ab.beta) < 1e-4f);
+
+    /* Duties reproduce the vector */
+    float duty[3];
+    Service_Modulator_AlphaBeta(3.0f, -2.0f, 12.0f, 0.85f, duty);
+    foc_ab_t v_out = Service_Foc_VoltageOfDuties(duty, 12.0f);
+    SIM_CHECK(fabsf(v_out.alpha - 3.0f) < 1e-3f && fabsf(v_out.beta + 2.0f) < 1e-3f);
+}
+
+int main(void)
+{
+    test_transforms();
+
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+    Control_Motor_Init();
+    Control_Foc_Init();
+
+    sim_bldc_params_t params;
+    Sim_BLDC_DefaultParams(&params);
+    Sim_BLDC_Attach(&params);
+
+    sim_bldc_state_t st;
+    control_foc_state_t fs;
+
+    /* --- Select FOC, start CW from standstill --- */
+    SIM_CHECK(Control_Drive_Select(CONTROL_DRIVE_FOC));
+    SIM_CHECK(Control_Drive_Get() == CONTROL_DRIVE_FOC);
+    Sim_BLDC_SetRotor(1.0f, 0.0f);
+    Control_Drive_SetSpeed_RPM(TEST_RPM);
+    SIM_CHECK(Control_Foc_GetMode() == CONTROL_FOC_MODE_ALIGNING);
+
+    int run_ms = test_time_to_running(600U);
+    Sim_BLDC_GetState(&st);
+    printf("CW: sensorless after %d ms at %.0f rpm\n", run_ms, st.rpm);
+    SIM_CHECK(run_ms > 0);
+
+    Sim_Run_ms(600U);
+    Sim_BLDC_GetState(&st);
+    Control_Foc_GetState(&fs);
+    float mean_err;
+    float max_err = test_max_angle_error(20U, &mean_err);
+    printf("CW: %.0f rpm (observer %.0f), Id %.2f A, Iq %.2f A, angle error mean %.1f deg max %.1f deg\n",
+           st.rpm, fs.speed_rpm, fs.i_d_a, fs.i_q_a, mean_err, max_err);
+    SIM_CHECK(Control_Foc_GetMode() == CONTROL_FOC_MODE_RUNNING);
+    SIM_CHECK(fabsf(st.rpm - TEST_RPM) < 0.03f * TEST_RPM);
+    SIM_CHECK(fabsf(Control_Drive_GetSpeed_RPM() - st.rpm) < 0.05f * TEST_RPM);
+    SIM_CHECK(fs.i_q_a > 0.0f);
+    SIM_CHECK(fs.i_d_a <= 0.0f && sqrtf(fs.i_d_a * fs.i_d_a + fs.i_q_a * fs.i_q_a) < 2.5f);   // Light load: minimum vector
+    SIM_CHECK(fabsf(mean_err) < 10.0f && fabsf(max_err) < 20.0f);
+
+    /* --- Drive selection refused while turning --- */
+    SIM_CHECK(!Control_Drive_Select(CONTROL_DRIVE_SIX_STEP));
+    SIM_CHECK(Control_Drive_Get() == CONTROL_DRIVE_FOC);
+
+    /* --- Reversal: slows down, restarts CCW --- */
+    Control_Drive_SetSpeed_RPM(-TEST_RPM);
+    Sim_Run_ms(2000U);
+    Sim_BLDC_GetState(&st);
+    printf("reversed: %.0f rpm, mode %d\n", st.rpm, (int)Control_Foc_GetMode());
+    SIM_CHECK(Control_Foc_GetMode() == CONTROL_FOC_MODE_RUNNING);
+    SIM_CHECK(fabsf(st.rpm + TEST_RPM) < 0.03f * TEST_RPM);
+
+    /* --- Zero command: decelerates, bridge off --- */
+    Control_Drive_SetSpeed_RPM(0.0f);
+    Sim_Run_ms(1500U);
+    SIM_CHECK(Control_Foc_GetMode() == CONTROL_FOC_MODE_STOPPED);
+
+    /* --- Back to six-step once stopped (caught windmilling) --- */
+    SIM_CHECK(Control_Drive_Select(CONTROL_DRIVE_SIX_STEP));
+    Sim_BLDC_SetRotor(1.0f, TEST_RPM * (2.0f * TEST_PI / 60.0f));
+    Control_Drive_SetSpeed_RPM(TEST_RPM);
+    Sim_Run_ms(500U);
+    Sim_BLDC_GetState(&st);
+    printf("six-step after FOC: %.0f rpm, mode %d\n", st.rpm, (int)Control_Motor_GetMode());
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP);
+    SIM_CHECK(st.rpm > 0.8f * TEST_RPM);
+
+    Control_Drive_Stop();
+
+    return Sim_Test_Summary(__FILE__);
+}
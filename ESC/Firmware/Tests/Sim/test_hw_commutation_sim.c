@@ -0,0 +1,205 @@
+/**
+ * @file test_hw_commutation_sim.c
+ * @brief Six-step commutation fast path and hardware-timed commutation
+ *        (TIM1 COM preload) on the virtual ESC.
+ *
+ * Every (step, direction) of the six_step() table must drive one phase
+ * high, one low, and report the Hi-Z one as floating phase.
+ * In INVERTER_COMM_PRELOAD mode the next pattern is preloaded and must
+ * reach the outputs exactly at the TIMER_EVENT_COMMUTATION deadline (TIM5
+ * TRGO → TIM1 COM), before the commutation callback runs; other timer
+ * events, cancelled deadlines and ISR-driven mode must leave it pending.
+ */
+
+#include "control.h"
+#include "i_inverter.h"
+#include "i_timer_sched.h"
+#include "service_bldc_motor.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define TEST_DUTY   0.3f
+
+static uint32_t s_change_count;
+static uint32_t s_change_at;
+
+static uint32_t s_cb_count;
+static uint32_t s_cb_at;
+static bool     s_cb_saw_step;
+static uint8_t  s_cb_step;
+
+static void test_observer(sim_inverter_change_t when)
+{
+    if (when == SIM_INVERTER_POST_CHANGE)
+    {
+        s_change_count++;
+        s_change_at = (uint32_t)Sim_GetCycles();
+    }
+}
+
+/** true if the outputs match CW six-step @p step */
+static bool test_outputs_are_step(uint8_t step)
+{
+    static const phase_output_state_t cw[6][PHASE_COUNT] = {
+        { STATE_PWM_HIGH, STATE_PWM_LOW,  STATE_HIZ      },
+        { STATE_PWM_HIGH, STATE_HIZ,      STATE_PWM_LOW  },
+        { STATE_HIZ,      STATE_PWM_HIGH, STATE_PWM_LOW  },
+        { STATE_PWM_LOW,  STATE_PWM_HIGH, STATE_HIZ      },
+        { STATE_PWM_LOW,  STATE_HIZ,      STATE_PWM_HIGH },
+        { STATE_HIZ,      STATE_PWM_LOW,  STATE_PWM_HIGH }
+    };
+    sim_inverter_state_t inv;
+
+    Sim_Inverter_GetState(&inv);
+    for (int ph = 0; ph < PHASE_COUNT; ph++)
+    {
+        if (inv.state[ph] != cw[step][ph])
+            return false;
+    }
+    return true;
+}
+
+/** Commutation callback: outputs already switched, preload the next step */
+static void test_commutation_cb(void *ctx)
+{
+    (void)ctx;
+    s_cb_count++;
+    s_cb_at       = ITimerSched->now();
+    s_cb_saw_step = test_outputs_are_step(s_cb_step);
+
+    s_cb_step = (uint8_t)((s_cb_step + 1U) % 6U);
+    Inverter_SixStepPreload(s_cb_step, TEST_DUTY, true);
+}
+
+static void test_nop_cb(void *ctx)
+{
+    (void)ctx;
+}
+
+static void test_clear(void)
+{
+    s_change_count = 0;
+    s_cb_count = 0;
+}
+
+int main(void)
+{
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+    Sim_Inverter_SetObserver(test_observer);
+
+    /* --- Six-step table: one high, one low, floating phase returned --- */
+    for (uint8_t dir = 0; dir < 2U; dir++)
+    {
+        uint8_t prev_floating = PHASE_COUNT;
+
+        for (uint8_t step = 0; step < 6U; step++)
+        {
+            uint8_t floating = Inverter_SixStepCommutate(step, TEST_DUTY, dir == 0U);
+            sim_inverter_state_t inv;
+            int high = 0, low = 0;
+
+            Sim_Inverter_GetState(&inv);
+            for (int ph = 0; ph < PHASE_COUNT; ph++)
+            {
+                high += (inv.state[ph] == STATE_PWM_HIGH);
+                low  += (inv.state[ph] == STATE_PWM_LOW);
+            }
+            SIM_CHECK(high == 1 && low == 1);
+            SIM_CHECK(floating < PHASE_COUNT && inv.state[floating] == STATE_HIZ);
+            SIM_CHECK(floating != prev_floating);
+            prev_floating = floating;
+        }
+    }
+    SIM_CHECK(Inverter_SixStepCommutate(6U, TEST_DUTY, true) == PHASE_COUNT);
+    SIM_CHECK(Inverter_SixStepCommutate(0U, 1.5f, true) == PHASE_COUNT);
+
+    /* --- ISR-driven step 0, then preload step 1 --- */
+    Inverter_SixStepCommutate(0U, TEST_DUTY, true);
+    SIM_CHECK(test_outputs_are_step(0U));
+
+    const phase_output_state_t step1[PHASE_COUNT] = { STATE_PWM_HIGH, STATE_HIZ, STATE_PWM_LOW };
+    SIM_CHECK(!IInverter->preload_output_states(step1));        // IMMEDIATE mode
+
+    SIM_CHECK(Service_Motor_SetHwCommutation(true));
+    s_cb_step = 1U;
+    Inverter_SixStepPreload(1U, TEST_DUTY, true);
+
+    /* --- Other timer events leave the pattern pending --- */
+    test_clear();
+    uint32_t t0 = ITimerSched->now();
+    ITimerSched->start(TIMER_EVENT_AUX1, 300U, test_nop_cb, NULL);
+    Sim_RunCycles(1000U);
+    SIM_CHECK(test_outputs_are_step(0U));
+    SIM_CHECK(s_change_count == 0U);
+
+    /* --- Pattern applied at the exact deadline, ahead of the callback --- */
+    test_clear();
+    t0 = ITimerSched->now();
+    SIM_CHECK(ITimerSched->start_at(TIMER_EVENT_COMMUTATION, t0 + 1501U, test_commutation_cb, NULL));
+    Sim_RunCycles(1500U);
+    SIM_CHECK(test_outputs_are_step(0U));
+    Sim_RunCycles(100U);
+    SIM_CHECK(s_cb_count == 1U);
+    SIM_CHECK(s_cb_saw_step);
+    SIM_CHECK(s_cb_at == t0 + 1501U);
+    SIM_CHECK(s_change_count >= 1U);
+    SIM_CHECK(s_change_at == t0 + 1501U);
+    SIM_CHECK(test_outputs_are_step(1U));
+
+    /* --- Consecutive steps, each preloaded by the previous callback --- */
+    test_clear();
+    t0 = ITimerSched->now();
+    for (uint32_t i = 1U; i <= 4U; i++)
+    {
+        ITimerSched->start_at(TIMER_EVENT_COMMUTATION, t0 + 997U * i, test_commutation_cb, NULL);
+        Sim_RunCycles(997U);
+        SIM_CHECK(s_cb_saw_step);
+        SIM_CHECK(s_change_at == t0 + 997U * i);
+    }
+    SIM_CHECK(s_cb_count == 4U);
+    SIM_CHECK(test_outputs_are_step(5U));
+
+    /* --- A cancelled commutation keeps the current outputs --- */
+    test_clear();
+    ITimerSched->start(TIMER_EVENT_COMMUTATION, 800U, test_commutation_cb, NULL);
+    Sim_RunCycles(400U);
+    ITimerSched->cancel(TIMER_EVENT_COMMUTATION);
+    Sim_RunCycles(2000U);
+    SIM_CHECK(s_cb_count == 0U);
+    SIM_CHECK(s_change_count == 0U);
+    SIM_CHECK(test_outputs_are_step(5U));
+
+    /* --- A deadline already past switches at once --- */
+    test_clear();
+    t0 = ITimerSched->now();
+    ITimerSched->start_at(TIMER_EVENT_COMMUTATION, t0 - 50U, test_commutation_cb, NULL);
+    Sim_RunCycles(1U);
+    SIM_CHECK(s_cb_count == 1U);
+    SIM_CHECK(s_cb_saw_step);
+    SIM_CHECK(s_change_at == t0);
+    SIM_CHECK(test_outputs_are_step(0U));
+
+    /* --- Back to ISR-driven mode: a pending pattern is applied, no more preload --- */
+    test_clear();
+    SIM_CHECK(Service_Motor_SetHwCommutation(false));
+    SIM_CHECK(test_outputs_are_step(1U));
+    SIM_CHECK(!IInverter->preload_output_states(step1));
+
+    SIM_CHECK(Service_Motor_SetHwCommutation(true));
+    Inverter_SixStepPreload(3U, TEST_DUTY, true);
+    Service_Motor_Stop();
+    ITimerSched->start(TIMER_EVENT_COMMUTATION, 100U, test_nop_cb, NULL);
+    Sim_RunCycles(500U);
+    sim_inverter_state_t inv;
+    Sim_Inverter_GetState(&inv);
+    SIM_CHECK(!inv.enabled);
+    SIM_CHECK(!IInverter->preload_output_states(step1));
+
+    Sim_Inverter_SetObserver(NULL);
+
+    return Sim_Test_Summary(__FILE__);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file test_irq_sched_sim.c
+ * @brief NVIC preemption model: hand-checked cases + board interrupt load.
+ */
+
+#include "sim_esc.h"
+#include "sim_irq_sched.h"
+#include "sim_test.h"
+
+#include <stdio.h>
+
+static sim_irq_source_cfg_t source(const char *name, uint16_t irqn, uint8_t prio,
+                                   uint32_t period, uint32_t offset, uint32_t cost)
+{
+    sim_irq_source_cfg_t cfg = {
+        .name = name, .irqn = irqn, .priority = prio,
+        .period_cycles = period, .offset_cycles = offset,
+        .cost_min_cycles = cost, .cost_max_cycles = cost,
+    };
+    return cfg;
+}
+
+int main(void)
+{
+    sim_irq_source_stats_t a, b;
+
+    /* --- Preemption: A (prio 1) interrupts B (prio 2) --- */
+    Sim_IrqSched_Reset(1);
+    sim_irq_source_cfg_t cfg_a = source("A", 50, 1, 1000, 50, 100);
+    sim_irq_source_cfg_t cfg_b = source("B", 29, 2, 1000, 0, 300);
+    int id_a = Sim_IrqSched_AddSource(&cfg_a);
+    int id_b = Sim_IrqSched_AddSource(&cfg_b);
+    Sim_IrqSched_Run(10000);
+
+    Sim_IrqSched_GetStats(id_a, &a);
+    Sim_IrqSched_GetStats(id_b, &b);
+    SIM_CHECK(a.completed == 10U && b.completed == 10U);
+    SIM_CHECK(a.latency_min == SIM_IRQ_ENTRY_CYCLES && a.latency_max == SIM_IRQ_ENTRY_CYCLES);
+    SIM_CHECK(a.max_depth == 2U && b.max_depth == 1U);
+    SIM_CHECK(b.preempted == 10U);
+    SIM_CHECK(b.response_max == SIM_IRQ_ENTRY_CYCLES + 300U + SIM_IRQ_ENTRY_CYCLES + 100U);
+    SIM_CHECK(a.deadline_misses == 0U && b.deadline_misses == 0U);
+
+    /* --- Equal priority: no preemption, lowest IRQn first, tail-chained --- */
+    Sim_IrqSched_Reset(1);
+    sim_irq_source_cfg_t cfg_adc = source("ADC", 18, 3, 1000, 0, 200);
+    sim_irq_source_cfg_t cfg_tim = source("TIM4", 30, 3, 1000, 0, 400);
+    int id_tim = Sim_IrqSched_AddSource(&cfg_tim);
+    int id_adc = Sim_IrqSched_AddSource(&cfg_adc);
+    Sim_IrqSched_Run(1000);
+
+    Sim_IrqSched_GetStats(id_adc, &a);
+    Sim_IrqSched_GetStats(id_tim, &b);
+    SIM_CHECK(a.latency_max == SIM_IRQ_ENTRY_CYCLES);
+    SIM_CHECK(b.latency_max == SIM_IRQ_ENTRY_CYCLES + 200U + SIM_IRQ_TAILCHAIN_CYCLES);
+    SIM_CHECK(Sim_IrqSched_GetMaxDepth() == 1U);
+
+    /* --- Overrun: a handler longer than its period loses releases --- */
+    Sim_IrqSched_Reset(1);
+    sim_irq_source_cfg_t cfg_slow = source("slow", 29, 2, 1000, 0, 1500);
+    int id_slow = Sim_IrqSched_AddSource(&cfg_slow);
+    Sim_IrqSched_Run(100000);
+    Sim_IrqSched_GetStats(id_slow, &a);
+    SIM_CHECK(a.lost > 0U && a.deadline_misses > 0U);
+    SIM_CHECK(Sim_IrqSched_GetLoad() > 0.99f);
+
+    /* --- Board interrupt set, commutation at 20 000 rpm, 1 s --- */
+    Sim_IrqSched_Reset(12345);
+    int id_tim5 = Sim_IrqSched_AddEscSources(20000.0f);
+    Sim_IrqSched_Run(SIM_CPU_FREQ_HZ);
+    Sim_IrqSched_PrintReport();
+
+    Sim_IrqSched_GetStats(id_tim5, &a);
+    SIM_CHECK(a.releases == a.completed || a.releases == a.completed + 1U);
+    SIM_CHECK(a.latency_max == SIM_IRQ_ENTRY_CYCLES);     // Highest priority: never delayed
+    SIM_CHECK(a.deadline_misses == 0U);
+
+    Sim_IrqSched_GetStats(Sim_IrqSched_Find("TIM3 fast"), &b);
+    SIM_CHECK(b.releases >= 23999U && b.lost == 0U && b.deadline_misses == 0U);
+    SIM_CHECK(b.preempted > 0U);                          // TIM5 lands inside the fast loop
+    SIM_CHECK(Sim_IrqSched_GetMaxDepth() >= 3U);          // TIM5 → TIM3 → ADC/TIM4/USART
+    SIM_CHECK(Sim_IrqSched_GetLoad() < 0.5f);
+
+    /* --- Same profile with a fast loop that overruns its period --- */
+    Sim_IrqSched_Reset(12345);
+    Sim_IrqSched_AddEscSources(20000.0f);
+    int id_fast = Sim_IrqSched_Find("TIM3 fast");
+    Sim_IrqSched_SetCost(id_fast, 5500U, 6500U, NULL, NULL);
+    Sim_IrqSched_Run(SIM_CPU_FREQ_HZ / 10U);
+    Sim_IrqSched_PrintReport();
+
+    Sim_IrqSched_GetStats(id_fast, &b);
+    SIM_CHECK(b.deadline_misses > 0U);
+    Sim_IrqSched_GetStats(Sim_IrqSched_Find("TIM4 low"), &b);
+    SIM_CHECK(b.latency_max > SIM_FASTLOOP_PERIOD_CYCLES);
+
+    return Sim_Test_Summary(__FILE__);
+}
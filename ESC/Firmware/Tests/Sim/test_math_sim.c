@@ -0,0 +1,126 @@
+/**
+ * @file test_math_sim.c
+ * @brief CORDIC math front end (software model on host) against libm.
+ *
+ *  - sine / cosine over several turns, wrapping of large angles
+ *  - batches (longer than one hook call) equal to single calls, bit for bit
+ *  - atan2 in every quadrant, on the axes, null vector
+ *  - magnitude over twelve decades (exact power-of-two scaling)
+ */
+
+#include "i_math.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define TEST_PI             3.14159265358979
+#define TEST_BATCH          11U
+
+static void test_sin_cos(void)
+{
+    double worst = 0.0;
+
+    for (int k = -4000; k <= 4000; k++)
+    {
+        float a = (float)k * (float)(TEST_PI / 1000.0);     // -4π – 4π
+        float s, c;
+
+        IMath->sin_cos(a, &s, &c);
+        double err_s = fabs((double)s - sin((double)a));
+        double err_c = fabs((double)c - cos((double)a));
+        if (err_s > worst) worst = err_s;
+        if (err_c > worst) worst = err_c;
+    }
+    printf("sin/cos: max error %.2e\n", worst);
+    SIM_CHECK(worst < 2e-6);
+
+    /* Far from zero: limited by the float angle itself (ulp(100) = 7.6e-6) */
+    float s, c;
+    IMath->sin_cos(100.0f, &s, &c);
+    SIM_CHECK(fabs((double)s - sin(100.0)) < 2e-5 && fabs((double)c - cos(100.0)) < 2e-5);
+    IMath->sin_cos(-100.0f, &s, &c);
+    SIM_CHECK(fabs((double)s - sin(-100.0)) < 2e-5 && fabs((double)c - cos(-100.0)) < 2e-5);
+
+    /* Exact quarter turns */
+    IMath->sin_cos((float)(TEST_PI / 2.0), &s, &c);
+    SIM_CHECK(fabsf(s - 1.0f) < 1e-6f && fabsf(c) < 1e-6f);
+    IMath->sin_cos((float)TEST_PI, &s, &c);
+    SIM_CHECK(fabsf(s) < 1e-6f && fabsf(c + 1.0f) < 1e-6f);
+}
+
+static void test_batch(void)
+{
+    float a[TEST_BATCH], s[TEST_BATCH], c[TEST_BATCH];
+
+    for (uint32_t k = 0; k < TEST_BATCH; k++)
+        a[k] = -7.0f + 1.3f * (float)k;
+
+    IMath->sin_cos_n(a, s, c, TEST_BATCH);
+
+    uint32_t mismatch = 0;
+    for (uint32_t k = 0; k < TEST_BATCH; k++)
+    {
+        float s1, c1;
+        IMath->sin_cos(a[k], &s1, &c1);
+        if (s1 != s[k] || c1 != c[k])
+            mismatch++;
+    }
+    SIM_CHECK(mismatch == 0U);
+}
+
+static void test_atan2(void)
+{
+    double worst = 0.0;
+
+    for (int k = -180; k < 180; k++)
+    {
+        double a = (double)k * (TEST_PI / 180.0) + 0.001;
+        float y = (float)(3.0 * sin(a));
+        float x = (float)(3.0 * cos(a));
+
+        double err = fabs((double)IMath->atan2(y, x) - atan2((double)y, (double)x));
+        if (err > worst) worst = err;
+    }
+    printf("atan2: max error %.2e\n", worst);
+    SIM_CHECK(worst < 1e-6);
+
+    SIM_CHECK(fabsf(IMath->atan2(0.0f, 5.0f)) < 1e-6f);
+    SIM_CHECK(fabsf(IMath->atan2(5.0f, 0.0f) - (float)(TEST_PI / 2.0)) < 1e-6f);
+    SIM_CHECK(fabsf(IMath->atan2(-5.0f, 0.0f) + (float)(TEST_PI / 2.0)) < 1e-6f);
+    SIM_CHECK(fabsf(fabsf(IMath->atan2(0.0f, -5.0f)) - (float)TEST_PI) < 1e-6f);
+    SIM_CHECK(IMath->atan2(0.0f, 0.0f) == 0.0f);
+}
+
+static void test_magnitude(void)
+{
+    double worst = 0.0;
+
+    for (int e = -6; e <= 6; e++)
+    {
+        for (int k = 0; k < 16; k++)
+        {
+            double a = (double)k * (TEST_PI / 8.0) + 0.1;
+            float  x = (float)(pow(10.0, e) * 1.7 * cos(a));
+            float  y = (float)(pow(10.0, e) * 1.7 * sin(a));
+
+            double ref = sqrt((double)x * x + (double)y * y);
+            double err = fabs((double)IMath->magnitude(x, y) - ref) / ref;
+            if (err > worst) worst = err;
+        }
+    }
+    printf("magnitude: max relative error %.2e\n", worst);
+    SIM_CHECK(worst < 1e-6);
+    SIM_CHECK(IMath->magnitude(0.0f, 0.0f) == 0.0f);
+    SIM_CHECK(fabsf(IMath->magnitude(-3.0f, 4.0f) - 5.0f) < 5e-6f);
+}
+
+int main(void)
+{
+    test_sin_cos();
+    test_batch();
+    test_atan2();
+    test_magnitude();
+
+    return Sim_Test_Summary(__FILE__);
+}
@@ -0,0 +1,183 @@
+/**
+ * @file test_modulator_sim.c
+ * @brief Space-vector modulator: linear range, overmodulation, six-step.
+ *
+ *  - linear range: duties reproduce the vector exactly, zero sequence
+ *    centred, 15 % more than sine PWM
+ *  - overmodulation: fundamental of the applied trajectory equal to the
+ *    request over a full turn, no phase error, monotonic up to six-step
+ *  - six-step: two-level duties, fundamental 2·Vbus/π
+ *  - every duty within [0, duty_max], polar input, no bus
+ */
+
+#include "service_modulator.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define TEST_PI             3.14159265358979
+#define TEST_VBUS           12.0f
+#define TEST_DUTY_MAX       0.85f
+#define TEST_STEPS          3600U
+
+/** Average phase voltage vector of a set of duties (common mode removed) */
+static void applied(const float duty[3], double *alpha, double *beta)
+{
+    *alpha = TEST_VBUS * (2.0 * duty[0] - duty[1] - duty[2]) / 3.0;
+    *beta  = TEST_VBUS * (duty[1] - duty[2]) / sqrt(3.0);
+}
+
+static bool duties_in_range(const float duty[3])
+{
+    for (int x = 0; x < 3; x++)
+        if (duty[x] < 0.0f || duty[x] > TEST_DUTY_MAX + 1e-6f)
+            return false;
+    return true;
+}
+
+/**
+ * @brief Radial and tangential fundamental of the trajectory applied for a
+ * reference of magnitude @p v_mag turning over one turn.
+ */
+static void fundamental(float v_mag, double *radial, double *tangential, uint32_t *out_of_range)
+{
+    double r = 0.0, t = 0.0;
+
+    *out_of_range = 0U;
+    for (uint32_t k = 0; k < TEST_STEPS; k++)
+    {
+        double th = 2.0 * TEST_PI * ((double)k + 0.5) / TEST_STEPS;
+        float duty[3];
+        double a, b;
+
+        Service_Modulator_AlphaBeta(v_mag * (float)cos(th), v_mag * (float)sin(th),
+                                    TEST_VBUS, TEST_DUTY_MAX, duty);
+        if (!duties_in_range(duty))
+            (*out_of_range)++;
+
+        applied(duty, &a, &b);
+        r +=  a * cos(th) + b * sin(th);
+        t += -a * sin(th) + b * cos(th);
+    }
+    *radial     = r / TEST_STEPS;
+    *tangential = t / TEST_STEPS;
+}
+
+static void test_linear(void)
+{
+    float v_lin = Service_Modulator_MaxLinear(TEST_VBUS, TEST_DUTY_MAX);
+    double worst = 0.0;
+    uint32_t bad = 0;
+
+    /* 15 % above sine PWM (duty_max·Vbus/2) */
+    SIM_CHECK(fabsf(v_lin / (0.5f * TEST_DUTY_MAX * TEST_VBUS) - 1.1547f) < 1e-3f);
+
+    for (uint32_t k = 0; k < 360U; k++)
+    {
+        double th  = (double)k * TEST_PI / 180.0;
+        float  mag = v_lin * (0.999f * (float)((k % 7U) + 1U) / 7.0f);
+        float  duty[3];
+        double a, b;
+
+        SIM_CHECK(Service_Modulator_AlphaBeta(mag * (float)cos(th), mag * (float)sin(th),
+                                              TEST_VBUS, TEST_DUTY_MAX, duty) == MODULATOR_LINEAR);
+        applied(duty, &a, &b);
+        double err = hypot(a - mag * cos(th), b - mag * sin(th));
+        if (err > worst) worst = err;
+
+        /* Centred when there is room, else the top duty at duty_max */
+        float d_max = fmaxf(fmaxf(duty[0], duty[1]), duty[2]);
+        float d_min = fminf(fminf(duty[0], duty[1]), duty[2]);
+        bool  room  = (d_max - d_min) <= 2.0f * TEST_DUTY_MAX - 1.0f;
+        if (!duties_in_range(duty)
+            || (room && fabsf(d_max + d_min - 1.0f) > 1e-4f)
+            || (!room && fabsf(d_max - TEST_DUTY_MAX) > 1e-5f))
+            bad++;
+    }
+    printf("linear: max vector error %.2e V\n", worst);
+    SIM_CHECK(worst < 1e-4);
+    SIM_CHECK(bad == 0U);
+}
+
+static void test_overmodulation(void)
+{
+    const float m[] = { 0.91f, 0.93f, 0.95f, 0.97f, 0.99f, 0.998f };
+    float six = Service_Modulator_MaxVoltage(TEST_VBUS, TEST_DUTY_MAX);
+    double prev = 0.0;
+
+    SIM_CHECK(fabsf(six - (float)(2.0 / TEST_PI) * TEST_DUTY_MAX * TEST_VBUS) < 1e-4f);
+
+    for (uint32_t i = 0; i < sizeof(m) / sizeof(m[0]); i++)
+    {
+        float v_mag = m[i] * six;
+        double radial, tangential;
+        uint32_t out_of_range;
+        float duty[3];
+
+        SIM_CHECK(Service_Modulator_AlphaBeta(v_mag, 0.1f, TEST_VBUS, TEST_DUTY_MAX, duty)
+                  == MODULATOR_OVERMODULATION);
+
+        fundamental(v_mag, &radial, &tangential, &out_of_range);
+        printf("m = %.3f: fundamental %.4f (requested %.4f), tangential %.1e\n",
+               m[i], radial, v_mag, tangential);
+
+        SIM_CHECK(fabs(radial / v_mag - 1.0) < 2e-3);
+        SIM_CHECK(fabs(tangential) < 1e-3);
+        SIM_CHECK(radial > prev);
+        SIM_CHECK(out_of_range == 0U);
+        prev = radial;
+    }
+}
+
+static void test_six_step(void)
+{
+    float six = Service_Modulator_MaxVoltage(TEST_VBUS, TEST_DUTY_MAX);
+    double radial, tangential;
+    uint32_t out_of_range, not_two_level = 0;
+
+    for (uint32_t k = 0; k < 360U; k++)
+    {
+        double th = ((double)k + 0.5) * TEST_PI / 180.0;
+        float duty[3];
+
+        SIM_CHECK(Service_Modulator_Polar(1.2f * six, (float)th, TEST_VBUS, TEST_DUTY_MAX, duty)
+                  == MODULATOR_SIX_STEP);
+        for (int x = 0; x < 3; x++)
+            if (fabsf(duty[x]) > 1e-5f && fabsf(duty[x] - TEST_DUTY_MAX) > 1e-5f)
+                not_two_level++;
+    }
+    SIM_CHECK(not_two_level == 0U);
+
+    fundamental(six, &radial, &tangential, &out_of_range);
+    printf("six-step: fundamental %.4f (2·Vbus/π %.4f)\n", radial, six);
+    SIM_CHECK(fabs(radial / six - 1.0) < 1e-3);
+    SIM_CHECK(out_of_range == 0U);
+}
+
+static void test_polar_and_bus(void)
+{
+    float d1[3], d2[3];
+
+    Service_Modulator_Polar(3.0f, 1.0f, TEST_VBUS, TEST_DUTY_MAX, d1);
+    Service_Modulator_AlphaBeta(3.0f * cosf(1.0f), 3.0f * sinf(1.0f), TEST_VBUS, TEST_DUTY_MAX, d2);
+    SIM_CHECK(fabsf(d1[0] - d2[0]) < 1e-5f && fabsf(d1[1] - d2[1]) < 1e-5f && fabsf(d1[2] - d2[2]) < 1e-5f);
+
+    /* Same normalised vector on another bus: same duties */
+    Service_Modulator_AlphaBeta(6.0f * cosf(1.0f), 6.0f * sinf(1.0f), 2.0f * TEST_VBUS, TEST_DUTY_MAX, d1);
+    SIM_CHECK(fabsf(d1[0] - d2[0]) < 1e-5f && fabsf(d1[1] - d2[1]) < 1e-5f && fabsf(d1[2] - d2[2]) < 1e-5f);
+
+    Service_Modulator_AlphaBeta(3.0f, 0.0f, 0.0f, TEST_DUTY_MAX, d1);
+    SIM_CHECK(d1[0] == 0.0f && d1[1] == 0.0f && d1[2] == 0.0f);
+}
+
+int main(void)
+{
+    test_linear();
+    test_overmodulation();
+    test_six_step();
+    test_polar_and_bus();
+
+    return Sim_Test_Summary(__FILE__);
+}
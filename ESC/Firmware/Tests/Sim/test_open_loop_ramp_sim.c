@@ -0,0 +1,135 @@
+/**
+ * @file test_open_loop_ramp_sim.c
+ * @brief Open-loop ramp timing on the virtual ESC (no motor attached).
+ *
+ * Commutation instants are recorded from the inverter output changes:
+ *  - the ramp ends within one step of the commanded time (steps at
+ *    absolute deadlines: no accumulated callback latency)
+ *  - the number of steps matches the integral of 6·f(t)
+ *  - mid-ramp step interval and duty follow the profile laws
+ *  - re-sync ramp: constant step interval over the hold time
+ */
+
+#include "control.h"
+#include "service_bldc_motor.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define TEST_CYCLES_PER_US  150.0f
+
+static uint32_t s_steps;            /**< Commutations since the ramp start */
+static uint8_t  s_last_step;
+static uint64_t s_last_at;          /**< Last commutation [cycles] */
+static uint64_t s_last_interval;    /**< Interval before it [cycles] */
+static uint64_t s_done_at;          /**< Ramp completion [cycles], 0 if still running */
+
+/** Inverter observer: one count per new six-step pattern */
+static void test_observer(sim_inverter_change_t when)
+{
+    uint8_t step;
+    float duty;
+    bool cw;
+
+    if (when != SIM_INVERTER_POST_CHANGE)
+        return;
+
+    Service_Motor_OpenLoopRamp_GetState(&step, &duty, &cw);
+    if (s_steps > 0U && step == s_last_step)
+        return;
+
+    uint64_t now = Sim_GetCycles();
+    s_last_interval = now - s_last_at;
+    s_last_at       = now;
+    s_last_step     = step;
+    s_steps++;
+}
+
+static void test_on_complete(void *ctx)
+{
+    (void)ctx;
+    s_done_at = Sim_GetCycles();
+}
+
+static uint64_t test_begin(void)
+{
+    s_steps   = 0U;
+    s_done_at = 0U;
+    return Sim_GetCycles();
+}
+
+/** Run to @p ms after @p t0; returns the last step interval [µs] */
+static float test_run_to_ms(uint64_t t0, float ms)
+{
+    uint64_t until = t0 + (uint64_t)(ms * 1000.0f * TEST_CYCLES_PER_US);
+    Sim_RunCycles(until - Sim_GetCycles());
+    return (float)s_last_interval / TEST_CYCLES_PER_US;
+}
+
+int main(void)
+{
+    uint8_t step;
+    float duty;
+    bool cw;
+
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+    Sim_Inverter_SetObserver(test_observer);
+
+    /* --- Linear 25 → 500 Hz in 300 ms: 6 · 262.5 Hz · 0.3 s = 472.5 steps --- */
+    uint64_t t0 = test_begin();
+    Service_Motor_OpenLoopRamp_Start(0.1f, 0.5f, 25.0f, 500.0f, 300U, true,
+                                     RAMP_PROFILE_LINEAR, test_on_complete, NULL);
+    (void)test_run_to_ms(t0, 320.0f);
+
+    float done_ms = (float)(s_done_at - t0) / (TEST_CYCLES_PER_US * 1000.0f);
+    printf("linear: %lu steps, done at %.3f ms (last step %.0f us)\n",
+           (unsigned long)s_steps, done_ms, (float)s_last_interval / TEST_CYCLES_PER_US);
+    SIM_CHECK(s_done_at != 0U);
+    SIM_CHECK(done_ms >= 300.0f && done_ms < 300.0f + 1000.0f / (6.0f * 500.0f));
+    SIM_CHECK(s_steps >= 470U && s_steps <= 475U);
+
+    /* --- Exponential 20 → 320 Hz in 200 ms: 80 Hz at mid-ramp --- */
+    t0 = test_begin();
+    Service_Motor_OpenLoopRamp_Start(0.1f, 0.5f, 20.0f, 320.0f, 200U, false,
+                                     RAMP_PROFILE_EXPONENTIAL, test_on_complete, NULL);
+    float mid_us = test_run_to_ms(t0, 100.0f);
+    Service_Motor_OpenLoopRamp_GetState(&step, &duty, &cw);
+
+    /* Interval set by the step that opened it: f(t) = 20 Hz · 16^(t / 200 ms) */
+    float opened_ms = (float)(s_last_at - s_last_interval - t0) / (TEST_CYCLES_PER_US * 1000.0f);
+    float mid_expected_us = 1e6f / (6.0f * 20.0f * powf(16.0f, opened_ms / 200.0f));
+    float duty_expected   = 0.1f + powf(0.5f, 1.5f) * 0.4f;            // ≈ 100 ms
+    printf("exponential: mid-ramp step %.0f us (expected %.0f), duty %.3f (expected %.3f)\n",
+           mid_us, mid_expected_us, duty, duty_expected);
+    SIM_CHECK(fabsf(mid_us - mid_expected_us) < 0.02f * mid_expected_us);
+    SIM_CHECK(fabsf(duty - duty_expected) < 0.01f);
+    SIM_CHECK(!cw);
+
+    (void)test_run_to_ms(t0, 199.0f);
+    Service_Motor_OpenLoopRamp_GetState(&step, &duty, &cw);
+    SIM_CHECK(s_done_at == 0U);
+    SIM_CHECK(fabsf(duty - 0.5f) < 0.01f);
+    (void)test_run_to_ms(t0, 203.0f);
+    SIM_CHECK(s_done_at != 0U);
+
+    /* --- Re-sync: 300 Hz held 50 ms, steps of 555.6 µs --- */
+    t0 = test_begin();
+    Service_Motor_OpenLoopRamp_Resync(3U, 0.4f, 300.0f, 50U, true, test_on_complete, NULL);
+    float hold_us = test_run_to_ms(t0, 30.0f);
+    (void)test_run_to_ms(t0, 55.0f);
+
+    printf("resync: %lu steps, step %.1f us, done at %.3f ms\n", (unsigned long)s_steps, hold_us,
+           (float)(s_done_at - t0) / (TEST_CYCLES_PER_US * 1000.0f));
+    SIM_CHECK(fabsf(hold_us - 1e6f / 1800.0f) < 1.0f);
+    SIM_CHECK(s_steps >= 90U && s_steps <= 91U);
+    SIM_CHECK(s_done_at != 0U && s_done_at - t0 < (uint64_t)(50556.0f * TEST_CYCLES_PER_US));
+
+    Sim_Inverter_SetObserver(NULL);
+    Service_Motor_Stop();
+
+    return Sim_Test_Summary(__FILE__);
+}
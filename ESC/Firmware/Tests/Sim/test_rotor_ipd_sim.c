@@ -0,0 +1,197 @@
+/**
+ * @file test_rotor_ipd_sim.c
+ * @brief Initial rotor position detection (inductive sensing) against the
+ *        BLDC plant model with a salient, saturating stator.
+ *
+ *  - estimator: synthetic peak currents, saliency must not bias the angle
+ *  - sequence: rotor at rest all around the turn, angle found within a
+ *    fraction of a step in about 1.5 ms, without moving the rotor
+ *  - constant-inductance motor: no contrast, result flagged invalid
+ *  - start-up: the ramp starts from the step just behind the rotor, in
+ *    both directions, a few ms after the flying-start listening time, and
+ *    hands over to closed loop on the commanded speed
+ */
+
+#include "control.h"
+#include "control_six_step.h"
+#include "service_bldc_motor.h"
+#include "service_loop.h"
+#include "service_rotor_ipd.h"
+#include "sim_bldc_plant.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#define TEST_SALIENCY       0.10f       /**< ±10 % phase inductance over the turn */
+#define TEST_SAT_PER_A      0.03f       /**< -3 %/A of magnet-aligned current */
+#define TEST_MAX_ERR_DEG    15.0f       /**< Well inside a 60° step */
+#define TEST_MAX_TICKS      60U         /**< 2.5 ms */
+#define TEST_LISTEN_MS      40U         /**< CATCH_LISTEN_MS */
+#define TEST_RPM            3000.0f
+#define TEST_RAMP_LAG_DEG   45.0f       /**< LOCATE_RAMP_LAG_DEG */
+#define TEST_MAX_LOCK_MS    1000U       /**< Handover within the start-up ramp */
+#define TEST_SETTLE_MS      500U        /**< Closed loop: speed on the command after this */
+#define TEST_SETTLE_BAND    0.10f       /**< ±10 % of command */
+
+#define TEST_DEG_PER_RAD    57.2957795f
+
+static float test_wrap180(float deg)
+{
+    deg = fmodf(deg + 180.0f, 360.0f);
+    return (deg < 0.0f) ? deg + 180.0f : deg - 180.0f;
+}
+
+static uint32_t s_ipd_ticks = 0;
+
+/** Fast loop of the detection alone (before the motor control takes it over) */
+static void test_fastloop_cb(void)
+{
+    if (Service_RotorIpd_Process() == ROTOR_IPD_RUNNING)
+        s_ipd_ticks++;
+}
+
+/** Run the detection from the fast loop; returns the periods it took */
+static uint32_t test_run_ipd(rotor_ipd_result_t *result)
+{
+    s_ipd_ticks = 0;
+    Service_RotorIpd_Start();
+    Sim_RunCycles(TEST_MAX_TICKS * SIM_PWM_PERIOD_CYCLES);
+    SIM_CHECK(Service_RotorIpd_GetResult(result));
+    return s_ipd_ticks + 1U;
+}
+
+/** Run until closed loop (1 ms steps); returns the time [ms], -1 if never */
+static int test_time_to_closed_loop(uint32_t max_ms)
+{
+    for (uint32_t ms = 0; ms < max_ms; ms++)
+    {
+        if (Control_Motor_GetMode() == CONTROL_MOTOR_MODE_CLOSED_LOOP)
+            return (int)ms;
+        Sim_Run_ms(1U);
+    }
+    return -1;
+}
+
+/** Standstill start through the control layer; returns the ramp's first step */
+static uint8_t test_start_from_rest(float theta_deg, float rpm)
+{
+    uint8_t step;
+    float duty;
+    bool cw;
+
+    Sim_BLDC_SetRotor(theta_deg / TEST_DEG_PER_RAD, 0.0f);
+    Control_Motor_SetSpeed_RPM(rpm);
+    Sim_Run_ms(TEST_LISTEN_MS + 3U);
+    SIM_CHECK(Control_Motor_GetMode() == CONTROL_MOTOR_MODE_OPEN_LOOP);
+
+    Service_Motor_OpenLoopRamp_GetState(&step, &duty, &cw);
+    return step;
+}
+
+int main(void)
+{
+    rotor_ipd_result_t r;
+
+    /* --- Estimator: first harmonic on the rotor, second one ignored --- */
+    float peaks[ROTOR_IPD_VECTORS];
+    for (int k = 0; k < ROTOR_IPD_VECTORS; k++)
+    {
+        float d = (150.0f + 60.0f * (float)k - 37.0f) / TEST_DEG_PER_RAD;
+        peaks[k] = 4.0f + 0.2f * cosf(d) + 0.4f * cosf(2.0f * d);
+    }
+    Service_RotorIpd_Estimate(peaks, &r);
+    SIM_CHECK(fabsf(test_wrap180(r.angle_deg - 37.0f)) < 0.5f);
+    SIM_CHECK(fabsf(r.contrast - 0.05f) < 0.005f);
+    SIM_CHECK(r.valid);
+
+    for (int k = 0; k < ROTOR_IPD_VECTORS; k++)
+        peaks[k] = 4.0f + 0.4f * cosf(2.0f * (60.0f * (float)k - 37.0f) / TEST_DEG_PER_RAD);
+    Service_RotorIpd_Estimate(peaks, &r);
+    SIM_CHECK(!r.valid);                                // Saliency alone: 180° ambiguity
+
+    /* --- Detection on the plant, rotor at rest all around the turn --- */
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+    SIM_CHECK(SFastLoop->init());
+    SFastLoop->register_callback(test_fastloop_cb);
+    SFastLoop->start();
+
+    sim_bldc_params_t params;
+    Sim_BLDC_DefaultParams(&params);
+    params.l_saliency  = TEST_SALIENCY;
+    params.l_sat_per_a = TEST_SAT_PER_A;
+    Sim_BLDC_Attach(&params);
+
+    sim_bldc_state_t st;
+    float max_err = 0.0f, min_contrast = 1.0f, max_moved = 0.0f;
+    uint32_t max_ticks = 0;
+
+    for (float theta = 0.0f; theta < 360.0f; theta += 15.0f)
+    {
+        Sim_BLDC_SetRotor(theta / TEST_DEG_PER_RAD, 0.0f);
+        uint32_t ticks = test_run_ipd(&r);
+        Sim_BLDC_GetState(&st);
+
+        float err = fabsf(test_wrap180(r.angle_deg - theta));
+        float moved = fabsf(test_wrap180(st.theta_e_rad * TEST_DEG_PER_RAD - theta));
+        SIM_CHECK(r.valid);
+        SIM_CHECK(err < TEST_MAX_ERR_DEG);
+
+        max_err      = fmaxf(max_err, err);
+        min_contrast = fminf(min_contrast, r.contrast);
+        max_moved    = fmaxf(max_moved, moved);
+        if (ticks > max_ticks) max_ticks = ticks;
+    }
+    printf("IPD: max |err| %.1f deg, min contrast %.1f %%, %lu periods (%.2f ms), rotor moved %.2f deg, peak %.2f A\n",
+           max_err, 100.0f * min_contrast, (unsigned long)max_ticks, (float)max_ticks / 24.0f, max_moved, r.peak_a[0]);
+    SIM_CHECK(max_ticks < 48U);                         // < 2 ms
+    SIM_CHECK(max_moved < 1.0f);
+
+    /* --- Constant inductance: nothing to see --- */
+    Sim_BLDC_DefaultParams(&params);
+    Sim_BLDC_Attach(&params);
+    Sim_BLDC_SetRotor(1.0f, 0.0f);
+    (void)test_run_ipd(&r);
+    printf("IPD, constant L: contrast %.2f %%\n", 100.0f * r.contrast);
+    SIM_CHECK(!r.valid);
+    SIM_CHECK(r.peak_a[0] > 2.0f);                      // Pulses did drive current
+
+    /* --- Start-up: ramp from the located step, both directions --- */
+    Control_Motor_Init();
+    params.l_saliency  = TEST_SALIENCY;
+    params.l_sat_per_a = TEST_SAT_PER_A;
+    Sim_BLDC_Attach(&params);
+
+    SIM_CHECK(test_start_from_rest(200.0f, TEST_RPM) == Service_Motor_SixStepOfAngle(200.0f - TEST_RAMP_LAG_DEG, true));
+    Sim_Run_ms(20U);
+    Sim_BLDC_GetState(&st);
+    printf("CW start from 200 deg: %.0f rpm after 20 ms\n", st.rpm);
+    SIM_CHECK(st.rpm > 90.0f);
+
+    int lock_ms = test_time_to_closed_loop(TEST_MAX_LOCK_MS);
+    Sim_Run_ms(TEST_SETTLE_MS);
+    Sim_BLDC_GetState(&st);
+    printf("CW start: closed loop after %d ms, %.0f rpm %u ms later\n", lock_ms, st.rpm, (unsigned)TEST_SETTLE_MS);
+    SIM_CHECK(lock_ms >= 0);
+    SIM_CHECK(fabsf(st.rpm - TEST_RPM) < TEST_SETTLE_BAND * TEST_RPM);
+    Control_Motor_Stop();
+    Sim_Run_ms(200U);
+
+    SIM_CHECK(test_start_from_rest(200.0f, -TEST_RPM) == Service_Motor_SixStepOfAngle(200.0f + TEST_RAMP_LAG_DEG, false));
+    Sim_Run_ms(20U);
+    Sim_BLDC_GetState(&st);
+    printf("CCW start from 200 deg: %.0f rpm after 20 ms\n", st.rpm);
+    SIM_CHECK(st.rpm < -90.0f);
+
+    lock_ms = test_time_to_closed_loop(TEST_MAX_LOCK_MS);
+    Sim_Run_ms(TEST_SETTLE_MS);
+    Sim_BLDC_GetState(&st);
+    printf("CCW start: closed loop after %d ms, %.0f rpm %u ms later\n", lock_ms, st.rpm, (unsigned)TEST_SETTLE_MS);
+    SIM_CHECK(lock_ms >= 0);
+    SIM_CHECK(fabsf(st.rpm + TEST_RPM) < TEST_SETTLE_BAND * TEST_RPM);
+    Control_Motor_Stop();
+
+    return Sim_Test_Summary(__FILE__);
+}
@@ -0,0 +1,149 @@
+/**
+ * @file test_timer_sched_sim.c
+ * @brief Multi-event timer scheduler (ITimerSched) on the virtual TIM5.
+ *
+ * Runs the scheduler of driver_timer_sched.c: more pending events than
+ * compare channels (sorted overflow queue), exact tick of every deadline,
+ * replacement, cancellation, eviction of a channel by an earlier deadline,
+ * late deadlines and callbacks re-arming themselves.
+ */
+
+#include "control.h"
+#include "i_timer_sched.h"
+#include "sim_esc.h"
+#include "sim_test.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define TEST_MAX_FIRED  32U
+
+static uint32_t s_fired_id[TEST_MAX_FIRED];
+static uint32_t s_fired_at[TEST_MAX_FIRED];
+static uint32_t s_fired_count;
+
+static uint32_t s_periodic_count;
+
+static void test_record_cb(void *ctx)
+{
+    if (s_fired_count < TEST_MAX_FIRED)
+    {
+        s_fired_id[s_fired_count] = (uint32_t)(uintptr_t)ctx;
+        s_fired_at[s_fired_count] = ITimerSched->now();
+    }
+    s_fired_count++;
+}
+
+static void test_periodic_cb(void *ctx)
+{
+    (void)ctx;
+    s_periodic_count++;
+    ITimerSched->start(TIMER_EVENT_AUX1, 1000U, test_periodic_cb, NULL);
+}
+
+static void test_clear(void)
+{
+    s_fired_count = 0;
+}
+
+static bool test_arm(timer_event_id_t id, uint32_t deadline)
+{
+    return ITimerSched->start_at(id, deadline, test_record_cb, (void *)(uintptr_t)id);
+}
+
+int main(void)
+{
+    SIM_CHECK(System_Init() == CONTROL_OK);
+    SIM_CHECK(Control_Init() == CONTROL_OK);
+
+    SIM_CHECK(ITimerSched->get_tick_hz() == SIM_CPU_FREQ_HZ);
+    SIM_CHECK(!ITimerSched->start(TIMER_EVENT_COUNT, 100U, test_record_cb, NULL));
+    SIM_CHECK(!ITimerSched->start(TIMER_EVENT_AUX0, 100U, NULL, NULL));
+
+    /* --- Six concurrent deadlines (3 channels + 3 queued), sub-µs spacing --- */
+    static const uint32_t delays[TIMER_EVENT_COUNT] = { 1000U, 401U, 1500U, 250U, 3007U, 402U };
+    static const uint32_t order[TIMER_EVENT_COUNT]  = { 3U, 1U, 5U, 0U, 2U, 4U };
+
+    test_clear();
+    uint32_t t0 = ITimerSched->now();
+    for (uint32_t id = 0; id < TIMER_EVENT_COUNT; id++)
+        SIM_CHECK(test_arm((timer_event_id_t)id, t0 + delays[id]));
+    for (uint32_t id = 0; id < TIMER_EVENT_COUNT; id++)
+        SIM_CHECK(ITimerSched->is_active((timer_event_id_t)id));
+
+    Sim_RunCycles(4000U);
+
+    SIM_CHECK(s_fired_count == TIMER_EVENT_COUNT);
+    for (uint32_t i = 0; i < TIMER_EVENT_COUNT && i < s_fired_count; i++)
+    {
+        SIM_CHECK(s_fired_id[i] == order[i]);
+        SIM_CHECK(s_fired_at[i] == t0 + delays[order[i]]);
+    }
+    for (uint32_t id = 0; id < TIMER_EVENT_COUNT; id++)
+        SIM_CHECK(!ITimerSched->is_active((timer_event_id_t)id));
+
+    /* --- Re-arming replaces the pending deadline --- */
+    test_clear();
+    t0 = ITimerSched->now();
+    test_arm(TIMER_EVENT_AUX0, t0 + 100U);
+    test_arm(TIMER_EVENT_AUX0, t0 + 500U);
+    Sim_RunCycles(1000U);
+    SIM_CHECK(s_fired_count == 1U);
+    SIM_CHECK(s_fired_at[0] == t0 + 500U);
+
+    /* --- Cancel one channel event and one queued event --- */
+    test_clear();
+    t0 = ITimerSched->now();
+    for (uint32_t id = 0; id < TIMER_EVENT_COUNT; id++)
+        test_arm((timer_event_id_t)id, t0 + 100U * (id + 1U));
+    ITimerSched->cancel(TIMER_EVENT_BLANKING);      // In a channel
+    ITimerSched->cancel(TIMER_EVENT_AUX0);          // Queued
+    Sim_RunCycles(1000U);
+    SIM_CHECK(s_fired_count == TIMER_EVENT_COUNT - 2U);
+    for (uint32_t i = 0; i < s_fired_count && i < TIMER_EVENT_COUNT; i++)
+    {
+        SIM_CHECK(s_fired_id[i] != TIMER_EVENT_BLANKING && s_fired_id[i] != TIMER_EVENT_AUX0);
+        SIM_CHECK(s_fired_at[i] == t0 + 100U * (s_fired_id[i] + 1U));
+    }
+
+    /* --- An earlier deadline evicts the latest channel event --- */
+    test_clear();
+    t0 = ITimerSched->now();
+    for (uint32_t id = 0; id < 5U; id++)
+        test_arm((timer_event_id_t)id, t0 + 10000U + 1000U * id);
+    test_arm(TIMER_EVENT_AUX1, t0 + 50U);
+    Sim_RunCycles(20000U);
+    SIM_CHECK(s_fired_count == 6U);
+    SIM_CHECK(s_fired_id[0] == TIMER_EVENT_AUX1 && s_fired_at[0] == t0 + 50U);
+    for (uint32_t i = 1; i < 6U && i < s_fired_count; i++)
+    {
+        SIM_CHECK(s_fired_id[i] == i - 1U);
+        SIM_CHECK(s_fired_at[i] == t0 + 10000U + 1000U * (i - 1U));
+    }
+
+    /* --- A deadline already in the past fires at once --- */
+    test_clear();
+    Sim_RunCycles(5000U);
+    t0 = ITimerSched->now();
+    test_arm(TIMER_EVENT_TIMEOUT, t0 - 10U);
+    Sim_RunCycles(1U);
+    SIM_CHECK(s_fired_count == 1U);
+    SIM_CHECK(s_fired_at[0] == t0);
+
+    /* --- Self re-arming callback alongside other deadlines --- */
+    test_clear();
+    s_periodic_count = 0;
+    t0 = ITimerSched->now();
+    ITimerSched->start(TIMER_EVENT_AUX1, 1000U, test_periodic_cb, NULL);
+    test_arm(TIMER_EVENT_COMMUTATION, t0 + 2500U);
+    test_arm(TIMER_EVENT_RAMP, t0 + 5500U);
+    Sim_RunCycles(10500U);
+    SIM_CHECK(s_periodic_count == 10U);
+    SIM_CHECK(s_fired_count == 2U);
+    SIM_CHECK(ITimerSched->is_active(TIMER_EVENT_AUX1));
+    ITimerSched->cancel(TIMER_EVENT_AUX1);
+    Sim_RunCycles(2000U);
+    SIM_CHECK(s_periodic_count == 10U);
+
+    return Sim_Test_Summary(__FILE__);
+}
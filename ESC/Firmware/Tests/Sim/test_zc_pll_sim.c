@@ -0,0 +1,160 @@
+/**
+ * @file test_zc_pll_sim.c
+ * @brief Zero-cross PLL (service_zc_pll) against an accelerating rotor.
+ *
+ * The zero-cross events of a rotor under constant electrical acceleration
+ * are generated analytically (µs timestamps, like the BEMF monitor), then:
+ *  - the speed estimate of the PLL must follow the acceleration without the
+ *    lag of the period EMA used so far (BEMF_FILTER_ALPHA = 0.2)
+ *  - the predicted commutation instant (crossing + 27°) must be on time
+ *  - a single spurious edge must be rejected without moving the estimate
+ *  - a lost rotor (sudden jump) must be re-acquired
+ *  - the libm-free wraps (extrapolated angle, six-step of an angle) must
+ *    match fmod / floor over several turns either way
+ */
+
+#include "service_bldc_motor.h"
+#include "service_zc_pll.h"
+#include "sim_test.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define TEST_OMEGA0_DPS     (360.0f * 200.0f)       /**< 200 Hz electrical (2000 rpm, 6 pole pairs) */
+#define TEST_ACCEL_DPS2     (360.0f * 5000.0f)      /**< +5 kHz/s: aggressive throttle step */
+#define TEST_EVENTS         300U
+#define TEST_SETTLE_EVENTS  12U
+#define TEST_EMA_ALPHA      0.2f                    /**< BEMF_FILTER_ALPHA */
+#define TEST_LEAD_DEG       27.0f                   /**< COMM_LEAD_FACTOR × 60° */
+
+/** Rotor time [s] at which the unwrapped angle reaches @p theta_deg */
+static double test_time_at(double theta_deg)
+{
+    double w = TEST_OMEGA0_DPS, a = TEST_ACCEL_DPS2;
+    return (-w + sqrt(w * w + 2.0 * a * theta_deg)) / a;
+}
+
+static double test_speed_at(double t_s)
+{
+    return TEST_OMEGA0_DPS + TEST_ACCEL_DPS2 * t_s;
+}
+
+static uint32_t test_us(double t_s)
+{
+    return 1000000U + (uint32_t)lround(t_s * 1e6);
+}
+
+int main(void)
+{
+    zc_pll_t pll;
+    Service_ZcPll_Init(&pll);
+
+    /* --- Tracking under constant acceleration --- */
+    float max_pll_err = 0.0f, max_ema_err = 0.0f, max_comm_err_deg = 0.0f;
+    float ema_period_us = 0.0f;
+    uint32_t prev_us = 0;
+
+    for (uint32_t k = 0; k < TEST_EVENTS; k++)
+    {
+        double theta = 60.0 * (double)k;                  // Crossing of step k % 6 at 60 + 60·(k % 6)
+        double t = test_time_at(theta);
+        uint32_t zc_us = test_us(t);
+
+        SIM_CHECK(Service_ZcPll_OnZeroCross(&pll, zc_us, (uint8_t)((k + 5U) % 6U)));
+
+        if (k > 0U)
+        {
+            float period = (float)(zc_us - prev_us);
+            ema_period_us = (k == 1U) ? period : (1.0f - TEST_EMA_ALPHA) * ema_period_us + TEST_EMA_ALPHA * period;
+        }
+        prev_us = zc_us;
+
+        if (k < TEST_SETTLE_EVENTS)
+            continue;
+
+        /* Speed at the fast-loop tick 20 µs after the crossing */
+        zc_pll_estimate_t est;
+        uint32_t now_us = zc_us + 20U;
+        Service_ZcPll_Estimate(&pll, now_us, &est);
+        SIM_CHECK(est.locked);
+
+        double true_w = test_speed_at(t + 20e-6);
+        float pll_err = (float)fabs(est.omega_dps - true_w) / (float)true_w;
+        float ema_err = (float)fabs(60.0 / (ema_period_us * 1e-6) - true_w) / (float)true_w;
+        if (pll_err > max_pll_err) max_pll_err = pll_err;
+        if (ema_err > max_ema_err) max_ema_err = ema_err;
+
+        /* Commutation at crossing + 27°, predicted from the tick */
+        float delay_us = Service_ZcPll_TimeToAngle(&pll, now_us, 60.0f + 60.0f * (float)((k + 5U) % 6U) + TEST_LEAD_DEG);
+        double t_comm = test_time_at(theta + TEST_LEAD_DEG);
+        float comm_err_deg = (float)(((double)(now_us - 1000000U) * 1e-6 + delay_us * 1e-6 - t_comm) * test_speed_at(t_comm));
+        if (fabsf(comm_err_deg) > max_comm_err_deg) max_comm_err_deg = fabsf(comm_err_deg);
+    }
+
+    printf("speed error: PLL %.3f %%, period EMA %.3f %%; commutation error %.2f deg\n",
+           max_pll_err * 100.0f, max_ema_err * 100.0f, max_comm_err_deg);
+    SIM_CHECK(max_pll_err < 0.005f);
+    SIM_CHECK(max_ema_err > 4.0f * max_pll_err);
+    SIM_CHECK(max_comm_err_deg < 1.0f);
+
+    /* --- Single spurious edge: rejected, estimate unchanged --- */
+    zc_pll_estimate_t before, after;
+    double theta = 60.0 * (double)TEST_EVENTS;
+    uint32_t zc_us = test_us(test_time_at(theta - 30.0));     // Mid-step glitch
+    Service_ZcPll_Estimate(&pll, zc_us, &before);
+    SIM_CHECK(!Service_ZcPll_OnZeroCross(&pll, zc_us, (uint8_t)((TEST_EVENTS + 5U) % 6U)));
+    Service_ZcPll_Estimate(&pll, zc_us, &after);
+    SIM_CHECK(after.omega_dps == before.omega_dps && after.locked);
+
+    zc_us = test_us(test_time_at(theta));
+    SIM_CHECK(Service_ZcPll_OnZeroCross(&pll, zc_us, (uint8_t)((TEST_EVENTS + 5U) % 6U)));
+
+    /* --- Lost rotor: re-acquired after consecutive rejects --- */
+    uint32_t jump_us = zc_us + 50000U;
+    uint32_t period_us = 500U;
+    bool relocked = false;
+    for (uint32_t k = 0; k < 20U; k++)
+    {
+        (void)Service_ZcPll_OnZeroCross(&pll, jump_us + k * period_us, (uint8_t)(k % 6U));
+        relocked = pll.locked && fabsf(pll.omega_dps - 60.0f / (period_us * 1e-6f)) < 0.01f * 60.0f / (period_us * 1e-6f);
+    }
+    printf("after a jump: locked %d, %.0f Hz electrical\n", (int)pll.locked, pll.omega_dps / 360.0f);
+    SIM_CHECK(relocked);
+
+    /* --- Not locked: no prediction --- */
+    Service_ZcPll_Reset(&pll);
+    SIM_CHECK(Service_ZcPll_TimeToAngle(&pll, zc_us, 90.0f) < 0.0f);
+
+    /* --- Wraps: extrapolation over ±5 turns, six-step of any angle --- */
+    pll.theta_deg  = 350.0f;
+    pll.omega_dps  = 360.0f * 300.0f;
+    pll.accel_dps2 = 0.0f;
+    pll.t_us       = 100000U;
+    float worst = 0.0f;
+    for (int32_t dt_us = -16000; dt_us <= 16000; dt_us += 7)
+    {
+        zc_pll_estimate_t est;
+        Service_ZcPll_Estimate(&pll, (uint32_t)((int32_t)pll.t_us + dt_us), &est);
+        double ref = fmod(350.0 + 108000.0 * (double)dt_us * 1e-6, 360.0);
+        if (ref < 0.0) ref += 360.0;
+        double d = fabs((double)est.theta_deg - ref);
+        d = fmin(d, 360.0 - d);
+        SIM_CHECK(est.theta_deg >= 0.0f && est.theta_deg < 360.0f);
+        worst = fmaxf(worst, (float)d);
+    }
+    printf("wrap: max deviation from fmod %.4f deg\n", worst);
+    SIM_CHECK(worst < 0.01f);
+
+    uint32_t mismatch = 0;
+    for (float deg = -720.0f; deg <= 720.0f; deg += 0.25f)
+    {
+        int32_t k_cw  = (int32_t)floor((deg - 30.0) / 60.0);
+        int32_t k_ccw = (int32_t)floor((210.0 - deg) / 60.0);
+        if (Service_Motor_SixStepOfAngle(deg, true) != (uint8_t)(((k_cw % 6) + 6) % 6)) mismatch++;
+        if (Service_Motor_SixStepOfAngle(deg, false) != (uint8_t)(((k_ccw % 6) + 6) % 6)) mismatch++;
+    }
+    SIM_CHECK(mismatch == 0U);
+
+    return Sim_Test_Summary(__FILE__);
+}